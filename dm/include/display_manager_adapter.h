@@ -58,6 +58,9 @@ public:
     virtual sptr<DisplayInfo> GetDisplayInfoByScreenId(ScreenId screenId);
     virtual std::vector<DisplayId> GetAllDisplayIds();
     virtual std::shared_ptr<Media::PixelMap> GetDisplaySnapshot(DisplayId displayId);
+    virtual DMError RequestDisplaySnapshot(DisplayId displayId, const sptr<IDisplayManagerAgent>& agent);
+    virtual ScreenId StartDisplayCapture(const DisplayCaptureOption& option,
+        const sptr<IDisplayManagerAgent>& displayManagerAgent);
     virtual bool WakeUpBegin(PowerStateChangeReason reason);
     virtual bool WakeUpEnd();
     virtual bool SuspendBegin(PowerStateChangeReason reason);
@@ -96,8 +99,34 @@ public:
     virtual DMError GetScreenGamutMap(ScreenId screenId, ScreenGamutMap& gamutMap);
     virtual DMError SetScreenGamutMap(ScreenId screenId, ScreenGamutMap gamutMap);
     virtual DMError SetScreenColorTransform(ScreenId screenId);
+
+    // The screen info cache is only served while the screen events of DMS keep it up to date.
+    void SetScreenInfoCacheEnabled(bool enabled);
+    void UpdateScreenInfoCache(const sptr<ScreenInfo>& screenInfo);
+    void RemoveScreenInfoCache(ScreenId screenId);
+    virtual void Clear() override;
 private:
+    struct ScreenInfoCacheItem {
+        sptr<ScreenInfo> info_;
+        bool hasColorGamuts_ { false };
+        std::vector<ScreenColorGamut> colorGamuts_;
+        bool hasColorGamut_ { false };
+        ScreenColorGamut colorGamut_ { ScreenColorGamut::COLOR_GAMUT_NATIVE };
+        bool hasGamutMap_ { false };
+        ScreenGamutMap gamutMap_ { ScreenGamutMap::GAMUT_MAP_CONSTANT };
+    };
+    ScreenInfoCacheItem* GetScreenInfoCacheItemLocked(ScreenId screenId);
+    void UpdateScreenInfoCacheLocked(const sptr<ScreenInfo>& screenInfo);
+    void InvalidateScreenInfoCache(ScreenId screenId);
+    void InvalidateAllScreenInfoCache();
+
     static inline SingletonDelegator<ScreenManagerAdapter> delegator;
+    std::mutex cacheMutex_;
+    bool isCacheEnabled_ { false };
+    bool isAllScreenInfosCached_ { false };
+    // bumped by every eviction, a reply to a query started under an older generation is not cached
+    uint64_t cacheGeneration_ { 0 };
+    std::map<ScreenId, ScreenInfoCacheItem> screenInfoCache_;
 };
 } // namespace OHOS::Rosen
 #endif // FOUNDATION_DM_DISPLAY_MANAGER_ADAPTER_H
@@ -34,6 +34,7 @@ public:
     void OnDisplayCreate(sptr<DisplayInfo>) override {};
     void OnDisplayDestroy(DisplayId) override {};
     void OnDisplayChange(const sptr<DisplayInfo>, DisplayChangeEvent) override {};
+    void OnDisplaySnapshot(DisplayId, std::shared_ptr<Media::PixelMap>) override {};
 };
 }
 }
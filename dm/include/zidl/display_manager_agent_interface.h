@@ -17,6 +17,7 @@
 #define OHOS_ROSEN_DISPLAY_MANAGER_AGENT_INTERFACE_H
 
 #include <iremote_broker.h>
+#include <pixel_map.h>
 #include "display_info.h"
 #include "dm_common.h"
 #include "screen_info.h"
@@ -45,6 +46,7 @@ public:
         TRANS_ID_ON_DISPLAY_CONNECT,
         TRANS_ID_ON_DISPLAY_DISCONNECT,
         TRANS_ID_ON_DISPLAY_CHANGED,
+        TRANS_ID_ON_DISPLAY_SNAPSHOT,
     };
     virtual void NotifyDisplayPowerEvent(DisplayPowerEvent event, EventStatus status) = 0;
     virtual void NotifyDisplayStateChanged(DisplayId id, DisplayState state) = 0;
@@ -55,6 +57,7 @@ public:
     virtual void OnDisplayCreate(sptr<DisplayInfo>) = 0;
     virtual void OnDisplayDestroy(DisplayId) = 0;
     virtual void OnDisplayChange(sptr<DisplayInfo>, DisplayChangeEvent) = 0;
+    virtual void OnDisplaySnapshot(DisplayId, std::shared_ptr<Media::PixelMap>) = 0;
 };
 } // namespace Rosen
 } // namespace OHOS
@@ -35,6 +35,7 @@ public:
     virtual void OnDisplayCreate(sptr<DisplayInfo>) override;
     virtual void OnDisplayDestroy(DisplayId) override;
     virtual void OnDisplayChange(sptr<DisplayInfo>, DisplayChangeEvent) override;
+    virtual void OnDisplaySnapshot(DisplayId, std::shared_ptr<Media::PixelMap>) override;
 private:
     static inline BrokerDelegator<DisplayManagerAgentProxy> delegator_;
 };
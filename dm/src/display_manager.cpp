@@ -45,6 +45,8 @@ public:
     bool RegisterDisplayPowerEventListener(sptr<IDisplayPowerEventListener> listener);
     bool UnregisterDisplayPowerEventListener(sptr<IDisplayPowerEventListener> listener);
     sptr<Display> GetDisplayByScreenId(ScreenId screenId);
+    bool GetScreenshotAsync(DisplayId displayId, ScreenshotCallback callback);
+    ScreenId StartDisplayCapture(const DisplayCaptureOption& option);
 private:
     void ClearDisplayStateCallback();
     void NotifyDisplayPowerEvent(DisplayPowerEvent event, EventStatus status);
@@ -65,6 +67,9 @@ private:
     sptr<DisplayManagerAgent> powerEventListenerAgent_;
     sptr<DisplayManagerAgent> displayStateAgent_;
     std::set<sptr<IDisplayListener>> displayListeners_;
+    class ScreenshotAgent;
+    std::set<sptr<ScreenshotAgent>> screenshotAgents_;
+    sptr<DisplayManagerAgentDefault> captureAgent_;
 };
 
 class DisplayManager::Impl::DisplayManagerListener : public DisplayManagerAgentDefault {
@@ -145,6 +150,33 @@ private:
     sptr<Impl> pImpl_;
 };
 
+// one agent per request, kept alive by impl until the capture is delivered
+class DisplayManager::Impl::ScreenshotAgent : public DisplayManagerAgentDefault {
+public:
+    ScreenshotAgent(sptr<Impl> impl, ScreenshotCallback callback) : pImpl_(impl), callback_(callback)
+    {
+    }
+    ~ScreenshotAgent() = default;
+
+    void OnDisplaySnapshot(DisplayId displayId, std::shared_ptr<Media::PixelMap> pixelMap) override
+    {
+        if (pixelMap == nullptr) {
+            WLOGFE("OnDisplaySnapshot: capture of display %{public}" PRIu64" failed", displayId);
+        }
+        // the set may hold the last reference of this agent, so keep the callback before releasing it
+        ScreenshotCallback callback = callback_;
+        sptr<Impl> impl = pImpl_;
+        {
+            std::lock_guard<std::recursive_mutex> lock(impl->mutex_);
+            impl->screenshotAgents_.erase(this);
+        }
+        callback(pixelMap);
+    }
+private:
+    sptr<Impl> pImpl_;
+    ScreenshotCallback callback_;
+};
+
 bool DisplayManager::Impl::CheckRectValid(const Media::Rect& rect, int32_t oriHeight, int32_t oriWidth) const
 {
     if (!((rect.left >= 0) && (rect.left < oriWidth) && (rect.top >= 0) && (rect.top < oriHeight))) {
@@ -336,6 +368,68 @@ std::shared_ptr<Media::PixelMap> DisplayManager::GetScreenshot(DisplayId display
     return dstScreenshot;
 }
 
+bool DisplayManager::Impl::GetScreenshotAsync(DisplayId displayId, ScreenshotCallback callback)
+{
+    sptr<ScreenshotAgent> agent = new ScreenshotAgent(this, callback);
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        screenshotAgents_.insert(agent);
+    }
+    DMError ret = SingletonContainer::Get<DisplayManagerAdapter>().RequestDisplaySnapshot(displayId, agent);
+    if (ret != DMError::DM_OK) {
+        WLOGFE("RequestDisplaySnapshot failed, ret %{public}d", static_cast<int32_t>(ret));
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        screenshotAgents_.erase(agent);
+        return false;
+    }
+    return true;
+}
+
+bool DisplayManager::GetScreenshotAsync(DisplayId displayId, ScreenshotCallback callback)
+{
+    if (displayId == DISPLAY_ID_INVALID || callback == nullptr) {
+        WLOGFE("displayId or callback invalid!");
+        return false;
+    }
+    return pImpl_->GetScreenshotAsync(displayId, callback);
+}
+
+ScreenId DisplayManager::Impl::StartDisplayCapture(const DisplayCaptureOption& option)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (captureAgent_ == nullptr) {
+        // identifies this process to DMS, which stops all its captures when the process dies
+        captureAgent_ = new DisplayManagerAgentDefault();
+    }
+    return SingletonContainer::Get<DisplayManagerAdapter>().StartDisplayCapture(option, captureAgent_);
+}
+
+ScreenId DisplayManager::StartDisplayCapture(const DisplayCaptureOption& option)
+{
+    if (option.displayId_ == DISPLAY_ID_INVALID || option.surface_ == nullptr) {
+        WLOGFE("displayId or surface invalid!");
+        return SCREEN_ID_INVALID;
+    }
+    if (option.width_ > MAX_RESOLUTION_SIZE || option.height_ > MAX_RESOLUTION_SIZE) {
+        WLOGFE("width or height too big!");
+        return SCREEN_ID_INVALID;
+    }
+    ScreenId captureId = pImpl_->StartDisplayCapture(option);
+    if (captureId == SCREEN_ID_INVALID) {
+        WLOGFE("StartDisplayCapture failed, display %{public}" PRIu64"", option.displayId_);
+    }
+    return captureId;
+}
+
+bool DisplayManager::StopDisplayCapture(ScreenId captureId)
+{
+    if (captureId == SCREEN_ID_INVALID) {
+        WLOGFE("captureId invalid!");
+        return false;
+    }
+    return SingletonContainer::Get<ScreenManagerAdapter>().DestroyVirtualScreen(captureId) == DMError::DM_OK;
+}
+
 sptr<Display> DisplayManager::GetDefaultDisplay()
 {
     return GetDisplayById(GetDefaultDisplayId());
@@ -15,6 +15,7 @@
 
 #include "display_manager_adapter.h"
 
+#include <cinttypes>
 #include <iremote_broker.h>
 #include <iservice_registry.h>
 #include <system_ability_definition.h>
@@ -57,40 +58,119 @@ std::shared_ptr<Media::PixelMap> DisplayManagerAdapter::GetDisplaySnapshot(Displ
     return displayManagerServiceProxy_->GetDisplaySnapshot(displayId);
 }
 
+DMError DisplayManagerAdapter::RequestDisplaySnapshot(DisplayId displayId, const sptr<IDisplayManagerAgent>& agent)
+{
+    INIT_PROXY_CHECK_RETURN(DMError::DM_ERROR_INIT_DMS_PROXY_LOCKED);
+
+    return displayManagerServiceProxy_->RequestDisplaySnapshot(displayId, agent);
+}
+
+ScreenId DisplayManagerAdapter::StartDisplayCapture(const DisplayCaptureOption& option,
+    const sptr<IDisplayManagerAgent>& displayManagerAgent)
+{
+    INIT_PROXY_CHECK_RETURN(SCREEN_ID_INVALID);
+
+    if (displayManagerAgent == nullptr) {
+        WLOGFE("StartDisplayCapture: agent is nullptr");
+        return SCREEN_ID_INVALID;
+    }
+    return displayManagerServiceProxy_->StartDisplayCapture(option, displayManagerAgent->AsObject());
+}
+
 DMError ScreenManagerAdapter::GetScreenSupportedColorGamuts(ScreenId screenId,
     std::vector<ScreenColorGamut>& colorGamuts)
 {
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto item = GetScreenInfoCacheItemLocked(screenId);
+        if (item != nullptr && item->hasColorGamuts_) {
+            colorGamuts = item->colorGamuts_;
+            return DMError::DM_OK;
+        }
+    }
     INIT_PROXY_CHECK_RETURN(DMError::DM_ERROR_INIT_DMS_PROXY_LOCKED);
 
-    return displayManagerServiceProxy_->GetScreenSupportedColorGamuts(screenId, colorGamuts);
+    DMError ret = displayManagerServiceProxy_->GetScreenSupportedColorGamuts(screenId, colorGamuts);
+    if (ret == DMError::DM_OK) {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto item = GetScreenInfoCacheItemLocked(screenId);
+        if (item != nullptr) {
+            item->colorGamuts_ = colorGamuts;
+            item->hasColorGamuts_ = true;
+        }
+    }
+    return ret;
 }
 
 DMError ScreenManagerAdapter::GetScreenColorGamut(ScreenId screenId, ScreenColorGamut& colorGamut)
 {
+    sptr<ScreenInfo> cachedInfo = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto item = GetScreenInfoCacheItemLocked(screenId);
+        if (item != nullptr && item->hasColorGamut_) {
+            colorGamut = item->colorGamut_;
+            return DMError::DM_OK;
+        }
+        cachedInfo = item != nullptr ? item->info_ : nullptr;
+    }
     INIT_PROXY_CHECK_RETURN(DMError::DM_ERROR_INIT_DMS_PROXY_LOCKED);
 
-    return displayManagerServiceProxy_->GetScreenColorGamut(screenId, colorGamut);
+    DMError ret = displayManagerServiceProxy_->GetScreenColorGamut(screenId, colorGamut);
+    if (ret == DMError::DM_OK) {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto item = GetScreenInfoCacheItemLocked(screenId);
+        // a newer screen version notified during the call makes the result outdated
+        if (item != nullptr && item->info_ == cachedInfo) {
+            item->colorGamut_ = colorGamut;
+            item->hasColorGamut_ = true;
+        }
+    }
+    return ret;
 }
 
 DMError ScreenManagerAdapter::SetScreenColorGamut(ScreenId screenId, int32_t colorGamutIdx)
 {
     INIT_PROXY_CHECK_RETURN(DMError::DM_ERROR_INIT_DMS_PROXY_LOCKED);
 
-    return displayManagerServiceProxy_->SetScreenColorGamut(screenId, colorGamutIdx);
+    DMError ret = displayManagerServiceProxy_->SetScreenColorGamut(screenId, colorGamutIdx);
+    InvalidateScreenInfoCache(screenId);
+    return ret;
 }
 
 DMError ScreenManagerAdapter::GetScreenGamutMap(ScreenId screenId, ScreenGamutMap& gamutMap)
 {
+    sptr<ScreenInfo> cachedInfo = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto item = GetScreenInfoCacheItemLocked(screenId);
+        if (item != nullptr && item->hasGamutMap_) {
+            gamutMap = item->gamutMap_;
+            return DMError::DM_OK;
+        }
+        cachedInfo = item != nullptr ? item->info_ : nullptr;
+    }
     INIT_PROXY_CHECK_RETURN(DMError::DM_ERROR_INIT_DMS_PROXY_LOCKED);
 
-    return displayManagerServiceProxy_->GetScreenGamutMap(screenId, gamutMap);
+    DMError ret = displayManagerServiceProxy_->GetScreenGamutMap(screenId, gamutMap);
+    if (ret == DMError::DM_OK) {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto item = GetScreenInfoCacheItemLocked(screenId);
+        if (item != nullptr && item->info_ == cachedInfo) {
+            item->gamutMap_ = gamutMap;
+            item->hasGamutMap_ = true;
+        }
+    }
+    return ret;
 }
 
 DMError ScreenManagerAdapter::SetScreenGamutMap(ScreenId screenId, ScreenGamutMap gamutMap)
 {
     INIT_PROXY_CHECK_RETURN(DMError::DM_ERROR_INIT_DMS_PROXY_LOCKED);
 
-    return displayManagerServiceProxy_->SetScreenGamutMap(screenId, gamutMap);
+    DMError ret = displayManagerServiceProxy_->SetScreenGamutMap(screenId, gamutMap);
+    InvalidateScreenInfoCache(screenId);
+    return ret;
 }
 
 DMError ScreenManagerAdapter::SetScreenColorTransform(ScreenId screenId)
@@ -106,7 +186,9 @@ ScreenId ScreenManagerAdapter::CreateVirtualScreen(VirtualScreenOption option,
     INIT_PROXY_CHECK_RETURN(SCREEN_ID_INVALID);
 
     WLOGFI("DisplayManagerAdapter::CreateVirtualScreen");
-    return displayManagerServiceProxy_->CreateVirtualScreen(option, displayManagerAgent->AsObject());
+    ScreenId screenId = displayManagerServiceProxy_->CreateVirtualScreen(option, displayManagerAgent->AsObject());
+    InvalidateScreenInfoCache(screenId);
+    return screenId;
 }
 
 DMError ScreenManagerAdapter::DestroyVirtualScreen(ScreenId screenId)
@@ -114,7 +196,9 @@ DMError ScreenManagerAdapter::DestroyVirtualScreen(ScreenId screenId)
     INIT_PROXY_CHECK_RETURN(DMError::DM_ERROR_INIT_DMS_PROXY_LOCKED);
 
     WLOGFI("DisplayManagerAdapter::DestroyVirtualScreen");
-    return displayManagerServiceProxy_->DestroyVirtualScreen(screenId);
+    DMError ret = displayManagerServiceProxy_->DestroyVirtualScreen(screenId);
+    InvalidateScreenInfoCache(screenId);
+    return ret;
 }
 
 DMError ScreenManagerAdapter::SetVirtualScreenSurface(ScreenId screenId, sptr<Surface> surface)
@@ -141,7 +225,9 @@ bool ScreenManagerAdapter::SetOrientation(ScreenId screenId, Orientation orienta
 {
     INIT_PROXY_CHECK_RETURN(false);
 
-    return displayManagerServiceProxy_->SetOrientation(screenId, orientation);
+    bool ret = displayManagerServiceProxy_->SetOrientation(screenId, orientation);
+    InvalidateScreenInfoCache(screenId);
+    return ret;
 }
 
 bool BaseAdapter::RegisterDisplayManagerAgent(const sptr<IDisplayManagerAgent>& displayManagerAgent,
@@ -273,6 +359,13 @@ void DMSDeathRecipient::OnRemoteDied(const wptr<IRemoteObject>& wptrDeath)
     return;
 }
 
+void ScreenManagerAdapter::Clear()
+{
+    // the screen events are lost together with DMS
+    SetScreenInfoCacheEnabled(false);
+    BaseAdapter::Clear();
+}
+
 void BaseAdapter::Clear()
 {
     if ((displayManagerServiceProxy_ != nullptr) && (displayManagerServiceProxy_->AsObject() != nullptr)) {
@@ -286,7 +379,9 @@ ScreenId ScreenManagerAdapter::MakeMirror(ScreenId mainScreenId, std::vector<Scr
 {
     INIT_PROXY_CHECK_RETURN(SCREEN_ID_INVALID);
 
-    return displayManagerServiceProxy_->MakeMirror(mainScreenId, mirrorScreenId);
+    ScreenId group = displayManagerServiceProxy_->MakeMirror(mainScreenId, mirrorScreenId);
+    InvalidateAllScreenInfoCache();
+    return group;
 }
 
 sptr<ScreenInfo> ScreenManagerAdapter::GetScreenInfo(ScreenId screenId)
@@ -295,9 +390,24 @@ sptr<ScreenInfo> ScreenManagerAdapter::GetScreenInfo(ScreenId screenId)
         WLOGFE("screen id is invalid");
         return nullptr;
     }
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto item = GetScreenInfoCacheItemLocked(screenId);
+        if (item != nullptr) {
+            return item->info_;
+        }
+        generation = cacheGeneration_;
+    }
     INIT_PROXY_CHECK_RETURN(nullptr);
 
     sptr<ScreenInfo> screenInfo = displayManagerServiceProxy_->GetScreenInfoById(screenId);
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (generation != cacheGeneration_) {
+        WLOGFD("screen info cache evicted during query, do not cache screen %{public}" PRIu64"", screenId);
+        return screenInfo;
+    }
+    UpdateScreenInfoCacheLocked(screenInfo);
     return screenInfo;
 }
 
@@ -332,16 +442,120 @@ sptr<ScreenGroupInfo> ScreenManagerAdapter::GetScreenGroupInfoById(ScreenId scre
 
 std::vector<sptr<ScreenInfo>> ScreenManagerAdapter::GetAllScreenInfos()
 {
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (isCacheEnabled_ && isAllScreenInfosCached_) {
+            std::vector<sptr<ScreenInfo>> screenInfos;
+            for (auto& iter : screenInfoCache_) {
+                screenInfos.emplace_back(iter.second.info_);
+            }
+            return screenInfos;
+        }
+        generation = cacheGeneration_;
+    }
     INIT_PROXY_CHECK_RETURN(std::vector<sptr<ScreenInfo>>());
 
-    return displayManagerServiceProxy_->GetAllScreenInfos();
+    auto screenInfos = displayManagerServiceProxy_->GetAllScreenInfos();
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (generation != cacheGeneration_) {
+        WLOGFD("screen info cache evicted during query, do not cache all screen infos");
+        return screenInfos;
+    }
+    for (auto& screenInfo : screenInfos) {
+        UpdateScreenInfoCacheLocked(screenInfo);
+    }
+    if (isCacheEnabled_ && screenInfoCache_.size() == screenInfos.size()) {
+        isAllScreenInfosCached_ = true;
+    }
+    return screenInfos;
+}
+
+void ScreenManagerAdapter::SetScreenInfoCacheEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    WLOGFI("screen info cache enabled: %{public}d", enabled);
+    isCacheEnabled_ = enabled;
+    cacheGeneration_++;
+    if (!enabled) {
+        screenInfoCache_.clear();
+        isAllScreenInfosCached_ = false;
+    }
+}
+
+void ScreenManagerAdapter::UpdateScreenInfoCache(const sptr<ScreenInfo>& screenInfo)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    UpdateScreenInfoCacheLocked(screenInfo);
+}
+
+void ScreenManagerAdapter::UpdateScreenInfoCacheLocked(const sptr<ScreenInfo>& screenInfo)
+{
+    if (screenInfo == nullptr || screenInfo->GetScreenId() == SCREEN_ID_INVALID || !isCacheEnabled_) {
+        return;
+    }
+    auto iter = screenInfoCache_.find(screenInfo->GetScreenId());
+    if (iter == screenInfoCache_.end()) {
+        screenInfoCache_[screenInfo->GetScreenId()].info_ = screenInfo;
+        return;
+    }
+    ScreenInfoCacheItem& item = iter->second;
+    uint32_t version = item.info_->GetVersion();
+    if (screenInfo->GetVersion() == version) {
+        return;
+    }
+    // versions only increase, an older info is a reply overtaken by a change event
+    if (screenInfo->GetVersion() < version) {
+        WLOGFD("drop outdated screen info, version %{public}u < %{public}u", screenInfo->GetVersion(), version);
+        return;
+    }
+    item.info_ = screenInfo;
+    item.hasColorGamut_ = false;
+    item.hasGamutMap_ = false;
+}
+
+void ScreenManagerAdapter::RemoveScreenInfoCache(ScreenId screenId)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    screenInfoCache_.erase(screenId);
+    cacheGeneration_++;
+}
+
+ScreenManagerAdapter::ScreenInfoCacheItem* ScreenManagerAdapter::GetScreenInfoCacheItemLocked(ScreenId screenId)
+{
+    if (!isCacheEnabled_) {
+        return nullptr;
+    }
+    auto iter = screenInfoCache_.find(screenId);
+    if (iter == screenInfoCache_.end()) {
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+void ScreenManagerAdapter::InvalidateScreenInfoCache(ScreenId screenId)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    screenInfoCache_.erase(screenId);
+    isAllScreenInfosCached_ = false;
+    cacheGeneration_++;
+}
+
+void ScreenManagerAdapter::InvalidateAllScreenInfoCache()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    screenInfoCache_.clear();
+    isAllScreenInfosCached_ = false;
+    cacheGeneration_++;
 }
 
 ScreenId ScreenManagerAdapter::MakeExpand(std::vector<ScreenId> screenId, std::vector<Point> startPoint)
 {
     INIT_PROXY_CHECK_RETURN(SCREEN_ID_INVALID);
 
-    return displayManagerServiceProxy_->MakeExpand(screenId, startPoint);
+    ScreenId group = displayManagerServiceProxy_->MakeExpand(screenId, startPoint);
+    InvalidateAllScreenInfoCache();
+    return group;
 }
 
 void ScreenManagerAdapter::RemoveVirtualScreenFromGroup(std::vector<ScreenId> screens)
@@ -349,12 +563,15 @@ void ScreenManagerAdapter::RemoveVirtualScreenFromGroup(std::vector<ScreenId> sc
     INIT_PROXY_CHECK_RETURN();
 
     displayManagerServiceProxy_->RemoveVirtualScreenFromGroup(screens);
+    InvalidateAllScreenInfoCache();
 }
 
 bool ScreenManagerAdapter::SetScreenActiveMode(ScreenId screenId, uint32_t modeId)
 {
     INIT_PROXY_CHECK_RETURN(false);
 
-    return displayManagerServiceProxy_->SetScreenActiveMode(screenId, modeId);
+    bool ret = displayManagerServiceProxy_->SetScreenActiveMode(screenId, modeId);
+    InvalidateScreenInfoCache(screenId);
+    return ret;
 }
 } // namespace OHOS::Rosen
\ No newline at end of file
@@ -50,6 +50,8 @@ private:
     void NotifyScreenChange(const sptr<ScreenInfo>& screenInfo);
     void NotifyScreenChange(const std::vector<sptr<ScreenInfo>>& screenInfos);
     bool UpdateScreenInfoLocked(sptr<ScreenInfo>);
+    bool RegisterScreenManagerListenerLocked();
+    void UnregisterScreenManagerListenerLocked(bool& ret);
 
     class ScreenManagerListener;
     sptr<ScreenManagerListener> screenManagerListener_;
@@ -158,6 +160,7 @@ ScreenManager::Impl::~Impl()
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     bool res = true;
     if (screenManagerListener_ != nullptr) {
+        SingletonContainer::Get<ScreenManagerAdapter>().SetScreenInfoCacheEnabled(false);
         res = SingletonContainer::Get<ScreenManagerAdapter>().UnregisterDisplayManagerAgent(
             screenManagerListener_,
             DisplayManagerAgentType::SCREEN_EVENT_LISTENER);
@@ -170,6 +173,7 @@ ScreenManager::Impl::~Impl()
 
 sptr<Screen> ScreenManager::Impl::GetScreen(ScreenId screenId)
 {
+    // served by the client cache while a screen listener keeps the screen events coming
     auto screenInfo = SingletonContainer::Get<ScreenManagerAdapter>().GetScreenInfo(screenId);
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     if (!UpdateScreenInfoLocked(screenInfo)) {
@@ -234,22 +238,45 @@ std::vector<sptr<Screen>> ScreenManager::GetAllScreens()
 bool ScreenManager::Impl::RegisterScreenListener(sptr<IScreenListener> listener)
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    bool ret = true;
-    if (screenManagerListener_ == nullptr) {
-        screenManagerListener_ = new ScreenManagerListener(this);
-        ret = SingletonContainer::Get<ScreenManagerAdapter>().RegisterDisplayManagerAgent(
-            screenManagerListener_,
-            DisplayManagerAgentType::SCREEN_EVENT_LISTENER);
-    }
+    bool ret = RegisterScreenManagerListenerLocked();
     if (!ret) {
         WLOGFW("RegisterScreenListener failed !");
-        screenManagerListener_ = nullptr;
     } else {
         screenListeners_.insert(listener);
     }
     return ret;
 }
 
+bool ScreenManager::Impl::RegisterScreenManagerListenerLocked()
+{
+    if (screenManagerListener_ != nullptr) {
+        return true;
+    }
+    screenManagerListener_ = new ScreenManagerListener(this);
+    bool ret = SingletonContainer::Get<ScreenManagerAdapter>().RegisterDisplayManagerAgent(
+        screenManagerListener_,
+        DisplayManagerAgentType::SCREEN_EVENT_LISTENER);
+    if (!ret) {
+        WLOGFW("RegisterDisplayManagerAgent SCREEN_EVENT_LISTENER failed !");
+        screenManagerListener_ = nullptr;
+        return false;
+    }
+    SingletonContainer::Get<ScreenManagerAdapter>().SetScreenInfoCacheEnabled(true);
+    return true;
+}
+
+void ScreenManager::Impl::UnregisterScreenManagerListenerLocked(bool& ret)
+{
+    if (!screenListeners_.empty() || !screenGroupListeners_.empty() || screenManagerListener_ == nullptr) {
+        return;
+    }
+    SingletonContainer::Get<ScreenManagerAdapter>().SetScreenInfoCacheEnabled(false);
+    ret = SingletonContainer::Get<ScreenManagerAdapter>().UnregisterDisplayManagerAgent(
+        screenManagerListener_,
+        DisplayManagerAgentType::SCREEN_EVENT_LISTENER);
+    screenManagerListener_ = nullptr;
+}
+
 bool ScreenManager::RegisterScreenListener(sptr<IScreenListener> listener)
 {
     if (listener == nullptr) {
@@ -269,12 +296,7 @@ bool ScreenManager::Impl::UnregisterScreenListener(sptr<IScreenListener> listene
     }
     bool ret = true;
     screenListeners_.erase(iter);
-    if (screenListeners_.empty() && screenGroupListeners_.empty() && screenManagerListener_ != nullptr) {
-        ret = SingletonContainer::Get<ScreenManagerAdapter>().UnregisterDisplayManagerAgent(
-            screenManagerListener_,
-            DisplayManagerAgentType::SCREEN_EVENT_LISTENER);
-        screenManagerListener_ = nullptr;
-    }
+    UnregisterScreenManagerListenerLocked(ret);
     return ret;
 }
 
@@ -290,16 +312,9 @@ bool ScreenManager::UnregisterScreenListener(sptr<IScreenListener> listener)
 bool ScreenManager::Impl::RegisterScreenGroupListener(sptr<IScreenGroupListener> listener)
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    bool ret = true;
-    if (screenManagerListener_ == nullptr) {
-        screenManagerListener_ = new ScreenManagerListener(this);
-        ret = SingletonContainer::Get<ScreenManagerAdapter>().RegisterDisplayManagerAgent(
-            screenManagerListener_,
-            DisplayManagerAgentType::SCREEN_EVENT_LISTENER);
-    }
+    bool ret = RegisterScreenManagerListenerLocked();
     if (!ret) {
         WLOGFW("RegisterScreenGroupListener failed !");
-        screenManagerListener_ = nullptr;
     } else {
         screenGroupListeners_.insert(listener);
     }
@@ -325,12 +340,7 @@ bool ScreenManager::Impl::UnregisterScreenGroupListener(sptr<IScreenGroupListene
     }
     bool ret = true;
     screenGroupListeners_.erase(iter);
-    if (screenGroupListeners_.empty() && screenGroupListeners_.empty() && screenManagerListener_ != nullptr) {
-        ret = SingletonContainer::Get<ScreenManagerAdapter>().UnregisterDisplayManagerAgent(
-            screenManagerListener_,
-            DisplayManagerAgentType::SCREEN_EVENT_LISTENER);
-        screenManagerListener_ = nullptr;
-    }
+    UnregisterScreenManagerListenerLocked(ret);
     return ret;
 }
 
@@ -433,6 +443,7 @@ ScreenPowerState ScreenManager::GetScreenPower(ScreenId dmsScreenId)
 
 void ScreenManager::Impl::NotifyScreenConnect(sptr<ScreenInfo> info)
 {
+    SingletonContainer::Get<ScreenManagerAdapter>().UpdateScreenInfoCache(info);
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     UpdateScreenInfoLocked(info);
 }
@@ -440,12 +451,14 @@ void ScreenManager::Impl::NotifyScreenConnect(sptr<ScreenInfo> info)
 void ScreenManager::Impl::NotifyScreenDisconnect(ScreenId screenId)
 {
     WLOGFI("screenId:%{public}" PRIu64".", screenId);
+    SingletonContainer::Get<ScreenManagerAdapter>().RemoveScreenInfoCache(screenId);
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     screenMap_.erase(screenId);
 }
 
 void ScreenManager::Impl::NotifyScreenChange(const sptr<ScreenInfo>& screenInfo)
 {
+    SingletonContainer::Get<ScreenManagerAdapter>().UpdateScreenInfoCache(screenInfo);
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     UpdateScreenInfoLocked(screenInfo);
 }
@@ -454,6 +467,7 @@ void ScreenManager::Impl::NotifyScreenChange(const std::vector<sptr<ScreenInfo>>
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     for (auto screenInfo : screenInfos) {
+        SingletonContainer::Get<ScreenManagerAdapter>().UpdateScreenInfoCache(screenInfo);
         UpdateScreenInfoLocked(screenInfo);
     }
 }
@@ -229,6 +229,31 @@ void DisplayManagerAgentProxy::OnDisplayChange(sptr<DisplayInfo> displayInfo, Di
         WLOGFE("SendRequest failed");
     }
 }
+
+void DisplayManagerAgentProxy::OnDisplaySnapshot(DisplayId displayId, std::shared_ptr<Media::PixelMap> pixelMap)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        WLOGFE("WriteInterfaceToken failed");
+        return;
+    }
+
+    if (!data.WriteUint64(displayId)) {
+        WLOGFE("Write DisplayId failed");
+        return;
+    }
+
+    if (!data.WriteParcelable(pixelMap == nullptr ? nullptr : pixelMap.get())) {
+        WLOGFE("Write PixelMap failed");
+        return;
+    }
+
+    if (Remote()->SendRequest(TRANS_ID_ON_DISPLAY_SNAPSHOT, data, reply, option) != ERR_NONE) {
+        WLOGFE("SendRequest failed");
+    }
+}
 } // namespace Rosen
 } // namespace OHOS
 
@@ -107,6 +107,16 @@ int32_t DisplayManagerAgentStub::OnRemoteRequest(uint32_t code, MessageParcel& d
             OnDisplayChange(displayInfo, static_cast<DisplayChangeEvent>(event));
             break;
         }
+        case TRANS_ID_ON_DISPLAY_SNAPSHOT: {
+            DisplayId displayId;
+            if (!data.ReadUint64(displayId)) {
+                WLOGFE("Read DisplayId failed");
+                return -1;
+            }
+            std::shared_ptr<Media::PixelMap> pixelMap(data.ReadParcelable<Media::PixelMap>());
+            OnDisplaySnapshot(displayId, pixelMap);
+            break;
+        }
         default:
             break;
     }
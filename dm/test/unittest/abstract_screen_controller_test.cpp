@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "abstract_screen_controller.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr uint32_t SCREEN_WIDTH = 720;
+    constexpr uint32_t SCREEN_HEIGHT = 1280;
+    constexpr ScreenId UNKNOWN_RS_SCREEN_ID = 2000;
+    constexpr ScreenId UNKNOWN_DMS_SCREEN_ID = 3000;
+}
+
+class AbstractScreenControllerTest : public testing::Test {
+public:
+    virtual void SetUp() override;
+    virtual void TearDown() override;
+    void QueueHotplugEvent(ScreenId rsScreenId, ScreenEvent first, ScreenEvent last);
+
+    ProfiledRecursiveMutex mutex_ { "AbstractScreenControllerTest" };
+    sptr<AbstractScreenController> controller_;
+    sptr<AbstractScreenController::AbstractScreenCallback> callback_;
+    uint32_t connectCount_ { 0 };
+    uint32_t disconnectCount_ { 0 };
+    uint32_t changeCount_ { 0 };
+    std::vector<std::pair<std::vector<ScreenId>, std::vector<ScreenId>>> reconfigurations_;
+};
+
+void AbstractScreenControllerTest::SetUp()
+{
+    controller_ = new AbstractScreenController(mutex_);
+    callback_ = new AbstractScreenController::AbstractScreenCallback();
+    callback_->onConnect_ = [this](sptr<AbstractScreen>) { connectCount_++; };
+    callback_->onDisconnect_ = [this](sptr<AbstractScreen>) { disconnectCount_++; };
+    callback_->onChange_ = [this](sptr<AbstractScreen>, DisplayChangeEvent) { changeCount_++; };
+    callback_->onReconfigure_ = [this](const std::vector<AbstractScreenController::DisconnectedScreen>& disconnected,
+        const std::vector<sptr<AbstractScreen>>& connected) {
+        std::vector<ScreenId> disconnectedIds;
+        for (auto& item : disconnected) {
+            disconnectedIds.push_back(item.screen_->dmsId_);
+        }
+        std::vector<ScreenId> connectedIds;
+        for (auto& screen : connected) {
+            connectedIds.push_back(screen->dmsId_);
+        }
+        reconfigurations_.emplace_back(disconnectedIds, connectedIds);
+    };
+    controller_->RegisterAbstractScreenCallback(callback_);
+}
+
+void AbstractScreenControllerTest::TearDown()
+{
+    controller_ = nullptr;
+    callback_ = nullptr;
+}
+
+void AbstractScreenControllerTest::QueueHotplugEvent(ScreenId rsScreenId, ScreenEvent first, ScreenEvent last)
+{
+    std::lock_guard<std::mutex> lock(controller_->pendingEventsMutex_);
+    controller_->pendingHotplugEvents_[rsScreenId] = { first, last };
+}
+
+namespace {
+/**
+ * @tc.name: HotplugBurst01
+ * @tc.desc: screens unplugged in one batch reach the displays as a single reconfiguration
+ * @tc.type: FUNC
+ */
+HWTEST_F(AbstractScreenControllerTest, HotplugBurst01, Function | SmallTest | Level2)
+{
+    ScreenId mainScreenId = controller_->ConnectHeadlessScreen(SCREEN_WIDTH, SCREEN_HEIGHT);
+    ScreenId firstScreenId = controller_->ConnectHeadlessScreen(SCREEN_WIDTH, SCREEN_HEIGHT);
+    ScreenId secondScreenId = controller_->ConnectHeadlessScreen(SCREEN_WIDTH, SCREEN_HEIGHT);
+    ASSERT_NE(SCREEN_ID_INVALID, mainScreenId);
+    ASSERT_NE(SCREEN_ID_INVALID, firstScreenId);
+    ASSERT_NE(SCREEN_ID_INVALID, secondScreenId);
+    connectCount_ = 0;
+
+    QueueHotplugEvent(controller_->ConvertToRsScreenId(firstScreenId), ScreenEvent::DISCONNECTED,
+        ScreenEvent::DISCONNECTED);
+    QueueHotplugEvent(controller_->ConvertToRsScreenId(secondScreenId), ScreenEvent::DISCONNECTED,
+        ScreenEvent::DISCONNECTED);
+    controller_->FlushScreenEvents();
+
+    ASSERT_EQ(0u, connectCount_);
+    ASSERT_EQ(0u, disconnectCount_);
+    ASSERT_EQ(1u, reconfigurations_.size());
+    ASSERT_EQ(std::vector<ScreenId>({ firstScreenId, secondScreenId }), reconfigurations_[0].first);
+    ASSERT_TRUE(reconfigurations_[0].second.empty());
+    ASSERT_EQ(nullptr, controller_->GetAbstractScreen(firstScreenId));
+    ASSERT_EQ(nullptr, controller_->GetAbstractScreen(secondScreenId));
+    ASSERT_NE(nullptr, controller_->GetAbstractScreen(mainScreenId));
+}
+
+/**
+ * @tc.name: HotplugBurst02
+ * @tc.desc: a mode change of a screen unplugged in the same batch is skipped
+ * @tc.type: FUNC
+ */
+HWTEST_F(AbstractScreenControllerTest, HotplugBurst02, Function | SmallTest | Level2)
+{
+    ScreenId mainScreenId = controller_->ConnectHeadlessScreen(SCREEN_WIDTH, SCREEN_HEIGHT);
+    ScreenId screenId = controller_->ConnectHeadlessScreen(SCREEN_WIDTH, SCREEN_HEIGHT);
+    ASSERT_NE(SCREEN_ID_INVALID, mainScreenId);
+    ASSERT_NE(SCREEN_ID_INVALID, screenId);
+
+    QueueHotplugEvent(controller_->ConvertToRsScreenId(screenId), ScreenEvent::DISCONNECTED,
+        ScreenEvent::DISCONNECTED);
+    {
+        std::lock_guard<std::mutex> lock(controller_->pendingEventsMutex_);
+        controller_->pendingModeChanges_.insert(screenId);
+        controller_->pendingModeChanges_.insert(mainScreenId);
+    }
+    controller_->FlushScreenEvents();
+
+    ASSERT_EQ(1u, reconfigurations_.size());
+    ASSERT_EQ(std::vector<ScreenId>({ screenId }), reconfigurations_[0].first);
+    // only the main screen which is still connected gets its mode change
+    ASSERT_EQ(1u, changeCount_);
+}
+
+/**
+ * @tc.name: HotplugBurst03
+ * @tc.desc: a screen plugged and unplugged within the settle window is never connected
+ * @tc.type: FUNC
+ */
+HWTEST_F(AbstractScreenControllerTest, HotplugBurst03, Function | SmallTest | Level2)
+{
+    ASSERT_NE(SCREEN_ID_INVALID, controller_->ConnectHeadlessScreen(SCREEN_WIDTH, SCREEN_HEIGHT));
+    connectCount_ = 0;
+
+    QueueHotplugEvent(UNKNOWN_RS_SCREEN_ID, ScreenEvent::CONNECTED, ScreenEvent::DISCONNECTED);
+    controller_->FlushScreenEvents();
+
+    ASSERT_EQ(0u, connectCount_);
+    ASSERT_TRUE(reconfigurations_.empty());
+    ASSERT_EQ(SCREEN_ID_INVALID, controller_->ConvertToDmsScreenId(UNKNOWN_RS_SCREEN_ID));
+}
+
+/**
+ * @tc.name: SettleWindow01
+ * @tc.desc: the first new screen opens a settle batch and the following outputs join it
+ * @tc.type: FUNC
+ */
+HWTEST_F(AbstractScreenControllerTest, SettleWindow01, Function | SmallTest | Level2)
+{
+    ASSERT_NE(SCREEN_ID_INVALID, controller_->ConnectHeadlessScreen(SCREEN_WIDTH, SCREEN_HEIGHT));
+
+    controller_->OnRsScreenConnectionChange(UNKNOWN_RS_SCREEN_ID, ScreenEvent::CONNECTED);
+    controller_->OnRsScreenConnectionChange(UNKNOWN_RS_SCREEN_ID + 1, ScreenEvent::CONNECTED);
+    // the batch is flushed by the test rather than by the delayed task
+    controller_->controllerHandler_->RemoveAllEvents();
+    {
+        std::lock_guard<std::mutex> lock(controller_->pendingEventsMutex_);
+        ASSERT_TRUE(controller_->flushScheduled_);
+        ASSERT_EQ(2u, controller_->pendingHotplugEvents_.size());
+        ASSERT_EQ(ScreenEvent::CONNECTED, controller_->pendingHotplugEvents_[UNKNOWN_RS_SCREEN_ID].first_);
+    }
+    controller_->FlushScreenEvents();
+    std::lock_guard<std::mutex> lock(controller_->pendingEventsMutex_);
+    ASSERT_TRUE(controller_->pendingHotplugEvents_.empty());
+    ASSERT_FALSE(controller_->flushScheduled_);
+}
+
+/**
+ * @tc.name: SettleWindow02
+ * @tc.desc: the first screen is needed by display init and is not delayed
+ * @tc.type: FUNC
+ */
+HWTEST_F(AbstractScreenControllerTest, SettleWindow02, Function | SmallTest | Level2)
+{
+    controller_->OnRsScreenConnectionChange(UNKNOWN_RS_SCREEN_ID, ScreenEvent::CONNECTED);
+
+    std::lock_guard<std::mutex> lock(controller_->pendingEventsMutex_);
+    ASSERT_TRUE(controller_->pendingHotplugEvents_.empty());
+    ASSERT_FALSE(controller_->flushScheduled_);
+}
+
+/**
+ * @tc.name: MirrorSource01
+ * @tc.desc: a rejected group change keeps the mirror source of the group
+ * @tc.type: FUNC
+ */
+HWTEST_F(AbstractScreenControllerTest, MirrorSource01, Function | SmallTest | Level2)
+{
+    ScreenId screenId = controller_->ConnectHeadlessScreen(SCREEN_WIDTH, SCREEN_HEIGHT);
+    ASSERT_NE(SCREEN_ID_INVALID, screenId);
+    auto group = controller_->GetAbstractScreenGroup(controller_->GetAbstractScreen(screenId)->groupDmsId_);
+    ASSERT_NE(nullptr, group);
+    ASSERT_EQ(screenId, group->mirrorScreenId_);
+
+    std::vector<ScreenId> screens = { screenId };
+    std::vector<Point> startPoints;
+    ASSERT_FALSE(controller_->ChangeScreenGroup(group, screens, startPoints, true, ScreenCombination::SCREEN_MIRROR,
+        UNKNOWN_DMS_SCREEN_ID));
+    ASSERT_EQ(screenId, group->mirrorScreenId_);
+}
+
+/**
+ * @tc.name: MirrorSource02
+ * @tc.desc: an accepted group change applies the mirror source, the default leaves it alone
+ * @tc.type: FUNC
+ */
+HWTEST_F(AbstractScreenControllerTest, MirrorSource02, Function | SmallTest | Level2)
+{
+    ScreenId screenId = controller_->ConnectHeadlessScreen(SCREEN_WIDTH, SCREEN_HEIGHT);
+    ASSERT_NE(SCREEN_ID_INVALID, screenId);
+    auto group = controller_->GetAbstractScreenGroup(controller_->GetAbstractScreen(screenId)->groupDmsId_);
+    ASSERT_NE(nullptr, group);
+
+    std::vector<ScreenId> screens = { screenId };
+    std::vector<Point> startPoints = { Point() };
+    ASSERT_TRUE(controller_->ChangeScreenGroup(group, screens, startPoints, true, ScreenCombination::SCREEN_EXPAND));
+    ASSERT_EQ(screenId, group->mirrorScreenId_);
+    ASSERT_TRUE(controller_->ChangeScreenGroup(group, screens, startPoints, true, ScreenCombination::SCREEN_MIRROR,
+        UNKNOWN_DMS_SCREEN_ID));
+    ASSERT_EQ(UNKNOWN_DMS_SCREEN_ID, group->mirrorScreenId_);
+    ASSERT_EQ(ScreenCombination::SCREEN_MIRROR, group->combination_);
+}
+
+/**
+ * @tc.name: RSTransactionBatch01
+ * @tc.desc: a flush inside nested batches is deferred until the outermost batch ends
+ * @tc.type: FUNC
+ */
+HWTEST_F(AbstractScreenControllerTest, RSTransactionBatch01, Function | SmallTest | Level2)
+{
+    WM_PROFILED_LOCK(mutex_);
+    {
+        AbstractScreenController::RSTransactionBatch outer(*controller_);
+        {
+            AbstractScreenController::RSTransactionBatch inner(*controller_);
+            ASSERT_EQ(2u, controller_->rsBatchDepth_);
+            controller_->FlushRSTransaction();
+            ASSERT_TRUE(controller_->rsFlushPending_);
+        }
+        ASSERT_EQ(1u, controller_->rsBatchDepth_);
+        ASSERT_TRUE(controller_->rsFlushPending_);
+    }
+    ASSERT_EQ(0u, controller_->rsBatchDepth_);
+    ASSERT_FALSE(controller_->rsFlushPending_);
+}
+}
+} // namespace Rosen
+} // namespace OHOS
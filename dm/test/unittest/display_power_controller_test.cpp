@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include "display_power_controller.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+class DisplayPowerControllerTest : public testing::Test {
+public:
+    virtual void SetUp() override;
+    virtual void TearDown() override;
+    uint64_t GetPhaseCount(DisplayPowerController::ScreenOnPhase phase) const;
+
+    ProfiledRecursiveMutex mutex_ { "DisplayPowerControllerTest" };
+    sptr<DisplayPowerController> controller_;
+};
+
+void DisplayPowerControllerTest::SetUp()
+{
+    controller_ = new DisplayPowerController(mutex_, [](DisplayId, DisplayStateChangeType) {});
+}
+
+void DisplayPowerControllerTest::TearDown()
+{
+    controller_ = nullptr;
+}
+
+uint64_t DisplayPowerControllerTest::GetPhaseCount(DisplayPowerController::ScreenOnPhase phase) const
+{
+    return controller_->screenOnHistograms_[static_cast<size_t>(phase)].GetSnapshot().count_;
+}
+
+namespace {
+/**
+ * @tc.name: ScreenOnStatistics01
+ * @tc.desc: A wake up records its total once, a later display on without wake up begin records none
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayPowerControllerTest, ScreenOnStatistics01, Function | SmallTest | Level2)
+{
+    ASSERT_TRUE(controller_->WakeUpBegin(PowerStateChangeReason::POWER_BUTTON));
+    ASSERT_TRUE(controller_->SetDisplayState(DisplayState::ON));
+    ASSERT_EQ(1u, GetPhaseCount(DisplayPowerController::ScreenOnPhase::TOTAL));
+    ASSERT_EQ(0u, controller_->wakeUpStartTimeUs_);
+
+    ASSERT_TRUE(controller_->SetDisplayState(DisplayState::OFF));
+    ASSERT_TRUE(controller_->SetDisplayState(DisplayState::ON));
+    ASSERT_EQ(2u, GetPhaseCount(DisplayPowerController::ScreenOnPhase::DISPLAY_ON));
+    ASSERT_EQ(1u, GetPhaseCount(DisplayPowerController::ScreenOnPhase::TOTAL));
+}
+
+/**
+ * @tc.name: ScreenOnStatistics02
+ * @tc.desc: Each wake up records its own total
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayPowerControllerTest, ScreenOnStatistics02, Function | SmallTest | Level2)
+{
+    ASSERT_TRUE(controller_->WakeUpBegin(PowerStateChangeReason::POWER_BUTTON));
+    ASSERT_TRUE(controller_->SetDisplayState(DisplayState::ON));
+    ASSERT_TRUE(controller_->SuspendBegin(PowerStateChangeReason::POWER_BUTTON));
+    ASSERT_TRUE(controller_->SetDisplayState(DisplayState::OFF));
+    ASSERT_TRUE(controller_->WakeUpBegin(PowerStateChangeReason::POWER_BUTTON));
+    ASSERT_TRUE(controller_->SetDisplayState(DisplayState::ON));
+    ASSERT_EQ(2u, GetPhaseCount(DisplayPowerController::ScreenOnPhase::TOTAL));
+}
+
+/**
+ * @tc.name: ScreenOnStatistics03
+ * @tc.desc: A keyguard drawn after display on is not recorded as a keyguard wait of the finished wake up
+ * @tc.type: FUNC
+ */
+HWTEST_F(DisplayPowerControllerTest, ScreenOnStatistics03, Function | SmallTest | Level2)
+{
+    ASSERT_TRUE(controller_->WakeUpBegin(PowerStateChangeReason::POWER_BUTTON));
+    controller_->NotifyDisplayEvent(DisplayEvent::KEYGUARD_DRAWN);
+    ASSERT_EQ(1u, GetPhaseCount(DisplayPowerController::ScreenOnPhase::KEYGUARD_DRAW_WAIT));
+    ASSERT_TRUE(controller_->SetDisplayState(DisplayState::ON));
+    controller_->NotifyDisplayEvent(DisplayEvent::UNLOCK);
+    controller_->NotifyDisplayEvent(DisplayEvent::KEYGUARD_DRAWN);
+    ASSERT_EQ(1u, GetPhaseCount(DisplayPowerController::ScreenOnPhase::KEYGUARD_DRAW_WAIT));
+}
+}
+} // namespace Rosen
+} // namespace OHOS
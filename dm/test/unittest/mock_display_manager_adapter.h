@@ -31,6 +31,9 @@ public:
     MOCK_METHOD0(GetDefaultDisplayId, DisplayId());
     MOCK_METHOD1(GetDisplayInfoByScreenId, sptr<DisplayInfo>(ScreenId screenId));
     MOCK_METHOD1(GetDisplaySnapshot, std::shared_ptr<Media::PixelMap>(DisplayId displayId));
+    MOCK_METHOD2(RequestDisplaySnapshot, DMError(DisplayId displayId, const sptr<IDisplayManagerAgent>& agent));
+    MOCK_METHOD2(StartDisplayCapture, ScreenId(const DisplayCaptureOption& option,
+        const sptr<IDisplayManagerAgent>& displayManagerAgent));
 
     MOCK_METHOD1(WakeUpBegin, bool(PowerStateChangeReason reason));
     MOCK_METHOD0(WakeUpEnd, bool());
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <functional>
+#include <gtest/gtest.h>
+#include <message_parcel.h>
+#include "abstract_screen_controller.h"
+#include "display_manager_adapter.h"
+#include "display_manager_proxy.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+sptr<ScreenInfo> MakeScreenInfo(ScreenId screenId, uint32_t version)
+{
+    MessageParcel parcel;
+    parcel.WriteString("ScreenInfoCacheTest");
+    parcel.WriteUint64(screenId);
+    parcel.WriteUint32(720); // virtual width
+    parcel.WriteUint32(1280); // virtual height
+    parcel.WriteFloat(1.0f);
+    parcel.WriteUint64(SCREEN_ID_INVALID);
+    parcel.WriteBool(false);
+    parcel.WriteUint32(static_cast<uint32_t>(Rotation::ROTATION_0));
+    parcel.WriteUint32(static_cast<uint32_t>(Orientation::UNSPECIFIED));
+    parcel.WriteUint32(static_cast<uint32_t>(ScreenType::REAL));
+    parcel.WriteUint32(version);
+    parcel.WriteUint32(0); // mode id
+    parcel.WriteUint32(0); // mode count
+    return ScreenInfo::Unmarshalling(parcel);
+}
+
+class TestDisplayManagerProxy : public DisplayManagerProxy {
+public:
+    TestDisplayManagerProxy() : DisplayManagerProxy(nullptr) {}
+
+    sptr<ScreenInfo> GetScreenInfoById(ScreenId screenId) override
+    {
+        queryCount_++;
+        if (onQuery_) {
+            onQuery_();
+        }
+        return MakeScreenInfo(screenId, version_);
+    }
+
+    std::vector<sptr<ScreenInfo>> GetAllScreenInfos() override
+    {
+        queryCount_++;
+        if (onQuery_) {
+            onQuery_();
+        }
+        std::vector<sptr<ScreenInfo>> screenInfos;
+        for (auto screenId : screenIds_) {
+            screenInfos.emplace_back(MakeScreenInfo(screenId, version_));
+        }
+        return screenInfos;
+    }
+
+    // runs while the query is in flight, as a screen event delivered before the reply would
+    std::function<void()> onQuery_;
+    std::vector<ScreenId> screenIds_ { 0, 1 };
+    uint32_t version_ { 1 };
+    uint32_t queryCount_ { 0 };
+};
+
+class TestScreenManagerAdapter : public ScreenManagerAdapter {
+public:
+    explicit TestScreenManagerAdapter(const sptr<IDisplayManager>& proxy)
+    {
+        displayManagerServiceProxy_ = proxy;
+        isProxyValid_ = true;
+        SetScreenInfoCacheEnabled(true);
+    }
+};
+}
+
+class ScreenInfoCacheTest : public testing::Test {
+public:
+    virtual void SetUp() override;
+    virtual void TearDown() override;
+    sptr<TestDisplayManagerProxy> proxy_;
+    std::unique_ptr<TestScreenManagerAdapter> adapter_;
+};
+
+void ScreenInfoCacheTest::SetUp()
+{
+    proxy_ = new TestDisplayManagerProxy();
+    adapter_ = std::make_unique<TestScreenManagerAdapter>(proxy_);
+}
+
+void ScreenInfoCacheTest::TearDown()
+{
+    adapter_ = nullptr;
+    proxy_ = nullptr;
+}
+
+namespace {
+/**
+ * @tc.name: CachedScreenInfo01
+ * @tc.desc: a screen info queried while the cache is enabled is served from the cache afterwards
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenInfoCacheTest, CachedScreenInfo01, Function | SmallTest | Level2)
+{
+    ASSERT_NE(nullptr, adapter_->GetScreenInfo(0));
+    ASSERT_NE(nullptr, adapter_->GetScreenInfo(0));
+    ASSERT_EQ(1u, proxy_->queryCount_);
+
+    ASSERT_EQ(2u, adapter_->GetAllScreenInfos().size());
+    ASSERT_EQ(2u, adapter_->GetAllScreenInfos().size());
+    ASSERT_EQ(2u, proxy_->queryCount_);
+}
+
+/**
+ * @tc.name: EvictDuringQuery01
+ * @tc.desc: a screen disconnected while its query is in flight is not put back into the cache
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenInfoCacheTest, EvictDuringQuery01, Function | SmallTest | Level2)
+{
+    proxy_->onQuery_ = [this]() { adapter_->RemoveScreenInfoCache(1); };
+    ASSERT_NE(nullptr, adapter_->GetScreenInfo(1));
+
+    proxy_->onQuery_ = nullptr;
+    ASSERT_NE(nullptr, adapter_->GetScreenInfo(1));
+    ASSERT_EQ(2u, proxy_->queryCount_);
+    ASSERT_NE(nullptr, adapter_->GetScreenInfo(1));
+    ASSERT_EQ(2u, proxy_->queryCount_);
+}
+
+/**
+ * @tc.name: EvictDuringQuery02
+ * @tc.desc: GetAllScreenInfos overtaken by a disconnect neither caches the removed screen nor marks all cached
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenInfoCacheTest, EvictDuringQuery02, Function | SmallTest | Level2)
+{
+    proxy_->onQuery_ = [this]() {
+        proxy_->screenIds_ = { 0 };
+        adapter_->RemoveScreenInfoCache(1);
+    };
+    ASSERT_EQ(2u, adapter_->GetAllScreenInfos().size());
+
+    proxy_->onQuery_ = nullptr;
+    auto screenInfos = adapter_->GetAllScreenInfos();
+    ASSERT_EQ(2u, proxy_->queryCount_);
+    ASSERT_EQ(1u, screenInfos.size());
+    ASSERT_EQ(0u, screenInfos[0]->GetScreenId());
+
+    ASSERT_EQ(1u, adapter_->GetAllScreenInfos().size());
+    ASSERT_EQ(2u, proxy_->queryCount_);
+    adapter_->GetScreenInfo(1);
+    ASSERT_EQ(3u, proxy_->queryCount_);
+}
+
+/**
+ * @tc.name: OutdatedReply01
+ * @tc.desc: a reply older than the change event received during the query does not replace the cached info
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenInfoCacheTest, OutdatedReply01, Function | SmallTest | Level2)
+{
+    proxy_->onQuery_ = [this]() { adapter_->UpdateScreenInfoCache(MakeScreenInfo(0, 2)); };
+    ASSERT_NE(nullptr, adapter_->GetScreenInfo(0));
+
+    proxy_->onQuery_ = nullptr;
+    auto screenInfo = adapter_->GetScreenInfo(0);
+    ASSERT_NE(nullptr, screenInfo);
+    ASSERT_EQ(2u, screenInfo->GetVersion());
+    ASSERT_EQ(1u, proxy_->queryCount_);
+}
+
+/**
+ * @tc.name: GroupChange01
+ * @tc.desc: a screen connected before it joins a group is cached with its parent once it joins
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenInfoCacheTest, GroupChange01, Function | SmallTest | Level2)
+{
+    ProfiledRecursiveMutex mutex { "ScreenInfoCacheTest" };
+    sptr<AbstractScreenController> controller = new AbstractScreenController(mutex);
+    ASSERT_NE(SCREEN_ID_INVALID, controller->ConnectHeadlessScreen(720, 1280));
+    ScreenId screenId = controller->ConnectHeadlessScreen(720, 1280);
+    ASSERT_NE(SCREEN_ID_INVALID, screenId);
+    sptr<ScreenInfo> grouped = controller->GetAbstractScreen(screenId)->ConvertToScreenInfo();
+    ASSERT_NE(SCREEN_ID_INVALID, grouped->GetParentId());
+
+    // the connect event carries the new screen, version 0, before AddToGroupLocked
+    adapter_->UpdateScreenInfoCache(MakeScreenInfo(screenId, 0));
+    adapter_->UpdateScreenInfoCache(grouped);
+    auto screenInfo = adapter_->GetScreenInfo(screenId);
+    ASSERT_NE(nullptr, screenInfo);
+    ASSERT_EQ(grouped->GetParentId(), screenInfo->GetParentId());
+    ASSERT_EQ(0u, proxy_->queryCount_);
+}
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -16,6 +16,7 @@
 #include "screenshot_test.h"
 
 #include <securec.h>
+#include <surface.h>
 
 #include "mock_display_manager_adapter.h"
 #include "singleton_mocker.h"
@@ -27,7 +28,9 @@ namespace OHOS {
 namespace Rosen {
 constexpr int32_t TEST_IMAGE_HEIGHT = 1080;
 constexpr int32_t TEST_IMAGE_WIDTH = 1920;
+constexpr ScreenId TEST_CAPTURE_ID = 10;
 using Mocker = SingletonMocker<DisplayManagerAdapter, MockDisplayManagerAdapter>;
+using ScreenMocker = SingletonMocker<ScreenManagerAdapter, MockScreenManagerAdapter>;
 void ScreenshotTest::SetUpTestCase()
 {
 }
@@ -117,6 +120,111 @@ HWTEST_F(ScreenshotTest, GetScreenshot_01, Function | MediumTest | Level2)
     ASSERT_EQ(width, TEST_IMAGE_WIDTH);
     ASSERT_EQ(height, TEST_IMAGE_HEIGHT);
 }
+
+/**
+ * @tc.name: GetScreenshotAsync01
+ * @tc.desc: the capture delivered through the agent reaches the callback
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenshotTest, GetScreenshotAsync01, Function | SmallTest | Level2)
+{
+    std::unique_ptr<Mocker> m = std::make_unique<Mocker>();
+    EXPECT_CALL(m->Mock(), RequestDisplaySnapshot(_, _)).Times(1).WillOnce(Invoke(
+        [](DisplayId displayId, const sptr<IDisplayManagerAgent>& agent) {
+            agent->OnDisplaySnapshot(displayId, CreatePixelMap());
+            return DMError::DM_OK;
+        }));
+    std::shared_ptr<Media::PixelMap> screenshot = nullptr;
+    ASSERT_TRUE(DisplayManager::GetInstance().GetScreenshotAsync(0,
+        [&screenshot](std::shared_ptr<Media::PixelMap> pixelMap) { screenshot = pixelMap; }));
+    ASSERT_NE(nullptr, screenshot);
+    ASSERT_EQ(TEST_IMAGE_WIDTH, screenshot->GetWidth());
+}
+
+/**
+ * @tc.name: StartDisplayCapture01
+ * @tc.desc: captures without surface or beyond the 4K limit shared with DMS are rejected before the IPC
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenshotTest, StartDisplayCapture01, Function | SmallTest | Level2)
+{
+    std::unique_ptr<Mocker> m = std::make_unique<Mocker>();
+    EXPECT_CALL(m->Mock(), StartDisplayCapture(_, _)).Times(0);
+    DisplayCaptureOption option = {
+        .displayId_ = 0,
+        .width_ = MAX_RESOLUTION_SIZE,
+        .height_ = MAX_RESOLUTION_SIZE,
+        .surface_ = nullptr,
+    };
+    ASSERT_EQ(SCREEN_ID_INVALID, DisplayManager::GetInstance().StartDisplayCapture(option));
+
+    option.surface_ = Surface::CreateSurfaceAsConsumer();
+    ASSERT_TRUE(option.surface_ != nullptr);
+    option.width_ = MAX_RESOLUTION_SIZE + 1;
+    ASSERT_EQ(SCREEN_ID_INVALID, DisplayManager::GetInstance().StartDisplayCapture(option));
+    option.width_ = MAX_RESOLUTION_SIZE;
+    option.height_ = MAX_RESOLUTION_SIZE + 1;
+    ASSERT_EQ(SCREEN_ID_INVALID, DisplayManager::GetInstance().StartDisplayCapture(option));
+    option.displayId_ = DISPLAY_ID_INVALID;
+    option.height_ = MAX_RESOLUTION_SIZE;
+    ASSERT_EQ(SCREEN_ID_INVALID, DisplayManager::GetInstance().StartDisplayCapture(option));
+}
+
+/**
+ * @tc.name: StartDisplayCapture02
+ * @tc.desc: a valid capture reaches DMS with an agent and returns the capture screen id
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenshotTest, StartDisplayCapture02, Function | SmallTest | Level2)
+{
+    std::unique_ptr<Mocker> m = std::make_unique<Mocker>();
+    DisplayCaptureOption option = {
+        .displayId_ = 0,
+        .width_ = MAX_RESOLUTION_SIZE,
+        .height_ = MAX_RESOLUTION_SIZE,
+        .surface_ = Surface::CreateSurfaceAsConsumer(),
+    };
+    EXPECT_CALL(m->Mock(), StartDisplayCapture(_, _)).Times(2).WillRepeatedly(Invoke(
+        [&option](const DisplayCaptureOption& captureOption, const sptr<IDisplayManagerAgent>& agent) {
+            EXPECT_TRUE(agent != nullptr);
+            EXPECT_EQ(option.surface_.GetRefPtr(), captureOption.surface_.GetRefPtr());
+            return TEST_CAPTURE_ID;
+        }));
+    ASSERT_EQ(TEST_CAPTURE_ID, DisplayManager::GetInstance().StartDisplayCapture(option));
+    ASSERT_EQ(TEST_CAPTURE_ID, DisplayManager::GetInstance().StartDisplayCapture(option));
+}
+
+/**
+ * @tc.name: StopDisplayCapture01
+ * @tc.desc: stopping a capture destroys its virtual screen, an invalid id is rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenshotTest, StopDisplayCapture01, Function | SmallTest | Level2)
+{
+    std::unique_ptr<ScreenMocker> m = std::make_unique<ScreenMocker>();
+    EXPECT_CALL(m->Mock(), DestroyVirtualScreen(TEST_CAPTURE_ID)).Times(2)
+        .WillOnce(Return(DMError::DM_OK))
+        .WillOnce(Return(DMError::DM_ERROR_IPC_FAILED));
+    ASSERT_FALSE(DisplayManager::GetInstance().StopDisplayCapture(SCREEN_ID_INVALID));
+    ASSERT_TRUE(DisplayManager::GetInstance().StopDisplayCapture(TEST_CAPTURE_ID));
+    ASSERT_FALSE(DisplayManager::GetInstance().StopDisplayCapture(TEST_CAPTURE_ID));
+}
+
+/**
+ * @tc.name: GetScreenshotAsync02
+ * @tc.desc: request rejected by service or with invalid parameters
+ * @tc.type: FUNC
+ */
+HWTEST_F(ScreenshotTest, GetScreenshotAsync02, Function | SmallTest | Level2)
+{
+    std::unique_ptr<Mocker> m = std::make_unique<Mocker>();
+    auto callback = [](std::shared_ptr<Media::PixelMap> pixelMap) {};
+    ASSERT_FALSE(DisplayManager::GetInstance().GetScreenshotAsync(DISPLAY_ID_INVALID, callback));
+    ASSERT_FALSE(DisplayManager::GetInstance().GetScreenshotAsync(0, nullptr));
+
+    EXPECT_CALL(m->Mock(), RequestDisplaySnapshot(_, _)).Times(1).WillOnce(Return(DMError::DM_ERROR_IPC_FAILED));
+    ASSERT_FALSE(DisplayManager::GetInstance().GetScreenshotAsync(0, callback));
+}
 }
 } // namespace Rosen
 } // namespace OHOS
@@ -33,7 +33,9 @@ namespace OHOS::Rosen {
 class AbstractDisplayController : public RefBase {
 using DisplayStateChangeListener = std::function<void(DisplayId, DisplayStateChangeType)>;
 public:
-    AbstractDisplayController(std::recursive_mutex& mutex, DisplayStateChangeListener);
+    using ScreenshotResultCallback = std::function<void(std::shared_ptr<Media::PixelMap>)>;
+
+    AbstractDisplayController(ProfiledRecursiveMutex& mutex, DisplayStateChangeListener);
     ~AbstractDisplayController();
     WM_DISALLOW_COPY_AND_MOVE(AbstractDisplayController);
 
@@ -42,6 +44,7 @@ public:
     RSScreenModeInfo GetScreenActiveMode(ScreenId id);
 
     std::shared_ptr<Media::PixelMap> GetScreenSnapshot(DisplayId displayId);
+    DMError CaptureScreen(DisplayId displayId, const ScreenshotResultCallback& callback);
     sptr<AbstractDisplay> GetAbstractDisplay(DisplayId displayId) const;
     sptr<AbstractDisplay> GetAbstractDisplayByScreen(ScreenId screenId) const;
     std::vector<DisplayId> GetAllDisplayIds() const;
@@ -50,6 +53,9 @@ public:
 private:
     void OnAbstractScreenConnect(sptr<AbstractScreen> absScreen);
     void OnAbstractScreenDisconnect(sptr<AbstractScreen> absScreen);
+    void OnAbstractScreensReconfigure(const std::vector<AbstractScreenController::DisconnectedScreen>& disconnected,
+        const std::vector<sptr<AbstractScreen>>& connected);
+    void ProcessScreenDisconnected(sptr<AbstractScreen> absScreen, sptr<AbstractScreenGroup> screenGroup);
     void OnAbstractScreenChange(sptr<AbstractScreen> absScreen, DisplayChangeEvent event);
     void ProcessDisplayUpdateOrientation(sptr<AbstractScreen> absScreen);
     void ProcessDisplaySizeChange(sptr<AbstractScreen> absScreen);
@@ -59,8 +65,12 @@ private:
     DisplayId ProcessNormalScreenDisconnected(sptr<AbstractScreen> absScreen, sptr<AbstractScreenGroup> screenGroup);
     DisplayId ProcessExpandScreenDisconnected(sptr<AbstractScreen> absScreen, sptr<AbstractScreenGroup> screenGroup);
     bool UpdateDisplaySize(sptr<AbstractDisplay> absDisplay, sptr<SupportedScreenModes> info);
+    class ScreenshotCallback;
+    void OnScreenCaptured(DisplayId displayId, const ScreenshotCallback* rsCallback,
+        std::shared_ptr<Media::PixelMap> pixelMap);
+    void PostCaptureTimeoutTask(DisplayId displayId, const std::shared_ptr<ScreenshotCallback>& rsCallback);
 
-    std::recursive_mutex& mutex_;
+    ProfiledRecursiveMutex& mutex_;
     std::atomic<DisplayId> displayCount_ { 0 };
     sptr<AbstractDisplay> dummyDisplay_;
     std::map<DisplayId, sptr<AbstractDisplay>> abstractDisplayMap_;
@@ -69,35 +79,32 @@ private:
     OHOS::Rosen::RSInterfaces& rsInterface_;
     DisplayStateChangeListener displayStateChangeListener_;
 
-    class ScreenshotCallback : public SurfaceCaptureCallback, public Future<std::shared_ptr<Media::PixelMap>> {
+    class ScreenshotCallback : public SurfaceCaptureCallback {
     public:
-        ScreenshotCallback() = default;
+        ScreenshotCallback(DisplayId displayId, wptr<AbstractDisplayController> controller)
+            : displayId_(displayId), controller_(controller) {}
         ~ScreenshotCallback() {};
         void OnSurfaceCapture(std::shared_ptr<Media::PixelMap> pixelmap) override
         {
-            FutureCall(pixelmap);
-        }
-
-    protected:
-        void Call(std::shared_ptr<Media::PixelMap> pixelmap) override
-        {
-            if (!flag_) {
-                flag_ = true;
-                pixelMap_ = pixelmap;
+            auto controller = controller_.promote();
+            if (controller != nullptr) {
+                controller->OnScreenCaptured(displayId_, this, pixelmap);
             }
         }
-        bool IsReady() override
-        {
-            return flag_;
-        }
-        std::shared_ptr<Media::PixelMap> FetchResult() override
-        {
-            return pixelMap_;
-        }
+
     private:
-        bool flag_ = false;
-        std::shared_ptr<Media::PixelMap> pixelMap_ = nullptr;
+        DisplayId displayId_;
+        wptr<AbstractDisplayController> controller_;
+    };
+
+    // captures of one display in flight share a single request to render service
+    struct PendingCapture {
+        std::shared_ptr<ScreenshotCallback> rsCallback_;
+        int64_t startTimeMs_;
+        std::vector<ScreenshotResultCallback> callbacks_;
     };
+    std::mutex captureMutex_;
+    std::map<DisplayId, PendingCapture> pendingCaptures_;
 };
 } // namespace OHOS::Rosen
 #endif // FOUNDATION_DMSERVER_ABSTRACT_DISPLAY_CONTROLLER_H
\ No newline at end of file
@@ -19,7 +19,9 @@
 
 #include <vector>
 #include <map>
+#include <mutex>
 #include <refbase.h>
+#include <screen_manager/rs_screen_mode_info.h>
 #include <screen_manager/screen_types.h>
 #include <ui/rs_display_node.h>
 #include <ui/rs_surface_node.h>
@@ -41,6 +43,9 @@ public:
     ~AbstractScreen();
     sptr<SupportedScreenModes> GetActiveScreenMode() const;
     std::vector<sptr<SupportedScreenModes>> GetAbstractScreenModes() const;
+    bool FillScreenModes(const std::vector<RSScreenModeInfo>& allModes);
+    // Only the active mode is known, the supported modes are enumerated from RS on first request.
+    bool DeferScreenModes(const RSScreenModeInfo& activeMode);
     sptr<AbstractScreenGroup> GetGroup() const;
     sptr<ScreenInfo> ConvertToScreenInfo() const;
     bool SetOrientation(Orientation orientation);
@@ -67,14 +72,20 @@ public:
     ScreenId groupDmsId_ { SCREEN_ID_INVALID };
     ScreenType type_ { ScreenType::REAL };
     int32_t activeIdx_ { 0 };
-    std::vector<sptr<SupportedScreenModes>> modes_ = {};
+    mutable std::vector<sptr<SupportedScreenModes>> modes_ = {}; // filled on first request when deferred
     float virtualPixelRatio_ = { 1.0 };
     Orientation orientation_ { Orientation::UNSPECIFIED };
     Rotation rotation_ { Rotation::ROTATION_0 };
     Orientation screenRequestedOrientation_ { Orientation::UNSPECIFIED };
+    uint32_t version_ { 0 }; // increased on every change notified to the clients
 protected:
     void FillScreenInfo(sptr<ScreenInfo>) const;
+    void LoadDeferredScreenModes() const;
     const sptr<AbstractScreenController> screenController_;
+    mutable std::mutex modesMutex_;
+    mutable sptr<SupportedScreenModes> deferredActiveMode_;
+    std::mutex colorGamutsMutex_;
+    std::vector<ScreenColorGamut> colorGamuts_; // queried from RS on first request, fixed for a screen
 };
 
 class AbstractScreenGroup : public AbstractScreen {
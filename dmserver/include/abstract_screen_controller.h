@@ -16,7 +16,10 @@
 #ifndef FOUNDATION_DMSERVER_ABSTRACT_SCREEN_CONTROLLER_H
 #define FOUNDATION_DMSERVER_ABSTRACT_SCREEN_CONTROLLER_H
 
+#include <array>
 #include <map>
+#include <mutex>
+#include <set>
 #include <vector>
 
 #include <event_handler.h>
@@ -27,6 +30,8 @@
 #include "abstract_screen.h"
 #include "display_manager_agent_controller.h"
 #include "dm_common.h"
+#include "perf_histogram.h"
+#include "profiled_mutex.h"
 #include "screen.h"
 #include "zidl/display_manager_agent_interface.h"
 
@@ -35,13 +40,22 @@ class AbstractScreenController : public RefBase {
 using OnAbstractScreenConnectCb = std::function<void(sptr<AbstractScreen>)>;
 using OnAbstractScreenChangeCb = std::function<void(sptr<AbstractScreen>, DisplayChangeEvent event)>;
 public:
+    // a screen which left the screen group it belonged to
+    struct DisconnectedScreen {
+        sptr<AbstractScreen> screen_;
+        sptr<AbstractScreenGroup> group_;
+    };
+    using OnAbstractScreensReconfigureCb = std::function<void(const std::vector<DisconnectedScreen>&,
+        const std::vector<sptr<AbstractScreen>>&)>;
     struct AbstractScreenCallback : public RefBase {
         OnAbstractScreenConnectCb onConnect_;
         OnAbstractScreenConnectCb onDisconnect_;
         OnAbstractScreenChangeCb onChange_;
+        // all screens connected and disconnected by one hotplug batch
+        OnAbstractScreensReconfigureCb onReconfigure_;
     };
 
-    explicit AbstractScreenController(std::recursive_mutex& mutex);
+    explicit AbstractScreenController(ProfiledRecursiveMutex& mutex);
     ~AbstractScreenController();
     WM_DISALLOW_COPY_AND_MOVE(AbstractScreenController);
 
@@ -57,18 +71,25 @@ public:
     ScreenId ConvertToDmsScreenId(ScreenId rsScreenId) const;
     void RegisterAbstractScreenCallback(sptr<AbstractScreenCallback> cb);
     ScreenId CreateVirtualScreen(VirtualScreenOption option, const sptr<IRemoteObject>& displayManagerAgent);
+    // connects a screen which only exists in memory, to run the services without render service
+    ScreenId ConnectHeadlessScreen(uint32_t width, uint32_t height);
     DMError DestroyVirtualScreen(ScreenId screenId);
     DMError SetVirtualScreenSurface(ScreenId screenId, sptr<Surface> surface);
     bool SetOrientation(ScreenId screenId, Orientation orientation, bool isFromWindow);
 
     bool SetScreenActiveMode(ScreenId screenId, uint32_t modeId);
     std::shared_ptr<RSDisplayNode> GetRSDisplayNodeByScreenId(ScreenId dmsScreenId) const;
+    std::shared_ptr<AppExecFwk::EventHandler> GetControllerHandler() const;
     void UpdateRSTree(ScreenId dmsScreenId, std::shared_ptr<RSSurfaceNode>& surfaceNode, bool isAdd);
     bool MakeMirror(ScreenId, std::vector<ScreenId> screens);
     bool MakeExpand(std::vector<ScreenId> screenIds, std::vector<Point> startPoints);
     void SetShotScreen(ScreenId mainScreenId, std::vector<ScreenId> shotScreenIds);
     void RemoveVirtualScreenFromGroup(std::vector<ScreenId> screens);
     void DumpScreenInfo() const;
+    // deferred to the end of a screen group reconfiguration when called inside one, mutex_ must be held
+    void FlushRSTransaction();
+    void DumpRotationStatistics(std::string& dumpInfo) const;
+    void ResetRotationStatistics();
     bool SetScreenPowerForAll(ScreenPowerState state, PowerStateChangeReason reason) const;
     ScreenPowerState GetScreenPower(ScreenId dmsScreenId) const;
 
@@ -81,14 +102,37 @@ public:
     DMError SetScreenColorTransform(ScreenId screenId);
 
 private:
+    enum class RotationPhase : uint32_t {
+        PREPARE,
+        LAYOUT,
+        COMMIT,
+        TOTAL,
+        PHASE_END,
+    };
+    void RecordRotationPhase(RotationPhase phase, uint64_t startTimeUs);
     void RegisterRsScreenConnectionChangeListener();
     void OnRsScreenConnectionChange(ScreenId rsScreenId, ScreenEvent screenEvent);
     bool OnRemoteDied(const sptr<IRemoteObject>& agent);
     bool RegisterVirtualScreenAgent(const sptr<IRemoteObject>& displayManagerAgent);
+    void ScheduleScreenEventsFlush();
+    void FlushScreenEvents();
+    // the RS queries describing a connected screen, they need no DMS state
+    struct ScreenProbeResult {
+        std::vector<RSScreenModeInfo> modes_; // empty when the mode enumeration is deferred
+        RSScreenModeInfo activeMode_;
+    };
+    bool ProbeScreen(ScreenId rsScreenId, bool deferModes, ScreenProbeResult& result) const;
+    std::map<ScreenId, ScreenProbeResult> ProbeScreens(const std::vector<ScreenId>& rsScreenIds) const;
     void ProcessScreenConnected(ScreenId rsScreenId);
-    sptr<AbstractScreen> InitAndGetScreen(ScreenId rsScreenId);
+    void ProcessStartupScreenConnectedLocked(ScreenId rsScreenId);
+    sptr<AbstractScreen> ProcessScreenConnectedLocked(ScreenId rsScreenId, const ScreenProbeResult& probe,
+        std::vector<sptr<ScreenInfo>>& added);
+    sptr<AbstractScreen> InitAndGetScreen(ScreenId rsScreenId, const ScreenProbeResult& probe);
     void ProcessScreenDisconnected(ScreenId rsScreenId);
-    bool FillAbstractScreen(sptr<AbstractScreen>& absScreen, ScreenId rsScreenId);
+    void ProcessScreenDisconnectedLocked(ScreenId rsScreenId, std::vector<sptr<ScreenInfo>>& removed,
+        std::set<sptr<AbstractScreenGroup>>& mirrorGroups, std::vector<DisconnectedScreen>& disconnectedScreens);
+    void RebuildMirrorGroupLocked(sptr<AbstractScreenGroup> screenGroup);
+    bool FillAbstractScreen(sptr<AbstractScreen>& absScreen, ScreenId rsScreenId, const ScreenProbeResult& probe);
     sptr<AbstractScreenGroup> AddToGroupLocked(sptr<AbstractScreen> newScreen);
     sptr<AbstractScreenGroup> RemoveFromGroupLocked(sptr<AbstractScreen> newScreen);
     bool RemoveChildFromGroup(sptr<AbstractScreen>, sptr<AbstractScreenGroup>);
@@ -96,17 +140,30 @@ private:
     sptr<AbstractScreenGroup> AddAsFirstScreenLocked(sptr<AbstractScreen> newScreen);
     sptr<AbstractScreenGroup> AddAsSuccedentScreenLocked(sptr<AbstractScreen> newScreen);
     void ProcessScreenModeChanged(ScreenId dmsScreenId);
-    void ChangeScreenGroup(sptr<AbstractScreenGroup> group, const std::vector<ScreenId>& screens,
-        const std::vector<Point>& startPoints, bool filterScreen, ScreenCombination combination);
-    void AddScreenToGroup(sptr<AbstractScreenGroup>, const std::vector<ScreenId>&,
-        const std::vector<Point>&, std::map<ScreenId, bool>&);
+    bool ChangeScreenGroup(sptr<AbstractScreenGroup> group, const std::vector<ScreenId>& screens,
+        const std::vector<Point>& startPoints, bool filterScreen, ScreenCombination combination,
+        ScreenId mirrorScreenId = SCREEN_ID_INVALID);
+    void AddScreenToGroup(sptr<AbstractScreenGroup>, const std::vector<sptr<AbstractScreen>>&,
+        const std::vector<Point>&, const std::vector<bool>&);
     void NotifyScreenConnected(sptr<ScreenInfo>) const;
     void NotifyScreenDisconnected(ScreenId screenId) const;
     void NotifyScreenChanged(sptr<ScreenInfo> screenInfo, ScreenChangeEvent event) const;
+    sptr<ScreenInfo> IncreaseScreenVersion(const sptr<AbstractScreen>& screen);
     void NotifyScreenGroupChanged(const sptr<ScreenInfo>& screenInfo, ScreenGroupChangeEvent event) const;
     void NotifyScreenGroupChanged(const std::vector<sptr<ScreenInfo>>& screenInfo, ScreenGroupChangeEvent event) const;
+    void NotifyScreenGroupChanged(const std::vector<sptr<ScreenInfo>>& removeFromGroup,
+        const std::vector<sptr<ScreenInfo>>& changeGroup, const std::vector<sptr<ScreenInfo>>& addToGroup) const;
     void DumpScreenGroupInfo() const;
 
+    class RSTransactionBatch {
+    public:
+        explicit RSTransactionBatch(AbstractScreenController& controller);
+        ~RSTransactionBatch();
+        WM_DISALLOW_COPY_AND_MOVE(RSTransactionBatch);
+    private:
+        AbstractScreenController& controller_;
+    };
+
     class ScreenIdManager {
     public:
         ScreenIdManager() = default;
@@ -127,13 +184,27 @@ private:
         std::map<ScreenId, ScreenId> dms2RsScreenIdMap_;
     };
 
-    std::recursive_mutex& mutex_;
+    ProfiledRecursiveMutex& mutex_;
     OHOS::Rosen::RSInterfaces& rsInterface_;
     ScreenIdManager screenIdManager_;
     std::map<ScreenId, sptr<AbstractScreen>> dmsScreenMap_;
     std::map<ScreenId, sptr<AbstractScreenGroup>> dmsScreenGroupMap_;
     std::map<ScreenId, std::shared_ptr<RSDisplayNode>> displayNodeMap_;
     std::map<sptr<IRemoteObject>, std::vector<ScreenId>> screenAgentMap_;
+    // hotplug and mode change events arriving within the settle window are applied as one batch
+    struct PendingScreenEvent {
+        ScreenEvent first_;
+        ScreenEvent last_;
+    };
+    std::mutex pendingEventsMutex_;
+    std::map<ScreenId, PendingScreenEvent> pendingHotplugEvents_;
+    std::set<ScreenId> pendingModeChanges_;
+    bool flushScheduled_ { false };
+    // guarded by mutex_, like every caller of RSTransactionBatch and FlushRSTransaction
+    uint32_t rsBatchDepth_ { 0 };
+    bool rsFlushPending_ { false };
+    ScreenId headlessRsScreenId_ { SCREEN_ID_INVALID };
+    std::array<PerfHistogram, static_cast<size_t>(RotationPhase::PHASE_END)> rotationHistograms_;
     sptr<AbstractScreenCallback> abstractScreenCallback_;
     std::shared_ptr<AppExecFwk::EventHandler> controllerHandler_;
 };
@@ -50,6 +50,8 @@ public:
         TRANS_ID_GET_ALL_DISPLAYIDS,
         TRANS_ID_NOTIFY_DISPLAY_EVENT,
         TRANS_ID_SET_FREEZE_EVENT,
+        TRANS_ID_REQUEST_DISPLAY_SNAPSHOT,
+        TRANS_ID_START_DISPLAY_CAPTURE,
         TRANS_ID_SCREEN_BASE = 1000,
         TRANS_ID_CREATE_VIRTUAL_SCREEN = TRANS_ID_SCREEN_BASE,
         TRANS_ID_DESTROY_VIRTUAL_SCREEN,
@@ -82,6 +84,9 @@ public:
     virtual DMError SetVirtualScreenSurface(ScreenId screenId, sptr<Surface> surface) = 0;
     virtual bool SetOrientation(ScreenId screenId, Orientation orientation) = 0;
     virtual std::shared_ptr<Media::PixelMap> GetDisplaySnapshot(DisplayId displayId) = 0;
+    virtual DMError RequestDisplaySnapshot(DisplayId displayId, const sptr<IDisplayManagerAgent>& agent) = 0;
+    virtual ScreenId StartDisplayCapture(const DisplayCaptureOption& option,
+        const sptr<IRemoteObject>& displayManagerAgent) = 0;
 
     // colorspace, gamut
     virtual DMError GetScreenSupportedColorGamuts(ScreenId screenId, std::vector<ScreenColorGamut>& colorGamuts) = 0;
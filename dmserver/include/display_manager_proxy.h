@@ -41,6 +41,9 @@ public:
     DMError SetVirtualScreenSurface(ScreenId screenId, sptr<Surface> surface) override;
     bool SetOrientation(ScreenId screenId, Orientation orientation) override;
     std::shared_ptr<Media::PixelMap> GetDisplaySnapshot(DisplayId displayId) override;
+    DMError RequestDisplaySnapshot(DisplayId displayId, const sptr<IDisplayManagerAgent>& agent) override;
+    ScreenId StartDisplayCapture(const DisplayCaptureOption& option,
+        const sptr<IRemoteObject>& displayManagerAgent) override;
 
     // colorspace, gamut
     DMError GetScreenSupportedColorGamuts(ScreenId screenId, std::vector<ScreenColorGamut>& colorGamuts) override;
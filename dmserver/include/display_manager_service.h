@@ -31,6 +31,7 @@
 #include "display_change_listener.h"
 #include "display_manager_stub.h"
 #include "display_power_controller.h"
+#include "profiled_mutex.h"
 #include "singleton_delegator.h"
 
 namespace OHOS::Rosen {
@@ -41,6 +42,7 @@ WM_DECLARE_SINGLE_INSTANCE_BASE(DisplayManagerService);
 public:
     void OnStart() override;
     void OnStop() override;
+    int Dump(int fd, const std::vector<std::u16string>& args) override;
     ScreenId CreateVirtualScreen(VirtualScreenOption option,
         const sptr<IRemoteObject>& displayManagerAgent) override;
     DMError DestroyVirtualScreen(ScreenId screenId) override;
@@ -52,6 +54,9 @@ public:
     bool SetOrientation(ScreenId screenId, Orientation orientation) override;
     bool SetOrientationFromWindow(ScreenId screenId, Orientation orientation);
     std::shared_ptr<Media::PixelMap> GetDisplaySnapshot(DisplayId displayId) override;
+    DMError RequestDisplaySnapshot(DisplayId displayId, const sptr<IDisplayManagerAgent>& agent) override;
+    ScreenId StartDisplayCapture(const DisplayCaptureOption& option,
+        const sptr<IRemoteObject>& displayManagerAgent) override;
     ScreenId GetRSScreenId(DisplayId displayId) const;
 
     // colorspace, gamut
@@ -91,6 +96,7 @@ public:
     bool SetScreenActiveMode(ScreenId screenId, uint32_t modeId) override;
 
     void RegisterDisplayChangeListener(sptr<IDisplayChangeListener> listener);
+    DisplayId CreateHeadlessDisplay(uint32_t width, uint32_t height);
 private:
     DisplayManagerService();
     ~DisplayManagerService() = default;
@@ -99,12 +105,13 @@ private:
     ScreenId GetScreenIdByDisplayId(DisplayId displayId) const;
     std::shared_ptr<RSDisplayNode> GetRSDisplayNodeByDisplayId(DisplayId displayId) const;
 
-    std::recursive_mutex mutex_;
+    ProfiledRecursiveMutex mutex_ { "DisplayManagerService" };
     static inline SingletonDelegator<DisplayManagerService> delegator_;
     sptr<AbstractDisplayController> abstractDisplayController_;
     sptr<AbstractScreenController> abstractScreenController_;
     sptr<DisplayPowerController> displayPowerController_;
     sptr<IDisplayChangeListener> displayChangeListener_;
+    std::once_flag headlessInitFlag_;
 };
 } // namespace OHOS::Rosen
 
@@ -44,6 +44,8 @@ public:
     void UpdateRSTree(DisplayId displayId, std::shared_ptr<RSSurfaceNode>& surfaceNode, bool isAdd);
     void RegisterDisplayChangeListener(sptr<IDisplayChangeListener> listener);
     bool SetOrientationFromWindow(DisplayId displayId, Orientation orientation);
+    // creates a display backed by an in-memory screen, for running window manager service without the platform
+    DisplayId CreateHeadlessDisplay(uint32_t width, uint32_t height);
 };
 } // namespace OHOS::Rosen
 
@@ -16,33 +16,52 @@
 #ifndef OHOS_ROSEN_DISPLAY_POWER_CONTROLLER_H
 #define OHOS_ROSEN_DISPLAY_POWER_CONTROLLER_H
 
+#include <array>
 #include <map>
 #include <mutex>
 #include <refbase.h>
 #include "display.h"
 #include "display_change_listener.h"
 #include "dm_common.h"
+#include "perf_histogram.h"
+#include "profiled_mutex.h"
 
 namespace OHOS {
 namespace Rosen {
 class DisplayPowerController : public RefBase {
 using DisplayStateChangeListener = std::function<void(DisplayId, DisplayStateChangeType)>;
 public:
-    DisplayPowerController(std::recursive_mutex& mutex, DisplayStateChangeListener listener)
+    DisplayPowerController(ProfiledRecursiveMutex& mutex, DisplayStateChangeListener listener)
         : mutex_(mutex), displayStateChangeListener_(listener)
     {
     }
     virtual ~DisplayPowerController() = default;
 
+    bool WakeUpBegin(PowerStateChangeReason reason);
     bool SuspendBegin(PowerStateChangeReason reason);
     bool SetDisplayState(DisplayState state);
     DisplayState GetDisplayState(DisplayId displayId);
     void NotifyDisplayEvent(DisplayEvent event);
+    void RecordScreenPowerRequest(ScreenPowerState state, uint64_t startTimeUs);
+    void DumpScreenOnStatistics(std::string& dumpInfo) const;
+    void ResetScreenOnStatistics();
 
 private:
+    enum class ScreenOnPhase : uint32_t {
+        POWER_REQUEST,      // screen power on requested to RS
+        KEYGUARD_DRAW_WAIT, // wake up begin to keyguard drawn
+        DISPLAY_ON,         // display on callbacks of WMS and agents
+        TOTAL,              // wake up begin to display on
+        PHASE_END,
+    };
+    void RecordScreenOnPhase(ScreenOnPhase phase, uint64_t startTimeUs);
+
     DisplayState displayState_ { DisplayState::UNKNOWN };
     bool isKeyguardDrawn_ { false };
-    std::recursive_mutex& mutex_;
+    uint64_t wakeUpStartTimeUs_ { 0 }; // 0 when no wake up is in progress
+    bool isKeyguardWaitRecorded_ { false };
+    std::array<PerfHistogram, static_cast<size_t>(ScreenOnPhase::PHASE_END)> screenOnHistograms_;
+    ProfiledRecursiveMutex& mutex_;
     DisplayStateChangeListener displayStateChangeListener_;
 };
 }
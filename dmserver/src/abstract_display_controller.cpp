@@ -15,6 +15,7 @@
 
 #include "abstract_display_controller.h"
 
+#include <chrono>
 #include <cinttypes>
 #include <surface.h>
 
@@ -27,9 +28,17 @@
 namespace OHOS::Rosen {
 namespace {
     constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_DISPLAY, "AbstractDisplayController"};
+    constexpr int64_t SCREENSHOT_TIMEOUT_MS = 2000;
+
+    int64_t GetSteadyTimeMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
 }
 
-AbstractDisplayController::AbstractDisplayController(std::recursive_mutex& mutex, DisplayStateChangeListener listener)
+AbstractDisplayController::AbstractDisplayController(ProfiledRecursiveMutex& mutex,
+    DisplayStateChangeListener listener)
     : mutex_(mutex), rsInterface_(RSInterfaces::GetInstance()), displayStateChangeListener_(listener)
 {
 }
@@ -56,6 +65,9 @@ void AbstractDisplayController::Init(sptr<AbstractScreenController> abstractScre
     abstractScreenCallback_->onChange_
         = std::bind(&AbstractDisplayController::OnAbstractScreenChange, this, std::placeholders::_1,
         std::placeholders::_2);
+    abstractScreenCallback_->onReconfigure_
+        = std::bind(&AbstractDisplayController::OnAbstractScreensReconfigure, this, std::placeholders::_1,
+        std::placeholders::_2);
     abstractScreenController_->ScreenConnectionInDisplayInit(abstractScreenCallback_);
     abstractScreenController->RegisterAbstractScreenCallback(abstractScreenCallback_);
 }
@@ -72,7 +84,7 @@ RSScreenModeInfo AbstractDisplayController::GetScreenActiveMode(ScreenId id)
 
 sptr<AbstractDisplay> AbstractDisplayController::GetAbstractDisplay(DisplayId displayId) const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     auto iter = abstractDisplayMap_.find(displayId);
     if (iter == abstractDisplayMap_.end()) {
         WLOGFE("Failed to get AbstractDisplay %{public}" PRIu64", return nullptr!", displayId);
@@ -83,7 +95,7 @@ sptr<AbstractDisplay> AbstractDisplayController::GetAbstractDisplay(DisplayId di
 
 sptr<AbstractDisplay> AbstractDisplayController::GetAbstractDisplayByScreen(ScreenId screenId) const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     for (auto iter : abstractDisplayMap_) {
         sptr<AbstractDisplay> display = iter.second;
         if (display->GetAbstractScreenId() == screenId) {
@@ -96,7 +108,7 @@ sptr<AbstractDisplay> AbstractDisplayController::GetAbstractDisplayByScreen(Scre
 
 std::vector<DisplayId> AbstractDisplayController::GetAllDisplayIds() const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     std::vector<DisplayId> res;
     for (auto iter = abstractDisplayMap_.begin(); iter != abstractDisplayMap_.end(); ++iter) {
         res.push_back(iter->first);
@@ -106,23 +118,107 @@ std::vector<DisplayId> AbstractDisplayController::GetAllDisplayIds() const
 
 std::shared_ptr<Media::PixelMap> AbstractDisplayController::GetScreenSnapshot(DisplayId displayId)
 {
-    sptr<AbstractDisplay> abstractDisplay = GetAbstractDisplay(displayId);
-    if (abstractDisplay == nullptr) {
-        WLOGFE("GetScreenSnapshot: GetAbstarctDisplay failed");
+    // the result is shared with the capture callback, which may outlive this call on timeout
+    auto future = std::make_shared<RunnableFuture<std::shared_ptr<Media::PixelMap>>>();
+    auto callback = [future](std::shared_ptr<Media::PixelMap> pixelMap) {
+        future->SetValue(pixelMap);
+    };
+    if (CaptureScreen(displayId, callback) != DMError::DM_OK) {
         return nullptr;
     }
-    ScreenId dmsScreenId = abstractDisplay->GetAbstractScreenId();
-    std::shared_ptr<RSDisplayNode> displayNode = abstractScreenController_->GetRSDisplayNodeByScreenId(dmsScreenId);
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    std::shared_ptr<ScreenshotCallback> callback = std::make_shared<ScreenshotCallback>();
-    rsInterface_.TakeSurfaceCapture(displayNode, callback);
-    std::shared_ptr<Media::PixelMap> screenshot = callback->GetResult(2000); // wait for 2000ms
+    std::shared_ptr<Media::PixelMap> screenshot = future->GetResult(SCREENSHOT_TIMEOUT_MS);
     if (screenshot == nullptr) {
         WLOGFE("Failed to get pixelmap from RS, return nullptr!");
     }
     return screenshot;
 }
 
+DMError AbstractDisplayController::CaptureScreen(DisplayId displayId, const ScreenshotResultCallback& callback)
+{
+    std::shared_ptr<RSDisplayNode> displayNode;
+    {
+        WM_PROFILED_LOCK(mutex_);
+        sptr<AbstractDisplay> abstractDisplay = GetAbstractDisplay(displayId);
+        if (abstractDisplay == nullptr) {
+            WLOGFE("CaptureScreen: GetAbstarctDisplay failed");
+            return DMError::DM_ERROR_INVALID_PARAM;
+        }
+        displayNode = abstractScreenController_->GetRSDisplayNodeByScreenId(abstractDisplay->GetAbstractScreenId());
+    }
+    if (displayNode == nullptr) {
+        WLOGFE("CaptureScreen: display node of display %{public}" PRIu64" is null", displayId);
+        return DMError::DM_ERROR_NULLPTR;
+    }
+
+    std::shared_ptr<ScreenshotCallback> rsCallback;
+    {
+        std::lock_guard<std::mutex> lock(captureMutex_);
+        int64_t now = GetSteadyTimeMs();
+        PendingCapture& pending = pendingCaptures_[displayId];
+        pending.callbacks_.push_back(callback);
+        if (pending.rsCallback_ != nullptr && now - pending.startTimeMs_ < SCREENSHOT_TIMEOUT_MS) {
+            WLOGFD("CaptureScreen: join capture of display %{public}" PRIu64", waiters %{public}zu",
+                displayId, pending.callbacks_.size());
+            return DMError::DM_OK;
+        }
+        // no capture in flight, or render service lost the last one: waiters move to a new request
+        rsCallback = std::make_shared<ScreenshotCallback>(displayId, wptr<AbstractDisplayController>(this));
+        pending.rsCallback_ = rsCallback;
+        pending.startTimeMs_ = now;
+    }
+    PostCaptureTimeoutTask(displayId, rsCallback);
+    WM_SCOPED_TRACE("dms:TakeSurfaceCapture(%" PRIu64")", displayId);
+    if (!rsInterface_.TakeSurfaceCapture(displayNode, rsCallback)) {
+        WLOGFE("CaptureScreen: TakeSurfaceCapture failed");
+        OnScreenCaptured(displayId, rsCallback.get(), nullptr);
+    }
+    return DMError::DM_OK;
+}
+
+void AbstractDisplayController::PostCaptureTimeoutTask(DisplayId displayId,
+    const std::shared_ptr<ScreenshotCallback>& rsCallback)
+{
+    auto handler = abstractScreenController_->GetControllerHandler();
+    if (handler == nullptr) {
+        return;
+    }
+    // render service may never answer, the waiters of this request fail once it times out
+    wptr<AbstractDisplayController> weakThis = this;
+    std::weak_ptr<ScreenshotCallback> weakCallback = rsCallback;
+    auto task = [weakThis, weakCallback, displayId]() {
+        auto controller = weakThis.promote();
+        auto callback = weakCallback.lock();
+        if (controller == nullptr || callback == nullptr) {
+            return;
+        }
+        WLOGFD("capture of display %{public}" PRIu64" timed out", displayId);
+        controller->OnScreenCaptured(displayId, callback.get(), nullptr);
+    };
+    handler->PostTask(task, SCREENSHOT_TIMEOUT_MS, AppExecFwk::EventQueue::Priority::HIGH);
+}
+
+void AbstractDisplayController::OnScreenCaptured(DisplayId displayId, const ScreenshotCallback* rsCallback,
+    std::shared_ptr<Media::PixelMap> pixelMap)
+{
+    std::vector<ScreenshotResultCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(captureMutex_);
+        auto iter = pendingCaptures_.find(displayId);
+        if (iter == pendingCaptures_.end() || iter->second.rsCallback_.get() != rsCallback) {
+            WLOGFW("OnScreenCaptured: capture of display %{public}" PRIu64" is outdated", displayId);
+            return;
+        }
+        callbacks.swap(iter->second.callbacks_);
+        pendingCaptures_.erase(iter);
+    }
+    if (pixelMap == nullptr) {
+        WLOGFE("OnScreenCaptured: failed to capture display %{public}" PRIu64"", displayId);
+    }
+    for (auto& callback : callbacks) {
+        callback(pixelMap);
+    }
+}
+
 void AbstractDisplayController::OnAbstractScreenConnect(sptr<AbstractScreen> absScreen)
 {
     if (absScreen == nullptr) {
@@ -130,7 +226,7 @@ void AbstractDisplayController::OnAbstractScreenConnect(sptr<AbstractScreen> abs
         return;
     }
     WLOGI("connect new screen. id:%{public}" PRIu64"", absScreen->dmsId_);
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     sptr<AbstractScreenGroup> group = absScreen->GetGroup();
     if (group == nullptr) {
         WLOGE("the group information of the screen is wrong");
@@ -155,16 +251,42 @@ void AbstractDisplayController::OnAbstractScreenDisconnect(sptr<AbstractScreen>
         WLOGE("the information of the screen is wrong");
         return;
     }
-    WLOGI("disconnect screen. id:%{public}" PRIu64"", absScreen->dmsId_);
     sptr<AbstractScreenGroup> screenGroup;
-    DisplayId absDisplayId = DISPLAY_ID_INVALID;
     {
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        WM_PROFILED_LOCK(mutex_);
         screenGroup = absScreen->GetGroup();
-        if (screenGroup == nullptr) {
-            WLOGE("the group information of the screen is wrong");
-            return;
+    }
+    ProcessScreenDisconnected(absScreen, screenGroup);
+}
+
+void AbstractDisplayController::OnAbstractScreensReconfigure(
+    const std::vector<AbstractScreenController::DisconnectedScreen>& disconnected,
+    const std::vector<sptr<AbstractScreen>>& connected)
+{
+    WM_SCOPED_TRACE("dms:OnAbstractScreensReconfigure(%zu, %zu)", disconnected.size(), connected.size());
+    // the displays of a whole hotplug batch are rebuilt under one hold of the DMS lock
+    WM_PROFILED_LOCK(mutex_);
+    for (auto& item : disconnected) {
+        if (item.group_ != nullptr) {
+            ProcessScreenDisconnected(item.screen_, item.group_);
         }
+    }
+    for (auto& absScreen : connected) {
+        OnAbstractScreenConnect(absScreen);
+    }
+}
+
+void AbstractDisplayController::ProcessScreenDisconnected(sptr<AbstractScreen> absScreen,
+    sptr<AbstractScreenGroup> screenGroup)
+{
+    WLOGI("disconnect screen. id:%{public}" PRIu64"", absScreen->dmsId_);
+    if (screenGroup == nullptr) {
+        WLOGE("the group information of the screen is wrong");
+        return;
+    }
+    DisplayId absDisplayId = DISPLAY_ID_INVALID;
+    {
+        WM_PROFILED_LOCK(mutex_);
         if (screenGroup->combination_ == ScreenCombination::SCREEN_ALONE
             || screenGroup->combination_ == ScreenCombination::SCREEN_MIRROR) {
             absDisplayId = ProcessNormalScreenDisconnected(absScreen, screenGroup);
@@ -256,7 +378,7 @@ void AbstractDisplayController::ProcessDisplayUpdateOrientation(sptr<AbstractScr
 {
     sptr<AbstractDisplay> abstractDisplay = nullptr;
     {
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        WM_PROFILED_LOCK(mutex_);
         auto iter = abstractDisplayMap_.begin();
         for (; iter != abstractDisplayMap_.end(); iter++) {
             abstractDisplay = iter->second;
@@ -309,7 +431,7 @@ void AbstractDisplayController::ProcessDisplaySizeChange(sptr<AbstractScreen> ab
 
     std::map<DisplayId, sptr<AbstractDisplay>> matchedDisplays;
     {
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        WM_PROFILED_LOCK(mutex_);
         for (auto iter = abstractDisplayMap_.begin(); iter != abstractDisplayMap_.end(); ++iter) {
             sptr<AbstractDisplay> absDisplay = iter->second;
             if (absDisplay == nullptr || absDisplay->GetAbstractScreenId() != absScreen->dmsId_) {
@@ -451,7 +573,7 @@ void AbstractDisplayController::SetFreeze(std::vector<DisplayId> displayIds, boo
         WM_SCOPED_TRACE("dms:SetFreeze(%" PRIu64")", displayId);
         {
             WLOGI("setfreeze display %{public}" PRIu64"", displayId);
-            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            WM_PROFILED_LOCK(mutex_);
             auto iter = abstractDisplayMap_.find(displayId);
             if (iter == abstractDisplayMap_.end()) {
                 WLOGE("setfreeze fail, cannot get display %{public}" PRIu64"", displayId);
@@ -20,10 +20,39 @@
 #include "display_manager_service.h"
 #include "dm_common.h"
 #include "window_manager_hilog.h"
+#include "wm_trace.h"
 
 namespace OHOS::Rosen {
 namespace {
     constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_DISPLAY, "AbstractScreenGroup"};
+
+    sptr<SupportedScreenModes> ConvertToSupportedScreenMode(const RSScreenModeInfo& rsScreenModeInfo)
+    {
+        sptr<SupportedScreenModes> info = new(std::nothrow) SupportedScreenModes();
+        if (info == nullptr) {
+            WLOGFE("create SupportedScreenModes failed");
+            return nullptr;
+        }
+        info->width_ = static_cast<uint32_t>(rsScreenModeInfo.GetScreenWidth());
+        info->height_ = static_cast<uint32_t>(rsScreenModeInfo.GetScreenHeight());
+        info->refreshRate_ = rsScreenModeInfo.GetScreenRefreshRate();
+        return info;
+    }
+
+    bool ConvertToSupportedScreenModes(const std::vector<RSScreenModeInfo>& allModes,
+        std::vector<sptr<SupportedScreenModes>>& modes)
+    {
+        for (const RSScreenModeInfo& rsScreenModeInfo : allModes) {
+            sptr<SupportedScreenModes> info = ConvertToSupportedScreenMode(rsScreenModeInfo);
+            if (info == nullptr) {
+                return false;
+            }
+            modes.push_back(info);
+            WLOGD("fill screen idx:%{public}d w/h:%{public}d/%{public}d",
+                rsScreenModeInfo.GetScreenModeId(), info->width_, info->height_);
+        }
+        return true;
+    }
 }
 
 AbstractScreen::AbstractScreen(sptr<AbstractScreenController> screenController, const std::string& name, ScreenId dmsId,
@@ -37,6 +66,12 @@ AbstractScreen::~AbstractScreen()
 
 sptr<SupportedScreenModes> AbstractScreen::GetActiveScreenMode() const
 {
+    {
+        std::lock_guard<std::mutex> lock(modesMutex_);
+        if (deferredActiveMode_ != nullptr) {
+            return deferredActiveMode_;
+        }
+    }
     if (activeIdx_ < 0 || activeIdx_ >= modes_.size()) {
         WLOGE("active mode index is wrong: %{public}d", activeIdx_);
         return nullptr;
@@ -46,9 +81,53 @@ sptr<SupportedScreenModes> AbstractScreen::GetActiveScreenMode() const
 
 std::vector<sptr<SupportedScreenModes>> AbstractScreen::GetAbstractScreenModes() const
 {
+    LoadDeferredScreenModes();
     return modes_;
 }
 
+bool AbstractScreen::FillScreenModes(const std::vector<RSScreenModeInfo>& allModes)
+{
+    std::vector<sptr<SupportedScreenModes>> modes;
+    if (!ConvertToSupportedScreenModes(allModes, modes)) {
+        return false;
+    }
+    modes_ = modes;
+    return true;
+}
+
+bool AbstractScreen::DeferScreenModes(const RSScreenModeInfo& activeMode)
+{
+    sptr<SupportedScreenModes> info = ConvertToSupportedScreenMode(activeMode);
+    if (info == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(modesMutex_);
+    deferredActiveMode_ = info;
+    return true;
+}
+
+void AbstractScreen::LoadDeferredScreenModes() const
+{
+    std::lock_guard<std::mutex> lock(modesMutex_);
+    if (deferredActiveMode_ == nullptr) {
+        return;
+    }
+    WM_SCOPED_TRACE("dms:LoadDeferredScreenModes(%" PRIu64")", rsId_);
+    std::vector<RSScreenModeInfo> allModes = RSInterfaces::GetInstance().GetScreenSupportedModes(rsId_);
+    if (activeIdx_ < 0 || static_cast<std::size_t>(activeIdx_) >= allModes.size()) {
+        // keep serving the active mode, the enumeration is retried on the next request
+        WLOGE("load screen modes failed, rsId %{public}" PRIu64", size %{public}u", rsId_,
+            static_cast<uint32_t>(allModes.size()));
+        return;
+    }
+    std::vector<sptr<SupportedScreenModes>> modes;
+    if (!ConvertToSupportedScreenModes(allModes, modes)) {
+        return;
+    }
+    modes_ = modes;
+    deferredActiveMode_ = nullptr;
+}
+
 sptr<AbstractScreenGroup> AbstractScreen::GetGroup() const
 {
     return screenController_->GetAbstractScreenGroup(groupDmsId_);
@@ -90,10 +169,7 @@ void AbstractScreen::InitRSDisplayNode(RSDisplayNodeConfig& config, Point& start
     rSDisplayNodeConfig_ = config;
     WLOGFI("SetDisplayOffset: posX:%{public}d, posY:%{public}d", startPoint.posX_, startPoint.posY_);
     rsDisplayNode_->SetDisplayOffset(startPoint.posX_, startPoint.posY_);
-    auto transactionProxy = RSTransactionProxy::GetInstance();
-    if (transactionProxy != nullptr) {
-        transactionProxy->FlushImplicitTransaction();
-    }
+    screenController_->FlushRSTransaction();
 }
 
 ScreenId AbstractScreen::GetScreenGroupId() const
@@ -103,6 +179,11 @@ ScreenId AbstractScreen::GetScreenGroupId() const
 
 DMError AbstractScreen::GetScreenSupportedColorGamuts(std::vector<ScreenColorGamut>& colorGamuts)
 {
+    std::lock_guard<std::mutex> lock(colorGamutsMutex_);
+    if (!colorGamuts_.empty()) {
+        colorGamuts = colorGamuts_;
+        return DMError::DM_OK;
+    }
     auto ret = RSInterfaces::GetInstance().GetScreenSupportedColorGamuts(rsId_, colorGamuts);
     if (ret != StatusCode::SUCCESS) {
         WLOGE("GetScreenSupportedColorGamuts fail! rsId %{public}" PRIu64"", rsId_);
@@ -110,7 +191,7 @@ DMError AbstractScreen::GetScreenSupportedColorGamuts(std::vector<ScreenColorGam
     }
     WLOGI("GetScreenSupportedColorGamuts ok! rsId %{public}" PRIu64", size %{public}u",
         rsId_, static_cast<uint32_t>(colorGamuts.size()));
-
+    colorGamuts_ = colorGamuts;
     return DMError::DM_OK;
 }
 
@@ -194,6 +275,7 @@ void AbstractScreen::FillScreenInfo(sptr<ScreenInfo> info) const
         return;
     }
     info->id_ = dmsId_;
+    info->version_ = version_;
     uint32_t width = 0;
     uint32_t height = 0;
     sptr<SupportedScreenModes> abstractScreenModes = GetActiveScreenMode();
@@ -215,7 +297,7 @@ void AbstractScreen::FillScreenInfo(sptr<ScreenInfo> info) const
     info->orientation_ = orientation_;
     info->type_ = type_;
     info->modeId_ = activeIdx_;
-    info->modes_ = modes_;
+    info->modes_ = GetAbstractScreenModes();
 }
 
 bool AbstractScreen::SetOrientation(Orientation orientation)
@@ -342,6 +424,8 @@ bool AbstractScreenGroup::AddChild(sptr<AbstractScreen>& dmsScreen, Point& start
     }
     dmsScreen->InitRSDisplayNode(config, startPoint);
     dmsScreen->groupDmsId_ = dmsId_;
+    // the parent is part of the screen info, clients caching it must see a new version
+    dmsScreen->version_++;
     abstractScreenMap_.insert(std::make_pair(screenId, std::make_pair(dmsScreen, startPoint)));
     return true;
 }
@@ -367,13 +451,13 @@ bool AbstractScreenGroup::RemoveChild(sptr<AbstractScreen>& dmsScreen)
         return false;
     }
     ScreenId screenId = dmsScreen->dmsId_;
-    dmsScreen->groupDmsId_ = SCREEN_ID_INVALID;
+    if (dmsScreen->groupDmsId_ != SCREEN_ID_INVALID) {
+        dmsScreen->groupDmsId_ = SCREEN_ID_INVALID;
+        dmsScreen->version_++;
+    }
     if (rsDisplayNode_ != nullptr) {
         rsDisplayNode_->RemoveFromTree();
-        auto transactionProxy = RSTransactionProxy::GetInstance();
-        if (transactionProxy != nullptr) {
-            transactionProxy->FlushImplicitTransaction();
-        }
+        screenController_->FlushRSTransaction();
     }
     return abstractScreenMap_.erase(screenId);
 }
@@ -16,8 +16,10 @@
 #include "abstract_screen_controller.h"
 
 #include <cinttypes>
+#include <future>
 #include <screen_manager/rs_screen_mode_info.h>
 #include <screen_manager/screen_types.h>
+#include <sstream>
 #include <surface.h>
 #include <thread>
 
@@ -31,9 +33,20 @@ namespace OHOS::Rosen {
 namespace {
     constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_DISPLAY, "AbstractScreenController"};
     const std::string CONTROLLER_THREAD_ID = "abstract_screen_controller_thread";
+    // screens bounce and docking stations attach several outputs within a few frames, wait for them to settle
+    constexpr int64_t SCREEN_EVENT_SETTLE_TIME_MS = 100;
+    // far above the ids of render service, so that headless screens never collide with real ones
+    constexpr ScreenId HEADLESS_RS_SCREEN_ID_BEGIN = 1000;
+    constexpr uint32_t HEADLESS_REFRESH_RATE = 60;
+    const char* const ROTATION_PHASE_NAMES[] = {
+        "Prepare",
+        "Layout",
+        "Commit",
+        "Total",
+    };
 }
 
-AbstractScreenController::AbstractScreenController(std::recursive_mutex& mutex)
+AbstractScreenController::AbstractScreenController(ProfiledRecursiveMutex& mutex)
     : mutex_(mutex), rsInterface_(RSInterfaces::GetInstance())
 {
     auto runner = AppExecFwk::EventRunner::Create(CONTROLLER_THREAD_ID);
@@ -73,7 +86,7 @@ void AbstractScreenController::RegisterRsScreenConnectionChangeListener()
 
 std::vector<ScreenId> AbstractScreenController::GetAllScreenIds() const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     std::vector<ScreenId> res;
     for (auto iter = dmsScreenMap_.begin(); iter != dmsScreenMap_.end(); iter++) {
         res.emplace_back(iter->first);
@@ -84,7 +97,7 @@ std::vector<ScreenId> AbstractScreenController::GetAllScreenIds() const
 std::vector<ScreenId> AbstractScreenController::GetShotScreenIds(std::vector<ScreenId> mirrorScreenIds) const
 {
     WLOGI("GetShotScreenIds");
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     std::vector<ScreenId> screenIds;
     for (ScreenId screenId : mirrorScreenIds) {
         auto iter = std::find(screenIds.begin(), screenIds.end(), screenId);
@@ -103,7 +116,7 @@ std::vector<ScreenId> AbstractScreenController::GetShotScreenIds(std::vector<Scr
 std::vector<ScreenId> AbstractScreenController::GetAllExpandOrMirrorScreenIds(
     std::vector<ScreenId> mirrorScreenIds) const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     std::vector<ScreenId> screenIds;
     for (ScreenId screenId : mirrorScreenIds) {
         auto screenIdIter = std::find(screenIds.begin(), screenIds.end(), screenId);
@@ -160,7 +173,7 @@ void AbstractScreenController::UpdateRSTree(ScreenId dmsScreenId, std::shared_pt
 sptr<AbstractScreen> AbstractScreenController::GetAbstractScreen(ScreenId dmsScreenId) const
 {
     WLOGI("GetAbstractScreen: screenId: %{public}" PRIu64"", dmsScreenId);
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     auto iter = dmsScreenMap_.find(dmsScreenId);
     if (iter == dmsScreenMap_.end()) {
         WLOGE("did not find screen:%{public}" PRIu64"", dmsScreenId);
@@ -171,7 +184,7 @@ sptr<AbstractScreen> AbstractScreenController::GetAbstractScreen(ScreenId dmsScr
 
 sptr<AbstractScreenGroup> AbstractScreenController::GetAbstractScreenGroup(ScreenId dmsScreenId)
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     auto iter = dmsScreenGroupMap_.find(dmsScreenId);
     if (iter == dmsScreenGroupMap_.end()) {
         WLOGE("didnot find screen:%{public}" PRIu64"", dmsScreenId);
@@ -182,8 +195,11 @@ sptr<AbstractScreenGroup> AbstractScreenController::GetAbstractScreenGroup(Scree
 
 ScreenId AbstractScreenController::GetDefaultAbstractScreenId()
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     ScreenId rsDefaultId = rsInterface_.GetDefaultScreenId();
+    if (rsDefaultId == SCREEN_ID_INVALID && headlessRsScreenId_ != SCREEN_ID_INVALID) {
+        return screenIdManager_.ConvertToDmsScreenId(headlessRsScreenId_);
+    }
     if (rsDefaultId == SCREEN_ID_INVALID) {
         WLOGFW("GetDefaultAbstractScreenId, rsDefaultId is invalid.");
         return SCREEN_ID_INVALID;
@@ -200,38 +216,124 @@ ScreenId AbstractScreenController::GetDefaultAbstractScreenId()
 
 ScreenId AbstractScreenController::ConvertToRsScreenId(ScreenId dmsScreenId) const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     return screenIdManager_.ConvertToRsScreenId(dmsScreenId);
 }
 
 ScreenId AbstractScreenController::ConvertToDmsScreenId(ScreenId rsScreenId) const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     return screenIdManager_.ConvertToDmsScreenId(rsScreenId);
 }
 
 void AbstractScreenController::RegisterAbstractScreenCallback(sptr<AbstractScreenCallback> cb)
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     abstractScreenCallback_ = cb;
 }
 
 void AbstractScreenController::OnRsScreenConnectionChange(ScreenId rsScreenId, ScreenEvent screenEvent)
 {
     WLOGFI("rs screen event. id:%{public}" PRIu64", event:%{public}u", rsScreenId, static_cast<uint32_t>(screenEvent));
+    if (screenEvent != ScreenEvent::CONNECTED && screenEvent != ScreenEvent::DISCONNECTED) {
+        WLOGE("unknown message:%{public}ud", static_cast<uint8_t>(screenEvent));
+        return;
+    }
     if (screenEvent == ScreenEvent::CONNECTED) {
-        ProcessScreenConnected(rsScreenId);
-        auto task = [this, rsScreenId] {
+        // the first screen is needed by display init, do not delay it
+        WM_PROFILED_LOCK(mutex_);
+        if (dmsScreenMap_.empty()) {
             ProcessScreenConnected(rsScreenId);
-        };
-        controllerHandler_->PostTask(task, AppExecFwk::EventQueue::Priority::HIGH);
-    } else if (screenEvent == ScreenEvent::DISCONNECTED) {
-        auto task = [this, rsScreenId] {
-            ProcessScreenDisconnected(rsScreenId);
-        };
-        controllerHandler_->PostTask(task, AppExecFwk::EventQueue::Priority::HIGH);
+            return;
+        }
+    }
+    // any other event opens or joins a settle batch, so that the outputs of a dock are connected together
+    std::lock_guard<std::mutex> lock(pendingEventsMutex_);
+    auto iter = pendingHotplugEvents_.find(rsScreenId);
+    if (iter == pendingHotplugEvents_.end()) {
+        pendingHotplugEvents_[rsScreenId] = { screenEvent, screenEvent };
     } else {
-        WLOGE("unknown message:%{public}ud", static_cast<uint8_t>(screenEvent));
+        iter->second.last_ = screenEvent;
+    }
+    ScheduleScreenEventsFlush();
+}
+
+void AbstractScreenController::ScheduleScreenEventsFlush()
+{
+    if (flushScheduled_) {
+        return;
+    }
+    flushScheduled_ = true;
+    auto task = [this] {
+        FlushScreenEvents();
+    };
+    controllerHandler_->PostTask(task, SCREEN_EVENT_SETTLE_TIME_MS, AppExecFwk::EventQueue::Priority::HIGH);
+}
+
+void AbstractScreenController::FlushScreenEvents()
+{
+    std::map<ScreenId, PendingScreenEvent> hotplugEvents;
+    std::set<ScreenId> modeChanges;
+    {
+        std::lock_guard<std::mutex> lock(pendingEventsMutex_);
+        hotplugEvents.swap(pendingHotplugEvents_);
+        modeChanges.swap(pendingModeChanges_);
+        flushScheduled_ = false;
+    }
+    WM_SCOPED_TRACE("dms:FlushScreenEvents(%zu, %zu)", hotplugEvents.size(), modeChanges.size());
+    std::vector<sptr<ScreenInfo>> removed;
+    std::vector<sptr<ScreenInfo>> added;
+    std::set<sptr<AbstractScreenGroup>> mirrorGroups;
+    std::vector<DisconnectedScreen> disconnectedScreens;
+    std::vector<sptr<AbstractScreen>> connectedScreens;
+    std::vector<ScreenId> toProbe;
+    for (const auto& [rsScreenId, event] : hotplugEvents) {
+        if (event.last_ == ScreenEvent::CONNECTED) {
+            toProbe.emplace_back(rsScreenId);
+        }
+    }
+    auto probes = ProbeScreens(toProbe);
+    {
+        WM_PROFILED_LOCK(mutex_);
+        std::vector<ScreenId> toConnect;
+        for (const auto& [rsScreenId, event] : hotplugEvents) {
+            bool known = screenIdManager_.HasRsScreenId(rsScreenId);
+            bool bounced = (event.first_ == ScreenEvent::DISCONNECTED);
+            if (known && (event.last_ == ScreenEvent::DISCONNECTED || bounced)) {
+                ProcessScreenDisconnectedLocked(rsScreenId, removed, mirrorGroups, disconnectedScreens);
+                known = false;
+            }
+            if (!known && event.last_ == ScreenEvent::CONNECTED) {
+                toConnect.emplace_back(rsScreenId);
+            }
+        }
+        for (auto& disconnected : disconnectedScreens) {
+            // the screen is gone, a mode change queued for it has nothing left to apply to
+            modeChanges.erase(disconnected.screen_->dmsId_);
+        }
+        for (auto& screenGroup : mirrorGroups) {
+            RebuildMirrorGroupLocked(screenGroup);
+        }
+        for (ScreenId rsScreenId : toConnect) {
+            auto probeIter = probes.find(rsScreenId);
+            if (probeIter == probes.end()) {
+                continue;
+            }
+            auto absScreen = ProcessScreenConnectedLocked(rsScreenId, probeIter->second, added);
+            if (absScreen != nullptr) {
+                connectedScreens.emplace_back(absScreen);
+                modeChanges.erase(absScreen->dmsId_);
+            }
+        }
+        NotifyScreenGroupChanged(removed, ScreenGroupChangeEvent::REMOVE_FROM_GROUP);
+        NotifyScreenGroupChanged(added, ScreenGroupChangeEvent::ADD_TO_GROUP);
+        // the displays follow the whole batch in one reconfiguration
+        if (abstractScreenCallback_ != nullptr && (!disconnectedScreens.empty() || !connectedScreens.empty())) {
+            abstractScreenCallback_->onReconfigure_(disconnectedScreens, connectedScreens);
+        }
+    }
+    for (ScreenId dmsScreenId : modeChanges) {
+        ProcessScreenModeChanged(dmsScreenId);
     }
 }
 
@@ -239,7 +341,7 @@ void AbstractScreenController::ScreenConnectionInDisplayInit(sptr<AbstractScreen
 {
     std::map<ScreenId, sptr<AbstractScreen>> dmsScreenMap;
     {
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        WM_PROFILED_LOCK(mutex_);
         dmsScreenMap = dmsScreenMap_;
         if (dmsScreenMap_.empty()) {
             return;
@@ -254,29 +356,154 @@ void AbstractScreenController::ScreenConnectionInDisplayInit(sptr<AbstractScreen
     }
 }
 
-void AbstractScreenController::ProcessScreenConnected(ScreenId rsScreenId)
+bool AbstractScreenController::ProbeScreen(ScreenId rsScreenId, bool deferModes, ScreenProbeResult& result) const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    if (!screenIdManager_.HasRsScreenId(rsScreenId)) {
-        WLOGFD("connect new screen");
-        auto absScreen = InitAndGetScreen(rsScreenId);
-        if (absScreen == nullptr) {
-            return;
+    WM_SCOPED_TRACE("dms:ProbeScreen(%" PRIu64")", rsScreenId);
+    if (!deferModes) {
+        result.modes_ = rsInterface_.GetScreenSupportedModes(rsScreenId);
+        if (result.modes_.empty()) {
+            WLOGE("supported screen mode is 0, screenId=%{public}" PRIu64"", rsScreenId);
+            return false;
         }
-        sptr<AbstractScreenGroup> screenGroup = AddToGroupLocked(absScreen);
-        if (screenGroup == nullptr) {
+    }
+    result.activeMode_ = rsInterface_.GetScreenActiveMode(rsScreenId);
+    return true;
+}
+
+std::map<ScreenId, AbstractScreenController::ScreenProbeResult> AbstractScreenController::ProbeScreens(
+    const std::vector<ScreenId>& rsScreenIds) const
+{
+    std::map<ScreenId, ScreenProbeResult> results;
+    if (rsScreenIds.size() == 1) {
+        ScreenProbeResult result;
+        if (ProbeScreen(rsScreenIds.front(), false, result)) {
+            results.emplace(rsScreenIds.front(), result);
+        }
+        return results;
+    }
+    // every probe waits for several RS round trips, the screens of a dock are probed concurrently
+    std::vector<std::pair<ScreenId, std::future<std::pair<bool, ScreenProbeResult>>>> probes;
+    for (ScreenId rsScreenId : rsScreenIds) {
+        probes.emplace_back(rsScreenId, std::async(std::launch::async, [this, rsScreenId] {
+            ScreenProbeResult result;
+            bool ret = ProbeScreen(rsScreenId, false, result);
+            return std::make_pair(ret, result);
+        }));
+    }
+    for (auto& [rsScreenId, probe] : probes) {
+        auto [ret, result] = probe.get();
+        if (ret) {
+            results.emplace(rsScreenId, result);
+        }
+    }
+    return results;
+}
+
+void AbstractScreenController::ProcessScreenConnected(ScreenId rsScreenId)
+{
+    {
+        WM_PROFILED_LOCK(mutex_);
+        if (dmsScreenMap_.empty()) {
+            ProcessStartupScreenConnectedLocked(rsScreenId);
             return;
         }
+    }
+    // the RS round trips of the probe are made outside the DMS mutex, as for a hotplug batch
+    ScreenProbeResult probe;
+    if (!ProbeScreen(rsScreenId, false, probe)) {
+        return;
+    }
+    WM_PROFILED_LOCK(mutex_);
+    std::vector<sptr<ScreenInfo>> added;
+    auto absScreen = ProcessScreenConnectedLocked(rsScreenId, probe, added);
+    if (absScreen == nullptr) {
+        return;
+    }
+    NotifyScreenGroupChanged(added, ScreenGroupChangeEvent::ADD_TO_GROUP);
+    if (abstractScreenCallback_ != nullptr) {
+        abstractScreenCallback_->onConnect_(absScreen);
+    }
+}
+
+ScreenId AbstractScreenController::ConnectHeadlessScreen(uint32_t width, uint32_t height)
+{
+    WM_PROFILED_LOCK(mutex_);
+    ScreenId rsScreenId = HEADLESS_RS_SCREEN_ID_BEGIN;
+    while (screenIdManager_.HasRsScreenId(rsScreenId)) {
+        rsScreenId++;
+    }
+    ScreenProbeResult probe;
+    probe.activeMode_.SetScreenWidth(static_cast<int32_t>(width));
+    probe.activeMode_.SetScreenHeight(static_cast<int32_t>(height));
+    probe.activeMode_.SetScreenRefreshRate(HEADLESS_REFRESH_RATE);
+    probe.activeMode_.SetScreenModeId(0);
+    probe.modes_.push_back(probe.activeMode_);
+    std::vector<sptr<ScreenInfo>> added;
+    auto absScreen = ProcessScreenConnectedLocked(rsScreenId, probe, added);
+    if (absScreen == nullptr) {
+        WLOGFE("connect headless screen failed, size: %{public}ux%{public}u", width, height);
+        return SCREEN_ID_INVALID;
+    }
+    if (headlessRsScreenId_ == SCREEN_ID_INVALID) {
+        headlessRsScreenId_ = rsScreenId;
+    }
+    if (abstractScreenCallback_ != nullptr) {
+        abstractScreenCallback_->onConnect_(absScreen);
+    }
+    WLOGFI("headless screen connected, screen: %{public}" PRIu64", size: %{public}ux%{public}u", absScreen->dmsId_,
+        width, height);
+    return absScreen->dmsId_;
+}
+
+void AbstractScreenController::ProcessStartupScreenConnectedLocked(ScreenId rsScreenId)
+{
+    // The default display is published as soon as the active mode of its screen is known. The supported modes
+    // are enumerated when the screen info is built for the listeners, after the display is up.
+    WM_SCOPED_TRACE("dms:ProcessStartupScreenConnected(%" PRIu64")", rsScreenId);
+    if (screenIdManager_.HasRsScreenId(rsScreenId)) {
+        WLOGE("reconnect screen, screenId=%{public}" PRIu64"", rsScreenId);
+        return;
+    }
+    ScreenProbeResult probe;
+    if (!ProbeScreen(rsScreenId, true, probe)) {
+        return;
+    }
+    auto absScreen = InitAndGetScreen(rsScreenId, probe);
+    if (absScreen == nullptr || AddToGroupLocked(absScreen) == nullptr) {
+        return;
+    }
+    if (abstractScreenCallback_ != nullptr) {
+        abstractScreenCallback_->onConnect_(absScreen);
+    }
+    auto task = [this, absScreen] {
+        NotifyScreenConnected(absScreen->ConvertToScreenInfo());
         NotifyScreenGroupChanged(absScreen->ConvertToScreenInfo(), ScreenGroupChangeEvent::ADD_TO_GROUP);
-        if (abstractScreenCallback_ != nullptr) {
-            abstractScreenCallback_->onConnect_(absScreen);
-        }
-    } else {
+    };
+    controllerHandler_->PostTask(task, AppExecFwk::EventQueue::Priority::HIGH);
+}
+
+sptr<AbstractScreen> AbstractScreenController::ProcessScreenConnectedLocked(ScreenId rsScreenId,
+    const ScreenProbeResult& probe, std::vector<sptr<ScreenInfo>>& added)
+{
+    if (screenIdManager_.HasRsScreenId(rsScreenId)) {
         WLOGE("reconnect screen, screenId=%{public}" PRIu64"", rsScreenId);
+        return nullptr;
     }
+    WLOGFD("connect new screen");
+    auto absScreen = InitAndGetScreen(rsScreenId, probe);
+    if (absScreen == nullptr) {
+        return nullptr;
+    }
+    NotifyScreenConnected(absScreen->ConvertToScreenInfo());
+    sptr<AbstractScreenGroup> screenGroup = AddToGroupLocked(absScreen);
+    if (screenGroup == nullptr) {
+        return nullptr;
+    }
+    added.emplace_back(absScreen->ConvertToScreenInfo());
+    return absScreen;
 }
 
-sptr<AbstractScreen> AbstractScreenController::InitAndGetScreen(ScreenId rsScreenId)
+sptr<AbstractScreen> AbstractScreenController::InitAndGetScreen(ScreenId rsScreenId, const ScreenProbeResult& probe)
 {
     ScreenId dmsScreenId = screenIdManager_.CreateAndGetNewScreenId(rsScreenId);
     sptr<AbstractScreen> absScreen =
@@ -286,21 +513,37 @@ sptr<AbstractScreen> AbstractScreenController::InitAndGetScreen(ScreenId rsScree
         screenIdManager_.DeleteScreenId(dmsScreenId);
         return nullptr;
     }
-    if (!FillAbstractScreen(absScreen, rsScreenId)) {
+    if (!FillAbstractScreen(absScreen, rsScreenId, probe)) {
         screenIdManager_.DeleteScreenId(dmsScreenId);
         WLOGFE("InitAndGetScreen failed.");
         return nullptr;
     }
     dmsScreenMap_.insert(std::make_pair(dmsScreenId, absScreen));
-    NotifyScreenConnected(absScreen->ConvertToScreenInfo());
     return absScreen;
 }
 
 void AbstractScreenController::ProcessScreenDisconnected(ScreenId rsScreenId)
+{
+    WM_PROFILED_LOCK(mutex_);
+    std::vector<sptr<ScreenInfo>> removed;
+    std::set<sptr<AbstractScreenGroup>> mirrorGroups;
+    std::vector<DisconnectedScreen> disconnectedScreens;
+    ProcessScreenDisconnectedLocked(rsScreenId, removed, mirrorGroups, disconnectedScreens);
+    if (abstractScreenCallback_ != nullptr && !disconnectedScreens.empty()) {
+        abstractScreenCallback_->onReconfigure_(disconnectedScreens, {});
+    }
+    NotifyScreenGroupChanged(removed, ScreenGroupChangeEvent::REMOVE_FROM_GROUP);
+    for (auto& screenGroup : mirrorGroups) {
+        RebuildMirrorGroupLocked(screenGroup);
+    }
+}
+
+void AbstractScreenController::ProcessScreenDisconnectedLocked(ScreenId rsScreenId,
+    std::vector<sptr<ScreenInfo>>& removed, std::set<sptr<AbstractScreenGroup>>& mirrorGroups,
+    std::vector<DisconnectedScreen>& disconnectedScreens)
 {
     WLOGFI("disconnect screen, screenId=%{public}" PRIu64"", rsScreenId);
     ScreenId dmsScreenId;
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
     if (!screenIdManager_.ConvertToDmsScreenId(rsScreenId, dmsScreenId)) {
         WLOGFE("disconnect screen, screenId=%{public}" PRIu64" is not in rs2DmsScreenIdMap_", rsScreenId);
         return;
@@ -309,55 +552,58 @@ void AbstractScreenController::ProcessScreenDisconnected(ScreenId rsScreenId)
     sptr<AbstractScreenGroup> screenGroup;
     if (dmsScreenMapIter != dmsScreenMap_.end()) {
         auto screen = dmsScreenMapIter->second;
-        if (abstractScreenCallback_ != nullptr && CheckScreenInScreenGroup(screen)) {
-            abstractScreenCallback_->onDisconnect_(screen);
-        }
+        // the group is kept for the display reconfiguration, it is looked up by id and gone once empty
+        disconnectedScreens.push_back({ screen, CheckScreenInScreenGroup(screen) ? screen->GetGroup() : nullptr });
         screenGroup = RemoveFromGroupLocked(screen);
         if (screenGroup != nullptr) {
-            NotifyScreenGroupChanged(screen->ConvertToScreenInfo(), ScreenGroupChangeEvent::REMOVE_FROM_GROUP);
+            removed.emplace_back(screen->ConvertToScreenInfo());
         }
         dmsScreenMap_.erase(dmsScreenMapIter);
         NotifyScreenDisconnected(dmsScreenId);
         if (screenGroup != nullptr && screenGroup->combination_ == ScreenCombination::SCREEN_MIRROR &&
-            screen->dmsId_ == screenGroup->mirrorScreenId_ && screenGroup->GetChildCount() != 0) {
-            auto defaultScreenId = GetDefaultAbstractScreenId();
-            std::vector<ScreenId> screens;
-            for (auto screen : screenGroup->GetChildren()) {
-                if (screen->dmsId_ != defaultScreenId) {
-                    screens.emplace_back(screen->dmsId_);
-                }
-            }
-            MakeMirror(defaultScreenId, screens);
+            screen->dmsId_ == screenGroup->mirrorScreenId_) {
+            mirrorGroups.insert(screenGroup);
         }
     }
     screenIdManager_.DeleteScreenId(dmsScreenId);
 }
 
-bool AbstractScreenController::FillAbstractScreen(sptr<AbstractScreen>& absScreen, ScreenId rsScreenId)
+void AbstractScreenController::RebuildMirrorGroupLocked(sptr<AbstractScreenGroup> screenGroup)
 {
-    std::vector<RSScreenModeInfo> allModes = rsInterface_.GetScreenSupportedModes(rsScreenId);
-    if (allModes.size() == 0) {
-        WLOGE("supported screen mode is 0, screenId=%{public}" PRIu64"", rsScreenId);
-        return false;
+    // several screens of the group may have gone in one batch, mirror the rest once
+    if (screenGroup->GetChildCount() == 0 || dmsScreenMap_.count(screenGroup->mirrorScreenId_) != 0) {
+        return;
     }
-    for (const RSScreenModeInfo& rsScreenModeInfo : allModes) {
-        sptr<SupportedScreenModes> info = new(std::nothrow) SupportedScreenModes();
-        if (info == nullptr) {
-            WLOGFE("create SupportedScreenModes failed");
-            return false;
+    auto defaultScreenId = GetDefaultAbstractScreenId();
+    std::vector<ScreenId> screens;
+    for (auto screen : screenGroup->GetChildren()) {
+        if (screen->dmsId_ != defaultScreenId) {
+            screens.emplace_back(screen->dmsId_);
         }
-        info->width_ = static_cast<uint32_t>(rsScreenModeInfo.GetScreenWidth());
-        info->height_ = static_cast<uint32_t>(rsScreenModeInfo.GetScreenHeight());
-        info->refreshRate_ = rsScreenModeInfo.GetScreenRefreshRate();
-        absScreen->modes_.push_back(info);
-        WLOGD("fill screen idx:%{public}d w/h:%{public}d/%{public}d",
-            rsScreenModeInfo.GetScreenModeId(), info->width_, info->height_);
-    }
-    int32_t activeModeId = rsInterface_.GetScreenActiveMode(rsScreenId).GetScreenModeId();
+    }
+    MakeMirror(defaultScreenId, screens);
+}
+
+bool AbstractScreenController::FillAbstractScreen(sptr<AbstractScreen>& absScreen, ScreenId rsScreenId,
+    const ScreenProbeResult& probe)
+{
+    int32_t activeModeId = probe.activeMode_.GetScreenModeId();
     WLOGD("fill screen activeModeId:%{public}d", activeModeId);
-    if (static_cast<std::size_t>(activeModeId) >= allModes.size()) {
+    if (probe.modes_.empty()) {
+        if (activeModeId < 0) {
+            WLOGE("activeModeId invalid, screenId=%{public}" PRIu64", activeModeId:%{public}d", rsScreenId,
+                activeModeId);
+            return false;
+        }
+        absScreen->activeIdx_ = activeModeId;
+        return absScreen->DeferScreenModes(probe.activeMode_);
+    }
+    if (static_cast<std::size_t>(activeModeId) >= probe.modes_.size()) {
         WLOGE("activeModeId exceed, screenId=%{public}" PRIu64", activeModeId:%{public}d/%{public}ud",
-            rsScreenId, activeModeId, static_cast<uint32_t>(allModes.size()));
+            rsScreenId, activeModeId, static_cast<uint32_t>(probe.modes_.size()));
+        return false;
+    }
+    if (!absScreen->FillScreenModes(probe.modes_)) {
         return false;
     }
     absScreen->activeIdx_ = activeModeId;
@@ -489,7 +735,7 @@ ScreenId AbstractScreenController::CreateVirtualScreen(VirtualScreenOption optio
         return SCREEN_ID_INVALID;
     }
     std::vector<ScreenId> virtualScreenIds;
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     std::map<sptr<IRemoteObject>, std::vector<ScreenId>>::iterator agIter = screenAgentMap_.find(displayManagerAgent);
     if (agIter == screenAgentMap_.end()) {
         if (!RegisterVirtualScreenAgent(displayManagerAgent)) {
@@ -535,7 +781,7 @@ ScreenId AbstractScreenController::CreateVirtualScreen(VirtualScreenOption optio
 DMError AbstractScreenController::DestroyVirtualScreen(ScreenId screenId)
 {
     WLOGFI("AbstractScreenController::DestroyVirtualScreen");
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     ScreenId rsScreenId = SCREEN_ID_INVALID;
     screenIdManager_.ConvertToRsScreenId(screenId, rsScreenId);
 
@@ -621,31 +867,80 @@ bool AbstractScreenController::SetOrientation(ScreenId screenId, Orientation new
         return true;
     }
 
+    // The window layout of the new orientation is finished before RS rotates the screen, so that the first rotated
+    // frame already shows the final window rects instead of the stretched old ones.
+    uint64_t startTimeUs = PerfHistogram::GetCurrentTimeUs();
+    uint64_t phaseStartTimeUs = startTimeUs;
+    Orientation orientationBefore = screen->orientation_;
+    Rotation rotationBefore = screen->rotation_;
     Rotation rotationAfter = screen->CalcRotation(newOrientation);
-    if (rotationAfter != screen->rotation_) {
+    {
+        WM_SCOPED_TRACE("dms:Rotation:Prepare(%" PRIu64")", screenId);
+        if (!screen->SetOrientation(newOrientation)) {
+            WLOGE("fail to set orientation, screen %{public}" PRIu64"", screenId);
+            return false;
+        }
+        screen->rotation_ = rotationAfter;
+        RecordRotationPhase(RotationPhase::PREPARE, phaseStartTimeUs);
+    }
+    {
+        // AbstractDisplayController rebuilds the display info and WMS relayouts all windows of the display
+        WM_SCOPED_TRACE("dms:Rotation:Layout(%" PRIu64")", screenId);
+        phaseStartTimeUs = PerfHistogram::GetCurrentTimeUs();
+        if (abstractScreenCallback_ != nullptr) {
+            abstractScreenCallback_->onChange_(screen, DisplayChangeEvent::UPDATE_ORIENTATION);
+        }
+        RecordRotationPhase(RotationPhase::LAYOUT, phaseStartTimeUs);
+    }
+    if (rotationAfter != rotationBefore) {
+        WM_SCOPED_TRACE("dms:Rotation:Commit(%" PRIu64")", screenId);
         WLOGI("set orientation. roatiton %{public}u", rotationAfter);
+        phaseStartTimeUs = PerfHistogram::GetCurrentTimeUs();
         if (!rsInterface_.RequestRotation(screenId, static_cast<ScreenRotation>(rotationAfter))) {
             WLOGE("rotate screen fail. %{public}" PRIu64"", screenId);
+            screen->SetOrientation(orientationBefore);
+            screen->rotation_ = rotationBefore;
+            if (abstractScreenCallback_ != nullptr) {
+                abstractScreenCallback_->onChange_(screen, DisplayChangeEvent::UPDATE_ORIENTATION);
+            }
+            // the rotated state was visible to ScreenManager queries during the layout phase
+            NotifyScreenChanged(IncreaseScreenVersion(screen), ScreenChangeEvent::UPDATE_ORIENTATION);
             return false;
         }
+        RecordRotationPhase(RotationPhase::COMMIT, phaseStartTimeUs);
     } else {
         WLOGI("rotation not changed. screen %{public}" PRIu64" rotation %{public}u", screenId, rotationAfter);
     }
-    if (!screen->SetOrientation(newOrientation)) {
-        WLOGE("fail to set orientation, screen %{public}" PRIu64"", screenId);
-        return false;
-    }
-    screen->rotation_ = rotationAfter;
+    RecordRotationPhase(RotationPhase::TOTAL, startTimeUs);
 
     // Notify rotation event to ScreenManager
-    NotifyScreenChanged(screen->ConvertToScreenInfo(), ScreenChangeEvent::UPDATE_ORIENTATION);
-    // Notify rotation event to AbstractDisplayController
-    if (abstractScreenCallback_ != nullptr) {
-        abstractScreenCallback_->onChange_(screen, DisplayChangeEvent::UPDATE_ORIENTATION);
-    }
+    NotifyScreenChanged(IncreaseScreenVersion(screen), ScreenChangeEvent::UPDATE_ORIENTATION);
     return true;
 }
 
+void AbstractScreenController::RecordRotationPhase(RotationPhase phase, uint64_t startTimeUs)
+{
+    uint64_t now = PerfHistogram::GetCurrentTimeUs();
+    rotationHistograms_[static_cast<size_t>(phase)].Record(now > startTimeUs ? now - startTimeUs : 0);
+}
+
+void AbstractScreenController::DumpRotationStatistics(std::string& dumpInfo) const
+{
+    std::ostringstream oss;
+    oss << "-------------------- DMS Rotation Statistics --------------------" << std::endl;
+    for (size_t i = 0; i < rotationHistograms_.size(); i++) {
+        oss << ROTATION_PHASE_NAMES[i] << ": " << rotationHistograms_[i].ToString() << std::endl;
+    }
+    dumpInfo.append(oss.str());
+}
+
+void AbstractScreenController::ResetRotationStatistics()
+{
+    for (auto& histogram : rotationHistograms_) {
+        histogram.Reset();
+    }
+}
+
 DMError AbstractScreenController::GetScreenSupportedColorGamuts(ScreenId screenId,
     std::vector<ScreenColorGamut>& colorGamuts)
 {
@@ -671,7 +966,11 @@ DMError AbstractScreenController::SetScreenColorGamut(ScreenId screenId, int32_t
     if (screen == nullptr) {
         return DMError::DM_ERROR_INVALID_PARAM;
     }
-    return screen->SetScreenColorGamut(colorGamutIdx);
+    DMError ret = screen->SetScreenColorGamut(colorGamutIdx);
+    if (ret == DMError::DM_OK) {
+        NotifyScreenChanged(IncreaseScreenVersion(screen), ScreenChangeEvent::CHANGE_COLOR_GAMUT);
+    }
+    return ret;
 }
 
 DMError AbstractScreenController::GetScreenGamutMap(ScreenId screenId, ScreenGamutMap& gamutMap)
@@ -689,7 +988,11 @@ DMError AbstractScreenController::SetScreenGamutMap(ScreenId screenId, ScreenGam
     if (screen == nullptr) {
         return DMError::DM_ERROR_INVALID_PARAM;
     }
-    return screen->SetScreenGamutMap(gamutMap);
+    DMError ret = screen->SetScreenGamutMap(gamutMap);
+    if (ret == DMError::DM_OK) {
+        NotifyScreenChanged(IncreaseScreenVersion(screen), ScreenChangeEvent::CHANGE_COLOR_GAMUT);
+    }
+    return ret;
 }
 
 DMError AbstractScreenController::SetScreenColorTransform(ScreenId screenId)
@@ -710,12 +1013,16 @@ bool AbstractScreenController::SetScreenActiveMode(ScreenId screenId, uint32_t m
     }
     uint32_t usedModeId = 0;
     {
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        WM_PROFILED_LOCK(mutex_);
         auto screen = GetAbstractScreen(screenId);
         if (screen == nullptr) {
             WLOGFE("SetScreenActiveMode: Get AbstractScreen failed");
             return false;
         }
+        if (modeId >= screen->GetAbstractScreenModes().size()) {
+            WLOGFE("SetScreenActiveMode: invalid modeId %{public}u", modeId);
+            return false;
+        }
         ScreenId rsScreenId = SCREEN_ID_INVALID;
         if (!screenIdManager_.ConvertToRsScreenId(screenId, rsScreenId)) {
             WLOGFE("SetScreenActiveMode: No corresponding rsId");
@@ -724,15 +1031,16 @@ bool AbstractScreenController::SetScreenActiveMode(ScreenId screenId, uint32_t m
         rsInterface_.SetScreenActiveMode(rsScreenId, modeId);
         usedModeId = static_cast<uint32_t>(screen->activeIdx_);
         screen->activeIdx_ = static_cast<int32_t>(modeId);
+        if (usedModeId != modeId) {
+            screen->version_++;
+        }
     }
-    // add thread to process mode change sync event
+    // mode changes are batched with hotplug events, a screen switched several times is notified once
     if (usedModeId != modeId) {
         WLOGI("SetScreenActiveMode: modeId: %{public}u ->  %{public}u", usedModeId, modeId);
-        auto func = [=]() {
-            ProcessScreenModeChanged(screenId);
-            return;
-        };
-        controllerHandler_->PostTask(func, AppExecFwk::EventQueue::Priority::HIGH);
+        std::lock_guard<std::mutex> lock(pendingEventsMutex_);
+        pendingModeChanges_.insert(screenId);
+        ScheduleScreenEventsFlush();
     }
     return true;
 }
@@ -743,7 +1051,7 @@ void AbstractScreenController::ProcessScreenModeChanged(ScreenId dmsScreenId)
     sptr<AbstractScreen> absScreen = nullptr;
     sptr<AbstractScreenCallback> absScreenCallback = nullptr;
     {
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        WM_PROFILED_LOCK(mutex_);
         auto dmsScreenMapIter = dmsScreenMap_.find(dmsScreenId);
         if (dmsScreenMapIter == dmsScreenMap_.end()) {
             WLOGFE("dmsScreenId=%{public}" PRIu64" is not in dmsScreenMap", dmsScreenId);
@@ -760,7 +1068,7 @@ void AbstractScreenController::ProcessScreenModeChanged(ScreenId dmsScreenId)
     if (absScreenCallback != nullptr) {
         absScreenCallback->onChange_(absScreen, DisplayChangeEvent::DISPLAY_SIZE_CHANGED);
     }
-    NotifyScreenChanged(absScreen->ConvertToScreenInfo(), ScreenChangeEvent::CHANGE_MODE);
+    NotifyScreenChanged(IncreaseScreenVersion(absScreen), ScreenChangeEvent::CHANGE_MODE);
 }
 
 bool AbstractScreenController::MakeMirror(ScreenId screenId, std::vector<ScreenId> screens)
@@ -774,8 +1082,8 @@ bool AbstractScreenController::MakeMirror(ScreenId screenId, std::vector<ScreenI
     WLOGFI("GetAbstractScreenGroup start");
     auto group = GetAbstractScreenGroup(screen->groupDmsId_);
     if (group == nullptr) {
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
-        sptr<AbstractScreenGroup> group = AddToGroupLocked(screen);
+        WM_PROFILED_LOCK(mutex_);
+        group = AddToGroupLocked(screen);
         if (group == nullptr) {
             WLOGFE("group is nullptr");
             return false;
@@ -791,19 +1099,31 @@ bool AbstractScreenController::MakeMirror(ScreenId screenId, std::vector<ScreenI
     startPoints.insert(startPoints.begin(), screens.size(), point);
     bool filterMirroredScreen =
         group->combination_ == ScreenCombination::SCREEN_MIRROR && group->mirrorScreenId_ == screen->dmsId_;
-    group->mirrorScreenId_ = screen->dmsId_;
-    ChangeScreenGroup(group, screens, startPoints, filterMirroredScreen, ScreenCombination::SCREEN_MIRROR);
+    if (!ChangeScreenGroup(group, screens, startPoints, filterMirroredScreen, ScreenCombination::SCREEN_MIRROR,
+        screen->dmsId_)) {
+        return false;
+    }
     WLOGFI("MakeMirror success");
     return true;
 }
 
-void AbstractScreenController::ChangeScreenGroup(sptr<AbstractScreenGroup> group, const std::vector<ScreenId>& screens,
-    const std::vector<Point>& startPoints, bool filterScreen, ScreenCombination combination)
+bool AbstractScreenController::ChangeScreenGroup(sptr<AbstractScreenGroup> group, const std::vector<ScreenId>& screens,
+    const std::vector<Point>& startPoints, bool filterScreen, ScreenCombination combination, ScreenId mirrorScreenId)
 {
-    std::map<ScreenId, bool> removeChildResMap;
-    std::vector<ScreenId> addScreens;
+    if (screens.size() != startPoints.size()) {
+        WLOGFE("ChangeScreenGroup: unequal size, screens: %{public}zu, points: %{public}zu",
+            screens.size(), startPoints.size());
+        return false;
+    }
+    WM_SCOPED_TRACE("dms:ChangeScreenGroup(%zu)", screens.size());
+    WM_PROFILED_LOCK(mutex_);
+    // the request is valid from here on; AddChild reads the mirror source while the children are added
+    if (mirrorScreenId != SCREEN_ID_INVALID) {
+        group->mirrorScreenId_ = mirrorScreenId;
+    }
+    // compute the final topology first, so that no intermediate state is applied or notified
+    std::vector<sptr<AbstractScreen>> changeScreens;
     std::vector<Point> addChildPos;
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
     for (uint64_t i = 0; i != screens.size(); i++) {
         ScreenId screenId = screens[i];
         WLOGFI("ChangeScreenGroup: screenId: %{public}" PRIu64"", screenId);
@@ -812,43 +1132,62 @@ void AbstractScreenController::ChangeScreenGroup(sptr<AbstractScreenGroup> group
             WLOGFE("screen:%{public}" PRIu64" is nullptr", screenId);
             continue;
         }
+        auto sameScreen = [screenId](const sptr<AbstractScreen>& changeScreen) {
+            return changeScreen->dmsId_ == screenId;
+        };
+        if (std::find_if(changeScreens.begin(), changeScreens.end(), sameScreen) != changeScreens.end()) {
+            continue;
+        }
         WLOGFI("ChangeScreenGroup: screen->groupDmsId_: %{public}" PRIu64"", screen->groupDmsId_);
         if (filterScreen && screen->groupDmsId_ == group->dmsId_ && group->HasChild(screen->dmsId_)) {
             continue;
         }
-        if (abstractScreenCallback_ != nullptr && CheckScreenInScreenGroup(screen)) {
-            abstractScreenCallback_->onDisconnect_(screen);
-        }
-        auto originGroup = RemoveFromGroupLocked(screen);
+        changeScreens.emplace_back(screen);
         addChildPos.emplace_back(startPoints[i]);
-        removeChildResMap[screenId] = originGroup != nullptr;
-        addScreens.emplace_back(screenId);
     }
-    group->combination_ = combination;
-    AddScreenToGroup(group, addScreens, addChildPos, removeChildResMap);
+    if (changeScreens.empty()) {
+        group->combination_ = combination;
+        return true;
+    }
+
+    std::vector<bool> removeChildRes;
+    if (abstractScreenCallback_ != nullptr) {
+        for (auto& screen : changeScreens) {
+            if (CheckScreenInScreenGroup(screen)) {
+                abstractScreenCallback_->onDisconnect_(screen);
+            }
+        }
+    }
+    {
+        // every display node of the new topology reaches RS in one transaction
+        RSTransactionBatch batch(*this);
+        for (auto& screen : changeScreens) {
+            removeChildRes.emplace_back(RemoveFromGroupLocked(screen) != nullptr);
+        }
+        group->combination_ = combination;
+        AddScreenToGroup(group, changeScreens, addChildPos, removeChildRes);
+    }
+    return true;
 }
 
 void AbstractScreenController::AddScreenToGroup(sptr<AbstractScreenGroup> group,
-    const std::vector<ScreenId>& addScreens, const std::vector<Point>& addChildPos,
-    std::map<ScreenId, bool>& removeChildResMap)
+    const std::vector<sptr<AbstractScreen>>& addScreens, const std::vector<Point>& addChildPos,
+    const std::vector<bool>& removeChildRes)
 {
     std::vector<sptr<ScreenInfo>> addToGroup;
     std::vector<sptr<ScreenInfo>> removeFromGroup;
     std::vector<sptr<ScreenInfo>> changeGroup;
+    std::vector<sptr<AbstractScreen>> connectScreens;
     for (uint64_t i = 0; i != addScreens.size(); i++) {
-        ScreenId screenId = addScreens[i];
-        sptr<AbstractScreen> screen = GetAbstractScreen(screenId);
-        if (screen == nullptr) {
-            continue;
-        }
+        sptr<AbstractScreen> screen = addScreens[i];
         Point expandPoint = addChildPos[i];
         WLOGFI("screenId: %{public}" PRIu64", Point: %{public}d, %{public}d",
             screen->dmsId_, expandPoint.posX_, expandPoint.posY_);
         bool addChildRes = group->AddChild(screen, expandPoint);
-        if (removeChildResMap[screenId] && addChildRes) {
+        if (removeChildRes[i] && addChildRes) {
             changeGroup.emplace_back(screen->ConvertToScreenInfo());
             WLOGFI("changeGroup");
-        } else if (removeChildResMap[screenId]) {
+        } else if (removeChildRes[i]) {
             WLOGFI("removeChild");
             removeFromGroup.emplace_back(screen->ConvertToScreenInfo());
         } else if (addChildRes) {
@@ -857,13 +1196,14 @@ void AbstractScreenController::AddScreenToGroup(sptr<AbstractScreenGroup> group,
         } else {
             WLOGFI("default, AddChild failed");
         }
-        if (group != nullptr && abstractScreenCallback_ != nullptr) {
+        connectScreens.emplace_back(screen);
+    }
+    if (abstractScreenCallback_ != nullptr) {
+        for (auto& screen : connectScreens) {
             abstractScreenCallback_->onConnect_(screen);
         }
     }
-    NotifyScreenGroupChanged(removeFromGroup, ScreenGroupChangeEvent::REMOVE_FROM_GROUP);
-    NotifyScreenGroupChanged(changeGroup, ScreenGroupChangeEvent::CHANGE_GROUP);
-    NotifyScreenGroupChanged(addToGroup, ScreenGroupChangeEvent::ADD_TO_GROUP);
+    NotifyScreenGroupChanged(removeFromGroup, changeGroup, addToGroup);
 }
 
 bool AbstractScreenController::MakeExpand(std::vector<ScreenId> screenIds, std::vector<Point> startPoints)
@@ -879,7 +1219,9 @@ bool AbstractScreenController::MakeExpand(std::vector<ScreenId> screenIds, std::
         return false;
     }
     bool filterExpandScreen = group->combination_ == ScreenCombination::SCREEN_EXPAND;
-    ChangeScreenGroup(group, screenIds, startPoints, filterExpandScreen, ScreenCombination::SCREEN_EXPAND);
+    if (!ChangeScreenGroup(group, screenIds, startPoints, filterExpandScreen, ScreenCombination::SCREEN_EXPAND)) {
+        return false;
+    }
     WLOGFI("MakeExpand success");
     return true;
 }
@@ -930,11 +1272,11 @@ void AbstractScreenController::RemoveVirtualScreenFromGroup(std::vector<ScreenId
         if (!originGroup->HasChild(screenId)) {
             continue;
         }
-        removeFromGroup.emplace_back(screen->ConvertToScreenInfo());
         if (abstractScreenCallback_ != nullptr && CheckScreenInScreenGroup(screen)) {
             abstractScreenCallback_->onDisconnect_(screen);
         }
         RemoveFromGroupLocked(screen);
+        removeFromGroup.emplace_back(screen->ConvertToScreenInfo());
     }
     NotifyScreenGroupChanged(removeFromGroup, ScreenGroupChangeEvent::REMOVE_FROM_GROUP);
 }
@@ -961,7 +1303,7 @@ bool AbstractScreenController::OnRemoteDied(const sptr<IRemoteObject>& agent)
 
 void AbstractScreenController::DumpScreenInfo() const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     WLOGI("-------- dump screen info begin---------");
     WLOGI("-------- the Screen Id Map Info---------");
     WLOGI("         DmsScreenId           RsScreenId");
@@ -1101,7 +1443,7 @@ bool AbstractScreenController::ScreenIdManager::ConvertToDmsScreenId(ScreenId rs
 ScreenId AbstractScreenController::ScreenIdManager::ConvertToDmsScreenId(ScreenId rsScreenId) const
 {
     ScreenId dmsScreenId = SCREEN_ID_INVALID;
-    ConvertToDmsScreenId(dmsScreenId, dmsScreenId);
+    ConvertToDmsScreenId(rsScreenId, dmsScreenId);
     return dmsScreenId;
 }
 
@@ -1127,6 +1469,19 @@ void AbstractScreenController::NotifyScreenDisconnected(ScreenId screenId) const
     controllerHandler_->PostTask(task, AppExecFwk::EventQueue::Priority::HIGH);
 }
 
+std::shared_ptr<AppExecFwk::EventHandler> AbstractScreenController::GetControllerHandler() const
+{
+    return controllerHandler_;
+}
+
+sptr<ScreenInfo> AbstractScreenController::IncreaseScreenVersion(const sptr<AbstractScreen>& screen)
+{
+    // the version and the snapshot carrying it must not interleave with another change of the same screen
+    WM_PROFILED_LOCK(mutex_);
+    screen->version_++;
+    return screen->ConvertToScreenInfo();
+}
+
 void AbstractScreenController::NotifyScreenChanged(sptr<ScreenInfo> screenInfo, ScreenChangeEvent event) const
 {
     if (screenInfo == nullptr) {
@@ -1167,6 +1522,56 @@ void AbstractScreenController::NotifyScreenGroupChanged(
     controllerHandler_->PostTask(task, AppExecFwk::EventQueue::Priority::HIGH);
 }
 
+void AbstractScreenController::NotifyScreenGroupChanged(const std::vector<sptr<ScreenInfo>>& removeFromGroup,
+    const std::vector<sptr<ScreenInfo>>& changeGroup, const std::vector<sptr<ScreenInfo>>& addToGroup) const
+{
+    if (removeFromGroup.empty() && changeGroup.empty() && addToGroup.empty()) {
+        return;
+    }
+    // the whole diff is delivered by one task, listeners never observe a partially applied reconfiguration
+    auto task = [=] {
+        WLOGFI("NotifyScreenGroupChanged, remove: %{public}zu, change: %{public}zu, add: %{public}zu",
+            removeFromGroup.size(), changeGroup.size(), addToGroup.size());
+        auto& agentController = DisplayManagerAgentController::GetInstance();
+        if (!removeFromGroup.empty()) {
+            agentController.OnScreenGroupChange(removeFromGroup, ScreenGroupChangeEvent::REMOVE_FROM_GROUP);
+        }
+        if (!changeGroup.empty()) {
+            agentController.OnScreenGroupChange(changeGroup, ScreenGroupChangeEvent::CHANGE_GROUP);
+        }
+        if (!addToGroup.empty()) {
+            agentController.OnScreenGroupChange(addToGroup, ScreenGroupChangeEvent::ADD_TO_GROUP);
+        }
+    };
+    controllerHandler_->PostTask(task, AppExecFwk::EventQueue::Priority::HIGH);
+}
+
+void AbstractScreenController::FlushRSTransaction()
+{
+    if (rsBatchDepth_ > 0) {
+        rsFlushPending_ = true;
+        return;
+    }
+    auto transactionProxy = RSTransactionProxy::GetInstance();
+    if (transactionProxy != nullptr) {
+        transactionProxy->FlushImplicitTransaction();
+    }
+}
+
+AbstractScreenController::RSTransactionBatch::RSTransactionBatch(AbstractScreenController& controller)
+    : controller_(controller)
+{
+    controller_.rsBatchDepth_++;
+}
+
+AbstractScreenController::RSTransactionBatch::~RSTransactionBatch()
+{
+    if (--controller_.rsBatchDepth_ == 0 && controller_.rsFlushPending_) {
+        controller_.rsFlushPending_ = false;
+        controller_.FlushRSTransaction();
+    }
+}
+
 bool AbstractScreenController::SetScreenPowerForAll(ScreenPowerState state, PowerStateChangeReason reason) const
 {
     WLOGFI("state:%{public}u, reason:%{public}u", state, reason);
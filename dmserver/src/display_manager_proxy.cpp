@@ -294,6 +294,76 @@ std::shared_ptr<Media::PixelMap> DisplayManagerProxy::GetDisplaySnapshot(Display
     return pixelMap;
 }
 
+DMError DisplayManagerProxy::RequestDisplaySnapshot(DisplayId displayId, const sptr<IDisplayManagerAgent>& agent)
+{
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        WLOGFW("RequestDisplaySnapshot: remote is nullptr");
+        return DMError::DM_ERROR_REMOTE_CREATE_FAILED;
+    }
+    if (agent == nullptr) {
+        WLOGFE("RequestDisplaySnapshot: agent is nullptr");
+        return DMError::DM_ERROR_NULLPTR;
+    }
+
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        WLOGFE("RequestDisplaySnapshot: WriteInterfaceToken failed");
+        return DMError::DM_ERROR_WRITE_INTERFACE_TOKEN_FAILED;
+    }
+
+    if (!data.WriteUint64(displayId) || !data.WriteRemoteObject(agent->AsObject())) {
+        WLOGFE("RequestDisplaySnapshot: write data failed");
+        return DMError::DM_ERROR_WRITE_DATA_FAILED;
+    }
+
+    if (remote->SendRequest(static_cast<uint32_t>(DisplayManagerMessage::TRANS_ID_REQUEST_DISPLAY_SNAPSHOT),
+        data, reply, option) != ERR_NONE) {
+        WLOGFW("RequestDisplaySnapshot: SendRequest failed");
+        return DMError::DM_ERROR_IPC_FAILED;
+    }
+    return static_cast<DMError>(reply.ReadInt32());
+}
+
+ScreenId DisplayManagerProxy::StartDisplayCapture(const DisplayCaptureOption& captureOption,
+    const sptr<IRemoteObject>& displayManagerAgent)
+{
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        WLOGFW("StartDisplayCapture: remote is nullptr");
+        return SCREEN_ID_INVALID;
+    }
+    if (captureOption.surface_ == nullptr || captureOption.surface_->GetProducer() == nullptr ||
+        displayManagerAgent == nullptr) {
+        WLOGFE("StartDisplayCapture: surface or agent is nullptr");
+        return SCREEN_ID_INVALID;
+    }
+
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        WLOGFE("StartDisplayCapture: WriteInterfaceToken failed");
+        return SCREEN_ID_INVALID;
+    }
+    bool res = data.WriteUint64(captureOption.displayId_) && data.WriteUint32(captureOption.width_) &&
+        data.WriteUint32(captureOption.height_) &&
+        data.WriteRemoteObject(captureOption.surface_->GetProducer()->AsObject()) &&
+        data.WriteRemoteObject(displayManagerAgent);
+    if (!res) {
+        WLOGFE("StartDisplayCapture: Write data failed");
+        return SCREEN_ID_INVALID;
+    }
+    if (remote->SendRequest(static_cast<uint32_t>(DisplayManagerMessage::TRANS_ID_START_DISPLAY_CAPTURE),
+        data, reply, option) != ERR_NONE) {
+        WLOGFW("StartDisplayCapture: SendRequest failed");
+        return SCREEN_ID_INVALID;
+    }
+    return static_cast<ScreenId>(reply.ReadUint64());
+}
+
 DMError DisplayManagerProxy::GetScreenSupportedColorGamuts(ScreenId screenId,
     std::vector<ScreenColorGamut>& colorGamuts)
 {
@@ -17,6 +17,7 @@
 
 #include <cinttypes>
 #include <iservice_registry.h>
+#include <string_ex.h>
 #include <system_ability_definition.h>
 
 #include "display_manager_agent_controller.h"
@@ -77,6 +78,20 @@ void DisplayManagerService::RegisterDisplayChangeListener(sptr<IDisplayChangeLis
     WLOGFI("IDisplayChangeListener registered");
 }
 
+DisplayId DisplayManagerService::CreateHeadlessDisplay(uint32_t width, uint32_t height)
+{
+    // the controllers are brought up without publishing the service or listening to render service
+    std::call_once(headlessInitFlag_, [this]() {
+        abstractDisplayController_->Init(abstractScreenController_);
+    });
+    ScreenId dmsScreenId = abstractScreenController_->ConnectHeadlessScreen(width, height);
+    if (dmsScreenId == SCREEN_ID_INVALID) {
+        return DISPLAY_ID_INVALID;
+    }
+    sptr<AbstractDisplay> display = abstractDisplayController_->GetAbstractDisplayByScreen(dmsScreenId);
+    return display == nullptr ? DISPLAY_ID_INVALID : display->GetId();
+}
+
 void DisplayManagerService::NotifyDisplayStateChange(DisplayId id, DisplayStateChangeType type)
 {
     WLOGFI("DisplayId %{public}" PRIu64"", id);
@@ -167,6 +182,57 @@ std::shared_ptr<Media::PixelMap> DisplayManagerService::GetDisplaySnapshot(Displ
     return screenSnapshot;
 }
 
+DMError DisplayManagerService::RequestDisplaySnapshot(DisplayId displayId, const sptr<IDisplayManagerAgent>& agent)
+{
+    WM_SCOPED_TRACE("dms:RequestDisplaySnapshot(%" PRIu64")", displayId);
+    if (agent == nullptr) {
+        WLOGFE("RequestDisplaySnapshot: agent is nullptr");
+        return DMError::DM_ERROR_NULLPTR;
+    }
+    auto callback = [displayId, agent](std::shared_ptr<Media::PixelMap> pixelMap) {
+        agent->OnDisplaySnapshot(displayId, pixelMap);
+    };
+    return abstractDisplayController_->CaptureScreen(displayId, callback);
+}
+
+ScreenId DisplayManagerService::StartDisplayCapture(const DisplayCaptureOption& option,
+    const sptr<IRemoteObject>& displayManagerAgent)
+{
+    WM_SCOPED_TRACE("dms:StartDisplayCapture(%" PRIu64")", option.displayId_);
+    if (option.surface_ == nullptr || displayManagerAgent == nullptr || option.width_ == 0 || option.height_ == 0 ||
+        option.width_ > MAX_RESOLUTION_SIZE || option.height_ > MAX_RESOLUTION_SIZE) {
+        WLOGFE("StartDisplayCapture: invalid option, %{public}ux%{public}u", option.width_, option.height_);
+        return SCREEN_ID_INVALID;
+    }
+    ScreenId mainScreenId = GetScreenIdByDisplayId(option.displayId_);
+    if (mainScreenId == SCREEN_ID_INVALID) {
+        return SCREEN_ID_INVALID;
+    }
+    // the capture screen is owned by the agent, so it is destroyed with the virtual screens when the client dies
+    VirtualScreenOption virtualOption = {
+        .name_ = "DisplayCapture" + std::to_string(option.displayId_),
+        .width_ = option.width_,
+        .height_ = option.height_,
+        .density_ = 1.0f,
+        .surface_ = option.surface_,
+        .flags_ = 0,
+        .isForShot_ = true,
+    };
+    ScreenId captureId = abstractScreenController_->CreateVirtualScreen(virtualOption, displayManagerAgent);
+    if (captureId == SCREEN_ID_INVALID) {
+        WLOGFE("StartDisplayCapture: create virtual screen failed");
+        return SCREEN_ID_INVALID;
+    }
+    if (MakeMirror(mainScreenId, { captureId }) == SCREEN_ID_INVALID) {
+        WLOGFE("StartDisplayCapture: mirror screen %{public}" PRIu64" failed", mainScreenId);
+        abstractScreenController_->DestroyVirtualScreen(captureId);
+        return SCREEN_ID_INVALID;
+    }
+    WLOGFI("StartDisplayCapture: display %{public}" PRIu64", capture screen %{public}" PRIu64"",
+        option.displayId_, captureId);
+    return captureId;
+}
+
 ScreenId DisplayManagerService::GetRSScreenId(DisplayId displayId) const
 {
     ScreenId dmsScreenId = GetScreenIdByDisplayId(displayId);
@@ -241,6 +307,54 @@ void DisplayManagerService::OnStop()
     WLOGFI("ready to stop display service.");
 }
 
+int DisplayManagerService::Dump(int fd, const std::vector<std::u16string>& args)
+{
+    std::vector<std::string> params;
+    for (auto& arg : args) {
+        params.emplace_back(Str16ToStr8(arg));
+    }
+    std::string dumpInfo;
+    if (params.empty() || params[0] == "-h") {
+        dumpInfo.append("Usage:\n")
+            .append(" -h                  help information\n")
+            .append(" -lock               dump lock profile of display manager service\n")
+            .append(" -lock -enable       start lock profiling\n")
+            .append(" -lock -disable      stop lock profiling\n")
+            .append(" -lock -reset        reset lock profile\n")
+            .append(" -rotation           dump per phase cost of screen rotations\n")
+            .append(" -rotation -reset    reset rotation statistics\n")
+            .append(" -power              dump per phase cost of screen on\n")
+            .append(" -power -reset       reset screen on statistics\n");
+    } else if (params[0] == "-lock") {
+        if (params.size() > 1 && params[1] == "-enable") {
+            mutex_.SetProfileEnabled(true);
+        } else if (params.size() > 1 && params[1] == "-disable") {
+            mutex_.SetProfileEnabled(false);
+        } else if (params.size() > 1 && params[1] == "-reset") {
+            mutex_.ResetProfile();
+        }
+        mutex_.DumpProfile(dumpInfo);
+    } else if (params[0] == "-rotation") {
+        if (params.size() > 1 && params[1] == "-reset") {
+            abstractScreenController_->ResetRotationStatistics();
+        }
+        abstractScreenController_->DumpRotationStatistics(dumpInfo);
+    } else if (params[0] == "-power") {
+        if (params.size() > 1 && params[1] == "-reset") {
+            displayPowerController_->ResetScreenOnStatistics();
+        }
+        displayPowerController_->DumpScreenOnStatistics(dumpInfo);
+    } else {
+        dumpInfo.append("unknown parameter: ").append(params[0]).append(", use -h for help\n");
+    }
+    int ret = dprintf(fd, "%s", dumpInfo.c_str());
+    if (ret < 0) {
+        WLOGFE("dump failed, ret: %{public}d", ret);
+        return -1;
+    }
+    return 0;
+}
+
 bool DisplayManagerService::RegisterDisplayManagerAgent(const sptr<IDisplayManagerAgent>& displayManagerAgent,
     DisplayManagerAgentType type)
 {
@@ -264,6 +378,7 @@ bool DisplayManagerService::UnregisterDisplayManagerAgent(const sptr<IDisplayMan
 bool DisplayManagerService::WakeUpBegin(PowerStateChangeReason reason)
 {
     WM_SCOPED_TRACE("dms:WakeUpBegin(%u)", reason);
+    displayPowerController_->WakeUpBegin(reason);
     return DisplayManagerAgentController::GetInstance().NotifyDisplayPowerEvent(DisplayPowerEvent::WAKE_UP,
         EventStatus::BEGIN);
 }
@@ -291,7 +406,11 @@ bool DisplayManagerService::SuspendEnd()
 bool DisplayManagerService::SetScreenPowerForAll(ScreenPowerState state, PowerStateChangeReason reason)
 {
     WLOGFI("SetScreenPowerForAll");
-    return abstractScreenController_->SetScreenPowerForAll(state, reason);
+    WM_SCOPED_TRACE("dms:SetScreenPowerForAll(%u)", state);
+    uint64_t startTimeUs = PerfHistogram::GetCurrentTimeUs();
+    bool ret = abstractScreenController_->SetScreenPowerForAll(state, reason);
+    displayPowerController_->RecordScreenPowerRequest(state, startTimeUs);
+    return ret;
 }
 
 ScreenPowerState DisplayManagerService::GetScreenPower(ScreenId dmsScreenId)
@@ -316,7 +435,7 @@ ScreenId DisplayManagerService::GetScreenIdByDisplayId(DisplayId displayId) cons
 
 DisplayState DisplayManagerService::GetDisplayState(DisplayId displayId)
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     return displayPowerController_->GetDisplayState(displayId);
 }
 
@@ -137,4 +137,9 @@ bool DisplayManagerServiceInner::SetOrientationFromWindow(DisplayId displayId, O
     return DisplayManagerService::GetInstance().
         SetOrientationFromWindow(displayInfo->GetScreenId(), orientation);
 }
+
+DisplayId DisplayManagerServiceInner::CreateHeadlessDisplay(uint32_t width, uint32_t height)
+{
+    return DisplayManagerService::GetInstance().CreateHeadlessDisplay(width, height);
+}
 } // namespace OHOS::Rosen
\ No newline at end of file
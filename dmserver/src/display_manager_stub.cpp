@@ -20,6 +20,7 @@
 #include <ipc_skeleton.h>
 
 #include "marshalling_helper.h"
+#include "profiled_mutex.h"
 #include "window_manager_hilog.h"
 
 #include "transaction/rs_interfaces.h"
@@ -37,6 +38,7 @@ int32_t DisplayManagerStub::OnRemoteRequest(uint32_t code, MessageParcel &data,
         WLOGFE("InterfaceToken check failed");
         return -1;
     }
+    ProfiledRequestScope requestScope(code);
     DisplayManagerMessage msgId = static_cast<DisplayManagerMessage>(code);
     switch (msgId) {
         case DisplayManagerMessage::TRANS_ID_GET_DEFAULT_DISPLAY_ID: {
@@ -181,6 +183,31 @@ int32_t DisplayManagerStub::OnRemoteRequest(uint32_t code, MessageParcel &data,
             SetFreeze(ids, data.ReadBool());
             break;
         }
+        case DisplayManagerMessage::TRANS_ID_REQUEST_DISPLAY_SNAPSHOT: {
+            DisplayId displayId = data.ReadUint64();
+            auto agent = iface_cast<IDisplayManagerAgent>(data.ReadRemoteObject());
+            reply.WriteInt32(static_cast<int32_t>(RequestDisplaySnapshot(displayId, agent)));
+            break;
+        }
+        case DisplayManagerMessage::TRANS_ID_START_DISPLAY_CAPTURE: {
+            DisplayId displayId = data.ReadUint64();
+            uint32_t width = data.ReadUint32();
+            uint32_t height = data.ReadUint32();
+            sptr<IBufferProducer> bp = iface_cast<IBufferProducer>(data.ReadRemoteObject());
+            sptr<Surface> surface = nullptr;
+            if (bp != nullptr) {
+                surface = Surface::CreateSurfaceAsProducer(bp);
+            }
+            sptr<IRemoteObject> agent = data.ReadRemoteObject();
+            DisplayCaptureOption option = {
+                .displayId_ = displayId,
+                .width_ = width,
+                .height_ = height,
+                .surface_ = surface,
+            };
+            reply.WriteUint64(static_cast<uint64_t>(StartDisplayCapture(option, agent)));
+            break;
+        }
         case DisplayManagerMessage::TRANS_ID_SCREEN_MAKE_MIRROR: {
             ScreenId mainScreenId = static_cast<ScreenId>(data.ReadUint64());
             std::vector<ScreenId> mirrorScreenId;
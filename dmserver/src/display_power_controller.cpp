@@ -14,19 +14,44 @@
  */
 
 #include "display_power_controller.h"
+
+#include <cinttypes>
+#include <sstream>
+
 #include "display_manager_service.h"
 #include "display_manager_agent_controller.h"
 #include "window_manager_hilog.h"
+#include "wm_trace.h"
 
 namespace OHOS {
 namespace Rosen {
 namespace {
     constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_DISPLAY, "DisplayPowerController"};
+    const char* const SCREEN_ON_PHASE_NAMES[] = {
+        "PowerRequest",
+        "KeyguardDrawWait",
+        "DisplayOn",
+        "Total",
+    };
+}
+
+bool DisplayPowerController::WakeUpBegin(PowerStateChangeReason reason)
+{
+    WLOGFI("reason:%{public}u", reason);
+    WM_PROFILED_LOCK(mutex_);
+    wakeUpStartTimeUs_ = PerfHistogram::GetCurrentTimeUs();
+    isKeyguardWaitRecorded_ = false;
+    return true;
 }
 
 bool DisplayPowerController::SuspendBegin(PowerStateChangeReason reason)
 {
     WLOGFI("reason:%{public}u", reason);
+    {
+        WM_PROFILED_LOCK(mutex_);
+        wakeUpStartTimeUs_ = 0;
+    }
+    // WMS freezes the windows below the keyguard and keeps them, so the next wake up only unfreezes that list
     displayStateChangeListener_(DISPLAY_ID_INVALID, DisplayStateChangeType::BEFORE_SUSPEND);
     return true;
 }
@@ -35,7 +60,7 @@ bool DisplayPowerController::SetDisplayState(DisplayState state)
 {
     WLOGFI("state:%{public}u", state);
     {
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        WM_PROFILED_LOCK(mutex_);
         if (displayState_ == state) {
             WLOGFE("state is already set");
             return false;
@@ -43,22 +68,32 @@ bool DisplayPowerController::SetDisplayState(DisplayState state)
     }
     switch (state) {
         case DisplayState::ON: {
+            WM_SCOPED_TRACE("dms:ScreenOn:DisplayOn");
+            uint64_t startTimeUs = PerfHistogram::GetCurrentTimeUs();
             bool isKeyguardDrawn;
+            uint64_t wakeUpStartTimeUs;
             {
-                std::lock_guard<std::recursive_mutex> lock(mutex_);
+                WM_PROFILED_LOCK(mutex_);
                 displayState_ = state;
                 isKeyguardDrawn = isKeyguardDrawn_;
+                wakeUpStartTimeUs = wakeUpStartTimeUs_;
+                // the wake up ends here, a later display on without WakeUpBegin must not record TOTAL again
+                wakeUpStartTimeUs_ = 0;
             }
             if (!isKeyguardDrawn) {
                 displayStateChangeListener_(DISPLAY_ID_INVALID, DisplayStateChangeType::BEFORE_UNLOCK);
             }
             DisplayManagerAgentController::GetInstance().NotifyDisplayPowerEvent(DisplayPowerEvent::DISPLAY_ON,
                 EventStatus::BEGIN);
+            RecordScreenOnPhase(ScreenOnPhase::DISPLAY_ON, startTimeUs);
+            if (wakeUpStartTimeUs != 0) {
+                RecordScreenOnPhase(ScreenOnPhase::TOTAL, wakeUpStartTimeUs);
+            }
             break;
         }
         case DisplayState::OFF: {
             {
-                std::lock_guard<std::recursive_mutex> lock(mutex_);
+                WM_PROFILED_LOCK(mutex_);
                 displayState_ = state;
             }
             DisplayManagerAgentController::GetInstance().NotifyDisplayPowerEvent(DisplayPowerEvent::DISPLAY_OFF,
@@ -86,13 +121,50 @@ void DisplayPowerController::NotifyDisplayEvent(DisplayEvent event)
         displayStateChangeListener_(DISPLAY_ID_INVALID, DisplayStateChangeType::BEFORE_UNLOCK);
         DisplayManagerAgentController::GetInstance().NotifyDisplayPowerEvent(DisplayPowerEvent::DESKTOP_READY,
             EventStatus::BEGIN);
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        WM_PROFILED_LOCK(mutex_);
         isKeyguardDrawn_ = false;
         return;
     }
     if (event == DisplayEvent::KEYGUARD_DRAWN) {
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        WM_PROFILED_LOCK(mutex_);
         isKeyguardDrawn_ = true;
+        if (wakeUpStartTimeUs_ != 0 && !isKeyguardWaitRecorded_) {
+            isKeyguardWaitRecorded_ = true;
+            RecordScreenOnPhase(ScreenOnPhase::KEYGUARD_DRAW_WAIT, wakeUpStartTimeUs_);
+        }
+    }
+}
+
+void DisplayPowerController::RecordScreenPowerRequest(ScreenPowerState state, uint64_t startTimeUs)
+{
+    if (state == ScreenPowerState::POWER_ON) {
+        RecordScreenOnPhase(ScreenOnPhase::POWER_REQUEST, startTimeUs);
+    }
+}
+
+void DisplayPowerController::RecordScreenOnPhase(ScreenOnPhase phase, uint64_t startTimeUs)
+{
+    uint64_t now = PerfHistogram::GetCurrentTimeUs();
+    uint64_t costUs = now > startTimeUs ? now - startTimeUs : 0;
+    WLOGFI("screen on phase %{public}s cost %{public}" PRIu64"us", SCREEN_ON_PHASE_NAMES[static_cast<size_t>(phase)],
+        costUs);
+    screenOnHistograms_[static_cast<size_t>(phase)].Record(costUs);
+}
+
+void DisplayPowerController::DumpScreenOnStatistics(std::string& dumpInfo) const
+{
+    std::ostringstream oss;
+    oss << "-------------------- DMS Screen On Statistics --------------------" << std::endl;
+    for (size_t i = 0; i < screenOnHistograms_.size(); i++) {
+        oss << SCREEN_ON_PHASE_NAMES[i] << ": " << screenOnHistograms_[i].ToString() << std::endl;
+    }
+    dumpInfo.append(oss.str());
+}
+
+void DisplayPowerController::ResetScreenOnStatistics()
+{
+    for (auto& histogram : screenOnHistograms_) {
+        histogram.Reset();
     }
 }
 }
@@ -22,6 +22,7 @@
 
 #include "display.h"
 #include "dm_common.h"
+#include "screen.h"
 #include "wm_single_instance.h"
 
 namespace OHOS::Rosen {
@@ -34,6 +35,7 @@ public:
         virtual void OnDestroy(DisplayId) = 0;
         virtual void OnChange(DisplayId) = 0;
     };
+    using ScreenshotCallback = std::function<void(std::shared_ptr<Media::PixelMap>)>;
 
     std::vector<sptr<Display>> GetAllDisplays();
     DisplayId GetDefaultDisplayId();
@@ -47,6 +49,9 @@ public:
     std::shared_ptr<Media::PixelMap> GetScreenshot(DisplayId displayId);
     std::shared_ptr<Media::PixelMap> GetScreenshot(DisplayId displayId, const Media::Rect &rect,
                                         const Media::Size &size, int rotation);
+    bool GetScreenshotAsync(DisplayId displayId, ScreenshotCallback callback);
+    ScreenId StartDisplayCapture(const DisplayCaptureOption& option);
+    bool StopDisplayCapture(ScreenId captureId);
 
     bool RegisterDisplayPowerEventListener(sptr<IDisplayPowerEventListener> listener);
     bool UnregisterDisplayPowerEventListener(sptr<IDisplayPowerEventListener> listener);
@@ -61,7 +66,7 @@ public:
     void NotifyDisplayEvent(DisplayEvent event);
     bool Freeze(std::vector<DisplayId> displayIds);
     bool Unfreeze(std::vector<DisplayId> displayIds);
-    constexpr static int32_t MAX_RESOLUTION_SIZE_SCREENSHOT = 3840; // max resolution, 4K
+    constexpr static int32_t MAX_RESOLUTION_SIZE_SCREENSHOT = static_cast<int32_t>(MAX_RESOLUTION_SIZE);
 
 private:
     DisplayManager();
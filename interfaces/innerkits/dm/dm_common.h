@@ -27,6 +27,7 @@ namespace {
     constexpr DisplayId DISPLAY_ID_INVALID = -1ULL;
     constexpr ScreenId SCREEN_ID_INVALID = -1ULL;
     constexpr int DOT_PER_INCH = 160;
+    constexpr uint32_t MAX_RESOLUTION_SIZE = 3840; // max size of screenshots and display captures, 4K
     const static std::string DEFAULT_SCREEN_NAME = "buildIn";
 }
 
@@ -92,6 +93,7 @@ public:
 enum class ScreenChangeEvent : uint32_t {
     UPDATE_ORIENTATION,
     CHANGE_MODE,
+    CHANGE_COLOR_GAMUT,
 };
 
 enum class ScreenGroupChangeEvent : uint32_t {
@@ -51,6 +51,14 @@ struct VirtualScreenOption {
     bool isForShot_ {true};
 };
 
+// frames of the display are mirrored into surface_ at width_ x height_ until the capture is stopped
+struct DisplayCaptureOption {
+    DisplayId displayId_;
+    uint32_t width_;
+    uint32_t height_;
+    sptr<Surface> surface_;
+};
+
 struct ExpandOption {
     ScreenId screenId_;
     uint32_t startX_;
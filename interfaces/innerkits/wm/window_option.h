@@ -53,6 +53,8 @@ public:
     float GetBrightness() const;
     void SetCallingWindow(uint32_t windowId);
     uint32_t GetCallingWindow() const;
+    void SetSpeculativeShowEnabled(bool enabled);
+    bool IsSpeculativeShowEnabled() const;
 
     Rect GetWindowRect() const;
     WindowType GetWindowType() const;
@@ -88,6 +90,7 @@ private:
     bool turnScreenOn_ = false;
     float brightness_ = UNDEFINED_BRIGHTNESS;
     uint32_t callingWindow_ = INVALID_WINDOW_ID;
+    bool isSpeculativeShowEnabled_ = false;
     std::unordered_map<WindowType, SystemBarProperty> sysBarPropMap_ {
         { WindowType::WINDOW_TYPE_STATUS_BAR,     SystemBarProperty() },
         { WindowType::WINDOW_TYPE_NAVIGATION_BAR, SystemBarProperty() },
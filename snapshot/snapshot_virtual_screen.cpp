@@ -17,8 +17,8 @@
 #include <unistd.h>
 #include <ctime>
 
+#include "display_manager.h"
 #include "snapshot_utils.h"
-#include "screen_manager.h"
 #include "surface_reader.h"
 #include "surface_reader_handler_impl.h"
 
@@ -30,21 +30,18 @@ namespace {
 const int SLEEP_US = 10 * 1000; // 10ms
 const int MAX_SNAPSHOT_COUNT = 10;
 const int MAX_WAIT_COUNT = 200;
-const float DEFAULT_DENSITY = 2.0;
+const uint32_t CAPTURE_FRAME_RATE = 10;
 const std::string FILE_NAME = "/data/snapshot_virtual_screen";
 }
 
-static VirtualScreenOption InitOption(ScreenId mainId, SurfaceReader& surfaceReader)
+static DisplayCaptureOption InitOption(DisplayId displayId, SurfaceReader& surfaceReader)
 {
-    auto defaultScreen = ScreenManager::GetInstance().GetScreenById(mainId);
-    VirtualScreenOption option = {
-        .name_ = "virtualScreen",
-        .width_ = defaultScreen->GetWidth(),
-        .height_ = defaultScreen->GetHeight(),
-        .density_ = DEFAULT_DENSITY,
+    auto display = DisplayManager::GetInstance().GetDisplayById(displayId);
+    DisplayCaptureOption option = {
+        .displayId_ = displayId,
+        .width_ = display == nullptr ? 0 : static_cast<uint32_t>(display->GetWidth()),
+        .height_ = display == nullptr ? 0 : static_cast<uint32_t>(display->GetHeight()),
         .surface_ = surfaceReader.GetSurface(),
-        .flags_ = 0,
-        .isForShot_ = true,
     };
     return option;
 }
@@ -58,12 +55,16 @@ int main(int argc, char *argv[])
         return 0;
     }
     surfaceReader.SetHandler(surfaceReaderHandler);
-    ScreenId mainId = static_cast<ScreenId>(DisplayManager::GetInstance().GetDefaultDisplayId());
-    VirtualScreenOption option = InitOption(mainId, surfaceReader);
-    ScreenId virtualScreenId = ScreenManager::GetInstance().CreateVirtualScreen(option);
-    std::vector<ScreenId> mirrorIds;
-    mirrorIds.push_back(virtualScreenId);
-    ScreenManager::GetInstance().MakeMirror(mainId, mirrorIds);
+    surfaceReader.SetFrameRate(CAPTURE_FRAME_RATE);
+    // RS reports full damage for the virtual screen, only the changed tiles are copied into the handler
+    surfaceReader.SetChangeDetectionEnabled(true);
+    DisplayId mainId = DisplayManager::GetInstance().GetDefaultDisplayId();
+    DisplayCaptureOption option = InitOption(mainId, surfaceReader);
+    ScreenId captureId = DisplayManager::GetInstance().StartDisplayCapture(option);
+    if (captureId == SCREEN_ID_INVALID) {
+        std::cout << "StartDisplayCapture failed!" << std::endl;
+        return 0;
+    }
     int fileIndex = 1;
     auto startTime = time(nullptr);
     while (time(nullptr) - startTime < MAX_SNAPSHOT_COUNT) {
@@ -91,7 +92,7 @@ int main(int argc, char *argv[])
         surfaceReaderHandler->ResetFlag();
         fileIndex++;
     }
-    ScreenManager::GetInstance().DestroyVirtualScreen(virtualScreenId);
-    std::cout << "DestroyVirtualScreen " << virtualScreenId << std::endl;
+    DisplayManager::GetInstance().StopDisplayCapture(captureId);
+    std::cout << "StopDisplayCapture " << captureId << std::endl;
     return 0;
 }
\ No newline at end of file
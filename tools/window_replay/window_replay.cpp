@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Replays transactions recorded by "hidumper -s 4606 -a '-record -start <name>'" to /data/window_transactions/.
+ * By default they drive an in-process WindowManagerService on a headless display, "-remote" sends them to the
+ * running service instead. Windows of every recorded display are replayed on the default display of the target.
+ * Build with window_manager_headless_backend = true to replay in-process without RS, MMI and power services.
+ */
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <iservice_registry.h>
+#include <system_ability_definition.h>
+
+#include "display_manager.h"
+#include "display_manager_service_inner.h"
+#include "headless_window_service_backend.h"
+#include "window_manager_service.h"
+#include "window_transaction_replayer.h"
+
+using namespace OHOS;
+using namespace OHOS::Rosen;
+
+namespace {
+// size of the headless display of the in-process service, the same as the rk3568 panel
+constexpr uint32_t HEADLESS_DISPLAY_WIDTH = 720;
+constexpr uint32_t HEADLESS_DISPLAY_HEIGHT = 1280;
+
+void PrintUsage(const char* cmd)
+{
+    std::cout << "usage: " << cmd << " <file> [-remote] [-realtime]" << std::endl;
+    std::cout << "  -remote     replay against the running window manager service" << std::endl;
+    std::cout << "  -realtime   keep the recorded intervals between transactions" << std::endl;
+}
+
+sptr<IWindowManager> GetRemoteWindowManager()
+{
+    sptr<ISystemAbilityManager> systemAbilityManager =
+        SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (systemAbilityManager == nullptr) {
+        return nullptr;
+    }
+    sptr<IRemoteObject> remoteObject = systemAbilityManager->GetSystemAbility(WINDOW_MANAGER_SERVICE_ID);
+    if (remoteObject == nullptr) {
+        return nullptr;
+    }
+    return iface_cast<IWindowManager>(remoteObject);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) { // 2: at least the file name
+        PrintUsage(argv[0]);
+        return -1;
+    }
+    bool isRemote = false;
+    bool keepTiming = false;
+    for (int i = 2; i < argc; i++) { // 2: options follow the file name
+        if (std::strcmp(argv[i], "-remote") == 0) {
+            isRemote = true;
+        } else if (std::strcmp(argv[i], "-realtime") == 0) {
+            keepTiming = true;
+        } else {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
+    sptr<IWindowManager> remote = nullptr;
+    if (isRemote) {
+        remote = GetRemoteWindowManager();
+        if (remote == nullptr) {
+            std::cout << "error: window manager service is not available" << std::endl;
+            return -1;
+        }
+    } else if (!WindowManagerService::GetInstance().StartInProcess(HEADLESS_DISPLAY_WIDTH,
+        HEADLESS_DISPLAY_HEIGHT)) {
+        std::cout << "error: start in-process window manager service failed" << std::endl;
+        return -1;
+    }
+    IWindowManager& target = isRemote ? *remote : static_cast<IWindowManager&>(WindowManagerService::GetInstance());
+    WindowTransactionReplayer replayer(target);
+    replayer.SetDefaultDisplay(isRemote ? DisplayManager::GetInstance().GetDefaultDisplayId() :
+        DisplayManagerServiceInner::GetInstance().GetDefaultDisplayId());
+    if (!replayer.Load(argv[1])) {
+        std::cout << "error: load " << argv[1] << " failed" << std::endl;
+        return -1;
+    }
+    replayer.Replay(keepTiming);
+    std::string result;
+    replayer.Dump(result);
+    auto headlessBackend =
+        dynamic_cast<HeadlessWindowServiceBackend*>(&SingletonContainer::Get<WindowServiceBackend>());
+    if (!isRemote && headlessBackend != nullptr) {
+        headlessBackend->Dump(result);
+    }
+    std::cout << result;
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Offline analyzer of the window tree records of window manager service. It has no dependency besides the standard
+ * library, so it can also be built on host:
+ *   hidumper -s 4606 -a '-tree -raw' > window_tree.bin
+ *   g++ -std=c++17 -I utils/include tools/window_tree_analyzer/window_tree_analyzer.cpp \
+ *       utils/src/window_tree_record.cpp -o window_tree_analyzer
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "window_tree_record.h"
+
+using namespace OHOS::Rosen;
+
+namespace {
+using WindowNodeRecordMap = std::map<uint32_t, WindowTreeNodeRecord>;
+
+void PrintUsage(const char* cmd)
+{
+    std::cout << "usage: " << cmd << " <file> [list | show <seq> | diff <seq> <seq> | replay]" << std::endl;
+    std::cout << "  list     list all records (default)" << std::endl;
+    std::cout << "  show     print the window tree of a record" << std::endl;
+    std::cout << "  diff     print windows added, removed or changed between two records" << std::endl;
+    std::cout << "  replay   print every record as a diff against the previous tree of the same display" << std::endl;
+}
+
+bool LoadSnapshots(const std::string& path, std::vector<WindowTreeSnapshot>& snapshots)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cout << "error: cannot open " << path << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    // the dump may be prefixed by text of hidumper, locate the file header first
+    for (size_t offset = 0; offset + sizeof(WindowTreeFileHeader) <= data.size(); offset++) {
+        uint32_t magic = 0;
+        std::memcpy(&magic, data.data() + offset, sizeof(magic));
+        if (magic == WINDOW_TREE_FILE_MAGIC &&
+            WindowTreeRecordBuffer::Deserialize(data.data() + offset, data.size() - offset, snapshots)) {
+            return true;
+        }
+        snapshots.clear();
+    }
+    std::cout << "error: no valid window tree records in " << path << std::endl;
+    return false;
+}
+
+const WindowTreeSnapshot* FindSnapshot(const std::vector<WindowTreeSnapshot>& snapshots, const char* seqStr)
+{
+    uint32_t seq = static_cast<uint32_t>(std::strtoul(seqStr, nullptr, 10));
+    for (auto& snapshot : snapshots) {
+        if (snapshot.header_.seq_ == seq) {
+            return &snapshot;
+        }
+    }
+    std::cout << "error: record " << seq << " not found" << std::endl;
+    return nullptr;
+}
+
+void PrintHeader(const WindowTreeRecordHeader& header)
+{
+    std::cout << "#" << header.seq_ << " time(ms): " << header.timestampMs_ << " reason: " <<
+        WindowTreeChangeReasonToString(header.reason_) << " windows: " << header.nodeCount_ << std::endl;
+}
+
+void PrintNode(const char* prefix, const WindowTreeNodeRecord& node)
+{
+    std::cout << prefix << std::setw(9) << node.displayId_ << std::setw(6) << node.windowId_ <<
+        std::setw(7) << node.parentId_ << std::setw(5) << node.type_ <<
+        std::setw(5) << static_cast<uint32_t>(node.mode_) << std::setw(5) << node.flags_ <<
+        std::setw(5) << node.zOrder_ << std::setw(8) << static_cast<uint32_t>(node.visibility_) <<
+        std::setw(12) << static_cast<uint32_t>(node.orientation_) << " [" << std::setw(5) << node.posX_ <<
+        std::setw(5) << node.posY_ << std::setw(5) << node.width_ << std::setw(5) << node.height_ << "]" << std::endl;
+}
+
+void ShowSnapshot(const WindowTreeSnapshot& snapshot)
+{
+    PrintHeader(snapshot.header_);
+    std::cout << "  DisplayId WinId Parent Type Mode Flag ZOrd Visible Orientation [    x    y    w    h]" << std::endl;
+    for (auto& node : snapshot.nodes_) {
+        PrintNode("  ", node);
+    }
+}
+
+bool IsNodeChanged(const WindowTreeNodeRecord& lhs, const WindowTreeNodeRecord& rhs)
+{
+    return lhs.displayId_ != rhs.displayId_ || lhs.parentId_ != rhs.parentId_ || lhs.type_ != rhs.type_ ||
+        lhs.flags_ != rhs.flags_ || lhs.zOrder_ != rhs.zOrder_ || lhs.posX_ != rhs.posX_ || lhs.posY_ != rhs.posY_ ||
+        lhs.width_ != rhs.width_ || lhs.height_ != rhs.height_ || lhs.mode_ != rhs.mode_ ||
+        lhs.visibility_ != rhs.visibility_ || lhs.orientation_ != rhs.orientation_;
+}
+
+void DiffNodes(const WindowNodeRecordMap& from, const WindowNodeRecordMap& to)
+{
+    for (auto& elem : to) {
+        auto iter = from.find(elem.first);
+        if (iter == from.end()) {
+            PrintNode("  + ", elem.second);
+        } else if (IsNodeChanged(iter->second, elem.second)) {
+            PrintNode("  < ", iter->second);
+            PrintNode("  > ", elem.second);
+        }
+    }
+    for (auto& elem : from) {
+        if (to.find(elem.first) == to.end()) {
+            PrintNode("  - ", elem.second);
+        }
+    }
+}
+
+WindowNodeRecordMap ToNodeMap(const WindowTreeSnapshot& snapshot)
+{
+    WindowNodeRecordMap nodeMap;
+    for (auto& node : snapshot.nodes_) {
+        nodeMap[node.windowId_] = node;
+    }
+    return nodeMap;
+}
+
+void Replay(const std::vector<WindowTreeSnapshot>& snapshots)
+{
+    // records of different screen groups are interleaved, so diff each display against its own last tree
+    std::map<uint64_t, WindowNodeRecordMap> displayTrees;
+    for (auto& snapshot : snapshots) {
+        std::map<uint64_t, WindowNodeRecordMap> currentTrees;
+        for (auto& node : snapshot.nodes_) {
+            currentTrees[node.displayId_][node.windowId_] = node;
+        }
+        PrintHeader(snapshot.header_);
+        for (auto& elem : currentTrees) {
+            DiffNodes(displayTrees[elem.first], elem.second);
+            displayTrees[elem.first] = elem.second;
+        }
+    }
+}
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) { // 2: at least the file name
+        PrintUsage(argv[0]);
+        return -1;
+    }
+    std::vector<WindowTreeSnapshot> snapshots;
+    if (!LoadSnapshots(argv[1], snapshots)) {
+        return -1;
+    }
+    std::string command = argc > 2 ? argv[2] : "list"; // 2: index of command
+    if (command == "list") {
+        for (auto& snapshot : snapshots) {
+            PrintHeader(snapshot.header_);
+        }
+    } else if (command == "show" && argc > 3) { // 3: index of seq
+        const WindowTreeSnapshot* snapshot = FindSnapshot(snapshots, argv[3]);
+        if (snapshot == nullptr) {
+            return -1;
+        }
+        ShowSnapshot(*snapshot);
+    } else if (command == "diff" && argc > 4) { // 3, 4: index of seqs
+        const WindowTreeSnapshot* from = FindSnapshot(snapshots, argv[3]);
+        const WindowTreeSnapshot* to = FindSnapshot(snapshots, argv[4]);
+        if (from == nullptr || to == nullptr) {
+            return -1;
+        }
+        PrintHeader(from->header_);
+        PrintHeader(to->header_);
+        DiffNodes(ToNodeMap(*from), ToNodeMap(*to));
+    } else if (command == "replay") {
+        Replay(snapshots);
+    } else {
+        PrintUsage(argv[0]);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_WM_INCLUDE_PERF_HISTOGRAM_H
+#define OHOS_WM_INCLUDE_PERF_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "noncopyable.h"
+
+namespace OHOS {
+namespace Rosen {
+struct PerfHistogramSnapshot {
+    uint64_t count_ { 0 };
+    uint64_t sumUs_ { 0 };
+    uint64_t maxUs_ { 0 };
+    uint64_t p50Us_ { 0 };
+    uint64_t p90Us_ { 0 };
+    uint64_t p99Us_ { 0 };
+
+    uint64_t GetAverageUs() const
+    {
+        return count_ == 0 ? 0 : sumUs_ / count_;
+    }
+};
+
+/*
+ * Latency histogram with power-of-two microsecond buckets. Recording only touches relaxed atomics, so it can be
+ * called from any thread on hot paths; snapshots are approximate while writers are active.
+ */
+class PerfHistogram {
+public:
+    PerfHistogram() = default;
+    ~PerfHistogram() = default;
+
+    void Record(uint64_t costUs);
+    PerfHistogramSnapshot GetSnapshot() const;
+    // takes the snapshot and clears the histogram in one step, every sample is reported by exactly one snapshot
+    PerfHistogramSnapshot TakeSnapshot();
+    void Reset();
+    std::string ToString() const;
+
+    static uint64_t GetCurrentTimeUs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    WM_DISALLOW_COPY_AND_MOVE(PerfHistogram);
+
+private:
+    // bucket i holds costs in [2^(i-1), 2^i) us, bucket 0 holds 0us, the last one collects the rest (> 8s)
+    static constexpr size_t BUCKET_NUM = 25;
+    static size_t GetBucketIndex(uint64_t costUs);
+    static uint64_t GetPercentileUs(const std::array<uint64_t, BUCKET_NUM>& buckets, uint64_t count,
+        uint64_t maxUs, uint32_t percent);
+    static PerfHistogramSnapshot MakeSnapshot(const std::array<uint64_t, BUCKET_NUM>& buckets, uint64_t sumUs,
+        uint64_t maxUs);
+
+    std::array<std::atomic<uint64_t>, BUCKET_NUM> buckets_ {};
+    std::atomic<uint64_t> sumUs_ { 0 };
+    std::atomic<uint64_t> maxUs_ { 0 };
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_WM_INCLUDE_PERF_HISTOGRAM_H
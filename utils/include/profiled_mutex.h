@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_WM_INCLUDE_PROFILED_MUTEX_H
+#define OHOS_WM_INCLUDE_PROFILED_MUTEX_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "noncopyable.h"
+
+#define WM_PROFILED_LOCK(mutex) ProfiledLockGuard profiledLockGuard(mutex, __func__)
+
+namespace OHOS {
+namespace Rosen {
+constexpr uint32_t INNER_REQUEST_CODE = UINT32_MAX;
+
+struct LockProfileStats {
+    uint64_t count_ { 0 };
+    uint64_t totalWaitUs_ { 0 };
+    uint64_t maxWaitUs_ { 0 };
+    uint64_t totalHoldUs_ { 0 };
+    uint64_t maxHoldUs_ { 0 };
+};
+
+/*
+ * Recursive mutex which records wait time, hold time and the call-site of the outermost owner, aggregated per IPC
+ * request code of the locking thread. Profiling is off by default and costs one relaxed atomic load per lock then.
+ */
+class ProfiledRecursiveMutex {
+public:
+    explicit ProfiledRecursiveMutex(const char* name) : name_(name) {}
+    ~ProfiledRecursiveMutex() = default;
+
+    // BasicLockable, so the mutex can still be used with std::lock_guard/std::unique_lock
+    void lock()
+    {
+        Lock(nullptr);
+    }
+    void unlock();
+    bool try_lock();
+
+    void Lock(const char* site);
+    void SetProfileEnabled(bool enabled);
+    bool IsProfileEnabled() const
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+    void ResetProfile();
+    void DumpProfile(std::string& dumpInfo) const;
+
+    WM_DISALLOW_COPY_AND_MOVE(ProfiledRecursiveMutex);
+
+private:
+    void OnAcquired(const char* site, uint64_t waitStartUs);
+
+    const char* name_;
+    std::recursive_mutex mutex_;
+    std::atomic<bool> enabled_ { false };
+
+    // owner information, only written by the thread holding mutex_
+    uint32_t depth_ { 0 };
+    uint64_t ownerSinceUs_ { 0 };
+    uint64_t ownerWaitUs_ { 0 };
+    uint32_t ownerCode_ { INNER_REQUEST_CODE };
+    const char* ownerSite_ { nullptr };
+
+    mutable std::mutex statsMutex_;
+    std::map<uint32_t, std::map<std::string, LockProfileStats>> stats_;
+};
+
+class ProfiledLockGuard final {
+public:
+    ProfiledLockGuard(ProfiledRecursiveMutex& mutex, const char* site) : mutex_(mutex)
+    {
+        mutex_.Lock(site);
+    }
+    ~ProfiledLockGuard()
+    {
+        mutex_.unlock();
+    }
+
+    WM_DISALLOW_COPY_AND_MOVE(ProfiledLockGuard);
+
+private:
+    ProfiledRecursiveMutex& mutex_;
+};
+
+// marks the IPC request code handled by current thread, used to aggregate lock profile per request
+class ProfiledRequestScope final {
+public:
+    explicit ProfiledRequestScope(uint32_t code);
+    ~ProfiledRequestScope();
+
+    WM_DISALLOW_COPY_AND_MOVE(ProfiledRequestScope);
+
+private:
+    uint32_t lastCode_;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_WM_INCLUDE_PROFILED_MUTEX_H
@@ -48,6 +48,7 @@ public:
     DEFINE_VAR_DEFAULT_FUNC_GET(ScreenType, Type, type, ScreenType::UNDEFINE);
     DEFINE_VAR_DEFAULT_FUNC_GET(uint32_t, ModeId, modeId, 0);
     DEFINE_VAR_FUNC_GET(std::vector<sptr<SupportedScreenModes>>, Modes, modes);
+    DEFINE_VAR_DEFAULT_FUNC_GET(uint32_t, Version, version, 0);
 protected:
     ScreenInfo() = default;
     bool InnerUnmarshalling(Parcel& parcel);
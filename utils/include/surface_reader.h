@@ -18,9 +18,14 @@
 
 #include "refbase.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <event_handler.h>
 #include <surface.h>
 
 #include "surface_reader_handler.h"
+#include "tile_change_detector.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -34,6 +39,11 @@ public:
 
     sptr<Surface> GetSurface() const;
     void SetHandler(sptr<SurfaceReaderHandler> handler);
+    // frames arriving faster than frameRate are dropped, 0 means no limit. The newest dropped frame is delivered
+    // when the interval ends, so the last content before the producer goes idle still reaches the handler.
+    void SetFrameRate(uint32_t frameRate);
+    // narrow full damage reported by the producer down to the tiles really changed, frames without change are skipped
+    void SetChangeDetectionEnabled(bool enabled);
 private:
     class BufferListener : public IBufferConsumerListener {
     public:
@@ -52,13 +62,28 @@ private:
     friend class BufferListener;
 
     void OnVsync();
-    bool ProcessBuffer(const sptr<SurfaceBuffer> &buf);
+    void OnTrailingFrame();
+    void DeliverBufferLocked(const sptr<SurfaceBuffer>& buffer);
+    void ReleaseBufferLocked(const sptr<SurfaceBuffer>& buffer);
+    void ScheduleTrailingFrameLocked(int64_t delayNs);
+    bool ProcessBuffer(const sptr<SurfaceBuffer> &buf, const Rect& damage);
+    bool ProcessFrame(SurfaceReaderFrame& frame);
+    bool ShouldDropFrame(int64_t& remainingNs);
 
     sptr<IBufferConsumerListener> listener_ = nullptr;
     sptr<Surface> csurface_ = nullptr; // cosumer surface
     sptr<Surface> psurface_ = nullptr; // producer surface
+    // the consumer thread and the trailing frame task share the frame state below
+    std::mutex mutex_;
     sptr<SurfaceBuffer> prevBuffer_ = nullptr;
+    sptr<SurfaceBuffer> droppedBuffer_ = nullptr; // newest frame dropped by the frame rate, still acquired
     sptr<SurfaceReaderHandler> handler_ = nullptr;
+    std::atomic<int64_t> frameIntervalNs_ { 0 };
+    int64_t lastFrameTimeNs_ = 0;
+    Rect pendingDamage_ = { 0, 0, 0, 0 };
+    std::atomic<bool> changeDetectionEnabled_ { false };
+    std::unique_ptr<TileChangeDetector> changeDetector_;
+    std::shared_ptr<AppExecFwk::EventHandler> trailingFrameHandler_;
 };
 }
 }
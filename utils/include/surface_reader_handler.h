@@ -17,9 +17,19 @@
 #define SURFACE_READER_HANDLER_H
 
 #include "pixel_map.h"
+#include "wm_common.h"
 
 namespace OHOS {
 namespace Rosen {
+// RGBA_8888 content of an acquired buffer, only valid during OnFrameAvailable
+struct SurfaceReaderFrame {
+    const uint8_t* addr_;
+    uint32_t width_;
+    uint32_t height_;
+    uint32_t stride_;
+    Rect damage_; // changed region since the previous frame, within the frame
+};
+
 class SurfaceReaderHandler : public RefBase {
 public:
     SurfaceReaderHandler() {}
@@ -27,6 +37,11 @@ public:
     {
     }
     virtual bool OnImageAvalible(sptr<Media::PixelMap> pixleMap) = 0;
+    // override to copy, diff or encode only the damaged region, the default copies the whole frame to a pixel map
+    virtual bool OnFrameAvailable(const SurfaceReaderFrame& frame);
+
+protected:
+    static bool CopyRegion(const SurfaceReaderFrame& frame, const Rect& region, uint8_t* dst, uint32_t dstStride);
 };
 }
 }
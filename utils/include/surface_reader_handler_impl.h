@@ -17,6 +17,7 @@
 #define SURFACE_READER_HANDLER_IMPL_H
 
 #include <mutex>
+#include <vector>
 #include "surface_reader_handler.h"
 
 namespace OHOS {
@@ -24,6 +25,8 @@ namespace Rosen {
 class SurfaceReaderHandlerImpl : public SurfaceReaderHandler {
 public:
     bool OnImageAvalible(sptr<Media::PixelMap> pixleMap) override;
+    // keeps a copy of the latest content up to date from the damage, a pixel map is built only once it is wanted
+    bool OnFrameAvailable(const SurfaceReaderFrame& frame) override;
     bool IsImageOk();
     void ResetFlag();
     sptr<Media::PixelMap> GetPixelMap();
@@ -31,6 +34,9 @@ public:
 private:
     bool flag_ = false;
     sptr<Media::PixelMap> pixleMap_ = nullptr;
+    std::vector<uint8_t> content_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
     std::recursive_mutex mutex_;
 };
 }
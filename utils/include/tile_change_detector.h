@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_WM_INCLUDE_TILE_CHANGE_DETECTOR_H
+#define OHOS_WM_INCLUDE_TILE_CHANGE_DETECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "wm_common.h"
+
+namespace OHOS {
+namespace Rosen {
+/*
+ * Finds the changed part of frames whose producer reports full damage. The frame is split into square tiles and
+ * the hash of every tile inside the damage is compared with the one of the last committed frame.
+ */
+class TileChangeDetector {
+public:
+    explicit TileChangeDetector(uint32_t tileSize, uint32_t bytesPerPixel);
+    ~TileChangeDetector() = default;
+
+    // returns the bounding rect of changed tiles clipped to the frame, empty if nothing changed
+    Rect Detect(const uint8_t* addr, uint32_t width, uint32_t height, uint32_t stride, const Rect& damage);
+    // the frame of the last Detect was delivered, its tiles become the reference of the next one
+    void Commit();
+    void Reset();
+
+private:
+    uint64_t HashTile(const uint8_t* addr, uint32_t width, uint32_t height, uint32_t stride, uint32_t column,
+        uint32_t row) const;
+
+    uint32_t tileSize_;
+    uint32_t bytesPerPixel_;
+    uint32_t width_ { 0 };
+    uint32_t height_ { 0 };
+    uint32_t columns_ { 0 };
+    uint32_t rows_ { 0 };
+    std::vector<uint64_t> tileHashes_;
+    uint32_t pendingWidth_ { 0 };
+    uint32_t pendingHeight_ { 0 };
+    std::vector<std::pair<size_t, uint64_t>> pendingTileHashes_; // tile index, hash
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_WM_INCLUDE_TILE_CHANGE_DETECTOR_H
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_WM_INCLUDE_WINDOW_STATE_PAGE_H
+#define OHOS_WM_INCLUDE_WINDOW_STATE_PAGE_H
+
+#include <atomic>
+#include <cstdint>
+
+/*
+ * Layout of the read-only shared memory page through which the window manager service publishes the global state
+ * that clients query most often. The service is the only writer and guards the snapshot with a sequence lock: the
+ * sequence is odd while a write is in progress, readers copy the snapshot and retry when the sequence moved.
+ */
+namespace OHOS {
+namespace Rosen {
+constexpr uint32_t WINDOW_STATE_PAGE_MAGIC = 0x50535457; // "WTSP"
+constexpr uint16_t WINDOW_STATE_PAGE_VERSION = 1;
+constexpr uint32_t WINDOW_STATE_MAX_DISPLAY_NUM = 8;
+constexpr uint32_t WINDOW_STATE_MAX_TOP_WINDOW_NUM = 64;
+
+struct WindowStateDisplayEntry {
+    uint64_t displayId_;
+    int32_t posX_;
+    int32_t posY_;
+    uint32_t width_;
+    uint32_t height_;
+    uint32_t focusedWindowId_;
+    uint32_t reserved_;
+};
+
+struct WindowStateTopWindowEntry {
+    uint32_t mainWindowId_;
+    uint32_t topWindowId_;
+};
+
+struct WindowStateSnapshot {
+    uint32_t displayCount_;
+    uint32_t topWindowCount_; // visible main windows only, the table is truncated beyond the max number
+    uint8_t isSystemDecorEnable_;
+    uint8_t reserved_[7];
+    WindowStateDisplayEntry displays_[WINDOW_STATE_MAX_DISPLAY_NUM];
+    WindowStateTopWindowEntry topWindows_[WINDOW_STATE_MAX_TOP_WINDOW_NUM];
+};
+
+struct WindowStatePage {
+    uint32_t magic_;
+    uint16_t version_;
+    uint16_t reserved_;
+    std::atomic<uint32_t> sequence_;
+    uint32_t snapshotSize_;
+    WindowStateSnapshot snapshot_;
+};
+
+static_assert(sizeof(WindowStateDisplayEntry) == 32, "WindowStateDisplayEntry layout changed");
+static_assert(sizeof(WindowStateTopWindowEntry) == 8, "WindowStateTopWindowEntry layout changed");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "sequence of the shared page must be lock free");
+
+void InitWindowStatePage(WindowStatePage& page);
+void WriteWindowStatePage(WindowStatePage& page, const WindowStateSnapshot& snapshot);
+bool ReadWindowStatePage(const WindowStatePage& page, WindowStateSnapshot& snapshot);
+bool FindTopWindowId(const WindowStateSnapshot& snapshot, uint32_t mainWinId, uint32_t& topWinId);
+bool FindFocusWindowId(const WindowStateSnapshot& snapshot, uint64_t displayId, uint32_t& focusWinId);
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_WM_INCLUDE_WINDOW_STATE_PAGE_H
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_WM_INCLUDE_WINDOW_TREE_RECORD_H
+#define OHOS_WM_INCLUDE_WINDOW_TREE_RECORD_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/*
+ * Binary snapshot format of the window tree. It only depends on the standard library so that the host side
+ * analyzer (tools/window_tree_analyzer) can share it with the service. All fields are written in host byte order.
+ *
+ * file   := WindowTreeFileHeader record*
+ * record := WindowTreeRecordHeader WindowTreeNodeRecord[nodeCount_]
+ */
+namespace OHOS {
+namespace Rosen {
+constexpr uint32_t WINDOW_TREE_FILE_MAGIC = 0x46525457; // "WTRF"
+constexpr uint32_t WINDOW_TREE_RECORD_MAGIC = 0x52525457; // "WTRR"
+constexpr uint16_t WINDOW_TREE_RECORD_VERSION = 1;
+
+enum class WindowTreeChangeReason : uint16_t {
+    ADD_WINDOW,
+    UPDATE_WINDOW,
+    REMOVE_WINDOW,
+    RAISE_ZORDER,
+    SWITCH_LAYOUT,
+    REORDER,
+    FOCUS_FAULT,
+    REASON_END,
+};
+
+struct WindowTreeFileHeader {
+    uint32_t magic_;
+    uint16_t version_;
+    uint16_t reserved_;
+    uint32_t recordCount_;
+    uint32_t nodeRecordSize_;
+};
+
+struct WindowTreeRecordHeader {
+    uint32_t magic_;
+    uint16_t version_;
+    uint16_t reason_;
+    uint32_t seq_;
+    uint32_t nodeCount_;
+    uint64_t timestampMs_; // wall clock, to match field reports with hilog
+};
+
+struct WindowTreeNodeRecord {
+    uint64_t displayId_;
+    uint32_t windowId_;
+    uint32_t parentId_;
+    uint32_t type_;
+    uint32_t flags_;
+    uint32_t zOrder_;
+    int32_t posX_;
+    int32_t posY_;
+    uint32_t width_;
+    uint32_t height_;
+    uint8_t mode_;
+    uint8_t visibility_;
+    uint8_t orientation_;
+    uint8_t reserved_;
+};
+
+static_assert(sizeof(WindowTreeFileHeader) == 16, "WindowTreeFileHeader layout changed");
+static_assert(sizeof(WindowTreeRecordHeader) == 24, "WindowTreeRecordHeader layout changed");
+static_assert(sizeof(WindowTreeNodeRecord) == 48, "WindowTreeNodeRecord layout changed");
+
+struct WindowTreeSnapshot {
+    WindowTreeRecordHeader header_;
+    std::vector<WindowTreeNodeRecord> nodes_;
+};
+
+const char* WindowTreeChangeReasonToString(uint16_t reason);
+
+/*
+ * Ring of the latest snapshots. Slots keep their capacity, so recording a tree after warm-up is a single memcpy
+ * without allocation.
+ */
+class WindowTreeRecordBuffer {
+public:
+    explicit WindowTreeRecordBuffer(uint32_t capacity);
+    ~WindowTreeRecordBuffer() = default;
+
+    uint32_t Record(WindowTreeChangeReason reason, const std::vector<WindowTreeNodeRecord>& nodes);
+    std::vector<WindowTreeSnapshot> GetSnapshots() const;
+    std::vector<uint8_t> Serialize() const;
+    void Clear();
+
+    static bool Deserialize(const uint8_t* data, size_t size, std::vector<WindowTreeSnapshot>& snapshots);
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::vector<uint8_t>> slots_;
+    uint32_t nextSeq_ { 0 };
+    uint32_t recordCount_ { 0 };
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_WM_INCLUDE_WINDOW_TREE_RECORD_H
@@ -93,6 +93,7 @@ namespace {
     constexpr float DEFAULT_SPLIT_RATIO = 0.5;
     constexpr float DEFAULT_ASPECT_RATIO = 0.66;
     constexpr uint32_t DIVIDER_WIDTH = 8;
+    constexpr uint32_t DEFAULT_DIVIDER_DRAG_NOTIFY_INTERVAL = 32; // ms
     constexpr uint32_t WINDOW_TITLE_BAR_HEIGHT = 37;
     constexpr uint32_t WINDOW_FRAME_WIDTH = 5;
     constexpr uint32_t WINDOW_FRAME_CORNER_WIDTH = 16; // the frame width of corner
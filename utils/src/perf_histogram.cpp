@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "perf_histogram.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr uint32_t PERCENT_50 = 50;
+    constexpr uint32_t PERCENT_90 = 90;
+    constexpr uint32_t PERCENT_99 = 99;
+    constexpr uint32_t PERCENT_100 = 100;
+}
+
+size_t PerfHistogram::GetBucketIndex(uint64_t costUs)
+{
+    size_t index = 0;
+    while (costUs != 0 && index < BUCKET_NUM - 1) {
+        costUs >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+void PerfHistogram::Record(uint64_t costUs)
+{
+    buckets_[GetBucketIndex(costUs)].fetch_add(1, std::memory_order_relaxed);
+    sumUs_.fetch_add(costUs, std::memory_order_relaxed);
+    uint64_t lastMax = maxUs_.load(std::memory_order_relaxed);
+    while (costUs > lastMax && !maxUs_.compare_exchange_weak(lastMax, costUs, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t PerfHistogram::GetPercentileUs(const std::array<uint64_t, BUCKET_NUM>& buckets, uint64_t count,
+    uint64_t maxUs, uint32_t percent)
+{
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t target = (count * percent + PERCENT_100 - 1) / PERCENT_100;
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < BUCKET_NUM; i++) {
+        accumulated += buckets[i];
+        if (accumulated >= target) {
+            // report the upper bound of the bucket
+            return i == 0 ? 0 : (static_cast<uint64_t>(1) << i) - 1;
+        }
+    }
+    return maxUs;
+}
+
+PerfHistogramSnapshot PerfHistogram::MakeSnapshot(const std::array<uint64_t, BUCKET_NUM>& buckets, uint64_t sumUs,
+    uint64_t maxUs)
+{
+    PerfHistogramSnapshot snapshot;
+    for (uint64_t bucket : buckets) {
+        snapshot.count_ += bucket;
+    }
+    snapshot.sumUs_ = sumUs;
+    snapshot.maxUs_ = maxUs;
+    snapshot.p50Us_ = std::min(GetPercentileUs(buckets, snapshot.count_, maxUs, PERCENT_50), maxUs);
+    snapshot.p90Us_ = std::min(GetPercentileUs(buckets, snapshot.count_, maxUs, PERCENT_90), maxUs);
+    snapshot.p99Us_ = std::min(GetPercentileUs(buckets, snapshot.count_, maxUs, PERCENT_99), maxUs);
+    return snapshot;
+}
+
+PerfHistogramSnapshot PerfHistogram::GetSnapshot() const
+{
+    std::array<uint64_t, BUCKET_NUM> buckets;
+    for (size_t i = 0; i < BUCKET_NUM; i++) {
+        buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    return MakeSnapshot(buckets, sumUs_.load(std::memory_order_relaxed), maxUs_.load(std::memory_order_relaxed));
+}
+
+PerfHistogramSnapshot PerfHistogram::TakeSnapshot()
+{
+    // exchanging each counter moves a sample to exactly one snapshot, a sample recorded meanwhile may have its bucket
+    // and its cost taken by two consecutive snapshots, but is never dropped the way snapshot then reset drops it
+    std::array<uint64_t, BUCKET_NUM> buckets;
+    for (size_t i = 0; i < BUCKET_NUM; i++) {
+        buckets[i] = buckets_[i].exchange(0, std::memory_order_relaxed);
+    }
+    return MakeSnapshot(buckets, sumUs_.exchange(0, std::memory_order_relaxed),
+        maxUs_.exchange(0, std::memory_order_relaxed));
+}
+
+void PerfHistogram::Reset()
+{
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    sumUs_.store(0, std::memory_order_relaxed);
+    maxUs_.store(0, std::memory_order_relaxed);
+}
+
+std::string PerfHistogram::ToString() const
+{
+    PerfHistogramSnapshot snapshot = GetSnapshot();
+    std::ostringstream os;
+    os << "count:" << snapshot.count_ << " avg:" << snapshot.GetAverageUs() << "us p50:" << snapshot.p50Us_ <<
+        "us p90:" << snapshot.p90Us_ << "us p99:" << snapshot.p99Us_ << "us max:" << snapshot.maxUs_ << "us";
+    return os.str();
+}
+} // namespace Rosen
+} // namespace OHOS
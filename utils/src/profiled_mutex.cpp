@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profiled_mutex.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "perf_histogram.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    thread_local uint32_t g_currentRequestCode = INNER_REQUEST_CODE;
+    const std::string UNKNOWN_SITE = "unknown";
+    constexpr int COLUMN_WIDTH = 12;
+}
+
+ProfiledRequestScope::ProfiledRequestScope(uint32_t code) : lastCode_(g_currentRequestCode)
+{
+    g_currentRequestCode = code;
+}
+
+ProfiledRequestScope::~ProfiledRequestScope()
+{
+    g_currentRequestCode = lastCode_;
+}
+
+void ProfiledRecursiveMutex::Lock(const char* site)
+{
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        mutex_.lock();
+        if (depth_++ == 0) {
+            ownerSinceUs_ = 0;
+        }
+        return;
+    }
+    uint64_t waitStartUs = PerfHistogram::GetCurrentTimeUs();
+    mutex_.lock();
+    OnAcquired(site, waitStartUs);
+}
+
+bool ProfiledRecursiveMutex::try_lock()
+{
+    if (!mutex_.try_lock()) {
+        return false;
+    }
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        if (depth_++ == 0) {
+            ownerSinceUs_ = 0;
+        }
+        return true;
+    }
+    OnAcquired(nullptr, PerfHistogram::GetCurrentTimeUs());
+    return true;
+}
+
+void ProfiledRecursiveMutex::OnAcquired(const char* site, uint64_t waitStartUs)
+{
+    if (depth_++ != 0) {
+        return; // reentry of the owner, only the outermost acquisition is profiled
+    }
+    ownerSinceUs_ = PerfHistogram::GetCurrentTimeUs();
+    ownerWaitUs_ = ownerSinceUs_ > waitStartUs ? ownerSinceUs_ - waitStartUs : 0;
+    ownerCode_ = g_currentRequestCode;
+    ownerSite_ = site;
+}
+
+void ProfiledRecursiveMutex::unlock()
+{
+    if (--depth_ != 0 || ownerSinceUs_ == 0) {
+        mutex_.unlock();
+        return;
+    }
+    uint64_t now = PerfHistogram::GetCurrentTimeUs();
+    uint64_t holdUs = now > ownerSinceUs_ ? now - ownerSinceUs_ : 0;
+    uint64_t waitUs = ownerWaitUs_;
+    uint32_t code = ownerCode_;
+    const char* site = ownerSite_;
+    ownerSinceUs_ = 0;
+    mutex_.unlock();
+
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    LockProfileStats& stats = stats_[code][site != nullptr ? site : UNKNOWN_SITE];
+    stats.count_++;
+    stats.totalWaitUs_ += waitUs;
+    stats.maxWaitUs_ = std::max(stats.maxWaitUs_, waitUs);
+    stats.totalHoldUs_ += holdUs;
+    stats.maxHoldUs_ = std::max(stats.maxHoldUs_, holdUs);
+}
+
+void ProfiledRecursiveMutex::SetProfileEnabled(bool enabled)
+{
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void ProfiledRecursiveMutex::ResetProfile()
+{
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    stats_.clear();
+}
+
+void ProfiledRecursiveMutex::DumpProfile(std::string& dumpInfo) const
+{
+    std::ostringstream os;
+    os << "-------------------- Lock Profile: " << name_ << " (" <<
+        (IsProfileEnabled() ? "enabled" : "disabled") << ") --------------------" << std::endl;
+    os << std::left << std::setw(COLUMN_WIDTH) << "Code" << std::setw(COLUMN_WIDTH) << "Count" <<
+        std::setw(COLUMN_WIDTH) << "AvgWait(us)" << std::setw(COLUMN_WIDTH) << "MaxWait(us)" <<
+        std::setw(COLUMN_WIDTH) << "AvgHold(us)" << std::setw(COLUMN_WIDTH) << "MaxHold(us)" <<
+        "CallSite" << std::endl;
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    for (auto& codeStats : stats_) {
+        for (auto& siteStats : codeStats.second) {
+            const LockProfileStats& stats = siteStats.second;
+            std::string code = codeStats.first == INNER_REQUEST_CODE ? "inner" : std::to_string(codeStats.first);
+            os << std::setw(COLUMN_WIDTH) << code << std::setw(COLUMN_WIDTH) << stats.count_ <<
+                std::setw(COLUMN_WIDTH) << stats.totalWaitUs_ / stats.count_ << std::setw(COLUMN_WIDTH) <<
+                stats.maxWaitUs_ << std::setw(COLUMN_WIDTH) << stats.totalHoldUs_ / stats.count_ <<
+                std::setw(COLUMN_WIDTH) << stats.maxHoldUs_ << siteStats.first << std::endl;
+        }
+    }
+    dumpInfo.append(os.str());
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -23,7 +23,7 @@ bool ScreenInfo::Marshalling(Parcel &parcel) const
         parcel.WriteFloat(virtualPixelRatio_) && parcel.WriteUint64(parent_) &&
         parcel.WriteBool(isScreenGroup_) && parcel.WriteUint32(static_cast<uint32_t>(rotation_)) &&
         parcel.WriteUint32(static_cast<uint32_t>(orientation_)) &&
-        parcel.WriteUint32(static_cast<uint32_t>(type_)) &&
+        parcel.WriteUint32(static_cast<uint32_t>(type_)) && parcel.WriteUint32(version_) &&
         parcel.WriteUint32(modeId_) && parcel.WriteUint32(static_cast<uint32_t>(modes_.size()));
     if (!res) {
         return false;
@@ -64,7 +64,7 @@ bool ScreenInfo::InnerUnmarshalling(Parcel& parcel)
         parcel.ReadUint32(virtualWidth_) && parcel.ReadUint32(virtualHeight_) &&
         parcel.ReadFloat(virtualPixelRatio_) && parcel.ReadUint64(parent_) &&
         parcel.ReadBool(isScreenGroup_) && parcel.ReadUint32(rotation) &&
-        parcel.ReadUint32(orientation) && parcel.ReadUint32(type) &&
+        parcel.ReadUint32(orientation) && parcel.ReadUint32(type) && parcel.ReadUint32(version_) &&
         parcel.ReadUint32(modeId_) && parcel.ReadUint32(size);
     if (!res1) {
         return false;
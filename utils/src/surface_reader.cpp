@@ -1,158 +1,300 @@
-/*
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
- * Licensed under the Apache License, Version 2.0 (the "License");
- * you may not use this file except in compliance with the License.
- * You may obtain a copy of the License at
- *
- *     http://www.apache.org/licenses/LICENSE-2.0
- *
- * Unless required by applicable law or agreed to in writing, software
- * distributed under the License is distributed on an "AS IS" BASIS,
- * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
- * See the License for the specific language governing permissions and
- * limitations under the License.
- */
-
-#include "surface_reader.h"
-#include "window_manager_hilog.h"
-#include "unique_fd.h"
-
-#include <securec.h>
-
-using namespace OHOS::Media;
-
-namespace OHOS {
-namespace Rosen {
-namespace {
-    constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_DISPLAY, "SurfaceReader"};
-} // namespace
-const int BPP = 4; // bytes per pixel
-
-SurfaceReader::SurfaceReader()
-{
-}
-
-SurfaceReader::~SurfaceReader()
-{
-    if (csurface_ != nullptr) {
-        csurface_->UnregisterConsumerListener();
-    }
-    psurface_ = nullptr;
-    csurface_ = nullptr;
-}
-
-bool SurfaceReader::Init()
-{
-    csurface_ = Surface::CreateSurfaceAsConsumer();
-    if (csurface_ == nullptr) {
-        return false;
-    }
-
-    auto producer = csurface_->GetProducer();
-    psurface_ = Surface::CreateSurfaceAsProducer(producer);
-    if (psurface_ == nullptr) {
-        return false;
-    }
-
-    listener_ = new BufferListener(*this);
-    SurfaceError ret = csurface_->RegisterConsumerListener(listener_);
-    if (ret != SURFACE_ERROR_OK) {
-        return false;
-    }
-    return true;
-}
-
-void SurfaceReader::OnVsync()
-{
-    WLOGFI("SurfaceReader::OnVsync");
-
-    sptr<SurfaceBuffer> cbuffer = nullptr;
-    int32_t fence = -1;
-    int64_t timestamp = 0;
-    Rect damage;
-    auto sret = csurface_->AcquireBuffer(cbuffer, fence, timestamp, damage);
-    if (cbuffer == nullptr || sret != OHOS::SURFACE_ERROR_OK) {
-        WLOGFE("SurfaceReader::OnVsync: surface buffer is null");
-        return;
-    }
-
-    if (!ProcessBuffer(cbuffer)) {
-        WLOGFE("SurfaceReader::OnVsync: ProcessBuffer failed");
-        return;
-    }
-
-    if (cbuffer != prevBuffer_) {
-        if (prevBuffer_ != nullptr) {
-            SurfaceError ret = csurface_->ReleaseBuffer(prevBuffer_, -1);
-            if (ret != SURFACE_ERROR_OK) {
-                WLOGFE("SurfaceReader::OnVsync: release buffer error");
-                return;
-            }
-        }
-
-        prevBuffer_ = cbuffer;
-    }
-}
-
-sptr<Surface> SurfaceReader::GetSurface() const
-{
-    return psurface_;
-}
-
-void SurfaceReader::SetHandler(sptr<SurfaceReaderHandler> handler)
-{
-    handler_ = handler;
-}
-
-bool SurfaceReader::ProcessBuffer(const sptr<SurfaceBuffer> &buf)
-{
-    if (handler_ == nullptr) {
-        WLOGFE("SurfaceReaderHandler not set");
-        return false;
-    }
-
-    BufferHandle *bufferHandle =  buf->GetBufferHandle();
-    if (bufferHandle == nullptr) {
-        WLOGFE("bufferHandle nullptr");
-        return false;
-    }
-
-    uint32_t width = static_cast<uint32_t>(bufferHandle->width);
-    uint32_t height = static_cast<uint32_t>(bufferHandle->height);
-    uint32_t stride = static_cast<uint32_t>(bufferHandle->stride);
-    uint8_t *addr = (uint8_t *)buf->GetVirAddr();
-
-    auto data = (uint8_t *)malloc(width * height * BPP);
-    if (data == nullptr) {
-        WLOGFE("data malloc failed");
-        return false;
-    }
-    for (uint32_t i = 0; i < height; i++) {
-        errno_t ret = memcpy_s(data + width * i * BPP,  width * BPP, addr + stride * i, width * BPP);
-        if (ret != EOK) {
-            WLOGFE("memcpy failed");
-            free(data);
-            return false;
-        }
-    }
-
-    sptr<PixelMap> pixelMap = new(std::nothrow) PixelMap();
-    if (pixelMap == nullptr) {
-        WLOGFE("create pixelMap failed");
-        return false;
-    }
-
-    ImageInfo info;
-    info.size.width = static_cast<int32_t>(width);
-    info.size.height = static_cast<int32_t>(height);
-    info.pixelFormat = OHOS::Media::PixelFormat::RGBA_8888;
-    info.colorSpace = ColorSpace::SRGB;
-    pixelMap->SetImageInfo(info);
-
-    pixelMap->SetPixelsAddr(data, nullptr, width * height, AllocatorType::HEAP_ALLOC, nullptr);
-
-    handler_->OnImageAvalible(pixelMap);
-    return true;
-}
-}
+/*
+ * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "surface_reader.h"
+#include "window_manager_hilog.h"
+#include "unique_fd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_DISPLAY, "SurfaceReader"};
+    constexpr uint32_t CHANGE_DETECTION_TILE_SIZE = 64;
+    constexpr int64_t NS_PER_MILLISECOND = 1000000;
+    const std::string TRAILING_FRAME_THREAD_ID = "surface_reader_trailing_frame";
+    const std::string TRAILING_FRAME_TASK = "TrailingFrameTask";
+
+    int64_t GetCurrentTimeNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    Rect UnionRect(const Rect& lhs, const Rect& rhs)
+    {
+        if (lhs.width_ == 0 || lhs.height_ == 0) {
+            return rhs;
+        }
+        if (rhs.width_ == 0 || rhs.height_ == 0) {
+            return lhs;
+        }
+        int64_t left = std::min(lhs.posX_, rhs.posX_);
+        int64_t top = std::min(lhs.posY_, rhs.posY_);
+        int64_t right = std::max(static_cast<int64_t>(lhs.posX_) + lhs.width_,
+            static_cast<int64_t>(rhs.posX_) + rhs.width_);
+        int64_t bottom = std::max(static_cast<int64_t>(lhs.posY_) + lhs.height_,
+            static_cast<int64_t>(rhs.posY_) + rhs.height_);
+        return { static_cast<int32_t>(left), static_cast<int32_t>(top), static_cast<uint32_t>(right - left),
+            static_cast<uint32_t>(bottom - top) };
+    }
+
+    // producers report no damage or damage outside the buffer when they do not track it
+    Rect ClipDamage(const OHOS::Rect& damage, uint32_t width, uint32_t height)
+    {
+        int64_t left = std::max(damage.x, 0);
+        int64_t top = std::max(damage.y, 0);
+        int64_t right = std::min(static_cast<int64_t>(damage.x) + damage.w, static_cast<int64_t>(width));
+        int64_t bottom = std::min(static_cast<int64_t>(damage.y) + damage.h, static_cast<int64_t>(height));
+        if (damage.w <= 0 || damage.h <= 0 || right <= left || bottom <= top) {
+            return { 0, 0, width, height };
+        }
+        return { static_cast<int32_t>(left), static_cast<int32_t>(top), static_cast<uint32_t>(right - left),
+            static_cast<uint32_t>(bottom - top) };
+    }
+} // namespace
+const int BPP = 4; // bytes per pixel
+constexpr int64_t NS_PER_SECOND = 1000000000;
+
+SurfaceReader::SurfaceReader()
+{
+}
+
+SurfaceReader::~SurfaceReader()
+{
+    if (csurface_ != nullptr) {
+        csurface_->UnregisterConsumerListener();
+    }
+    if (trailingFrameHandler_ != nullptr) {
+        trailingFrameHandler_->RemoveAllEvents();
+        // RemoveAllEvents and Stop do not wait for a trailing frame already being delivered, the runner runs its
+        // tasks in order, so once this empty task is done no task touches the reader anymore
+        trailingFrameHandler_->PostSyncTask([]() {}, AppExecFwk::EventQueue::Priority::IMMEDIATE);
+        auto runner = trailingFrameHandler_->GetEventRunner();
+        if (runner != nullptr) {
+            runner->Stop();
+        }
+        trailingFrameHandler_ = nullptr;
+    }
+    psurface_ = nullptr;
+    csurface_ = nullptr;
+}
+
+bool SurfaceReader::Init()
+{
+    csurface_ = Surface::CreateSurfaceAsConsumer();
+    if (csurface_ == nullptr) {
+        return false;
+    }
+
+    auto producer = csurface_->GetProducer();
+    psurface_ = Surface::CreateSurfaceAsProducer(producer);
+    if (psurface_ == nullptr) {
+        return false;
+    }
+
+    listener_ = new BufferListener(*this);
+    SurfaceError ret = csurface_->RegisterConsumerListener(listener_);
+    if (ret != SURFACE_ERROR_OK) {
+        return false;
+    }
+    return true;
+}
+
+void SurfaceReader::OnVsync()
+{
+    WLOGFI("SurfaceReader::OnVsync");
+
+    sptr<SurfaceBuffer> cbuffer = nullptr;
+    int32_t fence = -1;
+    int64_t timestamp = 0;
+    OHOS::Rect damage;
+    auto sret = csurface_->AcquireBuffer(cbuffer, fence, timestamp, damage);
+    if (cbuffer == nullptr || sret != OHOS::SURFACE_ERROR_OK) {
+        WLOGFE("SurfaceReader::OnVsync: surface buffer is null");
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    BufferHandle *bufferHandle = cbuffer->GetBufferHandle();
+    if (bufferHandle != nullptr) {
+        // damage of dropped frames is carried to the next delivered one
+        pendingDamage_ = UnionRect(pendingDamage_, ClipDamage(damage, static_cast<uint32_t>(bufferHandle->width),
+            static_cast<uint32_t>(bufferHandle->height)));
+    }
+
+    int64_t remainingNs = 0;
+    if (ShouldDropFrame(remainingNs)) {
+        // only the newest dropped frame is kept, it is delivered at the end of the interval unless a newer one
+        // is delivered first, so the content shown before the producer goes idle is never lost
+        ReleaseBufferLocked(droppedBuffer_);
+        droppedBuffer_ = cbuffer;
+        ScheduleTrailingFrameLocked(remainingNs);
+        return;
+    }
+    ReleaseBufferLocked(droppedBuffer_);
+    droppedBuffer_ = nullptr;
+    DeliverBufferLocked(cbuffer);
+}
+
+void SurfaceReader::OnTrailingFrame()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (droppedBuffer_ == nullptr) {
+        return;
+    }
+    sptr<SurfaceBuffer> buffer = droppedBuffer_;
+    droppedBuffer_ = nullptr;
+    lastFrameTimeNs_ = GetCurrentTimeNs();
+    DeliverBufferLocked(buffer);
+}
+
+void SurfaceReader::DeliverBufferLocked(const sptr<SurfaceBuffer>& buffer)
+{
+    Rect frameDamage = pendingDamage_;
+    pendingDamage_ = { 0, 0, 0, 0 };
+    if (!ProcessBuffer(buffer, frameDamage)) {
+        WLOGFE("SurfaceReader::OnVsync: ProcessBuffer failed");
+        // the handler did not take the frame, its damage is still owed to the next one
+        pendingDamage_ = frameDamage;
+        ReleaseBufferLocked(buffer);
+        return;
+    }
+
+    if (buffer != prevBuffer_) {
+        if (prevBuffer_ != nullptr) {
+            SurfaceError ret = csurface_->ReleaseBuffer(prevBuffer_, -1);
+            if (ret != SURFACE_ERROR_OK) {
+                WLOGFE("SurfaceReader::OnVsync: release buffer error");
+                return;
+            }
+        }
+
+        prevBuffer_ = buffer;
+    }
+}
+
+void SurfaceReader::ReleaseBufferLocked(const sptr<SurfaceBuffer>& buffer)
+{
+    // the last delivered buffer stays acquired, it is released once a newer one is delivered
+    if (buffer == nullptr || buffer == prevBuffer_) {
+        return;
+    }
+    sptr<SurfaceBuffer> releaseBuffer = buffer;
+    if (csurface_->ReleaseBuffer(releaseBuffer, -1) != SURFACE_ERROR_OK) {
+        WLOGFE("SurfaceReader::OnVsync: release buffer error");
+    }
+}
+
+void SurfaceReader::ScheduleTrailingFrameLocked(int64_t delayNs)
+{
+    if (trailingFrameHandler_ == nullptr) {
+        trailingFrameHandler_ = std::make_shared<AppExecFwk::EventHandler>(
+            AppExecFwk::EventRunner::Create(TRAILING_FRAME_THREAD_ID));
+    }
+    // the interval end does not move, a newer dropped frame just replaces the buffer the task delivers
+    trailingFrameHandler_->RemoveTask(TRAILING_FRAME_TASK);
+    int64_t delayMs = (delayNs + NS_PER_MILLISECOND - 1) / NS_PER_MILLISECOND;
+    trailingFrameHandler_->PostTask([this]() { OnTrailingFrame(); }, TRAILING_FRAME_TASK, delayMs);
+}
+
+sptr<Surface> SurfaceReader::GetSurface() const
+{
+    return psurface_;
+}
+
+void SurfaceReader::SetHandler(sptr<SurfaceReaderHandler> handler)
+{
+    handler_ = handler;
+}
+
+void SurfaceReader::SetFrameRate(uint32_t frameRate)
+{
+    frameIntervalNs_ = frameRate == 0 ? 0 : NS_PER_SECOND / frameRate;
+}
+
+bool SurfaceReader::ShouldDropFrame(int64_t& remainingNs)
+{
+    remainingNs = 0;
+    int64_t intervalNs = frameIntervalNs_.load();
+    if (intervalNs == 0) {
+        return false;
+    }
+    int64_t now = GetCurrentTimeNs();
+    if (lastFrameTimeNs_ != 0 && now - lastFrameTimeNs_ < intervalNs) {
+        remainingNs = intervalNs - (now - lastFrameTimeNs_);
+        return true;
+    }
+    lastFrameTimeNs_ = now;
+    return false;
+}
+
+void SurfaceReader::SetChangeDetectionEnabled(bool enabled)
+{
+    // the detector itself is created and dropped by the consumer thread on its next frame
+    changeDetectionEnabled_ = enabled;
+}
+
+bool SurfaceReader::ProcessBuffer(const sptr<SurfaceBuffer> &buf, const Rect& damage)
+{
+    if (handler_ == nullptr) {
+        WLOGFE("SurfaceReaderHandler not set");
+        return false;
+    }
+
+    BufferHandle *bufferHandle =  buf->GetBufferHandle();
+    if (bufferHandle == nullptr) {
+        WLOGFE("bufferHandle nullptr");
+        return false;
+    }
+
+    SurfaceReaderFrame frame = {
+        .addr_ = static_cast<const uint8_t*>(buf->GetVirAddr()),
+        .width_ = static_cast<uint32_t>(bufferHandle->width),
+        .height_ = static_cast<uint32_t>(bufferHandle->height),
+        .stride_ = static_cast<uint32_t>(bufferHandle->stride),
+        .damage_ = damage,
+    };
+    return ProcessFrame(frame);
+}
+
+bool SurfaceReader::ProcessFrame(SurfaceReaderFrame& frame)
+{
+    if (!changeDetectionEnabled_.load()) {
+        changeDetector_ = nullptr;
+    } else if (changeDetector_ == nullptr) {
+        changeDetector_ = std::make_unique<TileChangeDetector>(CHANGE_DETECTION_TILE_SIZE, BPP);
+    }
+    if (changeDetector_ != nullptr) {
+        frame.damage_ = changeDetector_->Detect(frame.addr_, frame.width_, frame.height_, frame.stride_,
+            frame.damage_);
+        if (frame.damage_.width_ == 0 || frame.damage_.height_ == 0) {
+            WLOGFD("SurfaceReader: frame unchanged, skip");
+            return true;
+        }
+    }
+    if (!handler_->OnFrameAvailable(frame)) {
+        return false;
+    }
+    if (changeDetector_ != nullptr) {
+        // only a delivered frame becomes the reference, otherwise its changes would never reach the handler
+        changeDetector_->Commit();
+    }
+    return true;
+}
+}
 }
\ No newline at end of file
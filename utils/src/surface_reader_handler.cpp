@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "surface_reader_handler.h"
+
+#include <securec.h>
+
+#include "window_manager_hilog.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_DISPLAY, "SurfaceReaderHandler"};
+    constexpr uint32_t BPP = 4; // bytes per pixel
+}
+
+bool SurfaceReaderHandler::CopyRegion(const SurfaceReaderFrame& frame, const Rect& region, uint8_t* dst,
+    uint32_t dstStride)
+{
+    if (frame.addr_ == nullptr || dst == nullptr || region.posX_ < 0 || region.posY_ < 0 ||
+        region.posX_ + region.width_ > frame.width_ || region.posY_ + region.height_ > frame.height_) {
+        WLOGFE("invalid region [%{public}d, %{public}d, %{public}u, %{public}u]",
+            region.posX_, region.posY_, region.width_, region.height_);
+        return false;
+    }
+    size_t rowBytes = static_cast<size_t>(region.width_) * BPP;
+    for (uint32_t i = 0; i < region.height_; i++) {
+        size_t row = static_cast<size_t>(region.posY_) + i;
+        size_t offset = static_cast<size_t>(region.posX_) * BPP;
+        if (memcpy_s(dst + row * dstStride + offset, rowBytes, frame.addr_ + row * frame.stride_ + offset,
+            rowBytes) != EOK) {
+            WLOGFE("memcpy failed");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SurfaceReaderHandler::OnFrameAvailable(const SurfaceReaderFrame& frame)
+{
+    uint32_t dstStride = frame.width_ * BPP;
+    auto data = static_cast<uint8_t*>(malloc(static_cast<size_t>(dstStride) * frame.height_));
+    if (data == nullptr) {
+        WLOGFE("data malloc failed");
+        return false;
+    }
+    Rect wholeFrame = { 0, 0, frame.width_, frame.height_ };
+    if (!CopyRegion(frame, wholeFrame, data, dstStride)) {
+        free(data);
+        return false;
+    }
+
+    sptr<Media::PixelMap> pixelMap = new(std::nothrow) Media::PixelMap();
+    if (pixelMap == nullptr) {
+        WLOGFE("create pixelMap failed");
+        free(data);
+        return false;
+    }
+    Media::ImageInfo info;
+    info.size.width = static_cast<int32_t>(frame.width_);
+    info.size.height = static_cast<int32_t>(frame.height_);
+    info.pixelFormat = Media::PixelFormat::RGBA_8888;
+    info.colorSpace = Media::ColorSpace::SRGB;
+    pixelMap->SetImageInfo(info);
+    pixelMap->SetPixelsAddr(data, nullptr, frame.width_ * frame.height_, Media::AllocatorType::HEAP_ALLOC, nullptr);
+    return OnImageAvalible(pixelMap);
+}
+} // namespace Rosen
+} // namespace OHOS
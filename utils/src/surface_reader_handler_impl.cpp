@@ -20,6 +20,7 @@ namespace OHOS {
 namespace Rosen {
 namespace {
     constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_DISPLAY, "SurfaceReaderHandlerImpl"};
+    constexpr uint32_t BPP = 4; // bytes per pixel
 } // namespace
 bool SurfaceReaderHandlerImpl::OnImageAvalible(sptr<Media::PixelMap> pixleMap)
 {
@@ -32,6 +33,36 @@ bool SurfaceReaderHandlerImpl::OnImageAvalible(sptr<Media::PixelMap> pixleMap)
     return true;
 }
 
+bool SurfaceReaderHandlerImpl::OnFrameAvailable(const SurfaceReaderFrame& frame)
+{
+    uint32_t stride = frame.width_ * BPP;
+    Rect wholeFrame = { 0, 0, frame.width_, frame.height_ };
+    if (frame.width_ != width_ || frame.height_ != height_) {
+        content_.assign(static_cast<size_t>(stride) * frame.height_, 0);
+        width_ = frame.width_;
+        height_ = frame.height_;
+        if (!CopyRegion(frame, wholeFrame, content_.data(), stride)) {
+            width_ = 0;
+            height_ = 0;
+            return false;
+        }
+    } else if (!CopyRegion(frame, frame.damage_, content_.data(), stride)) {
+        return false;
+    }
+    if (IsImageOk()) {
+        WLOGFD("last image not taken yet, only the content is updated");
+        return true;
+    }
+    SurfaceReaderFrame content = {
+        .addr_ = content_.data(),
+        .width_ = width_,
+        .height_ = height_,
+        .stride_ = stride,
+        .damage_ = wholeFrame,
+    };
+    return SurfaceReaderHandler::OnFrameAvailable(content);
+}
+
 bool SurfaceReaderHandlerImpl::IsImageOk()
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tile_change_detector.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+}
+
+TileChangeDetector::TileChangeDetector(uint32_t tileSize, uint32_t bytesPerPixel)
+    : tileSize_(tileSize == 0 ? 1 : tileSize), bytesPerPixel_(bytesPerPixel)
+{
+}
+
+void TileChangeDetector::Reset()
+{
+    width_ = 0;
+    height_ = 0;
+    columns_ = 0;
+    rows_ = 0;
+    tileHashes_.clear();
+    pendingWidth_ = 0;
+    pendingHeight_ = 0;
+    pendingTileHashes_.clear();
+}
+
+void TileChangeDetector::Commit()
+{
+    if (pendingWidth_ != width_ || pendingHeight_ != height_) {
+        width_ = pendingWidth_;
+        height_ = pendingHeight_;
+        columns_ = (width_ + tileSize_ - 1) / tileSize_;
+        rows_ = (height_ + tileSize_ - 1) / tileSize_;
+        tileHashes_.assign(static_cast<size_t>(columns_) * rows_, 0);
+    }
+    for (auto& [index, hash] : pendingTileHashes_) {
+        tileHashes_[index] = hash;
+    }
+    pendingTileHashes_.clear();
+}
+
+Rect TileChangeDetector::Detect(const uint8_t* addr, uint32_t width, uint32_t height, uint32_t stride,
+    const Rect& damage)
+{
+    Rect changed = { 0, 0, 0, 0 };
+    pendingTileHashes_.clear();
+    if (addr == nullptr || width == 0 || height == 0) {
+        return changed;
+    }
+    // nothing is stored before Commit, a frame the consumer did not take is compared again with the next one
+    pendingWidth_ = width;
+    pendingHeight_ = height;
+    bool sizeChanged = (width != width_ || height != height_);
+    uint32_t columns = (width + tileSize_ - 1) / tileSize_;
+    uint32_t rows = (height + tileSize_ - 1) / tileSize_;
+
+    // tiles outside the damage keep their hash, after a size change every tile is new
+    int64_t left = sizeChanged ? 0 : std::max<int64_t>(damage.posX_, 0);
+    int64_t top = sizeChanged ? 0 : std::max<int64_t>(damage.posY_, 0);
+    int64_t right = sizeChanged ? width : std::min<int64_t>(static_cast<int64_t>(damage.posX_) + damage.width_, width);
+    int64_t bottom = sizeChanged ? height :
+        std::min<int64_t>(static_cast<int64_t>(damage.posY_) + damage.height_, height);
+    if (right <= left || bottom <= top) {
+        return changed;
+    }
+
+    uint32_t minColumn = columns;
+    uint32_t maxColumn = 0;
+    uint32_t minRow = rows;
+    uint32_t maxRow = 0;
+    for (uint32_t row = static_cast<uint32_t>(top) / tileSize_; row <= (bottom - 1) / tileSize_; row++) {
+        for (uint32_t column = static_cast<uint32_t>(left) / tileSize_; column <= (right - 1) / tileSize_; column++) {
+            uint64_t hash = HashTile(addr, width, height, stride, column, row);
+            size_t index = static_cast<size_t>(row) * columns + column;
+            if (!sizeChanged && hash == tileHashes_[index]) {
+                continue;
+            }
+            pendingTileHashes_.emplace_back(index, hash);
+            minColumn = std::min(minColumn, column);
+            maxColumn = std::max(maxColumn, column);
+            minRow = std::min(minRow, row);
+            maxRow = std::max(maxRow, row);
+        }
+    }
+    if (minColumn > maxColumn || minRow > maxRow) {
+        return changed;
+    }
+    changed.posX_ = static_cast<int32_t>(minColumn * tileSize_);
+    changed.posY_ = static_cast<int32_t>(minRow * tileSize_);
+    changed.width_ = std::min((maxColumn + 1) * tileSize_, width) - minColumn * tileSize_;
+    changed.height_ = std::min((maxRow + 1) * tileSize_, height) - minRow * tileSize_;
+    return changed;
+}
+
+uint64_t TileChangeDetector::HashTile(const uint8_t* addr, uint32_t width, uint32_t height, uint32_t stride,
+    uint32_t column, uint32_t row) const
+{
+    uint32_t startX = column * tileSize_;
+    uint32_t startY = row * tileSize_;
+    size_t rowBytes = static_cast<size_t>(std::min(tileSize_, width - startX)) * bytesPerPixel_;
+    uint32_t tileHeight = std::min(tileSize_, height - startY);
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (uint32_t y = 0; y < tileHeight; y++) {
+        const uint8_t* line = addr + static_cast<size_t>(startY + y) * stride +
+            static_cast<size_t>(startX) * bytesPerPixel_;
+        size_t i = 0;
+        for (; i + sizeof(uint64_t) <= rowBytes; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, line + i, sizeof(word));
+            hash = (hash ^ word) * FNV_PRIME;
+        }
+        for (; i < rowBytes; i++) {
+            hash = (hash ^ line[i]) * FNV_PRIME;
+        }
+    }
+    return hash;
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_state_page.h"
+
+#include <cstring>
+#include <thread>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr uint32_t MAX_READ_RETRY_TIMES = 16;
+}
+
+void InitWindowStatePage(WindowStatePage& page)
+{
+    page.magic_ = WINDOW_STATE_PAGE_MAGIC;
+    page.version_ = WINDOW_STATE_PAGE_VERSION;
+    page.reserved_ = 0;
+    page.snapshotSize_ = static_cast<uint32_t>(sizeof(WindowStateSnapshot));
+    std::memset(&page.snapshot_, 0, sizeof(page.snapshot_));
+    page.sequence_.store(0, std::memory_order_release);
+}
+
+void WriteWindowStatePage(WindowStatePage& page, const WindowStateSnapshot& snapshot)
+{
+    uint32_t sequence = page.sequence_.load(std::memory_order_relaxed);
+    page.sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&page.snapshot_, &snapshot, sizeof(snapshot));
+    page.sequence_.store(sequence + 2, std::memory_order_release); // even again, the snapshot is consistent
+}
+
+bool ReadWindowStatePage(const WindowStatePage& page, WindowStateSnapshot& snapshot)
+{
+    if (page.magic_ != WINDOW_STATE_PAGE_MAGIC || page.version_ != WINDOW_STATE_PAGE_VERSION ||
+        page.snapshotSize_ != sizeof(WindowStateSnapshot)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < MAX_READ_RETRY_TIMES; i++) {
+        uint32_t begin = page.sequence_.load(std::memory_order_acquire);
+        if ((begin & 1) != 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::memcpy(&snapshot, &page.snapshot_, sizeof(snapshot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (page.sequence_.load(std::memory_order_relaxed) == begin) {
+            return snapshot.displayCount_ <= WINDOW_STATE_MAX_DISPLAY_NUM &&
+                snapshot.topWindowCount_ <= WINDOW_STATE_MAX_TOP_WINDOW_NUM;
+        }
+    }
+    return false;
+}
+
+bool FindTopWindowId(const WindowStateSnapshot& snapshot, uint32_t mainWinId, uint32_t& topWinId)
+{
+    for (uint32_t i = 0; i < snapshot.topWindowCount_; i++) {
+        if (snapshot.topWindows_[i].mainWindowId_ == mainWinId) {
+            topWinId = snapshot.topWindows_[i].topWindowId_;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FindFocusWindowId(const WindowStateSnapshot& snapshot, uint64_t displayId, uint32_t& focusWinId)
+{
+    for (uint32_t i = 0; i < snapshot.displayCount_; i++) {
+        if (snapshot.displays_[i].displayId_ == displayId) {
+            focusWinId = snapshot.displays_[i].focusedWindowId_;
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace Rosen
+} // namespace OHOS
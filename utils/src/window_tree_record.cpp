@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_tree_record.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    const char* const REASON_NAMES[] = {
+        "AddWindow",
+        "UpdateWindow",
+        "RemoveWindow",
+        "RaiseZOrder",
+        "SwitchLayout",
+        "Reorder",
+        "FocusFault",
+    };
+}
+
+const char* WindowTreeChangeReasonToString(uint16_t reason)
+{
+    if (reason >= static_cast<uint16_t>(WindowTreeChangeReason::REASON_END)) {
+        return "Unknown";
+    }
+    return REASON_NAMES[reason];
+}
+
+WindowTreeRecordBuffer::WindowTreeRecordBuffer(uint32_t capacity) : slots_(capacity == 0 ? 1 : capacity)
+{
+}
+
+uint32_t WindowTreeRecordBuffer::Record(WindowTreeChangeReason reason, const std::vector<WindowTreeNodeRecord>& nodes)
+{
+    WindowTreeRecordHeader header;
+    header.magic_ = WINDOW_TREE_RECORD_MAGIC;
+    header.version_ = WINDOW_TREE_RECORD_VERSION;
+    header.reason_ = static_cast<uint16_t>(reason);
+    header.nodeCount_ = static_cast<uint32_t>(nodes.size());
+    header.timestampMs_ = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    size_t nodesSize = nodes.size() * sizeof(WindowTreeNodeRecord);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    header.seq_ = nextSeq_++;
+    std::vector<uint8_t>& slot = slots_[header.seq_ % slots_.size()];
+    slot.resize(sizeof(header) + nodesSize);
+    std::memcpy(slot.data(), &header, sizeof(header));
+    if (nodesSize != 0) {
+        std::memcpy(slot.data() + sizeof(header), nodes.data(), nodesSize);
+    }
+    if (recordCount_ < slots_.size()) {
+        recordCount_++;
+    }
+    return header.seq_;
+}
+
+std::vector<WindowTreeSnapshot> WindowTreeRecordBuffer::GetSnapshots() const
+{
+    std::vector<uint8_t> data = Serialize();
+    std::vector<WindowTreeSnapshot> snapshots;
+    Deserialize(data.data(), data.size(), snapshots);
+    return snapshots;
+}
+
+std::vector<uint8_t> WindowTreeRecordBuffer::Serialize() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t totalSize = sizeof(WindowTreeFileHeader);
+    uint32_t firstSeq = nextSeq_ - recordCount_;
+    for (uint32_t i = 0; i < recordCount_; i++) {
+        totalSize += slots_[(firstSeq + i) % slots_.size()].size();
+    }
+    std::vector<uint8_t> data(totalSize);
+    WindowTreeFileHeader fileHeader = { WINDOW_TREE_FILE_MAGIC, WINDOW_TREE_RECORD_VERSION, 0, recordCount_,
+        static_cast<uint32_t>(sizeof(WindowTreeNodeRecord)) };
+    std::memcpy(data.data(), &fileHeader, sizeof(fileHeader));
+    size_t offset = sizeof(fileHeader);
+    for (uint32_t i = 0; i < recordCount_; i++) {
+        const std::vector<uint8_t>& slot = slots_[(firstSeq + i) % slots_.size()];
+        std::memcpy(data.data() + offset, slot.data(), slot.size());
+        offset += slot.size();
+    }
+    return data;
+}
+
+void WindowTreeRecordBuffer::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    recordCount_ = 0;
+}
+
+bool WindowTreeRecordBuffer::Deserialize(const uint8_t* data, size_t size, std::vector<WindowTreeSnapshot>& snapshots)
+{
+    WindowTreeFileHeader fileHeader;
+    if (data == nullptr || size < sizeof(fileHeader)) {
+        return false;
+    }
+    std::memcpy(&fileHeader, data, sizeof(fileHeader));
+    if (fileHeader.magic_ != WINDOW_TREE_FILE_MAGIC || fileHeader.version_ != WINDOW_TREE_RECORD_VERSION ||
+        fileHeader.nodeRecordSize_ != sizeof(WindowTreeNodeRecord)) {
+        return false;
+    }
+    size_t offset = sizeof(fileHeader);
+    for (uint32_t i = 0; i < fileHeader.recordCount_; i++) {
+        WindowTreeSnapshot snapshot;
+        if (size - offset < sizeof(snapshot.header_)) {
+            return false;
+        }
+        std::memcpy(&snapshot.header_, data + offset, sizeof(snapshot.header_));
+        offset += sizeof(snapshot.header_);
+        if (snapshot.header_.magic_ != WINDOW_TREE_RECORD_MAGIC ||
+            (size - offset) / sizeof(WindowTreeNodeRecord) < snapshot.header_.nodeCount_) {
+            return false;
+        }
+        snapshot.nodes_.resize(snapshot.header_.nodeCount_);
+        size_t nodesSize = snapshot.header_.nodeCount_ * sizeof(WindowTreeNodeRecord);
+        if (nodesSize != 0) {
+            std::memcpy(snapshot.nodes_.data(), data + offset, nodesSize);
+        }
+        offset += nodesSize;
+        snapshots.push_back(std::move(snapshot));
+    }
+    return true;
+}
+} // namespace Rosen
+} // namespace OHOS
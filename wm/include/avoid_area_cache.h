@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_AVOID_AREA_CACHE_H
+#define OHOS_ROSEN_AVOID_AREA_CACHE_H
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "wm_common.h"
+#include "wm_common_inner.h"
+#include "wm_single_instance.h"
+
+namespace OHOS {
+namespace Rosen {
+/*
+ * Per display copy of the avoid areas and mode change hot zones answered by WMS. Avoid areas are kept current by
+ * the UpdateAvoidArea pushes that shown app main windows receive, so they are only cached while such a window is
+ * shown; every push or invalidation bumps the display version, and a server answer fetched under an older version
+ * is not stored. Hot zones only depend on the display size and the WMS configuration.
+ */
+class AvoidAreaCache {
+WM_DECLARE_SINGLE_INSTANCE(AvoidAreaCache);
+public:
+    uint64_t GetVersion(DisplayId displayId);
+    bool GetAvoidArea(DisplayId displayId, AvoidAreaType type, std::vector<Rect>& avoidArea);
+    void SetAvoidArea(DisplayId displayId, AvoidAreaType type, const std::vector<Rect>& avoidArea, uint64_t version);
+    void OnSystemAvoidAreaChanged(DisplayId displayId, const std::vector<Rect>& avoidArea);
+    void Invalidate(DisplayId displayId);
+    bool GetHotZones(DisplayId displayId, uint32_t displayWidth, uint32_t displayHeight, ModeChangeHotZones& hotZones);
+    void SetHotZones(DisplayId displayId, uint32_t displayWidth, uint32_t displayHeight,
+        const ModeChangeHotZones& hotZones);
+
+private:
+    struct DisplayEntry {
+        uint64_t version_ = 0;
+        std::map<AvoidAreaType, std::vector<Rect>> avoidAreas_;
+        bool hasHotZones_ = false;
+        uint32_t hotZonesDisplayWidth_ = 0;
+        uint32_t hotZonesDisplayHeight_ = 0;
+        ModeChangeHotZones hotZones_;
+    };
+
+    std::mutex mutex_;
+    std::map<DisplayId, DisplayEntry> entries_;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_AVOID_AREA_CACHE_H
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_INPUT_LATENCY_TRACKER_H
+#define OHOS_ROSEN_INPUT_LATENCY_TRACKER_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "perf_histogram.h"
+
+namespace OHOS {
+namespace Rosen {
+/*
+ * Follows the pointer events of one window from their arrival in the process to the end of the frame that
+ * consumed them, and aggregates the time spent in each stage. Move events coalesced by vsync batching are dropped
+ * when a newer event of the batch is dispatched, so every frame accounts for the event it actually drew.
+ * A frame only stamps its end time; the records are matched to their frames later by FlushFrames, off the
+ * critical part of the vsync.
+ */
+class InputLatencyTracker {
+public:
+    enum class Stage : uint32_t {
+        RECEIVE = 0, // event action time to the input listener of the process
+        BATCH, // input listener to dispatch into the window, includes waiting for vsync
+        CONSUME, // window and ACE handling of the event
+        FRAME, // end of handling to the end of the next frame callback
+        TOTAL, // event action time to the end of the frame
+        STAGE_END,
+    };
+
+    InputLatencyTracker() = default;
+    ~InputLatencyTracker() = default;
+
+    void OnEventReceived(int32_t eventId, int64_t actionTimeUs);
+    void OnEventDispatched(int32_t eventId);
+    void OnEventConsumed(int32_t eventId);
+    // returns true when FlushFrames has records to account
+    bool OnFrame();
+    void FlushFrames();
+    PerfHistogramSnapshot GetSnapshot(Stage stage) const;
+    void Dump(std::vector<std::string>& info) const;
+    void Reset();
+
+private:
+    struct Record {
+        int32_t eventId_;
+        uint64_t actionTimeUs_;
+        uint64_t receiveTimeUs_;
+        uint64_t dispatchTimeUs_;
+        uint64_t consumeTimeUs_;
+    };
+    static constexpr size_t STAGE_NUM = static_cast<size_t>(Stage::STAGE_END);
+    static constexpr size_t MAX_PENDING_EVENTS = 8;
+    static constexpr size_t MAX_PENDING_FRAMES = 4;
+
+    int32_t FindRecordLocked(int32_t eventId) const;
+    void EraseRecordsLocked(size_t begin, size_t end);
+    uint64_t GetFrameEndLocked(uint64_t timeUs) const;
+    void RecordCost(Stage stage, uint64_t beginUs, uint64_t endUs);
+
+    mutable std::mutex mutex_;
+    std::array<Record, MAX_PENDING_EVENTS> records_ {}; // oldest first
+    size_t recordCount_ = 0;
+    std::array<uint64_t, MAX_PENDING_FRAMES> frameEndTimesUs_ {}; // oldest first
+    size_t frameCount_ = 0;
+    std::array<PerfHistogram, STAGE_NUM> histograms_;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_INPUT_LATENCY_TRACKER_H
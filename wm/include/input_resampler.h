@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_INPUT_RESAMPLER_H
+#define OHOS_ROSEN_INPUT_RESAMPLER_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include <pointer_event.h>
+
+namespace OHOS {
+namespace Rosen {
+/*
+ * Keeps the recent positions of every touch pointer and moves the pointers of a batched move event to where they
+ * were, or are predicted to be, at frame time. Sampling slightly behind the vsync lets most frames interpolate
+ * between two real samples; extrapolation is bounded to avoid overshooting when the finger stops.
+ */
+class InputResampler {
+public:
+    InputResampler() = default;
+    ~InputResampler() = default;
+
+    void AddSample(const std::shared_ptr<MMI::PointerEvent>& pointerEvent);
+    void Resample(const std::shared_ptr<MMI::PointerEvent>& pointerEvent, int64_t frameTimeUs) const;
+    void ClearPointer(int32_t pointerId);
+    void Clear();
+
+private:
+    struct Sample {
+        int64_t timeUs_;
+        int32_t globalX_;
+        int32_t globalY_;
+        int32_t localX_;
+        int32_t localY_;
+    };
+    static constexpr size_t HISTORY_SIZE = 4;
+    struct PointerHistory {
+        std::array<Sample, HISTORY_SIZE> samples_; // ring buffer, samples_[newest_] is the latest one
+        size_t newest_ = 0;
+        size_t count_ = 0;
+
+        void Push(const Sample& sample);
+        const Sample& Get(size_t age) const; // age 0 is the latest sample
+    };
+    static bool ShouldResample(const std::shared_ptr<MMI::PointerEvent>& pointerEvent);
+    static bool ResamplePointer(const PointerHistory& history, int64_t sampleTimeUs, Sample& result);
+    static Sample Lerp(const Sample& from, const Sample& to, int64_t timeUs);
+
+    std::unordered_map<int32_t, PointerHistory> histories_;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_INPUT_RESAMPLER_H
@@ -16,6 +16,13 @@
 #ifndef OHOS_INPUT_TRANSFER_STATION
 #define OHOS_INPUT_TRANSFER_STATION
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <event_handler.h>
+
 #include "input_manager.h"
 #include "pointer_event.h"
 #include "window.h"
@@ -31,15 +38,31 @@ class InputTransferStation {
 WM_DECLARE_SINGLE_INSTANCE(InputTransferStation);
 friend class InputEventListener;
 public:
-    void AddInputWindow(const sptr<Window>& window);
+    void AddInputWindow(const sptr<Window>& window,
+        const std::shared_ptr<InputLatencyTracker>& latencyTracker = nullptr);
     void RemoveInputWindow(const sptr<Window>& window);
     void SetInputListener(uint32_t windowId, const std::shared_ptr<MMI::IInputEventConsumer>& listener);
+    // receive input on a dedicated thread instead of the main runner, must be set before the first input window;
+    // events of ACE windows still hop to the main runner when it is available
+    void SetInputThreadEnabled(bool enabled, bool isMainHandlerAvailable);
 
 private:
-    sptr<WindowInputChannel> GetInputChannel(uint32_t windowId);
+    using ChannelMap = std::unordered_map<uint32_t, sptr<WindowInputChannel>>;
+    sptr<WindowInputChannel> GetInputChannel(uint32_t windowId) const;
+    void InitInputListenerLocked();
+    std::shared_ptr<AppExecFwk::EventHandler> GetUiHandler(const sptr<WindowInputChannel>& channel) const;
+    bool ShouldLogEvent();
+
+    // serializes writers; readers never take it, they copy the published map pointer with std::atomic_load, which
+    // is not lock-free for shared_ptr but only holds an internal lock for the pointer copy, never for a map copy
     std::mutex mtx_;
-    std::unordered_map<uint32_t, sptr<WindowInputChannel>> windowInputChannels_;
+    std::shared_ptr<const ChannelMap> windowInputChannels_ = std::make_shared<const ChannelMap>();
     std::shared_ptr<MMI::IInputEventConsumer> inputListener_ = nullptr;
+    bool isInputThreadEnabled_ = false;
+    bool isMainHandlerAvailable_ = true;
+    std::shared_ptr<AppExecFwk::EventHandler> inputHandler_ = nullptr;
+    std::shared_ptr<AppExecFwk::EventHandler> mainHandler_ = nullptr;
+    std::atomic<uint32_t> eventCount_ { 0 };
 };
 
 class InputEventListener : public MMI::IInputEventConsumer {
@@ -16,16 +16,19 @@
 #ifndef OHOS_VSYNC_STATION_H
 #define OHOS_VSYNC_STATION_H
 
+#include <array>
 #include <atomic>
 #include <functional>
-#include <map>
 #include <memory>
-#include <unordered_set>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include <refbase.h>
 #include <event_handler.h>
 #include <vsync_receiver.h>
 
+#include "perf_histogram.h"
 #include "wm_single_instance.h"
 
 namespace OHOS {
@@ -34,9 +37,14 @@ class VsyncStation {
 WM_DECLARE_SINGLE_INSTANCE_BASE(VsyncStation);
 using OnCallback = std::function<void(int64_t)>;
 public:
-    enum class CallbackType {
+    // callbacks of one vsync run in this order; CALLBACK_IDLE is not critical and yields to the next vsync
+    // when the frame deadline has already passed
+    enum class CallbackType : uint32_t {
         CALLBACK_INPUT = 0,
-        CALLBACK_FRAME = 1,
+        CALLBACK_ANIMATION,
+        CALLBACK_FRAME,
+        CALLBACK_IDLE,
+        CALLBACK_TYPE_END,
     };
     struct VsyncCallback {
         OnCallback onCallback;
@@ -44,15 +52,25 @@ public:
     ~VsyncStation() = default;
     void RequestVsync(CallbackType type, const std::shared_ptr<VsyncCallback>& vsyncCallback);
     void RemoveCallback(CallbackType type, const std::shared_ptr<VsyncCallback>& vsyncCallback);
+    std::string GetCallbackCostInfo() const;
+    void ResetCallbackCosts();
     void SetIsMainHandlerAvailable(bool available)
     {
         isMainHandlerAvailable_ = available;
     }
 
 private:
-    VsyncStation() = default;
+    using CallbackList = std::vector<std::shared_ptr<VsyncCallback>>;
+    static constexpr size_t CALLBACK_TYPE_NUM = static_cast<size_t>(CallbackType::CALLBACK_TYPE_END);
+
+    VsyncStation();
     static void OnVsync(int64_t nanoTimestamp, void* client);
     void VsyncCallbackInner(int64_t nanoTimestamp);
+    void DispatchCallbacks(CallbackType type, int64_t nanoTimestamp);
+    void DeferCallbacks(CallbackType type);
+    void UpdateFramePeriodLocked(int64_t nanoTimestamp);
+    bool InitReceiverLocked();
+    bool MarkVsyncRequestedLocked();
     void OnVsyncTimeOut();
     AppExecFwk::EventHandler::Callback vsyncTimeoutCallback_ = std::bind(&VsyncStation::OnVsyncTimeOut, this);
     const std::string VSYNC_THREAD_ID = "vsync_thread";
@@ -61,10 +79,18 @@ private:
     bool hasRequestedVsync_ = false;
     bool isMainHandlerAvailable_ = false;
     uint32_t vsyncCount_ = 0;
-    std::map<CallbackType, std::unordered_set<std::shared_ptr<VsyncCallback>>> vsyncCallbacks_ = {
-        {CallbackType::CALLBACK_INPUT, {}},
-        {CallbackType::CALLBACK_FRAME, {}},
-    };
+    bool isIdleDeferred_ = false;
+    // the frame period is the shortest interval between vsyncs over a window of samples, since vsyncs that were
+    // not requested back to back are several periods apart
+    int64_t framePeriodNs_;
+    int64_t lastVsyncTimestamp_ = 0;
+    int64_t minVsyncIntervalNs_;
+    uint32_t vsyncIntervalCount_ = 0;
+    // callbacks are requested into pendingCallbacks_ and swapped with dispatchingCallbacks_ on vsync, both keep their
+    // capacity so that a vsync does not allocate
+    std::array<CallbackList, CALLBACK_TYPE_NUM> pendingCallbacks_;
+    std::array<CallbackList, CALLBACK_TYPE_NUM> dispatchingCallbacks_;
+    std::array<PerfHistogram, CALLBACK_TYPE_NUM> callbackCosts_;
     VSyncReceiver::FrameCallback frameCallback_ = {
         .userData_ = this,
         .callback_ = OnVsync,
@@ -25,6 +25,7 @@
 #include "singleton_delegator.h"
 #include "window_property.h"
 #include "window_manager_interface.h"
+#include "window_state_page.h"
 namespace OHOS {
 namespace Rosen {
 class WMSDeathRecipient : public IRemoteObject::DeathRecipient {
@@ -64,14 +65,18 @@ public:
     virtual void ClearWindowAdapter();
 
     virtual WMError GetAccessibilityWindowInfo(sptr<AccessibilityWindowInfo>& windowInfo);
+    virtual bool ReadWindowState(WindowStateSnapshot& snapshot);
 private:
     static inline SingletonDelegator<WindowAdapter> delegator;
     bool InitWMSProxy();
+    sptr<Ashmem> GetWindowStatePage();
 
     std::recursive_mutex mutex_;
     sptr<IWindowManager> windowManagerServiceProxy_ = nullptr;
     sptr<WMSDeathRecipient> wmsDeath_ = nullptr;
     bool isProxyValid_ { false };
+    sptr<Ashmem> windowStatePage_ = nullptr; // mapped read only, answers read-mostly queries without an IPC
+    bool isWindowStatePageRequested_ { false };
 };
 } // namespace Rosen
 } // namespace OHOS
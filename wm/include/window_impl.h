@@ -16,6 +16,7 @@
 #ifndef OHOS_ROSEN_WINDOW_IMPL_H
 #define OHOS_ROSEN_WINDOW_IMPL_H
 
+#include <future>
 #include <map>
 
 #include <ability_context.h>
@@ -25,6 +26,7 @@
 #include <ui_content.h>
 #include <ui/rs_surface_node.h>
 
+#include "input_latency_tracker.h"
 #include "input_transfer_station.h"
 #include "vsync_station.h"
 #include "window.h"
@@ -34,6 +36,8 @@
 
 namespace OHOS {
 namespace Rosen {
+class WindowAdapter;
+
 union ColorParam {
 #if BIG_ENDIANNESS
     struct {
@@ -247,6 +251,7 @@ private:
     void SetDefaultOption(); // for api7
     bool IsWindowValid() const;
     void OnVsync(int64_t timeStamp);
+    bool ConsumeRectPrediction(const Rect& rect);
     static sptr<Window> FindTopWindow(uint32_t topWinId);
     WMError Drag(const Rect& rect);
     void ConsumeMoveOrDragEvent(std::shared_ptr<MMI::PointerEvent>& pointerEvent);
@@ -257,12 +262,20 @@ private:
     bool IsPointerEventConsumed();
     void AdjustWindowAnimationFlag();
     void MapFloatingWindowToAppIfNeeded();
+    WMError ShowSpeculatively();
+    void WaitForAddWindow() const;
+    void WaitForSpeculativeShow();
+    void OnSpeculativeShowFailed(WMError ret);
     WMError UpdateProperty(PropertyChangeAction action);
+    WindowAdapter& GetWindowAdapter() const;
+    void SetWindowState(WindowState state);
     WMError Destroy(bool needNotifyServer);
     WMError SetBackgroundColor(uint32_t color);
     uint32_t GetBackgroundColor() const;
     Rect GetSystemAlarmWindowDefaultSize(Rect defaultRect);
     void HandleModeChangeHotZones(int32_t posX, int32_t posY);
+    bool IsAvoidAreaCacheable() const;
+    void InvalidateAvoidAreaCache();
 
     // colorspace, gamut
     using ColorSpaceConvertMap = struct {
@@ -275,9 +288,9 @@ private:
 
     std::shared_ptr<VsyncStation::VsyncCallback> callback_ =
         std::make_shared<VsyncStation::VsyncCallback>(VsyncStation::VsyncCallback());
-    static std::map<std::string, std::pair<uint32_t, sptr<Window>>> windowMap_;
-    static std::map<uint32_t, std::vector<sptr<WindowImpl>>> subWindowMap_;
-    static std::map<uint32_t, std::vector<sptr<WindowImpl>>> appFloatingWindowMap_;
+    std::shared_ptr<VsyncStation::VsyncCallback> idleCallback_ =
+        std::make_shared<VsyncStation::VsyncCallback>(VsyncStation::VsyncCallback());
+    std::shared_ptr<InputLatencyTracker> inputLatencyTracker_ = std::make_shared<InputLatencyTracker>();
     sptr<WindowProperty> property_;
     WindowState state_ { WindowState::STATE_INITIAL };
     WindowTag windowTag_;
@@ -294,7 +307,7 @@ private:
     std::string name_;
     std::unique_ptr<Ace::UIContent> uiContent_;
     std::shared_ptr<AbilityRuntime::Context> context_;
-    std::recursive_mutex mutex_;
+    mutable std::recursive_mutex mutex_;
     const float SYSTEM_ALARM_WINDOW_WIDTH_RATIO = 0.8;
     const float SYSTEM_ALARM_WINDOW_HEIGHT_RATIO = 0.3;
 
@@ -307,8 +320,13 @@ private:
     Rect startPointRect_ = { 0, 0, 0, 0 };
     Rect startRectExceptFrame_ = { 0, 0, 0, 0 };
     Rect startRectExceptCorner_ = { 0, 0, 0, 0 };
+    uint32_t startDisplayWidth_ = 0;
+    uint32_t startDisplayHeight_ = 0;
     bool isAppDecorEnbale_ = true;
     bool isSystemDecorEnable_ = true;
+    bool isSpeculativeShowEnabled_ = false;
+    bool isRectPredicted_ = false; // window rect comes from the create reply, not from a layout yet
+    std::shared_future<WMError> pendingAddWindow_;
 };
 }
 }
@@ -15,9 +15,13 @@
 #ifndef OHOS_WINDOW_INPUT_CHANNEL
 #define OHOS_WINDOW_INPUT_CHANNEL
 
+#include <atomic>
+
 #include <window.h>
 #include <i_input_event_consumer.h>
 #include <key_event.h>
+#include "input_latency_tracker.h"
+#include "input_resampler.h"
 #include "refbase.h"
 #include "vsync_station.h"
 
@@ -25,23 +29,36 @@ namespace OHOS {
 namespace Rosen {
 class WindowInputChannel : public RefBase {
 public:
-    explicit WindowInputChannel(const sptr<Window>& window);
+    explicit WindowInputChannel(const sptr<Window>& window,
+        const std::shared_ptr<InputLatencyTracker>& latencyTracker = nullptr);
     ~WindowInputChannel() = default;
+    void OnPointerEventReceived(const std::shared_ptr<MMI::PointerEvent>& pointerEvent);
     void HandlePointerEvent(std::shared_ptr<MMI::PointerEvent>& pointerEvent);
     void HandleKeyEvent(std::shared_ptr<MMI::KeyEvent>& keyEvent);
     void SetInputListener(const std::shared_ptr<MMI::IInputEventConsumer>& listener);
+    // read by the input thread to route events, while the listener is set on the main thread
+    bool HasInputListener() const
+    {
+        return hasInputListener_.load(std::memory_order_acquire);
+    }
     void Destroy();
 private:
     void OnVsync(int64_t timeStamp);
+    void DispatchPointerEvent(std::shared_ptr<MMI::PointerEvent>& pointerEvent);
     bool IsKeyboardEvent(const std::shared_ptr<MMI::KeyEvent>& keyEvent) const;
+    std::shared_ptr<MMI::IInputEventConsumer> GetInputListener();
     std::shared_ptr<MMI::PointerEvent> moveEvent_ = nullptr;
+    InputResampler resampler_;
+    std::atomic<uint32_t> moveEventCount_ { 0 };
     std::mutex mtx_;
     sptr<Window> window_;
     bool isAvailable_;
     std::shared_ptr<VsyncStation::VsyncCallback> callback_ =
         std::make_shared<VsyncStation::VsyncCallback>(VsyncStation::VsyncCallback());
     static const int32_t MAX_INPUT_NUM = 100;
-    std::shared_ptr<MMI::IInputEventConsumer> inputListener_;
+    std::shared_ptr<MMI::IInputEventConsumer> inputListener_; // guarded by mtx_
+    std::atomic<bool> hasInputListener_ { false };
+    std::shared_ptr<InputLatencyTracker> latencyTracker_;
 };
 }
 }
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_REGISTRY_H
+#define OHOS_ROSEN_WINDOW_REGISTRY_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <refbase.h>
+
+#include "wm_single_instance.h"
+
+namespace OHOS {
+namespace AbilityRuntime {
+class Context;
+}
+namespace Rosen {
+class WindowImpl;
+
+/*
+ * Client side index of the windows created by this process, by name, by window id and by the ability context of
+ * their main window. Readers work on an immutable snapshot and never take a lock, so lookups from the input and
+ * vsync threads do not contend with window creation; writers copy the snapshot, modify it and publish it.
+ */
+class WindowRegistry {
+WM_DECLARE_SINGLE_INSTANCE(WindowRegistry);
+public:
+    bool Add(const sptr<WindowImpl>& window, uint32_t parentId);
+    void Remove(uint32_t windowId);
+    bool IsEmpty() const;
+    bool Contains(const std::string& name) const;
+    sptr<WindowImpl> FindByName(const std::string& name) const;
+    sptr<WindowImpl> FindById(uint32_t windowId) const;
+    sptr<WindowImpl> FindMainWindowByContext(const AbilityRuntime::Context* context) const;
+    std::vector<sptr<WindowImpl>> GetSubWindows(uint32_t parentId) const;
+    std::vector<sptr<WindowImpl>> TakeSubWindows(uint32_t parentId);
+    void AddAppFloatingWindow(uint32_t mainWindowId, const sptr<WindowImpl>& window);
+    std::vector<sptr<WindowImpl>> TakeAppFloatingWindows(uint32_t mainWindowId);
+
+private:
+    struct Snapshot {
+        std::unordered_map<std::string, sptr<WindowImpl>> nameMap_;
+        std::unordered_map<uint32_t, sptr<WindowImpl>> idMap_;
+        std::unordered_map<const AbilityRuntime::Context*, uint32_t> contextMap_; // context to main window id
+        std::unordered_map<uint32_t, uint32_t> parentIdMap_; // sub window id to parent window id
+        std::unordered_map<uint32_t, std::vector<sptr<WindowImpl>>> subWindowMap_;
+        std::unordered_map<uint32_t, std::vector<sptr<WindowImpl>>> appFloatingWindowMap_;
+    };
+    std::shared_ptr<const Snapshot> Load() const;
+    void Publish(const std::shared_ptr<const Snapshot>& snapshot);
+    static void RemoveFromList(std::vector<sptr<WindowImpl>>& windows, uint32_t windowId);
+
+    std::mutex writeMutex_;
+    std::shared_ptr<const Snapshot> snapshot_ = std::make_shared<const Snapshot>();
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_WINDOW_REGISTRY_H
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "avoid_area_cache.h"
+
+namespace OHOS {
+namespace Rosen {
+WM_IMPLEMENT_SINGLE_INSTANCE(AvoidAreaCache)
+
+uint64_t AvoidAreaCache::GetVersion(DisplayId displayId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_[displayId].version_;
+}
+
+bool AvoidAreaCache::GetAvoidArea(DisplayId displayId, AvoidAreaType type, std::vector<Rect>& avoidArea)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(displayId);
+    if (iter == entries_.end()) {
+        return false;
+    }
+    auto areaIter = iter->second.avoidAreas_.find(type);
+    if (areaIter == iter->second.avoidAreas_.end()) {
+        return false;
+    }
+    avoidArea = areaIter->second;
+    return true;
+}
+
+void AvoidAreaCache::SetAvoidArea(DisplayId displayId, AvoidAreaType type, const std::vector<Rect>& avoidArea,
+    uint64_t version)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = entries_[displayId];
+    if (entry.version_ != version) {
+        return; // changed while the server was asked, the answer may be stale
+    }
+    entry.avoidAreas_[type] = avoidArea;
+}
+
+void AvoidAreaCache::OnSystemAvoidAreaChanged(DisplayId displayId, const std::vector<Rect>& avoidArea)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = entries_[displayId];
+    entry.version_++;
+    entry.avoidAreas_[AvoidAreaType::TYPE_SYSTEM] = avoidArea;
+}
+
+void AvoidAreaCache::Invalidate(DisplayId displayId)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = entries_[displayId];
+    entry.version_++;
+    entry.avoidAreas_.clear();
+}
+
+bool AvoidAreaCache::GetHotZones(DisplayId displayId, uint32_t displayWidth, uint32_t displayHeight,
+    ModeChangeHotZones& hotZones)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(displayId);
+    if (iter == entries_.end() || !iter->second.hasHotZones_ ||
+        iter->second.hotZonesDisplayWidth_ != displayWidth || iter->second.hotZonesDisplayHeight_ != displayHeight) {
+        return false;
+    }
+    hotZones = iter->second.hotZones_;
+    return true;
+}
+
+void AvoidAreaCache::SetHotZones(DisplayId displayId, uint32_t displayWidth, uint32_t displayHeight,
+    const ModeChangeHotZones& hotZones)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = entries_[displayId];
+    entry.hasHotZones_ = true;
+    entry.hotZonesDisplayWidth_ = displayWidth;
+    entry.hotZonesDisplayHeight_ = displayHeight;
+    entry.hotZones_ = hotZones;
+}
+} // namespace Rosen
+} // namespace OHOS
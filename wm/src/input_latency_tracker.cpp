@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "input_latency_tracker.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    const char* const STAGE_NAMES[] = { "receive", "batch", "consume", "frame", "total" };
+}
+
+int32_t InputLatencyTracker::FindRecordLocked(int32_t eventId) const
+{
+    for (size_t i = 0; i < recordCount_; i++) {
+        if (records_[i].eventId_ == eventId) {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+void InputLatencyTracker::EraseRecordsLocked(size_t begin, size_t end)
+{
+    if (begin >= end) {
+        return;
+    }
+    std::move(records_.begin() + end, records_.begin() + recordCount_, records_.begin() + begin);
+    recordCount_ -= end - begin;
+}
+
+uint64_t InputLatencyTracker::GetFrameEndLocked(uint64_t timeUs) const
+{
+    for (size_t i = 0; i < frameCount_; i++) {
+        if (frameEndTimesUs_[i] >= timeUs) {
+            return frameEndTimesUs_[i];
+        }
+    }
+    return 0;
+}
+
+void InputLatencyTracker::RecordCost(Stage stage, uint64_t beginUs, uint64_t endUs)
+{
+    if (beginUs == 0 || endUs < beginUs) {
+        return;
+    }
+    histograms_[static_cast<size_t>(stage)].Record(endUs - beginUs);
+}
+
+void InputLatencyTracker::OnEventReceived(int32_t eventId, int64_t actionTimeUs)
+{
+    uint64_t now = PerfHistogram::GetCurrentTimeUs();
+    uint64_t actionTime = actionTimeUs > 0 ? static_cast<uint64_t>(actionTimeUs) : 0;
+    RecordCost(Stage::RECEIVE, actionTime, now);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (recordCount_ == MAX_PENDING_EVENTS) {
+        EraseRecordsLocked(0, 1); // the oldest event never reached a frame
+    }
+    records_[recordCount_++] = { eventId, actionTime, now, 0, 0 };
+}
+
+void InputLatencyTracker::OnEventDispatched(int32_t eventId)
+{
+    uint64_t now = PerfHistogram::GetCurrentTimeUs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    int32_t index = FindRecordLocked(eventId);
+    if (index < 0) {
+        return;
+    }
+    Record& record = records_[index];
+    record.dispatchTimeUs_ = now;
+    RecordCost(Stage::BATCH, record.receiveTimeUs_, now);
+    // older events still waiting for dispatch were coalesced into this one
+    size_t end = static_cast<size_t>(index);
+    size_t begin = end;
+    while (begin > 0 && records_[begin - 1].dispatchTimeUs_ == 0) {
+        begin--;
+    }
+    EraseRecordsLocked(begin, end);
+}
+
+void InputLatencyTracker::OnEventConsumed(int32_t eventId)
+{
+    uint64_t now = PerfHistogram::GetCurrentTimeUs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    int32_t index = FindRecordLocked(eventId);
+    if (index < 0 || records_[index].dispatchTimeUs_ == 0) {
+        return;
+    }
+    records_[index].consumeTimeUs_ = now;
+    RecordCost(Stage::CONSUME, records_[index].dispatchTimeUs_, now);
+}
+
+bool InputLatencyTracker::OnFrame()
+{
+    uint64_t now = PerfHistogram::GetCurrentTimeUs();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frameCount_ == MAX_PENDING_FRAMES) {
+        // nobody flushed for a while, the events of the oldest frame are accounted to the next one
+        std::move(frameEndTimesUs_.begin() + 1, frameEndTimesUs_.begin() + frameCount_, frameEndTimesUs_.begin());
+        frameCount_--;
+    }
+    frameEndTimesUs_[frameCount_++] = now;
+    return recordCount_ > 0;
+}
+
+void InputLatencyTracker::FlushFrames()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (frameCount_ == 0) {
+        return;
+    }
+    uint64_t lastFrameEndUs = frameEndTimesUs_[frameCount_ - 1];
+    size_t kept = 0;
+    for (size_t i = 0; i < recordCount_; i++) {
+        const Record& record = records_[i];
+        uint64_t handledTimeUs = record.consumeTimeUs_ != 0 ? record.consumeTimeUs_ : record.dispatchTimeUs_;
+        if (record.dispatchTimeUs_ == 0 || handledTimeUs > lastFrameEndUs) {
+            records_[kept++] = record; // still waiting for its batch or for the end of its frame
+            continue;
+        }
+        if (record.consumeTimeUs_ != 0) {
+            uint64_t frameEndUs = GetFrameEndLocked(record.consumeTimeUs_);
+            RecordCost(Stage::FRAME, record.consumeTimeUs_, frameEndUs);
+            RecordCost(Stage::TOTAL, record.actionTimeUs_ != 0 ? record.actionTimeUs_ : record.receiveTimeUs_,
+                frameEndUs);
+        }
+    }
+    recordCount_ = kept;
+    frameCount_ = 0;
+}
+
+PerfHistogramSnapshot InputLatencyTracker::GetSnapshot(Stage stage) const
+{
+    if (stage >= Stage::STAGE_END) {
+        return {};
+    }
+    return histograms_[static_cast<size_t>(stage)].GetSnapshot();
+}
+
+void InputLatencyTracker::Dump(std::vector<std::string>& info) const
+{
+    for (size_t i = 0; i < STAGE_NUM; i++) {
+        info.push_back(std::string(STAGE_NAMES[i]) + ": " + histograms_[i].ToString());
+    }
+}
+
+void InputLatencyTracker::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    recordCount_ = 0;
+    frameCount_ = 0;
+    for (auto& histogram : histograms_) {
+        histogram.Reset();
+    }
+}
+} // namespace Rosen
+} // namespace OHOS
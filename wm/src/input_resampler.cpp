@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "input_resampler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr int64_t RESAMPLE_LATENCY_US = 5000; // sample this far behind the frame time
+    constexpr int64_t RESAMPLE_MIN_DELTA_US = 2000; // samples closer than this are too noisy to extrapolate
+    constexpr int64_t RESAMPLE_MAX_DELTA_US = 20000; // samples further apart than this are too stale
+    constexpr int64_t RESAMPLE_MAX_PREDICTION_US = 8000;
+}
+
+void InputResampler::PointerHistory::Push(const Sample& sample)
+{
+    newest_ = (count_ == 0) ? 0 : (newest_ + 1) % HISTORY_SIZE;
+    samples_[newest_] = sample;
+    count_ = std::min(count_ + 1, HISTORY_SIZE);
+}
+
+const InputResampler::Sample& InputResampler::PointerHistory::Get(size_t age) const
+{
+    return samples_[(newest_ + HISTORY_SIZE - age) % HISTORY_SIZE];
+}
+
+bool InputResampler::ShouldResample(const std::shared_ptr<MMI::PointerEvent>& pointerEvent)
+{
+    // mouse and touchpad cursors are drawn at their reported position, only touch input is resampled
+    return pointerEvent != nullptr && pointerEvent->GetSourceType() == MMI::PointerEvent::SOURCE_TYPE_TOUCHSCREEN &&
+        pointerEvent->GetPointerAction() == MMI::PointerEvent::POINTER_ACTION_MOVE;
+}
+
+void InputResampler::AddSample(const std::shared_ptr<MMI::PointerEvent>& pointerEvent)
+{
+    if (!ShouldResample(pointerEvent)) {
+        return;
+    }
+    int64_t timeUs = pointerEvent->GetActionTime();
+    for (int32_t pointerId : pointerEvent->GetPointerIds()) {
+        MMI::PointerEvent::PointerItem item;
+        if (!pointerEvent->GetPointerItem(pointerId, item)) {
+            continue;
+        }
+        auto& history = histories_[pointerId];
+        if (history.count_ > 0 && history.Get(0).timeUs_ >= timeUs) {
+            continue; // out of order or duplicated sample
+        }
+        history.Push({ timeUs, item.GetGlobalX(), item.GetGlobalY(), item.GetLocalX(), item.GetLocalY() });
+    }
+}
+
+InputResampler::Sample InputResampler::Lerp(const Sample& from, const Sample& to, int64_t timeUs)
+{
+    float alpha = static_cast<float>(timeUs - from.timeUs_) / static_cast<float>(to.timeUs_ - from.timeUs_);
+    auto lerp = [alpha](int32_t a, int32_t b) {
+        return static_cast<int32_t>(std::lround(a + alpha * (b - a)));
+    };
+    return { timeUs, lerp(from.globalX_, to.globalX_), lerp(from.globalY_, to.globalY_),
+        lerp(from.localX_, to.localX_), lerp(from.localY_, to.localY_) };
+}
+
+bool InputResampler::ResamplePointer(const PointerHistory& history, int64_t sampleTimeUs, Sample& result)
+{
+    if (history.count_ < 2) { // 2: at least two samples are needed
+        return false;
+    }
+    const Sample& newest = history.Get(0);
+    if (newest.timeUs_ > sampleTimeUs) {
+        // interpolate between the two samples around the sample time
+        for (size_t age = 1; age < history.count_; age++) {
+            const Sample& older = history.Get(age);
+            if (older.timeUs_ <= sampleTimeUs) {
+                result = Lerp(older, history.Get(age - 1), sampleTimeUs);
+                return true;
+            }
+        }
+        return false;
+    }
+    const Sample& previous = history.Get(1);
+    int64_t delta = newest.timeUs_ - previous.timeUs_;
+    if (delta < RESAMPLE_MIN_DELTA_US || delta > RESAMPLE_MAX_DELTA_US) {
+        return false;
+    }
+    int64_t maxPredictedTime = newest.timeUs_ + std::min(delta / 2, RESAMPLE_MAX_PREDICTION_US); // 2: half delta
+    result = Lerp(previous, newest, std::min(sampleTimeUs, maxPredictedTime));
+    return true;
+}
+
+void InputResampler::Resample(const std::shared_ptr<MMI::PointerEvent>& pointerEvent, int64_t frameTimeUs) const
+{
+    if (!ShouldResample(pointerEvent)) {
+        return;
+    }
+    int64_t sampleTimeUs = frameTimeUs - RESAMPLE_LATENCY_US;
+    // a capped extrapolation samples a pointer earlier, all pointers are moved to the earliest time sampled
+    for (int32_t pointerId : pointerEvent->GetPointerIds()) {
+        auto iter = histories_.find(pointerId);
+        Sample sample;
+        if (iter != histories_.end() && ResamplePointer(iter->second, sampleTimeUs, sample)) {
+            sampleTimeUs = std::min(sampleTimeUs, sample.timeUs_);
+        }
+    }
+    bool isResampled = false;
+    for (int32_t pointerId : pointerEvent->GetPointerIds()) {
+        auto iter = histories_.find(pointerId);
+        Sample sample;
+        MMI::PointerEvent::PointerItem item;
+        if (iter == histories_.end() || !ResamplePointer(iter->second, sampleTimeUs, sample) ||
+            !pointerEvent->GetPointerItem(pointerId, item)) {
+            continue;
+        }
+        item.SetGlobalX(sample.globalX_);
+        item.SetGlobalY(sample.globalY_);
+        item.SetLocalX(sample.localX_);
+        item.SetLocalY(sample.localY_);
+        pointerEvent->UpdatePointerItem(pointerId, item);
+        isResampled = true;
+    }
+    if (isResampled) {
+        // velocity trackers in ACE pair the position with the action time, both must describe the same instant
+        pointerEvent->SetActionTime(sampleTimeUs);
+    }
+}
+
+void InputResampler::ClearPointer(int32_t pointerId)
+{
+    histories_.erase(pointerId);
+}
+
+void InputResampler::Clear()
+{
+    histories_.clear();
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -20,6 +20,8 @@ namespace OHOS {
 namespace Rosen {
 namespace {
     constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "InputTransferStation"};
+    const std::string INPUT_THREAD_ID = "input_thread";
+    constexpr uint32_t EVENT_LOG_SAMPLE_INTERVAL = 64; // log one of this many events, stylus input is 240Hz+
 }
 WM_IMPLEMENT_SINGLE_INSTANCE(InputTransferStation)
 
@@ -30,12 +32,20 @@ void InputEventListener::OnInputEvent(std::shared_ptr<MMI::KeyEvent> keyEvent) c
         return;
     }
     uint32_t windowId = static_cast<uint32_t>(keyEvent->GetAgentWindowId());
-    WLOGFI("Receive keyEvent, windowId: %{public}u", windowId);
-    auto channel = InputTransferStation::GetInstance().GetInputChannel(windowId);
+    auto& station = InputTransferStation::GetInstance();
+    if (station.ShouldLogEvent()) {
+        WLOGFD("Receive keyEvent, windowId: %{public}u", windowId);
+    }
+    auto channel = station.GetInputChannel(windowId);
     if (channel == nullptr) {
         WLOGFE("WindowInputChannel is nullptr");
         return;
     }
+    auto uiHandler = station.GetUiHandler(channel);
+    if (uiHandler != nullptr) {
+        uiHandler->PostTask([channel, keyEvent]() mutable { channel->HandleKeyEvent(keyEvent); });
+        return;
+    }
     channel->HandleKeyEvent(keyEvent);
 }
 
@@ -45,7 +55,9 @@ void InputEventListener::OnInputEvent(std::shared_ptr<MMI::AxisEvent> axisEvent)
         WLOGFE("AxisEvent is nullptr");
         return;
     }
-    WLOGFI("Receive axisEvent, windowId: %{public}d", axisEvent->GetAgentWindowId());
+    if (InputTransferStation::GetInstance().ShouldLogEvent()) {
+        WLOGFD("Receive axisEvent, windowId: %{public}d", axisEvent->GetAgentWindowId());
+    }
     axisEvent->MarkProcessed();
 }
 
@@ -56,27 +68,62 @@ void InputEventListener::OnInputEvent(std::shared_ptr<MMI::PointerEvent> pointer
         return;
     }
     uint32_t windowId = static_cast<uint32_t>(pointerEvent->GetAgentWindowId());
-    WLOGFI("Receive pointerEvent, windowId: %{public}u", windowId);
-    auto channel = InputTransferStation::GetInstance().GetInputChannel(windowId);
+    auto& station = InputTransferStation::GetInstance();
+    if (station.ShouldLogEvent()) {
+        WLOGFD("Receive pointerEvent, windowId: %{public}u", windowId);
+    }
+    auto channel = station.GetInputChannel(windowId);
     if (channel == nullptr) {
         WLOGFE("WindowInputChannel is nullptr");
         return;
     }
+    channel->OnPointerEventReceived(pointerEvent);
+    auto uiHandler = station.GetUiHandler(channel);
+    if (uiHandler != nullptr) {
+        uiHandler->PostTask([channel, pointerEvent]() mutable { channel->HandlePointerEvent(pointerEvent); });
+        return;
+    }
     channel->HandlePointerEvent(pointerEvent);
 }
 
-void InputTransferStation::AddInputWindow(const sptr<Window>& window)
+void InputTransferStation::SetInputThreadEnabled(bool enabled, bool isMainHandlerAvailable)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (inputListener_ != nullptr) {
+        WLOGFE("Input listener is already registered, input thread can not be changed.");
+        return;
+    }
+    isInputThreadEnabled_ = enabled;
+    isMainHandlerAvailable_ = isMainHandlerAvailable;
+}
+
+void InputTransferStation::InitInputListenerLocked()
+{
+    WLOGFI("Init input listener");
+    std::shared_ptr<MMI::IInputEventConsumer> listener = std::make_shared<InputEventListener>(InputEventListener());
+    if (isInputThreadEnabled_) {
+        inputHandler_ = std::make_shared<AppExecFwk::EventHandler>(AppExecFwk::EventRunner::Create(INPUT_THREAD_ID));
+        auto mainEventRunner = AppExecFwk::EventRunner::GetMainEventRunner();
+        if (mainEventRunner != nullptr && isMainHandlerAvailable_) {
+            mainHandler_ = std::make_shared<AppExecFwk::EventHandler>(mainEventRunner);
+        }
+    }
+    MMI::InputManager::GetInstance()->SetWindowInputEventConsumer(listener, inputHandler_);
+    inputListener_ = listener;
+}
+
+void InputTransferStation::AddInputWindow(const sptr<Window>& window,
+    const std::shared_ptr<InputLatencyTracker>& latencyTracker)
 {
     uint32_t windowId = window->GetWindowId();
     WLOGFI("Add input window, windowId: %{public}u", windowId);
-    sptr<WindowInputChannel> inputChannel = new WindowInputChannel(window);
+    sptr<WindowInputChannel> inputChannel = new WindowInputChannel(window, latencyTracker);
     std::lock_guard<std::mutex> lock(mtx_);
-    windowInputChannels_.insert(std::make_pair(windowId, inputChannel));
+    auto channels = std::make_shared<ChannelMap>(*std::atomic_load(&windowInputChannels_));
+    channels->insert(std::make_pair(windowId, inputChannel));
+    std::atomic_store(&windowInputChannels_, std::shared_ptr<const ChannelMap>(channels));
     if (inputListener_ == nullptr) {
-        WLOGFI("Init input listener");
-        std::shared_ptr<MMI::IInputEventConsumer> listener = std::make_shared<InputEventListener>(InputEventListener());
-        MMI::InputManager::GetInstance()->SetWindowInputEventConsumer(listener);
-        inputListener_ = listener;
+        InitInputListenerLocked();
     }
 }
 
@@ -85,10 +132,13 @@ void InputTransferStation::RemoveInputWindow(const sptr<Window>& window)
     uint32_t windowId = window->GetWindowId();
     WLOGFI("Remove input window, windowId: %{public}u", windowId);
     std::lock_guard<std::mutex> lock(mtx_);
-    auto iter = windowInputChannels_.find(windowId);
-    if (iter != windowInputChannels_.end()) {
+    auto current = std::atomic_load(&windowInputChannels_);
+    auto iter = current->find(windowId);
+    if (iter != current->end()) {
         auto inputChannel = iter->second;
-        windowInputChannels_.erase(windowId);
+        auto channels = std::make_shared<ChannelMap>(*current);
+        channels->erase(windowId);
+        std::atomic_store(&windowInputChannels_, std::shared_ptr<const ChannelMap>(channels));
         if (inputChannel != nullptr) {
             inputChannel->Destroy();
         }
@@ -109,15 +159,30 @@ void InputTransferStation::SetInputListener(
     channel->SetInputListener(listener);
 }
 
-sptr<WindowInputChannel> InputTransferStation::GetInputChannel(uint32_t windowId)
+sptr<WindowInputChannel> InputTransferStation::GetInputChannel(uint32_t windowId) const
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    auto iter = windowInputChannels_.find(windowId);
-    if (iter == windowInputChannels_.end()) {
+    auto channels = std::atomic_load(&windowInputChannels_);
+    auto iter = channels->find(windowId);
+    if (iter == channels->end()) {
         WLOGFE("Can not find channel according to windowId: %{public}u", windowId);
         return nullptr;
     }
     return iter->second;
 }
+
+std::shared_ptr<AppExecFwk::EventHandler> InputTransferStation::GetUiHandler(
+    const sptr<WindowInputChannel>& channel) const
+{
+    // on the input thread, only windows drawn by ACE hop to the main runner, input listeners are handled in place
+    if (!isInputThreadEnabled_ || channel->HasInputListener()) {
+        return nullptr;
+    }
+    return mainHandler_;
+}
+
+bool InputTransferStation::ShouldLogEvent()
+{
+    return eventCount_.fetch_add(1, std::memory_order_relaxed) % EVENT_LOG_SAMPLE_INTERVAL == 0;
+}
 }
 }
@@ -14,6 +14,11 @@
  */
 
 #include "vsync_station.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+
 #include "transaction/rs_interfaces.h"
 #include "window_manager_hilog.h"
 
@@ -23,45 +28,90 @@ namespace {
     constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "VsyncStation"};
     const std::string VSYNC_TIME_OUT_TASK = "vsync_time_out_task";
     constexpr int64_t VSYNC_TIME_OUT_MILLISECONDS = 600;
+    constexpr size_t CALLBACK_LIST_CAPACITY = 16;
+    constexpr uint32_t CREATE_RECEIVER_MAX_RETRY = 3;
+    constexpr int64_t DEFAULT_FRAME_PERIOD_NANOSECONDS = 16666667; // 60Hz until the vsync period is measured
+    constexpr int64_t MIN_FRAME_PERIOD_NANOSECONDS = 4000000; // 4ms: faster than 240Hz is not a vsync period
+    constexpr int64_t MAX_FRAME_PERIOD_NANOSECONDS = 34000000; // 34ms: slower than 30Hz spans skipped vsyncs
+    constexpr uint32_t FRAME_PERIOD_SAMPLE_NUM = 8;
+    constexpr uint64_t SLOW_CALLBACK_MICROSECONDS = 8000;
+    const char* const CALLBACK_TYPE_NAMES[] = { "input", "animation", "frame", "idle" };
+
+    int64_t GetCurrentTimeNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
 }
 WM_IMPLEMENT_SINGLE_INSTANCE(VsyncStation)
 
+VsyncStation::VsyncStation()
+    : framePeriodNs_(DEFAULT_FRAME_PERIOD_NANOSECONDS), minVsyncIntervalNs_(MAX_FRAME_PERIOD_NANOSECONDS)
+{
+    for (size_t i = 0; i < CALLBACK_TYPE_NUM; i++) {
+        pendingCallbacks_[i].reserve(CALLBACK_LIST_CAPACITY);
+        dispatchingCallbacks_[i].reserve(CALLBACK_LIST_CAPACITY);
+    }
+}
+
+bool VsyncStation::InitReceiverLocked()
+{
+    if (receiver_ != nullptr) {
+        return true;
+    }
+    if (vsyncHandler_ == nullptr) {
+        auto mainEventRunner = AppExecFwk::EventRunner::GetMainEventRunner();
+        if (mainEventRunner != nullptr && isMainHandlerAvailable_) {
+            vsyncHandler_ = std::make_shared<AppExecFwk::EventHandler>(mainEventRunner);
+        } else {
+            WLOGFE("MainEventRunner is not available, create a new EventRunner for vsyncHandler_.");
+            vsyncHandler_ = std::make_shared<AppExecFwk::EventHandler>(
+                AppExecFwk::EventRunner::Create(VSYNC_THREAD_ID));
+        }
+    }
+    auto& rsClient = OHOS::Rosen::RSInterfaces::GetInstance();
+    for (uint32_t retry = 0; retry < CREATE_RECEIVER_MAX_RETRY && receiver_ == nullptr; retry++) {
+        receiver_ = rsClient.CreateVSyncReceiver("WM_" + std::to_string(::getpid()), vsyncHandler_);
+    }
+    if (receiver_ == nullptr) {
+        // callbacks stay pending, the next request tries again
+        WLOGFE("Create vsync receiver failed.");
+        return false;
+    }
+    receiver_->Init();
+    return true;
+}
+
+bool VsyncStation::MarkVsyncRequestedLocked()
+{
+    if (hasRequestedVsync_) {
+        return false;
+    }
+    hasRequestedVsync_ = true;
+    vsyncCount_++;
+    if (vsyncCount_ & 0x01) { // write log every 2 vsync
+        WLOGFI("Request next vsync.");
+    }
+    vsyncHandler_->RemoveTask(VSYNC_TIME_OUT_TASK);
+    vsyncHandler_->PostTask(vsyncTimeoutCallback_, VSYNC_TIME_OUT_TASK, VSYNC_TIME_OUT_MILLISECONDS);
+    return true;
+}
+
 void VsyncStation::RequestVsync(CallbackType type, const std::shared_ptr<VsyncCallback>& vsyncCallback)
 {
     {
         std::lock_guard<std::mutex> lock(mtx_);
-        auto iter = vsyncCallbacks_.find(type);
-        if (iter == vsyncCallbacks_.end()) {
-            WLOGFE("wrong callback type.");
+        if (type >= CallbackType::CALLBACK_TYPE_END || vsyncCallback == nullptr) {
+            WLOGFE("wrong callback type or null callback.");
             return;
         }
-        iter->second.insert(vsyncCallback);
-
-        if (vsyncHandler_ == nullptr) {
-            auto mainEventRunner = AppExecFwk::EventRunner::GetMainEventRunner();
-            if (mainEventRunner != nullptr && isMainHandlerAvailable_) {
-                vsyncHandler_ = std::make_shared<AppExecFwk::EventHandler>(mainEventRunner);
-            } else {
-                WLOGFE("MainEventRunner is not available, create a new EventRunner for vsyncHandler_.");
-                vsyncHandler_ = std::make_shared<AppExecFwk::EventHandler>(
-                    AppExecFwk::EventRunner::Create(VSYNC_THREAD_ID));
-            }
-            auto& rsClient = OHOS::Rosen::RSInterfaces::GetInstance();
-            while (receiver_ == nullptr) {
-                receiver_ = rsClient.CreateVSyncReceiver("WM_" + std::to_string(::getpid()), vsyncHandler_);
-            }
-            receiver_->Init();
+        auto& callbacks = pendingCallbacks_[static_cast<size_t>(type)];
+        if (std::find(callbacks.begin(), callbacks.end(), vsyncCallback) == callbacks.end()) {
+            callbacks.push_back(vsyncCallback);
         }
-        if (hasRequestedVsync_) {
+        if (!InitReceiverLocked() || !MarkVsyncRequestedLocked()) {
             return;
         }
-        hasRequestedVsync_ = true;
-        vsyncCount_++;
-        if (vsyncCount_ & 0x01) { // write log every 2 vsync
-            WLOGFI("Request next vsync.");
-        }
-        vsyncHandler_->RemoveTask(VSYNC_TIME_OUT_TASK);
-        vsyncHandler_->PostTask(vsyncTimeoutCallback_, VSYNC_TIME_OUT_TASK, VSYNC_TIME_OUT_MILLISECONDS);
     }
     receiver_->RequestNextVSync(frameCallback_);
 }
@@ -70,33 +120,112 @@ void VsyncStation::RemoveCallback(CallbackType type, const std::shared_ptr<Vsync
 {
     WLOGFI("Remove callback, type: %{public}u", type);
     std::lock_guard<std::mutex> lock(mtx_);
-    auto iter = vsyncCallbacks_.find(type);
-    if (iter == vsyncCallbacks_.end()) {
+    if (type >= CallbackType::CALLBACK_TYPE_END) {
         WLOGFE("wrong callback type.");
         return;
     }
-    iter->second.erase(vsyncCallback);
+    auto& callbacks = pendingCallbacks_[static_cast<size_t>(type)];
+    callbacks.erase(std::remove(callbacks.begin(), callbacks.end(), vsyncCallback), callbacks.end());
+}
+
+void VsyncStation::DispatchCallbacks(CallbackType type, int64_t timestamp)
+{
+    size_t index = static_cast<size_t>(type);
+    for (const auto& callback : dispatchingCallbacks_[index]) {
+        uint64_t startTime = PerfHistogram::GetCurrentTimeUs();
+        callback->onCallback(timestamp);
+        uint64_t cost = PerfHistogram::GetCurrentTimeUs() - startTime;
+        callbackCosts_[index].Record(cost);
+        if (cost > SLOW_CALLBACK_MICROSECONDS) {
+            WLOGFI("Slow %{public}s vsync callback, cost: %{public}" PRIu64 "us", CALLBACK_TYPE_NAMES[index], cost);
+        }
+    }
+    dispatchingCallbacks_[index].clear();
+}
+
+void VsyncStation::DeferCallbacks(CallbackType type)
+{
+    size_t index = static_cast<size_t>(type);
+    bool needRequest = false;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto& callbacks = pendingCallbacks_[index];
+        for (const auto& callback : dispatchingCallbacks_[index]) {
+            if (std::find(callbacks.begin(), callbacks.end(), callback) == callbacks.end()) {
+                callbacks.push_back(callback);
+            }
+        }
+        needRequest = MarkVsyncRequestedLocked();
+    }
+    dispatchingCallbacks_[index].clear();
+    if (needRequest && receiver_ != nullptr) {
+        receiver_->RequestNextVSync(frameCallback_);
+    }
+}
+
+void VsyncStation::UpdateFramePeriodLocked(int64_t timestamp)
+{
+    int64_t interval = timestamp - lastVsyncTimestamp_;
+    lastVsyncTimestamp_ = timestamp;
+    if (interval < MIN_FRAME_PERIOD_NANOSECONDS || interval > MAX_FRAME_PERIOD_NANOSECONDS) {
+        return;
+    }
+    minVsyncIntervalNs_ = std::min(minVsyncIntervalNs_, interval);
+    if (++vsyncIntervalCount_ < FRAME_PERIOD_SAMPLE_NUM) {
+        return;
+    }
+    // a new window of samples follows refresh rate changes in both directions
+    framePeriodNs_ = minVsyncIntervalNs_;
+    minVsyncIntervalNs_ = MAX_FRAME_PERIOD_NANOSECONDS;
+    vsyncIntervalCount_ = 0;
 }
 
 void VsyncStation::VsyncCallbackInner(int64_t timestamp)
 {
-    std::map<CallbackType, std::unordered_set<std::shared_ptr<VsyncCallback>>> vsyncCallbacks;
+    int64_t framePeriodNs;
     {
         std::lock_guard<std::mutex> lock(mtx_);
         hasRequestedVsync_ = false;
-        vsyncCallbacks = vsyncCallbacks_;
-        for (auto& vsyncCallbacksSet: vsyncCallbacks_) {
-            vsyncCallbacksSet.second.clear();
+        UpdateFramePeriodLocked(timestamp);
+        framePeriodNs = framePeriodNs_;
+        for (size_t i = 0; i < CALLBACK_TYPE_NUM; i++) {
+            // dispatching lists were cleared after the last vsync, swapping keeps both capacities
+            std::swap(pendingCallbacks_[i], dispatchingCallbacks_[i]);
         }
         vsyncHandler_->RemoveTask(VSYNC_TIME_OUT_TASK);
         if (vsyncCount_ & 0x01) { // write log every 2 vsync
             WLOGFI("On vsync callback.");
         }
     }
-    for (auto& vsyncCallbacksSet: vsyncCallbacks) {
-        for (const auto& callback: vsyncCallbacksSet.second) {
-            callback->onCallback(timestamp);
-        }
+    DispatchCallbacks(CallbackType::CALLBACK_INPUT, timestamp);
+    DispatchCallbacks(CallbackType::CALLBACK_ANIMATION, timestamp);
+    DispatchCallbacks(CallbackType::CALLBACK_FRAME, timestamp);
+    if (dispatchingCallbacks_[static_cast<size_t>(CallbackType::CALLBACK_IDLE)].empty()) {
+        return;
+    }
+    // idle work is deferred at most once so that it is not starved by a series of long frames
+    if (!isIdleDeferred_ && GetCurrentTimeNs() > timestamp + framePeriodNs) {
+        isIdleDeferred_ = true;
+        DeferCallbacks(CallbackType::CALLBACK_IDLE);
+        return;
+    }
+    isIdleDeferred_ = false;
+    DispatchCallbacks(CallbackType::CALLBACK_IDLE, timestamp);
+}
+
+std::string VsyncStation::GetCallbackCostInfo() const
+{
+    std::string info;
+    for (size_t i = 0; i < CALLBACK_TYPE_NUM; i++) {
+        info += std::string(CALLBACK_TYPE_NAMES[i]) + ": " + callbackCosts_[i].ToString() + "\n";
+    }
+    return info;
+}
+
+void VsyncStation::ResetCallbackCosts()
+{
+    for (auto& callbackCost : callbackCosts_) {
+        callbackCost.Reset();
     }
 }
 
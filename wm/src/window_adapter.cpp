@@ -153,6 +153,11 @@ WMError WindowAdapter::GetSystemDecorEnable(bool& isSystemDecorEnable)
 {
     INIT_PROXY_CHECK_RETURN(WMError::WM_ERROR_SAMGR);
 
+    WindowStateSnapshot snapshot;
+    if (ReadWindowState(snapshot)) {
+        isSystemDecorEnable = snapshot.isSystemDecorEnable_ != 0;
+        return WMError::WM_OK;
+    }
     return windowManagerServiceProxy_->GetSystemDecorEnable(isSystemDecorEnable);
 }
 
@@ -207,6 +212,38 @@ void WindowAdapter::ClearWindowAdapter()
     }
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     isProxyValid_ = false;
+    windowStatePage_ = nullptr;
+    isWindowStatePageRequested_ = false;
+}
+
+sptr<Ashmem> WindowAdapter::GetWindowStatePage()
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (windowStatePage_ != nullptr || isWindowStatePageRequested_) {
+        return windowStatePage_;
+    }
+    // asked once per service connection, a service without the page keeps being queried by IPC
+    isWindowStatePageRequested_ = true;
+    sptr<Ashmem> page = windowManagerServiceProxy_->GetWindowStatePage();
+    if (page == nullptr || !page->MapReadOnlyAshmem()) {
+        WLOGFW("window state page is not available");
+        return nullptr;
+    }
+    windowStatePage_ = page;
+    return windowStatePage_;
+}
+
+bool WindowAdapter::ReadWindowState(WindowStateSnapshot& snapshot)
+{
+    INIT_PROXY_CHECK_RETURN(false);
+
+    // the reference keeps the page mapped while it is read, even if the service dies meanwhile
+    sptr<Ashmem> page = GetWindowStatePage();
+    if (page == nullptr) {
+        return false;
+    }
+    auto addr = static_cast<const WindowStatePage*>(page->ReadFromAshmem(sizeof(WindowStatePage), 0));
+    return addr != nullptr && ReadWindowStatePage(*addr, snapshot);
 }
 
 void WMSDeathRecipient::OnRemoteDied(const wptr<IRemoteObject>& wptrDeath)
@@ -228,6 +265,11 @@ WMError WindowAdapter::GetTopWindowId(uint32_t mainWinId, uint32_t& topWinId)
 {
     INIT_PROXY_CHECK_RETURN(WMError::WM_ERROR_SAMGR);
 
+    // main windows missing from the page are hidden ones or beyond its table, let the service answer them
+    WindowStateSnapshot snapshot;
+    if (ReadWindowState(snapshot) && FindTopWindowId(snapshot, mainWinId, topWinId)) {
+        return WMError::WM_OK;
+    }
     return windowManagerServiceProxy_->GetTopWindowId(mainWinId, topWinId);
 }
 
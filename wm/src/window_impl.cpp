@@ -19,6 +19,7 @@
 
 #include <ability_manager_client.h>
 
+#include "avoid_area_cache.h"
 #include "color_parser.h"
 #include "display_manager.h"
 #include "singleton_container.h"
@@ -26,6 +27,7 @@
 #include "window_agent.h"
 #include "window_helper.h"
 #include "window_manager_hilog.h"
+#include "window_registry.h"
 #include "wm_common.h"
 #include "wm_common_inner.h"
 
@@ -33,6 +35,9 @@ namespace OHOS {
 namespace Rosen {
 namespace {
     constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WindowImpl"};
+    const std::string PARAM_DUMP_INPUT_LATENCY = "-inputlatency";
+    const std::string PARAM_DUMP_RESET = "reset";
+    const std::string PARAM_DUMP_VSYNC = "-vsync";
 }
 
 const WindowImpl::ColorSpaceConvertMap WindowImpl::colorSpaceConvertMap[] = {
@@ -40,10 +45,6 @@ const WindowImpl::ColorSpaceConvertMap WindowImpl::colorSpaceConvertMap[] = {
     { ColorSpace::COLOR_SPACE_WIDE_GAMUT, COLOR_GAMUT_DCI_P3 },
 };
 
-std::map<std::string, std::pair<uint32_t, sptr<Window>>> WindowImpl::windowMap_;
-std::map<uint32_t, std::vector<sptr<WindowImpl>>> WindowImpl::subWindowMap_;
-std::map<uint32_t, std::vector<sptr<WindowImpl>>> WindowImpl::appFloatingWindowMap_;
-
 WindowImpl::WindowImpl(const sptr<WindowOption>& option)
 {
     property_ = new (std::nothrow) WindowProperty();
@@ -62,6 +63,7 @@ WindowImpl::WindowImpl(const sptr<WindowOption>& option)
     property_->SetHitOffset(option->GetHitOffset());
     property_->SetRequestedOrientation(option->GetRequestedOrientation());
     windowTag_ = option->GetWindowTag();
+    isSpeculativeShowEnabled_ = option->IsSpeculativeShowEnabled();
     property_->SetTurnScreenOn(option->IsTurnScreenOn());
     property_->SetKeepScreenOn(option->IsKeepScreenOn());
     property_->SetBrightness(option->GetBrightness());
@@ -72,6 +74,7 @@ WindowImpl::WindowImpl(const sptr<WindowOption>& option)
     }
     name_ = option->GetWindowName();
     callback_->onCallback = std::bind(&WindowImpl::OnVsync, this, std::placeholders::_1);
+    idleCallback_->onCallback = [this](int64_t) { inputLatencyTracker_->FlushFrames(); };
 
     struct RSSurfaceNodeConfig rsSurfaceNodeConfig;
     rsSurfaceNodeConfig.SurfaceNodeName = property_->GetWindowName();
@@ -85,11 +88,7 @@ WindowImpl::~WindowImpl()
 
 sptr<Window> WindowImpl::Find(const std::string& name)
 {
-    auto iter = windowMap_.find(name);
-    if (iter == windowMap_.end()) {
-        return nullptr;
-    }
-    return iter->second.second;
+    return WindowRegistry::GetInstance().FindByName(name);
 }
 
 const std::shared_ptr<AbilityRuntime::Context> WindowImpl::GetContext() const
@@ -99,18 +98,18 @@ const std::shared_ptr<AbilityRuntime::Context> WindowImpl::GetContext() const
 
 sptr<Window> WindowImpl::FindTopWindow(uint32_t topWinId)
 {
-    if (windowMap_.empty()) {
+    auto& registry = WindowRegistry::GetInstance();
+    if (registry.IsEmpty()) {
         WLOGFE("Please create mainWindow First!");
         return nullptr;
     }
-    for (auto iter = windowMap_.begin(); iter != windowMap_.end(); iter++) {
-        if (topWinId == iter->second.first) {
-            WLOGFI("FindTopWindow id: %{public}u", topWinId);
-            return iter->second.second;
-        }
+    sptr<WindowImpl> window = registry.FindById(topWinId);
+    if (window == nullptr) {
+        WLOGFE("Cannot find topWindow!");
+        return nullptr;
     }
-    WLOGFE("Cannot find topWindow!");
-    return nullptr;
+    WLOGFI("FindTopWindow id: %{public}u", topWinId);
+    return window;
 }
 
 sptr<Window> WindowImpl::GetTopWindowWithId(uint32_t mainWinId)
@@ -126,18 +125,16 @@ sptr<Window> WindowImpl::GetTopWindowWithId(uint32_t mainWinId)
 
 sptr<Window> WindowImpl::GetTopWindowWithContext(const std::shared_ptr<AbilityRuntime::Context>& context)
 {
-    if (windowMap_.empty()) {
+    auto& registry = WindowRegistry::GetInstance();
+    if (registry.IsEmpty()) {
         WLOGFE("Please create mainWindow First!");
         return nullptr;
     }
     uint32_t mainWinId = INVALID_WINDOW_ID;
-    for (auto iter = windowMap_.begin(); iter != windowMap_.end(); iter++) {
-        auto win = iter->second.second;
-        if (context.get() == win->GetContext().get() && WindowHelper::IsMainWindow(win->GetType())) {
-            mainWinId = win->GetWindowId();
-            WLOGFI("GetTopWindow Find MainWinId:%{public}u.", mainWinId);
-            break;
-        }
+    sptr<WindowImpl> mainWindow = registry.FindMainWindowByContext(context.get());
+    if (mainWindow != nullptr) {
+        mainWinId = mainWindow->GetWindowId();
+        WLOGFI("GetTopWindow Find MainWinId:%{public}u.", mainWinId);
     }
     WLOGFI("GetTopWindowfinal MainWinId:%{public}u!", mainWinId);
     if (mainWinId == INVALID_WINDOW_ID) {
@@ -155,11 +152,12 @@ sptr<Window> WindowImpl::GetTopWindowWithContext(const std::shared_ptr<AbilityRu
 
 std::vector<sptr<Window>> WindowImpl::GetSubWindow(uint32_t parentId)
 {
-    if (subWindowMap_.find(parentId) == subWindowMap_.end()) {
+    auto subWindows = WindowRegistry::GetInstance().GetSubWindows(parentId);
+    if (subWindows.empty()) {
         WLOGFE("Cannot parentWindow with id: %{public}u!", parentId);
         return std::vector<sptr<Window>>();
     }
-    return std::vector<sptr<Window>>(subWindowMap_[parentId].begin(), subWindowMap_[parentId].end());
+    return std::vector<sptr<Window>>(subWindows.begin(), subWindows.end());
 }
 
 std::shared_ptr<RSSurfaceNode> WindowImpl::GetSurfaceNode() const
@@ -261,18 +259,44 @@ WMError WindowImpl::GetAvoidAreaByType(AvoidAreaType type, AvoidArea& avoidArea)
 {
     WLOGFI("GetAvoidAreaByType  Search Type: %{public}u", static_cast<uint32_t>(type));
     std::vector<Rect> avoidAreaVec;
+    auto& cache = AvoidAreaCache::GetInstance();
+    DisplayId displayId = property_->GetDisplayId();
+    bool isCacheable = IsAvoidAreaCacheable();
+    // 4: the avoid area num (left, top, right, bottom)
+    if (isCacheable && cache.GetAvoidArea(displayId, type, avoidAreaVec) && avoidAreaVec.size() == 4) {
+        avoidArea = {avoidAreaVec[0], avoidAreaVec[1], avoidAreaVec[2], avoidAreaVec[3]};
+        return WMError::WM_OK;
+    }
+    uint64_t version = cache.GetVersion(displayId);
     uint32_t windowId = property_->GetWindowId();
-    WMError ret = SingletonContainer::Get<WindowAdapter>().GetAvoidAreaByType(windowId, type, avoidAreaVec);
+    WMError ret = GetWindowAdapter().GetAvoidAreaByType(windowId, type, avoidAreaVec);
     if (ret != WMError::WM_OK || avoidAreaVec.size() != 4) {    // 4: the avoid area num (left, top, right, bottom)
         WLOGFE("GetAvoidAreaByType errCode:%{public}d winId:%{public}u Type is :%{public}u." \
             "Or avoidArea Size != 4. Current size of avoid area: %{public}u", static_cast<int32_t>(ret),
             property_->GetWindowId(), static_cast<uint32_t>(type), static_cast<uint32_t>(avoidAreaVec.size()));
         return ret;
     }
+    if (isCacheable) {
+        cache.SetAvoidArea(displayId, type, avoidAreaVec, version);
+    }
     avoidArea = {avoidAreaVec[0], avoidAreaVec[1], avoidAreaVec[2], avoidAreaVec[3]}; // 0:left 1:top 2:right 3:bottom
     return ret;
 }
 
+bool WindowImpl::IsAvoidAreaCacheable() const
+{
+    // shown app main windows receive every avoid area change of their display
+    return state_ == WindowState::STATE_SHOWN && WindowHelper::IsMainWindow(property_->GetWindowType());
+}
+
+void WindowImpl::InvalidateAvoidAreaCache()
+{
+    // the display may be left without a window that receives avoid area changes
+    if (WindowHelper::IsMainWindow(property_->GetWindowType())) {
+        AvoidAreaCache::GetInstance().Invalidate(property_->GetDisplayId());
+    }
+}
+
 WMError WindowImpl::SetWindowType(WindowType type)
 {
     WLOGFI("window id: %{public}u, type:%{public}u.", property_->GetWindowId(), static_cast<uint32_t>(type));
@@ -328,7 +352,7 @@ WMError WindowImpl::SetWindowBackgroundBlur(WindowBlurLevel level)
         return WMError::WM_ERROR_INVALID_WINDOW;
     }
     property_->SetWindowBackgroundBlur(level);
-    return SingletonContainer::Get<WindowAdapter>().SetWindowBackgroundBlur(property_->GetWindowId(), level);
+    return GetWindowAdapter().SetWindowBackgroundBlur(property_->GetWindowId(), level);
 }
 
 WMError WindowImpl::SetAlpha(float alpha)
@@ -338,7 +362,7 @@ WMError WindowImpl::SetAlpha(float alpha)
         return WMError::WM_ERROR_INVALID_WINDOW;
     }
     property_->SetAlpha(alpha);
-    return SingletonContainer::Get<WindowAdapter>().SetAlpha(property_->GetWindowId(), alpha);
+    return GetWindowAdapter().SetAlpha(property_->GetWindowId(), alpha);
 }
 
 WMError WindowImpl::AddWindowFlag(WindowFlag flag)
@@ -417,7 +441,7 @@ WMError WindowImpl::SetUIContent(const std::string& contentInfo,
     }
     // make uiContent_ available after Initialize/Restore
     uiContent_ = std::move(uiContent);
-    if (state_ == WindowState::STATE_SHOWN) {
+    if (state_ == WindowState::STATE_SHOWN || isRectPredicted_) {
         Ace::ViewportConfig config;
         Rect rect = GetRect();
         config.SetSize(rect.width_, rect.height_);
@@ -490,6 +514,24 @@ ColorSpace WindowImpl::GetColorSpace()
 
 void WindowImpl::DumpInfo(const std::vector<std::string>& params, std::vector<std::string>& info)
 {
+    if (!params.empty() && params[0] == PARAM_DUMP_INPUT_LATENCY) {
+        // "-inputlatency reset" clears the statistics after dumping them
+        info.push_back("window " + std::to_string(GetWindowId()) + " input latency:");
+        inputLatencyTracker_->Dump(info);
+        if (params.size() > 1 && params[1] == PARAM_DUMP_RESET) {
+            inputLatencyTracker_->Reset();
+        }
+        return;
+    }
+    if (!params.empty() && params[0] == PARAM_DUMP_VSYNC) {
+        // the vsync station is shared by all windows of the process, "-vsync reset" clears it after dumping
+        info.push_back("vsync callback cost:");
+        info.push_back(VsyncStation::GetInstance().GetCallbackCostInfo());
+        if (params.size() > 1 && params[1] == PARAM_DUMP_RESET) {
+            VsyncStation::GetInstance().ResetCallbackCosts();
+        }
+        return;
+    }
     WLOGFI("Ace:DumpInfo");
     if (uiContent_ != nullptr) {
         uiContent_->DumpInfo(params, info);
@@ -588,38 +630,49 @@ void WindowImpl::MapFloatingWindowToAppIfNeeded()
         return;
     }
 
-    for (auto& winPair : windowMap_) {
-        auto win = winPair.second.second;
-        if (win->GetType() == WindowType::WINDOW_TYPE_APP_MAIN_WINDOW &&
-            context_.get() == win->GetContext().get()) {
-            appFloatingWindowMap_[win->GetWindowId()].push_back(this);
-            WLOGFI("Map FloatingWindow %{public}u to AppMainWindow %{public}u", GetWindowId(), win->GetWindowId());
-            return;
-        }
+    auto& registry = WindowRegistry::GetInstance();
+    sptr<WindowImpl> win = registry.FindMainWindowByContext(context_.get());
+    if (win != nullptr && win->GetType() == WindowType::WINDOW_TYPE_APP_MAIN_WINDOW) {
+        registry.AddAppFloatingWindow(win->GetWindowId(), this);
+        WLOGFI("Map FloatingWindow %{public}u to AppMainWindow %{public}u", GetWindowId(), win->GetWindowId());
     }
 }
 
 WMError WindowImpl::UpdateProperty(PropertyChangeAction action)
 {
-    return SingletonContainer::Get<WindowAdapter>().UpdateProperty(property_, action);
+    return GetWindowAdapter().UpdateProperty(property_, action);
+}
+
+WindowAdapter& WindowImpl::GetWindowAdapter() const
+{
+    // a speculative AddWindow has to reach server before any other request about this window
+    WaitForAddWindow();
+    return SingletonContainer::Get<WindowAdapter>();
+}
+
+void WindowImpl::SetWindowState(WindowState state)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    state_ = state;
 }
 
 WMError WindowImpl::Create(const std::string& parentName, const std::shared_ptr<AbilityRuntime::Context>& context)
 {
     WLOGFI("[Client] Window Create");
     // check window name, same window names are forbidden
-    if (windowMap_.find(name_) != windowMap_.end()) {
+    auto& registry = WindowRegistry::GetInstance();
+    if (registry.Contains(name_)) {
         WLOGFE("WindowName(%{public}s) already exists.", name_.c_str());
         return WMError::WM_ERROR_INVALID_PARAM;
     }
     // check parent name, if create sub window and there is not exist parent Window, then return
     if (parentName != "") {
-        if (windowMap_.find(parentName) == windowMap_.end()) {
+        sptr<WindowImpl> parentWindow = registry.FindByName(parentName);
+        if (parentWindow == nullptr) {
             WLOGFE("ParentName is empty or valid. ParentName is %{public}s", parentName.c_str());
             return WMError::WM_ERROR_INVALID_PARAM;
         } else {
-            uint32_t parentId = windowMap_[parentName].first;
-            property_->SetParentId(parentId);
+            property_->SetParentId(parentWindow->GetWindowId());
         }
     }
     context_ = context;
@@ -633,73 +686,48 @@ WMError WindowImpl::Create(const std::string& parentName, const std::shared_ptr<
             property_->SetTokenState(true);
         }
     }
+    bool isMainWindow = WindowHelper::IsMainWindow(property_->GetWindowType());
+    if (isMainWindow) {
+        // server clears it in the create reply when system decor is disabled, saving a separate query
+        property_->SetDecorEnable(true);
+    }
     WMError ret = SingletonContainer::Get<WindowAdapter>().CreateWindow(windowAgent, property_, surfaceNode_,
         windowId, token);
     property_->SetWindowId(windowId);
-    if (WindowHelper::IsMainWindow(property_->GetWindowType())) {
-        if (SingletonContainer::Get<WindowAdapter>().GetSystemDecorEnable(isSystemDecorEnable_) == WMError::WM_OK) {
-            WLOGFE("get system decor enable:%{public}d", isSystemDecorEnable_);
-            if (isSystemDecorEnable_) {
-                property_->SetDecorEnable(true);
-            }
-        }
+    if (isMainWindow) {
+        isSystemDecorEnable_ = property_->GetDecorEnable();
+        WLOGFI("system decor enable:%{public}d", isSystemDecorEnable_);
     }
     if (ret != WMError::WM_OK) {
         WLOGFE("create window failed with errCode:%{public}d", static_cast<int32_t>(ret));
         return ret;
     }
-    windowMap_.insert(std::make_pair(name_, std::pair<uint32_t, sptr<Window>>(windowId, this)));
-    if (parentName != "") { // add to subWindowMap_
-        subWindowMap_[property_->GetParentId()].push_back(this);
+    isRectPredicted_ = !WindowHelper::IsEmptyRect(property_->GetWindowRect());
+    // the name check above is not atomic with the registration, a concurrent create may have taken the name
+    if (!registry.Add(window, parentName != "" ? property_->GetParentId() : INVALID_WINDOW_ID)) {
+        SingletonContainer::Get<WindowAdapter>().DestroyWindow(windowId);
+        return WMError::WM_ERROR_INVALID_PARAM;
     }
 
     MapFloatingWindowToAppIfNeeded();
 
-    state_ = WindowState::STATE_CREATED;
-    InputTransferStation::GetInstance().AddInputWindow(this);
+    SetWindowState(WindowState::STATE_CREATED);
+    InputTransferStation::GetInstance().AddInputWindow(this, inputLatencyTracker_);
     return ret;
 }
 
 void WindowImpl::DestroyFloatingWindow()
 {
-    // remove from appFloatingWindowMap_
-    for (auto& floatingWindows: appFloatingWindowMap_) {
-        for (auto iter = floatingWindows.second.begin(); iter != floatingWindows.second.end(); ++iter) {
-            if ((*iter)->GetWindowId() == GetWindowId()) {
-                floatingWindows.second.erase(iter);
-                break;
-            }
-        }
-    }
-
     // Destroy app floating window if exist
-    if (appFloatingWindowMap_.count(GetWindowId()) > 0) {
-        for (auto& floatingWindow : appFloatingWindowMap_.at(GetWindowId())) {
-            floatingWindow->Destroy();
-        }
-        appFloatingWindowMap_.erase(GetWindowId());
+    for (auto& floatingWindow : WindowRegistry::GetInstance().TakeAppFloatingWindows(GetWindowId())) {
+        floatingWindow->Destroy();
     }
 }
 
 void WindowImpl::DestroySubWindow()
 {
-    if (subWindowMap_.count(property_->GetParentId()) > 0) { // remove from subWindowMap_
-        std::vector<sptr<WindowImpl>>& subWindows = subWindowMap_.at(property_->GetParentId());
-        for (auto iter = subWindows.begin(); iter < subWindows.end(); ++iter) {
-            if ((*iter)->GetWindowId() == GetWindowId()) {
-                subWindows.erase(iter);
-                break;
-            }
-        }
-    }
-
-    if (subWindowMap_.count(GetWindowId()) > 0) { // remove from subWindowMap_ and windowMap_
-        std::vector<sptr<WindowImpl>>& subWindows = subWindowMap_.at(GetWindowId());
-        for (auto& subWindow : subWindows) {
-            subWindow->Destroy(false);
-        }
-        subWindowMap_[GetWindowId()].clear();
-        subWindowMap_.erase(GetWindowId());
+    for (auto& subWindow : WindowRegistry::GetInstance().TakeSubWindows(GetWindowId())) {
+        subWindow->Destroy(false);
     }
 }
 
@@ -715,16 +743,15 @@ WMError WindowImpl::Destroy(bool needNotifyServer)
     }
 
     WLOGFI("[Client] Window %{public}u Destroy", property_->GetWindowId());
+    WaitForSpeculativeShow();
     InputTransferStation::GetInstance().RemoveInputWindow(this);
     WMError ret = WMError::WM_OK;
     if (needNotifyServer) {
         NotifyBeforeDestroy(GetWindowName());
-        if (subWindowMap_.count(GetWindowId()) > 0) {
-            for (auto& subWindow : subWindowMap_.at(GetWindowId())) {
-                NotifyBeforeSubWindowDestroy(subWindow);
-            }
+        for (auto& subWindow : WindowRegistry::GetInstance().GetSubWindows(GetWindowId())) {
+            NotifyBeforeSubWindowDestroy(subWindow);
         }
-        ret = SingletonContainer::Get<WindowAdapter>().DestroyWindow(property_->GetWindowId());
+        ret = GetWindowAdapter().DestroyWindow(property_->GetWindowId());
         if (ret != WMError::WM_OK) {
             WLOGFE("destroy window failed with errCode:%{public}d", static_cast<int32_t>(ret));
             return ret;
@@ -733,13 +760,16 @@ WMError WindowImpl::Destroy(bool needNotifyServer)
         WLOGFI("Do not need to notify server to destroy window");
     }
 
-    windowMap_.erase(GetWindowName());
+    // also drops the window from its parent's sub windows and from the app floating windows
+    WindowRegistry::GetInstance().Remove(GetWindowId());
     DestroySubWindow();
     DestroyFloatingWindow();
     {
         std::lock_guard<std::recursive_mutex> lock(mutex_);
-        state_ = WindowState::STATE_DESTROYED;
+        SetWindowState(WindowState::STATE_DESTROYED);
+        InvalidateAvoidAreaCache();
         VsyncStation::GetInstance().RemoveCallback(VsyncStation::CallbackType::CALLBACK_FRAME, callback_);
+        VsyncStation::GetInstance().RemoveCallback(VsyncStation::CallbackType::CALLBACK_IDLE, idleCallback_);
     }
     return ret;
 }
@@ -759,7 +789,7 @@ WMError WindowImpl::Show(uint32_t reason)
 
     WindowStateChangeReason stateChangeReason = static_cast<WindowStateChangeReason>(reason);
     if (stateChangeReason == WindowStateChangeReason::KEYGUARD) {
-        state_ = WindowState::STATE_SHOWN;
+        SetWindowState(WindowState::STATE_SHOWN);
         NotifyAfterForeground();
         return WMError::WM_OK;
     }
@@ -770,10 +800,10 @@ WMError WindowImpl::Show(uint32_t reason)
     if (state_ == WindowState::STATE_SHOWN) {
         if (property_->GetWindowType() == WindowType::WINDOW_TYPE_DESKTOP) {
             WLOGFI("desktop window [id:%{public}u] is shown, minimize all app windows", property_->GetWindowId());
-            SingletonContainer::Get<WindowAdapter>().MinimizeAllAppWindows(property_->GetDisplayId());
+            GetWindowAdapter().MinimizeAllAppWindows(property_->GetDisplayId());
         } else {
             WLOGFI("window is already shown id: %{public}u, raise to top", property_->GetWindowId());
-            SingletonContainer::Get<WindowAdapter>().ProcessPointDown(property_->GetWindowId());
+            GetWindowAdapter().ProcessPointDown(property_->GetWindowId());
         }
         for (auto& listener : lifecycleListeners_) {
             if (listener != nullptr) {
@@ -783,9 +813,12 @@ WMError WindowImpl::Show(uint32_t reason)
         return WMError::WM_OK;
     }
     SetDefaultOption();
+    if (isSpeculativeShowEnabled_) {
+        return ShowSpeculatively();
+    }
     WMError ret = SingletonContainer::Get<WindowAdapter>().AddWindow(property_);
     if (ret == WMError::WM_OK || ret == WMError::WM_ERROR_DEATH_RECIPIENT) {
-        state_ = WindowState::STATE_SHOWN;
+        SetWindowState(WindowState::STATE_SHOWN);
         NotifyAfterForeground();
     } else {
         WLOGFE("show errCode:%{public}d for winId:%{public}u", static_cast<int32_t>(ret), property_->GetWindowId());
@@ -793,6 +826,81 @@ WMError WindowImpl::Show(uint32_t reason)
     return ret;
 }
 
+WMError WindowImpl::ShowSpeculatively()
+{
+    // AddWindow goes on in the background, so the app draws its first frame while server places the window.
+    // A failed add rolls the window back to hidden on the main thread, or on the next call which waits for it.
+    WaitForSpeculativeShow();
+    sptr<WindowProperty> property = new (std::nothrow) WindowProperty(property_);
+    if (property == nullptr) {
+        return WMError::WM_ERROR_NULLPTR;
+    }
+    std::shared_ptr<AppExecFwk::EventHandler> mainHandler;
+    auto mainEventRunner = AppExecFwk::EventRunner::GetMainEventRunner();
+    if (mainEventRunner != nullptr) {
+        mainHandler = std::make_shared<AppExecFwk::EventHandler>(mainEventRunner);
+    }
+    // the worker must never own the window: the last reference released there would destroy the future it runs
+    wptr<WindowImpl> weakWindow(this);
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        pendingAddWindow_ = std::async(std::launch::async, [weakWindow, property, mainHandler]() mutable {
+            WMError ret = SingletonContainer::Get<WindowAdapter>().AddWindow(property);
+            if (ret != WMError::WM_OK && ret != WMError::WM_ERROR_DEATH_RECIPIENT && mainHandler != nullptr) {
+                mainHandler->PostTask([weakWindow]() {
+                    auto window = weakWindow.promote();
+                    if (window != nullptr) {
+                        window->WaitForSpeculativeShow();
+                    }
+                });
+            }
+            return ret;
+        }).share();
+        SetWindowState(WindowState::STATE_SHOWN);
+    }
+    NotifyAfterForeground();
+    return WMError::WM_OK;
+}
+
+void WindowImpl::WaitForAddWindow() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (pendingAddWindow_.valid()) {
+        pendingAddWindow_.wait();
+    }
+}
+
+void WindowImpl::WaitForSpeculativeShow()
+{
+    WMError ret = WMError::WM_OK;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (!pendingAddWindow_.valid()) {
+            return;
+        }
+        ret = pendingAddWindow_.get();
+        pendingAddWindow_ = std::shared_future<WMError>();
+    }
+    if (ret != WMError::WM_OK && ret != WMError::WM_ERROR_DEATH_RECIPIENT) {
+        OnSpeculativeShowFailed(ret);
+    }
+}
+
+void WindowImpl::OnSpeculativeShowFailed(WMError ret)
+{
+    WLOGFE("speculative show errCode:%{public}d for winId:%{public}u", static_cast<int32_t>(ret),
+        property_->GetWindowId());
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (state_ != WindowState::STATE_SHOWN) {
+            return;
+        }
+        SetWindowState(WindowState::STATE_HIDDEN);
+        InvalidateAvoidAreaCache();
+    }
+    NotifyAfterBackground();
+}
+
 WMError WindowImpl::Hide(uint32_t reason)
 {
     WLOGFI("[Client] Window [name:%{public}s, id:%{public}u] Hide", name_.c_str(), property_->GetWindowId());
@@ -801,20 +909,22 @@ WMError WindowImpl::Hide(uint32_t reason)
     }
     WindowStateChangeReason stateChangeReason = static_cast<WindowStateChangeReason>(reason);
     if (stateChangeReason == WindowStateChangeReason::KEYGUARD) {
-        state_ = WindowState::STATE_FROZEN;
+        SetWindowState(WindowState::STATE_FROZEN);
         NotifyAfterBackground();
         return WMError::WM_OK;
     }
+    WaitForSpeculativeShow();
     if (state_ == WindowState::STATE_HIDDEN || state_ == WindowState::STATE_CREATED) {
         WLOGFI("window is already hidden id: %{public}u", property_->GetWindowId());
         return WMError::WM_OK;
     }
-    WMError ret = SingletonContainer::Get<WindowAdapter>().RemoveWindow(property_->GetWindowId());
+    WMError ret = GetWindowAdapter().RemoveWindow(property_->GetWindowId());
     if (ret != WMError::WM_OK) {
         WLOGFE("hide errCode:%{public}d for winId:%{public}u", static_cast<int32_t>(ret), property_->GetWindowId());
         return ret;
     }
-    state_ = WindowState::STATE_HIDDEN;
+    SetWindowState(WindowState::STATE_HIDDEN);
+    InvalidateAvoidAreaCache();
     NotifyAfterBackground();
     return ret;
 }
@@ -1108,7 +1218,7 @@ WMError WindowImpl::RequestFocus() const
     if (!IsWindowValid()) {
         return WMError::WM_ERROR_INVALID_WINDOW;
     }
-    return SingletonContainer::Get<WindowAdapter>().RequestFocus(property_->GetWindowId());
+    return GetWindowAdapter().RequestFocus(property_->GetWindowId());
 }
 
 void WindowImpl::AddInputEventListener(const std::shared_ptr<MMI::IInputEventConsumer>& inputEventListener)
@@ -1313,6 +1423,8 @@ void WindowImpl::UpdateRect(const struct Rect& rect, bool decoStatus, WindowSize
         property_->SetRequestRect(rect);
         return;
     }
+    // ace already laid out at the predicted rect, no need to do it again when the prediction was right
+    bool isPredictedRectHit = ConsumeRectPrediction(rect);
     property_->SetWindowRect(rect);
     WLOGFI("sizeChange callback size: %{public}lu", (unsigned long)windowChangeListeners_.size());
     for (auto& listener : windowChangeListeners_) {
@@ -1321,7 +1433,7 @@ void WindowImpl::UpdateRect(const struct Rect& rect, bool decoStatus, WindowSize
         }
     }
 
-    if (uiContent_ != nullptr) {
+    if (uiContent_ != nullptr && !isPredictedRectHit) {
         Ace::ViewportConfig config;
         config.SetSize(rect.width_, rect.height_);
         config.SetPosition(rect.posX_, rect.posY_);
@@ -1331,6 +1443,14 @@ void WindowImpl::UpdateRect(const struct Rect& rect, bool decoStatus, WindowSize
     }
 }
 
+bool WindowImpl::ConsumeRectPrediction(const Rect& rect)
+{
+    // only the first layout after create can match the prediction
+    bool isHit = isRectPredicted_ && rect == property_->GetWindowRect();
+    isRectPredicted_ = false;
+    return isHit;
+}
+
 void WindowImpl::UpdateMode(WindowMode mode)
 {
     WLOGI("UpdateMode %{public}u", mode);
@@ -1454,7 +1574,15 @@ void WindowImpl::HandleModeChangeHotZones(int32_t posX, int32_t posY)
     }
 
     ModeChangeHotZones hotZones;
-    auto res = SingletonContainer::Get<WindowAdapter>().GetModeChangeHotZones(property_->GetDisplayId(), hotZones);
+    auto& cache = AvoidAreaCache::GetInstance();
+    DisplayId displayId = property_->GetDisplayId();
+    WMError res = WMError::WM_OK;
+    if (!cache.GetHotZones(displayId, startDisplayWidth_, startDisplayHeight_, hotZones)) {
+        res = SingletonContainer::Get<WindowAdapter>().GetModeChangeHotZones(displayId, hotZones);
+        if (res == WMError::WM_OK && startDisplayWidth_ != 0) {
+            cache.SetHotZones(displayId, startDisplayWidth_, startDisplayHeight_, hotZones);
+        }
+    }
     WLOGFI("[HotZone] Window %{public}u, Pointer[%{public}d, %{public}d]", GetWindowId(), posX, posY);
     if (res == WMError::WM_OK) {
         WLOGFI("[HotZone] Fullscreen [%{public}d, %{public}d, %{public}u, %{public}u]", hotZones.fullscreen_.posX_,
@@ -1481,13 +1609,13 @@ void WindowImpl::EndMoveOrDragWindow(int32_t posX, int32_t posY, int32_t pointId
     }
 
     if (startDragFlag_) {
-        SingletonContainer::Get<WindowAdapter>().ProcessPointUp(GetWindowId());
+        GetWindowAdapter().ProcessPointUp(GetWindowId());
         startDragFlag_ = false;
     }
 
     if (startMoveFlag_) {
         if (GetType() == WindowType::WINDOW_TYPE_DOCK_SLICE) {
-            SingletonContainer::Get<WindowAdapter>().ProcessPointUp(GetWindowId());
+            GetWindowAdapter().ProcessPointUp(GetWindowId());
         }
         startMoveFlag_ = false;
         HandleModeChangeHotZones(posX, posY);
@@ -1514,6 +1642,8 @@ void WindowImpl::ReadyToMoveOrDragWindow(int32_t globalX, int32_t globalY, int32
         return;
     }
     float virtualPixelRatio = display->GetVirtualPixelRatio();
+    startDisplayWidth_ = static_cast<uint32_t>(display->GetWidth());
+    startDisplayHeight_ = static_cast<uint32_t>(display->GetHeight());
 
     startRectExceptFrame_.posX_ = startPointRect_.posX_ +
         static_cast<int32_t>(WINDOW_FRAME_WIDTH * virtualPixelRatio);
@@ -1535,12 +1665,12 @@ void WindowImpl::ReadyToMoveOrDragWindow(int32_t globalX, int32_t globalY, int32
 
     if (GetType() == WindowType::WINDOW_TYPE_DOCK_SLICE) {
         startMoveFlag_ = true;
-        SingletonContainer::Get<WindowAdapter>().ProcessPointDown(property_->GetWindowId(), true);
+        GetWindowAdapter().ProcessPointDown(property_->GetWindowId(), true);
     } else if (!WindowHelper::IsPointInTargetRect(startPointPosX_, startPointPosY_, startRectExceptFrame_) ||
         (WindowHelper::IsPointInTargetRect(startPointPosX_, startPointPosY_, startRectExceptFrame_) &&
         (!WindowHelper::IsPointInWindowExceptCorner(startPointPosX_, startPointPosY_, startRectExceptCorner_)))) {
         startDragFlag_ = true;
-        SingletonContainer::Get<WindowAdapter>().ProcessPointDown(property_->GetWindowId(), true);
+        GetWindowAdapter().ProcessPointDown(property_->GetWindowId(), true);
     }
     return;
 }
@@ -1619,7 +1749,7 @@ void WindowImpl::ConsumePointerEvent(std::shared_ptr<MMI::PointerEvent>& pointer
                 return;
             }
         }
-        SingletonContainer::Get<WindowAdapter>().ProcessPointDown(property_->GetWindowId());
+        GetWindowAdapter().ProcessPointDown(property_->GetWindowId());
     }
 
     if (WindowHelper::IsMainFloatingWindow(GetType(), GetMode()) ||
@@ -1642,11 +1772,16 @@ void WindowImpl::ConsumePointerEvent(std::shared_ptr<MMI::PointerEvent>& pointer
     }
     WLOGFI("Transfer pointer event to ACE");
     uiContent_->ProcessPointerEvent(pointerEvent);
+    inputLatencyTracker_->OnEventConsumed(pointerEvent->GetId());
 }
 
 void WindowImpl::OnVsync(int64_t timeStamp)
 {
     uiContent_->ProcessVsyncEvent(static_cast<uint64_t>(timeStamp));
+    if (inputLatencyTracker_->OnFrame()) {
+        // latency statistics are not needed for drawing, they are accounted when the vsync has time left
+        VsyncStation::GetInstance().RequestVsync(VsyncStation::CallbackType::CALLBACK_IDLE, idleCallback_);
+    }
 }
 
 void WindowImpl::RequestFrame()
@@ -1675,10 +1810,7 @@ void WindowImpl::UpdateConfiguration(const std::shared_ptr<AppExecFwk::Configura
         WLOGFD("notify ace winId:%{public}u", GetWindowId());
         uiContent_->UpdateConfiguration(configuration);
     }
-    if (subWindowMap_.count(GetWindowId()) == 0) {
-        return;
-    }
-    for (auto& subWindow : subWindowMap_.at(GetWindowId())) {
+    for (auto& subWindow : WindowRegistry::GetInstance().GetSubWindows(GetWindowId())) {
         subWindow->UpdateConfiguration(configuration);
     }
 }
@@ -1686,6 +1818,11 @@ void WindowImpl::UpdateConfiguration(const std::shared_ptr<AppExecFwk::Configura
 void WindowImpl::UpdateAvoidArea(const std::vector<Rect>& avoidArea)
 {
     WLOGFI("Window Update AvoidArea, id: %{public}u", property_->GetWindowId());
+    AvoidAreaCache::GetInstance().OnSystemAvoidAreaChanged(property_->GetDisplayId(), avoidArea);
+    // every app window of the display is told to keep the cache current, listeners still only hear fullscreen ones
+    if (GetMode() != WindowMode::WINDOW_MODE_FULLSCREEN) {
+        return;
+    }
     for (auto& listener : avoidAreaChangeListeners_) {
         if (listener != nullptr) {
             listener->OnAvoidAreaChanged(avoidArea);
@@ -1707,7 +1844,7 @@ void WindowImpl::UpdateWindowState(WindowState state)
                 AAFwk::AbilityManagerClient::GetInstance()->DoAbilityBackground(abilityContext->GetToken(),
                     static_cast<uint32_t>(WindowStateChangeReason::KEYGUARD));
             } else {
-                state_ = WindowState::STATE_FROZEN;
+                SetWindowState(WindowState::STATE_FROZEN);
                 NotifyAfterBackground();
             }
             break;
@@ -1718,7 +1855,7 @@ void WindowImpl::UpdateWindowState(WindowState state)
                 AAFwk::AbilityManagerClient::GetInstance()->DoAbilityForeground(abilityContext->GetToken(),
                     static_cast<uint32_t>(WindowStateChangeReason::KEYGUARD));
             } else {
-                state_ = WindowState::STATE_SHOWN;
+                SetWindowState(WindowState::STATE_SHOWN);
                 NotifyAfterForeground();
             }
             break;
@@ -1745,6 +1882,7 @@ void WindowImpl::UpdateDragEvent(const PointInfo& point, DragEvent event)
 void WindowImpl::UpdateDisplayId(DisplayId from, DisplayId to)
 {
     WLOGFD("update displayId. win %{public}u", GetWindowId());
+    InvalidateAvoidAreaCache();
     for (auto& listener : displayMoveListeners_) {
         if (listener != nullptr) {
             listener->OnDisplayMove(from, to);
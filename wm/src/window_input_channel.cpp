@@ -21,8 +21,12 @@ namespace OHOS {
 namespace Rosen {
 namespace {
     constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WindowInputChannel"};
+    constexpr int64_t NANOSECONDS_PER_MICROSECOND = 1000;
+    constexpr uint32_t MOVE_EVENT_LOG_SAMPLE_INTERVAL = 64;
 }
-WindowInputChannel::WindowInputChannel(const sptr<Window>& window): window_(window), isAvailable_(true)
+WindowInputChannel::WindowInputChannel(const sptr<Window>& window,
+    const std::shared_ptr<InputLatencyTracker>& latencyTracker)
+    : window_(window), isAvailable_(true), latencyTracker_(latencyTracker)
 {
     callback_->onCallback = std::bind(&WindowInputChannel::OnVsync, this, std::placeholders::_1);
 }
@@ -43,8 +47,9 @@ void WindowInputChannel::HandleKeyEvent(std::shared_ptr<MMI::KeyEvent>& keyEvent
     }
     if (!isKeyboardEvent || !inputMethodHasProcessed) {
         WLOGFI("dispatch keyEvent to ACE");
-        if (inputListener_ != nullptr) {
-            inputListener_->OnInputEvent(keyEvent);
+        auto inputListener = GetInputListener();
+        if (inputListener != nullptr) {
+            inputListener->OnInputEvent(keyEvent);
             return;
         }
         window_->ConsumeKeyEvent(keyEvent);
@@ -58,13 +63,14 @@ void WindowInputChannel::HandlePointerEvent(std::shared_ptr<MMI::PointerEvent>&
         WLOGFE("pointerEvent is nullptr");
         return;
     }
-    if (inputListener_ != nullptr) {
+    auto inputListener = GetInputListener();
+    if (inputListener != nullptr) {
         int32_t action = pointerEvent->GetPointerAction();
         if (action == MMI::PointerEvent::POINTER_ACTION_DOWN ||
             action == MMI::PointerEvent::POINTER_ACTION_BUTTON_DOWN) {
             window_->ConsumePointerEvent(pointerEvent);
         }
-        inputListener_->OnInputEvent(pointerEvent);
+        inputListener->OnInputEvent(pointerEvent);
         return;
     }
     if (pointerEvent->GetPointerAction() == MMI::PointerEvent::POINTER_ACTION_MOVE) {
@@ -73,6 +79,7 @@ void WindowInputChannel::HandlePointerEvent(std::shared_ptr<MMI::PointerEvent>&
             std::lock_guard<std::mutex> lock(mtx_);
             pointerEventTemp = moveEvent_;
             moveEvent_ = pointerEvent;
+            resampler_.AddSample(pointerEvent);
             if (isAvailable_) {
                 VsyncStation::GetInstance().RequestVsync(VsyncStation::CallbackType::CALLBACK_INPUT, callback_);
             } else {
@@ -80,15 +87,22 @@ void WindowInputChannel::HandlePointerEvent(std::shared_ptr<MMI::PointerEvent>&
                 pointerEvent->MarkProcessed();
             }
         }
-        WLOGFI("Receive move event, windowId: %{public}u, action: %{public}d",
-            window_->GetWindowId(), pointerEvent->GetPointerAction());
+        if (moveEventCount_.fetch_add(1, std::memory_order_relaxed) % MOVE_EVENT_LOG_SAMPLE_INTERVAL == 0) {
+            WLOGFD("Receive move event, windowId: %{public}u, action: %{public}d",
+                window_->GetWindowId(), pointerEvent->GetPointerAction());
+        }
         if (pointerEventTemp != nullptr) {
             pointerEventTemp->MarkProcessed();
         }
     } else {
         WLOGFI("Dispatch non-move event, windowId: %{public}u, action: %{public}d",
             window_->GetWindowId(), pointerEvent->GetPointerAction());
-        window_->ConsumePointerEvent(pointerEvent);
+        {
+            // a new or finished touch must not be resampled against the positions of the previous one
+            std::lock_guard<std::mutex> lock(mtx_);
+            resampler_.ClearPointer(pointerEvent->GetPointerId());
+        }
+        DispatchPointerEvent(pointerEvent);
         pointerEvent->MarkProcessed();
     }
 }
@@ -100,20 +114,48 @@ void WindowInputChannel::OnVsync(int64_t timeStamp)
         std::lock_guard<std::mutex> lock(mtx_);
         pointerEvent = moveEvent_;
         moveEvent_ = nullptr;
+        if (pointerEvent != nullptr) {
+            resampler_.Resample(pointerEvent, timeStamp / NANOSECONDS_PER_MICROSECOND);
+        }
     }
     if (pointerEvent == nullptr) {
         WLOGFE("moveEvent_ is nullptr");
         return;
     }
-    WLOGFI("Dispatch move event, windowId: %{public}u, action: %{public}d",
-        window_->GetWindowId(), pointerEvent->GetPointerAction());
-    window_->ConsumePointerEvent(pointerEvent);
+    if (moveEventCount_.load(std::memory_order_relaxed) % MOVE_EVENT_LOG_SAMPLE_INTERVAL == 0) {
+        WLOGFD("Dispatch move event, windowId: %{public}u, action: %{public}d",
+            window_->GetWindowId(), pointerEvent->GetPointerAction());
+    }
+    DispatchPointerEvent(pointerEvent);
     pointerEvent->MarkProcessed();
 }
 
+void WindowInputChannel::OnPointerEventReceived(const std::shared_ptr<MMI::PointerEvent>& pointerEvent)
+{
+    if (latencyTracker_ != nullptr) {
+        latencyTracker_->OnEventReceived(pointerEvent->GetId(), pointerEvent->GetActionTime());
+    }
+}
+
+void WindowInputChannel::DispatchPointerEvent(std::shared_ptr<MMI::PointerEvent>& pointerEvent)
+{
+    if (latencyTracker_ != nullptr) {
+        latencyTracker_->OnEventDispatched(pointerEvent->GetId());
+    }
+    window_->ConsumePointerEvent(pointerEvent);
+}
+
 void WindowInputChannel::SetInputListener(const std::shared_ptr<MMI::IInputEventConsumer>& listener)
 {
+    std::lock_guard<std::mutex> lock(mtx_);
     inputListener_ = listener;
+    hasInputListener_.store(listener != nullptr, std::memory_order_release);
+}
+
+std::shared_ptr<MMI::IInputEventConsumer> WindowInputChannel::GetInputListener()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return inputListener_;
 }
 
 void WindowInputChannel::Destroy()
@@ -122,6 +164,7 @@ void WindowInputChannel::Destroy()
     WLOGFI("Destroy WindowInputChannel, windowId:%{public}u", window_->GetWindowId());
     isAvailable_ = false;
     VsyncStation::GetInstance().RemoveCallback(VsyncStation::CallbackType::CALLBACK_INPUT, callback_);
+    resampler_.Clear();
     if (moveEvent_ != nullptr) {
         moveEvent_->MarkProcessed();
         moveEvent_ = nullptr;
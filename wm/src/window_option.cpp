@@ -223,6 +223,16 @@ uint32_t WindowOption::GetCallingWindow() const
     return callingWindow_;
 }
 
+void WindowOption::SetSpeculativeShowEnabled(bool enabled)
+{
+    isSpeculativeShowEnabled_ = enabled;
+}
+
+bool WindowOption::IsSpeculativeShowEnabled() const
+{
+    return isSpeculativeShowEnabled_;
+}
+
 Orientation WindowOption::GetRequestedOrientation() const
 {
     return requestedOrientation_;
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_registry.h"
+
+#include <atomic>
+
+#include "window_helper.h"
+#include "window_impl.h"
+#include "window_manager_hilog.h"
+#include "wm_common.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WindowRegistry"};
+}
+WM_IMPLEMENT_SINGLE_INSTANCE(WindowRegistry)
+
+std::shared_ptr<const WindowRegistry::Snapshot> WindowRegistry::Load() const
+{
+    return std::atomic_load(&snapshot_);
+}
+
+void WindowRegistry::Publish(const std::shared_ptr<const Snapshot>& snapshot)
+{
+    std::atomic_store(&snapshot_, snapshot);
+}
+
+void WindowRegistry::RemoveFromList(std::vector<sptr<WindowImpl>>& windows, uint32_t windowId)
+{
+    for (auto iter = windows.begin(); iter != windows.end(); ++iter) {
+        if ((*iter)->GetWindowId() == windowId) {
+            windows.erase(iter);
+            return;
+        }
+    }
+}
+
+bool WindowRegistry::Add(const sptr<WindowImpl>& window, uint32_t parentId)
+{
+    if (window == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    auto snapshot = std::make_shared<Snapshot>(*Load());
+    if (!snapshot->nameMap_.emplace(window->GetWindowName(), window).second) {
+        WLOGFE("WindowName(%{public}s) already registered.", window->GetWindowName().c_str());
+        return false;
+    }
+    uint32_t windowId = window->GetWindowId();
+    snapshot->idMap_[windowId] = window;
+    auto context = window->GetContext().get();
+    if (context != nullptr && WindowHelper::IsMainWindow(window->GetType())) {
+        snapshot->contextMap_.emplace(context, windowId);
+    }
+    if (parentId != INVALID_WINDOW_ID) {
+        snapshot->parentIdMap_[windowId] = parentId;
+        snapshot->subWindowMap_[parentId].push_back(window);
+    }
+    Publish(snapshot);
+    return true;
+}
+
+void WindowRegistry::Remove(uint32_t windowId)
+{
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    auto current = Load();
+    auto windowIter = current->idMap_.find(windowId);
+    if (windowIter == current->idMap_.end()) {
+        return;
+    }
+    auto snapshot = std::make_shared<Snapshot>(*current);
+    sptr<WindowImpl> window = windowIter->second;
+    snapshot->nameMap_.erase(window->GetWindowName());
+    snapshot->idMap_.erase(windowId);
+
+    auto context = window->GetContext().get();
+    auto contextIter = snapshot->contextMap_.find(context);
+    if (contextIter != snapshot->contextMap_.end() && contextIter->second == windowId) {
+        snapshot->contextMap_.erase(contextIter);
+        // another main window of the same ability takes over the context
+        for (auto& item : snapshot->idMap_) {
+            if (item.second->GetContext().get() == context && WindowHelper::IsMainWindow(item.second->GetType())) {
+                snapshot->contextMap_.emplace(context, item.first);
+                break;
+            }
+        }
+    }
+
+    auto parentIter = snapshot->parentIdMap_.find(windowId);
+    if (parentIter != snapshot->parentIdMap_.end()) {
+        auto subIter = snapshot->subWindowMap_.find(parentIter->second);
+        if (subIter != snapshot->subWindowMap_.end()) {
+            RemoveFromList(subIter->second, windowId);
+        }
+        snapshot->parentIdMap_.erase(parentIter);
+    }
+    for (auto& floatingWindows : snapshot->appFloatingWindowMap_) {
+        RemoveFromList(floatingWindows.second, windowId);
+    }
+    Publish(snapshot);
+}
+
+bool WindowRegistry::IsEmpty() const
+{
+    return Load()->nameMap_.empty();
+}
+
+bool WindowRegistry::Contains(const std::string& name) const
+{
+    auto snapshot = Load();
+    return snapshot->nameMap_.find(name) != snapshot->nameMap_.end();
+}
+
+sptr<WindowImpl> WindowRegistry::FindByName(const std::string& name) const
+{
+    auto snapshot = Load();
+    auto iter = snapshot->nameMap_.find(name);
+    return iter == snapshot->nameMap_.end() ? nullptr : iter->second;
+}
+
+sptr<WindowImpl> WindowRegistry::FindById(uint32_t windowId) const
+{
+    auto snapshot = Load();
+    auto iter = snapshot->idMap_.find(windowId);
+    return iter == snapshot->idMap_.end() ? nullptr : iter->second;
+}
+
+sptr<WindowImpl> WindowRegistry::FindMainWindowByContext(const AbilityRuntime::Context* context) const
+{
+    if (context == nullptr) {
+        return nullptr;
+    }
+    auto snapshot = Load();
+    auto iter = snapshot->contextMap_.find(context);
+    if (iter == snapshot->contextMap_.end()) {
+        return nullptr;
+    }
+    auto windowIter = snapshot->idMap_.find(iter->second);
+    return windowIter == snapshot->idMap_.end() ? nullptr : windowIter->second;
+}
+
+std::vector<sptr<WindowImpl>> WindowRegistry::GetSubWindows(uint32_t parentId) const
+{
+    auto snapshot = Load();
+    auto iter = snapshot->subWindowMap_.find(parentId);
+    if (iter == snapshot->subWindowMap_.end()) {
+        return {};
+    }
+    return iter->second;
+}
+
+std::vector<sptr<WindowImpl>> WindowRegistry::TakeSubWindows(uint32_t parentId)
+{
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    auto current = Load();
+    auto iter = current->subWindowMap_.find(parentId);
+    if (iter == current->subWindowMap_.end()) {
+        return {};
+    }
+    std::vector<sptr<WindowImpl>> subWindows = iter->second;
+    auto snapshot = std::make_shared<Snapshot>(*current);
+    snapshot->subWindowMap_.erase(parentId);
+    for (auto& subWindow : subWindows) {
+        snapshot->parentIdMap_.erase(subWindow->GetWindowId());
+    }
+    Publish(snapshot);
+    return subWindows;
+}
+
+void WindowRegistry::AddAppFloatingWindow(uint32_t mainWindowId, const sptr<WindowImpl>& window)
+{
+    if (window == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    auto snapshot = std::make_shared<Snapshot>(*Load());
+    snapshot->appFloatingWindowMap_[mainWindowId].push_back(window);
+    Publish(snapshot);
+}
+
+std::vector<sptr<WindowImpl>> WindowRegistry::TakeAppFloatingWindows(uint32_t mainWindowId)
+{
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    auto current = Load();
+    auto iter = current->appFloatingWindowMap_.find(mainWindowId);
+    if (iter == current->appFloatingWindowMap_.end()) {
+        return {};
+    }
+    std::vector<sptr<WindowImpl>> floatingWindows = iter->second;
+    auto snapshot = std::make_shared<Snapshot>(*current);
+    snapshot->appFloatingWindowMap_.erase(mainWindowId);
+    Publish(snapshot);
+    return floatingWindows;
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "avoid_area_cache_test.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr DisplayId DISPLAY_ID = 0;
+    constexpr DisplayId OTHER_DISPLAY_ID = 1;
+    constexpr uint32_t DISPLAY_WIDTH = 720;
+    constexpr uint32_t DISPLAY_HEIGHT = 1280;
+    const std::vector<Rect> AVOID_AREA = { { 0, 0, 0, 0 }, { 0, 0, 720, 48 }, { 0, 0, 0, 0 }, { 0, 1232, 720, 48 } };
+    const std::vector<Rect> CHANGED_AVOID_AREA = { { 0, 0, 0, 0 }, { 0, 0, 720, 96 }, { 0, 0, 0, 0 },
+        { 0, 1232, 720, 48 } };
+}
+
+void AvoidAreaCacheTest::SetUpTestCase()
+{
+}
+
+void AvoidAreaCacheTest::TearDownTestCase()
+{
+}
+
+void AvoidAreaCacheTest::SetUp()
+{
+    AvoidAreaCache::GetInstance().entries_.clear();
+    m_ = std::make_unique<Mocker>();
+}
+
+void AvoidAreaCacheTest::TearDown()
+{
+    m_ = nullptr;
+    AvoidAreaCache::GetInstance().entries_.clear();
+}
+
+sptr<WindowImpl> AvoidAreaCacheTest::CreateShownWindow(const std::string& name)
+{
+    sptr<WindowOption> option = new WindowOption();
+    option->SetWindowName(name);
+    option->SetWindowType(WindowType::WINDOW_TYPE_APP_MAIN_WINDOW);
+    sptr<WindowImpl> window = new WindowImpl(option);
+    EXPECT_CALL(m_->Mock(), CreateWindow(_, _, _, _, _)).Times(1).WillOnce(Return(WMError::WM_OK));
+    window->Create("");
+    EXPECT_CALL(m_->Mock(), AddWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    window->Show();
+    return window;
+}
+
+void AvoidAreaCacheTest::FillCache(DisplayId displayId)
+{
+    auto& cache = AvoidAreaCache::GetInstance();
+    cache.OnSystemAvoidAreaChanged(displayId, AVOID_AREA);
+    cache.SetAvoidArea(displayId, AvoidAreaType::TYPE_CUTOUT, AVOID_AREA, cache.GetVersion(displayId));
+}
+
+bool AvoidAreaCacheTest::IsCached(DisplayId displayId)
+{
+    std::vector<Rect> avoidArea;
+    auto& cache = AvoidAreaCache::GetInstance();
+    return cache.GetAvoidArea(displayId, AvoidAreaType::TYPE_SYSTEM, avoidArea) ||
+        cache.GetAvoidArea(displayId, AvoidAreaType::TYPE_CUTOUT, avoidArea);
+}
+
+namespace {
+/**
+ * @tc.name: Version01
+ * @tc.desc: A server answer fetched before a push or an invalidation is not stored
+ * @tc.type: FUNC
+ */
+HWTEST_F(AvoidAreaCacheTest, Version01, Function | SmallTest | Level2)
+{
+    auto& cache = AvoidAreaCache::GetInstance();
+    std::vector<Rect> avoidArea;
+    uint64_t version = cache.GetVersion(DISPLAY_ID);
+    cache.OnSystemAvoidAreaChanged(DISPLAY_ID, CHANGED_AVOID_AREA);
+    cache.SetAvoidArea(DISPLAY_ID, AvoidAreaType::TYPE_SYSTEM, AVOID_AREA, version);
+    ASSERT_TRUE(cache.GetAvoidArea(DISPLAY_ID, AvoidAreaType::TYPE_SYSTEM, avoidArea));
+    ASSERT_TRUE(avoidArea == CHANGED_AVOID_AREA);
+
+    version = cache.GetVersion(DISPLAY_ID);
+    cache.Invalidate(DISPLAY_ID);
+    cache.SetAvoidArea(DISPLAY_ID, AvoidAreaType::TYPE_CUTOUT, AVOID_AREA, version);
+    ASSERT_FALSE(cache.GetAvoidArea(DISPLAY_ID, AvoidAreaType::TYPE_CUTOUT, avoidArea));
+
+    cache.SetAvoidArea(DISPLAY_ID, AvoidAreaType::TYPE_CUTOUT, AVOID_AREA, cache.GetVersion(DISPLAY_ID));
+    ASSERT_TRUE(cache.GetAvoidArea(DISPLAY_ID, AvoidAreaType::TYPE_CUTOUT, avoidArea));
+    ASSERT_TRUE(avoidArea == AVOID_AREA);
+}
+
+/**
+ * @tc.name: Version02
+ * @tc.desc: Versions are kept per display, a change of one display does not drop answers of another
+ * @tc.type: FUNC
+ */
+HWTEST_F(AvoidAreaCacheTest, Version02, Function | SmallTest | Level2)
+{
+    auto& cache = AvoidAreaCache::GetInstance();
+    uint64_t version = cache.GetVersion(DISPLAY_ID);
+    cache.Invalidate(OTHER_DISPLAY_ID);
+    cache.SetAvoidArea(DISPLAY_ID, AvoidAreaType::TYPE_CUTOUT, AVOID_AREA, version);
+    ASSERT_TRUE(IsCached(DISPLAY_ID));
+    ASSERT_FALSE(IsCached(OTHER_DISPLAY_ID));
+}
+
+/**
+ * @tc.name: Invalidate01
+ * @tc.desc: Hiding the shown main window drops the avoid areas of its display
+ * @tc.type: FUNC
+ */
+HWTEST_F(AvoidAreaCacheTest, Invalidate01, Function | SmallTest | Level2)
+{
+    sptr<WindowImpl> window = CreateShownWindow("AvoidAreaCacheTest_Invalidate01");
+    ASSERT_TRUE(window->IsAvoidAreaCacheable());
+    FillCache(DISPLAY_ID);
+    ASSERT_TRUE(IsCached(DISPLAY_ID));
+
+    EXPECT_CALL(m_->Mock(), RemoveWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Hide());
+    ASSERT_FALSE(IsCached(DISPLAY_ID));
+    ASSERT_FALSE(window->IsAvoidAreaCacheable());
+
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    window->Destroy();
+}
+
+/**
+ * @tc.name: Invalidate02
+ * @tc.desc: Destroying the shown main window drops the avoid areas of its display
+ * @tc.type: FUNC
+ */
+HWTEST_F(AvoidAreaCacheTest, Invalidate02, Function | SmallTest | Level2)
+{
+    sptr<WindowImpl> window = CreateShownWindow("AvoidAreaCacheTest_Invalidate02");
+    FillCache(DISPLAY_ID);
+    uint64_t version = AvoidAreaCache::GetInstance().GetVersion(DISPLAY_ID);
+
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Destroy());
+    ASSERT_FALSE(IsCached(DISPLAY_ID));
+    ASSERT_NE(version, AvoidAreaCache::GetInstance().GetVersion(DISPLAY_ID));
+}
+
+/**
+ * @tc.name: Invalidate03
+ * @tc.desc: Moving a main window to another display drops the avoid areas of the display it left
+ * @tc.type: FUNC
+ */
+HWTEST_F(AvoidAreaCacheTest, Invalidate03, Function | SmallTest | Level2)
+{
+    sptr<WindowImpl> window = CreateShownWindow("AvoidAreaCacheTest_Invalidate03");
+    FillCache(DISPLAY_ID);
+    FillCache(OTHER_DISPLAY_ID);
+
+    window->UpdateDisplayId(DISPLAY_ID, OTHER_DISPLAY_ID);
+    ASSERT_FALSE(IsCached(DISPLAY_ID));
+    ASSERT_TRUE(IsCached(OTHER_DISPLAY_ID));
+    ASSERT_EQ(OTHER_DISPLAY_ID, window->property_->GetDisplayId());
+
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    window->Destroy();
+}
+
+/**
+ * @tc.name: HotZones01
+ * @tc.desc: Hot zones are answered for the display size they were fetched at only
+ * @tc.type: FUNC
+ */
+HWTEST_F(AvoidAreaCacheTest, HotZones01, Function | SmallTest | Level2)
+{
+    auto& cache = AvoidAreaCache::GetInstance();
+    ModeChangeHotZones hotZones;
+    ASSERT_FALSE(cache.GetHotZones(DISPLAY_ID, DISPLAY_WIDTH, DISPLAY_HEIGHT, hotZones));
+
+    ModeChangeHotZones portraitZones;
+    portraitZones.fullscreen_ = { 0, 0, DISPLAY_WIDTH, 48 };
+    cache.SetHotZones(DISPLAY_ID, DISPLAY_WIDTH, DISPLAY_HEIGHT, portraitZones);
+    ASSERT_TRUE(cache.GetHotZones(DISPLAY_ID, DISPLAY_WIDTH, DISPLAY_HEIGHT, hotZones));
+    ASSERT_TRUE(hotZones.fullscreen_ == portraitZones.fullscreen_);
+    ASSERT_FALSE(cache.GetHotZones(DISPLAY_ID, DISPLAY_HEIGHT, DISPLAY_WIDTH, hotZones));
+    ASSERT_FALSE(cache.GetHotZones(OTHER_DISPLAY_ID, DISPLAY_WIDTH, DISPLAY_HEIGHT, hotZones));
+
+    // a rotated display fetches its own zones, which replace the ones of the old size
+    ModeChangeHotZones landscapeZones;
+    landscapeZones.fullscreen_ = { 0, 0, DISPLAY_HEIGHT, 48 };
+    cache.SetHotZones(DISPLAY_ID, DISPLAY_HEIGHT, DISPLAY_WIDTH, landscapeZones);
+    ASSERT_TRUE(cache.GetHotZones(DISPLAY_ID, DISPLAY_HEIGHT, DISPLAY_WIDTH, hotZones));
+    ASSERT_TRUE(hotZones.fullscreen_ == landscapeZones.fullscreen_);
+    ASSERT_FALSE(cache.GetHotZones(DISPLAY_ID, DISPLAY_WIDTH, DISPLAY_HEIGHT, hotZones));
+
+    // avoid area invalidation does not touch the hot zones, they only depend on the display size
+    cache.Invalidate(DISPLAY_ID);
+    ASSERT_TRUE(cache.GetHotZones(DISPLAY_ID, DISPLAY_HEIGHT, DISPLAY_WIDTH, hotZones));
+}
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "input_latency_tracker_test.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+using Stage = InputLatencyTracker::Stage;
+
+void InputLatencyTrackerTest::SetUpTestCase()
+{
+}
+
+void InputLatencyTrackerTest::TearDownTestCase()
+{
+}
+
+void InputLatencyTrackerTest::SetUp()
+{
+}
+
+void InputLatencyTrackerTest::TearDown()
+{
+}
+
+namespace {
+/**
+ * @tc.name: FullPath01
+ * @tc.desc: An event that is dispatched, consumed and followed by a frame is counted in every stage
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputLatencyTrackerTest, FullPath01, Function | SmallTest | Level2)
+{
+    InputLatencyTracker tracker;
+    int64_t actionTime = static_cast<int64_t>(PerfHistogram::GetCurrentTimeUs());
+    tracker.OnEventReceived(1, actionTime);
+    tracker.OnEventDispatched(1);
+    tracker.OnEventConsumed(1);
+    ASSERT_TRUE(tracker.OnFrame());
+    ASSERT_EQ(0u, tracker.GetSnapshot(Stage::TOTAL).count_);
+    tracker.FlushFrames();
+    for (uint32_t stage = 0; stage < static_cast<uint32_t>(Stage::STAGE_END); stage++) {
+        ASSERT_EQ(1u, tracker.GetSnapshot(static_cast<Stage>(stage)).count_);
+    }
+
+    // a second frame does not count the event again
+    ASSERT_FALSE(tracker.OnFrame());
+    tracker.FlushFrames();
+    ASSERT_EQ(1u, tracker.GetSnapshot(Stage::TOTAL).count_);
+}
+
+/**
+ * @tc.name: Coalesce01
+ * @tc.desc: Move events replaced by a newer event of the same batch do not reach the frame stage
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputLatencyTrackerTest, Coalesce01, Function | SmallTest | Level2)
+{
+    InputLatencyTracker tracker;
+    int64_t actionTime = static_cast<int64_t>(PerfHistogram::GetCurrentTimeUs());
+    tracker.OnEventReceived(1, actionTime);
+    tracker.OnEventReceived(2, actionTime); // 2: newer event of the batch
+    tracker.OnEventReceived(3, actionTime); // 3: event of the next batch
+    tracker.OnEventDispatched(2);
+    tracker.OnEventConsumed(2);
+    tracker.OnEventDispatched(1);
+    tracker.OnFrame();
+    tracker.FlushFrames();
+    ASSERT_EQ(3u, tracker.GetSnapshot(Stage::RECEIVE).count_);
+    ASSERT_EQ(1u, tracker.GetSnapshot(Stage::BATCH).count_);
+    ASSERT_EQ(1u, tracker.GetSnapshot(Stage::TOTAL).count_);
+
+    tracker.OnEventDispatched(3);
+    tracker.OnEventConsumed(3);
+    tracker.OnFrame();
+    tracker.FlushFrames();
+    ASSERT_EQ(2u, tracker.GetSnapshot(Stage::TOTAL).count_);
+
+    tracker.Reset();
+    ASSERT_EQ(0u, tracker.GetSnapshot(Stage::TOTAL).count_);
+    std::vector<std::string> info;
+    tracker.Dump(info);
+    ASSERT_EQ(static_cast<size_t>(Stage::STAGE_END), info.size());
+}
+
+/**
+ * @tc.name: FlushFrames01
+ * @tc.desc: A flush covering several frames accounts every event to the end of its own frame
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputLatencyTrackerTest, FlushFrames01, Function | SmallTest | Level2)
+{
+    InputLatencyTracker tracker;
+    int64_t actionTime = static_cast<int64_t>(PerfHistogram::GetCurrentTimeUs());
+    tracker.OnEventReceived(1, actionTime);
+    tracker.OnEventDispatched(1);
+    tracker.OnEventConsumed(1);
+    tracker.OnFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2)); // 2: keeps the second event out of the first frame
+    tracker.OnEventReceived(2, actionTime);
+    tracker.OnEventDispatched(2);
+    tracker.OnEventConsumed(2);
+    tracker.FlushFrames();
+    // the second event is consumed after the last finished frame, it waits for the next one
+    ASSERT_EQ(1u, tracker.GetSnapshot(Stage::FRAME).count_);
+    uint64_t firstFrameUs = tracker.GetSnapshot(Stage::FRAME).maxUs_;
+
+    tracker.OnFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2)); // 2: a later frame must not stretch the second event
+    tracker.OnFrame();
+    tracker.FlushFrames();
+    ASSERT_EQ(2u, tracker.GetSnapshot(Stage::FRAME).count_);
+    ASSERT_LT(tracker.GetSnapshot(Stage::FRAME).maxUs_, firstFrameUs + 2000); // 2000: the sleep above in us
+}
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "input_resampler_test.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr int32_t POINTER_ID = 0;
+
+    std::shared_ptr<MMI::PointerEvent> CreateMoveEvent(int64_t timeUs, int32_t posX,
+        int32_t sourceType = MMI::PointerEvent::SOURCE_TYPE_TOUCHSCREEN)
+    {
+        MMI::PointerEvent::PointerItem pointerItem;
+        pointerItem.SetPointerId(POINTER_ID);
+        pointerItem.SetGlobalX(posX);
+        pointerItem.SetGlobalY(posX);
+        pointerItem.SetLocalX(posX);
+        pointerItem.SetLocalY(posX);
+        std::shared_ptr<MMI::PointerEvent> pointerEvent = MMI::PointerEvent::Create();
+        pointerEvent->AddPointerItem(pointerItem);
+        pointerEvent->SetPointerId(POINTER_ID);
+        pointerEvent->SetPointerAction(MMI::PointerEvent::POINTER_ACTION_MOVE);
+        pointerEvent->SetSourceType(sourceType);
+        pointerEvent->SetActionTime(timeUs);
+        return pointerEvent;
+    }
+
+    // every pointer is a pair of pointer id and position
+    std::shared_ptr<MMI::PointerEvent> CreateMultiMoveEvent(int64_t timeUs,
+        const std::vector<std::pair<int32_t, int32_t>>& pointers)
+    {
+        std::shared_ptr<MMI::PointerEvent> pointerEvent = MMI::PointerEvent::Create();
+        pointerEvent->SetPointerId(pointers.front().first);
+        pointerEvent->SetPointerAction(MMI::PointerEvent::POINTER_ACTION_MOVE);
+        pointerEvent->SetSourceType(MMI::PointerEvent::SOURCE_TYPE_TOUCHSCREEN);
+        pointerEvent->SetActionTime(timeUs);
+        for (auto& [pointerId, posX] : pointers) {
+            MMI::PointerEvent::PointerItem pointerItem;
+            pointerItem.SetPointerId(pointerId);
+            pointerItem.SetGlobalX(posX);
+            pointerItem.SetGlobalY(posX);
+            pointerItem.SetLocalX(posX);
+            pointerItem.SetLocalY(posX);
+            pointerEvent->AddPointerItem(pointerItem);
+        }
+        return pointerEvent;
+    }
+
+    int32_t GetGlobalX(const std::shared_ptr<MMI::PointerEvent>& pointerEvent, int32_t pointerId = POINTER_ID)
+    {
+        MMI::PointerEvent::PointerItem pointerItem;
+        pointerEvent->GetPointerItem(pointerId, pointerItem);
+        return pointerItem.GetGlobalX();
+    }
+}
+
+void InputResamplerTest::SetUpTestCase()
+{
+}
+
+void InputResamplerTest::TearDownTestCase()
+{
+}
+
+void InputResamplerTest::SetUp()
+{
+}
+
+void InputResamplerTest::TearDown()
+{
+}
+
+namespace {
+/**
+ * @tc.name: Interpolate01
+ * @tc.desc: Pointer is moved between the two samples around the resample time
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputResamplerTest, Interpolate01, Function | SmallTest | Level2)
+{
+    InputResampler resampler;
+    resampler.AddSample(CreateMoveEvent(0, 0));
+    auto pointerEvent = CreateMoveEvent(10000, 100); // 10000: 10ms, 100: moved 100px
+    resampler.AddSample(pointerEvent);
+
+    resampler.Resample(pointerEvent, 10000); // 10000: frame time, resampled 5ms before
+    ASSERT_EQ(50, GetGlobalX(pointerEvent));
+    ASSERT_EQ(5000, pointerEvent->GetActionTime()); // 5000: the resample time
+}
+
+/**
+ * @tc.name: Extrapolate01
+ * @tc.desc: Pointer is predicted past the latest sample by at most half the sample interval
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputResamplerTest, Extrapolate01, Function | SmallTest | Level2)
+{
+    InputResampler resampler;
+    resampler.AddSample(CreateMoveEvent(0, 0));
+    auto pointerEvent = CreateMoveEvent(8000, 80); // 8000: 8ms, 80: moved 80px
+    resampler.AddSample(pointerEvent);
+
+    resampler.Resample(pointerEvent, 11000); // 11000: resample time is 6ms, 2ms before the latest sample
+    ASSERT_EQ(60, GetGlobalX(pointerEvent));
+    ASSERT_EQ(6000, pointerEvent->GetActionTime()); // 6000: the resample time
+
+    pointerEvent = CreateMoveEvent(8000, 80);
+    resampler.Resample(pointerEvent, 30000); // 30000: prediction is limited to 4ms after the latest sample
+    ASSERT_EQ(120, GetGlobalX(pointerEvent));
+}
+
+/**
+ * @tc.name: Extrapolate02
+ * @tc.desc: A capped prediction stamps the event with the time the pointers were predicted for
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputResamplerTest, Extrapolate02, Function | SmallTest | Level2)
+{
+    InputResampler resampler;
+    resampler.AddSample(CreateMoveEvent(0, 0));
+    auto pointerEvent = CreateMoveEvent(8000, 80); // 8000: 8ms, 80: moved 80px
+    resampler.AddSample(pointerEvent);
+
+    resampler.Resample(pointerEvent, 30000); // 30000: prediction is limited to 4ms after the latest sample
+    ASSERT_EQ(120, GetGlobalX(pointerEvent));
+    ASSERT_EQ(12000, pointerEvent->GetActionTime()); // 12000: the latest sample plus the 4ms limit
+}
+
+/**
+ * @tc.name: Extrapolate03
+ * @tc.desc: With several pointers every pointer is predicted for the earliest capped time
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputResamplerTest, Extrapolate03, Function | SmallTest | Level2)
+{
+    constexpr int32_t secondPointerId = 1;
+    InputResampler resampler;
+    resampler.AddSample(CreateMultiMoveEvent(0, { { POINTER_ID, 0 } }));
+    resampler.AddSample(CreateMultiMoveEvent(4000, { { secondPointerId, 0 } })); // 4000: 4ms
+    auto pointerEvent = CreateMultiMoveEvent(8000, { { POINTER_ID, 80 }, { secondPointerId, 40 } }); // 8000: 8ms
+    resampler.AddSample(pointerEvent);
+
+    // the second pointer moves every 4ms and is predicted 2ms ahead at most, the first one follows it
+    resampler.Resample(pointerEvent, 30000); // 30000: frame time
+    ASSERT_EQ(10000, pointerEvent->GetActionTime()); // 10000: the latest sample plus the 2ms limit
+    ASSERT_EQ(100, GetGlobalX(pointerEvent));
+    ASSERT_EQ(60, GetGlobalX(pointerEvent, secondPointerId));
+}
+
+/**
+ * @tc.name: NoResample01
+ * @tc.desc: Single samples, cleared pointers and mouse events keep their reported position
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputResamplerTest, NoResample01, Function | SmallTest | Level2)
+{
+    InputResampler resampler;
+    auto pointerEvent = CreateMoveEvent(0, 10); // 10: reported position
+    resampler.AddSample(pointerEvent);
+    resampler.Resample(pointerEvent, 10000); // 10000: frame time
+    ASSERT_EQ(10, GetGlobalX(pointerEvent));
+    ASSERT_EQ(0, pointerEvent->GetActionTime()); // not resampled, keeps the reported time
+
+    pointerEvent = CreateMoveEvent(10000, 100); // 10000: 10ms, 100: reported position
+    resampler.AddSample(pointerEvent);
+    resampler.ClearPointer(POINTER_ID);
+    resampler.Resample(pointerEvent, 10000); // 10000: frame time
+    ASSERT_EQ(100, GetGlobalX(pointerEvent));
+
+    resampler.AddSample(CreateMoveEvent(0, 0, MMI::PointerEvent::SOURCE_TYPE_MOUSE));
+    pointerEvent = CreateMoveEvent(10000, 100, MMI::PointerEvent::SOURCE_TYPE_MOUSE);
+    resampler.AddSample(pointerEvent);
+    resampler.Resample(pointerEvent, 10000); // 10000: frame time
+    ASSERT_EQ(100, GetGlobalX(pointerEvent));
+    ASSERT_EQ(10000, pointerEvent->GetActionTime()); // 10000: not resampled, keeps the reported time
+}
+}
+} // namespace Rosen
+} // namespace OHOS
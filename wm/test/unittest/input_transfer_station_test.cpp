@@ -14,8 +14,6 @@
  */
 
 #include "input_transfer_station_test.h"
-#include "mock_window_adapter.h"
-#include "singleton_mocker.h"
 
 using namespace testing;
 using namespace testing::ext;
@@ -23,6 +21,11 @@ using namespace testing::ext;
 namespace OHOS {
 namespace Rosen {
 using WindowMocker = SingletonMocker<WindowAdapter, MockWindowAdapter>;
+namespace {
+    constexpr uint32_t SNAPSHOT_WINDOW_ID = 100;
+    constexpr uint32_t ROUTING_WINDOW_ID = 101;
+}
+
 void InputTransferStationTest::SetUpTestCase()
 {
     std::unique_ptr<WindowMocker> m = std::make_unique<WindowMocker>();
@@ -45,6 +48,18 @@ void InputTransferStationTest::TearDown()
 {
 }
 
+sptr<WindowImpl> InputTransferStationTest::CreateInputWindow(WindowMocker& mocker, const std::string& name,
+    uint32_t windowId)
+{
+    sptr<WindowOption> option = new WindowOption();
+    option->SetWindowName(name);
+    sptr<WindowImpl> window = new WindowImpl(option);
+    EXPECT_CALL(mocker.Mock(), CreateWindow(_, _, _, _, _)).Times(1)
+        .WillOnce(DoAll(SetArgReferee<3>(windowId), Return(WMError::WM_OK)));
+    window->Create("");
+    return window;
+}
+
 namespace {
 /**
  * @tc.name: AddInputWindow
@@ -79,6 +94,70 @@ HWTEST_F(InputTransferStationTest, SetInputListener, Function | SmallTest | Leve
     std::shared_ptr<MMI::IInputEventConsumer> listener = std::make_shared<InputEventListener>(InputEventListener());
     InputTransferStation::GetInstance().SetInputListener(windowId, listener);
 }
+
+/**
+ * @tc.name: ChannelSnapshot01
+ * @tc.desc: Adding and removing a window publishes a new channel map, a map already loaded stays unchanged
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputTransferStationTest, ChannelSnapshot01, Function | SmallTest | Level2)
+{
+    auto& station = InputTransferStation::GetInstance();
+    std::unique_ptr<WindowMocker> m = std::make_unique<WindowMocker>();
+    auto before = std::atomic_load(&station.windowInputChannels_);
+    sptr<WindowImpl> window = CreateInputWindow(*m, "ChannelSnapshot01", SNAPSHOT_WINDOW_ID);
+    sptr<WindowInputChannel> channel = station.GetInputChannel(SNAPSHOT_WINDOW_ID);
+    ASSERT_TRUE(channel != nullptr);
+    ASSERT_TRUE(before->find(SNAPSHOT_WINDOW_ID) == before->end());
+
+    auto added = std::atomic_load(&station.windowInputChannels_);
+    station.RemoveInputWindow(window);
+    ASSERT_TRUE(station.GetInputChannel(SNAPSHOT_WINDOW_ID) == nullptr);
+    // a reader that loaded the map before the removal still holds the channel it found
+    auto iter = added->find(SNAPSHOT_WINDOW_ID);
+    ASSERT_TRUE(iter != added->end());
+    ASSERT_EQ(channel.GetRefPtr(), iter->second.GetRefPtr());
+
+    EXPECT_CALL(m->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    window->Destroy();
+}
+
+/**
+ * @tc.name: InputThreadRouting01
+ * @tc.desc: On the input thread, ACE windows hop to the main handler and windows with a listener stay in place
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputTransferStationTest, InputThreadRouting01, Function | SmallTest | Level2)
+{
+    auto& station = InputTransferStation::GetInstance();
+    std::unique_ptr<WindowMocker> m = std::make_unique<WindowMocker>();
+    sptr<WindowImpl> window = CreateInputWindow(*m, "InputThreadRouting01", ROUTING_WINDOW_ID);
+    sptr<WindowInputChannel> channel = station.GetInputChannel(ROUTING_WINDOW_ID);
+    ASSERT_TRUE(channel != nullptr);
+    bool isInputThreadEnabled = station.isInputThreadEnabled_;
+    auto mainHandler = station.mainHandler_;
+    station.isInputThreadEnabled_ = true;
+    station.mainHandler_ = std::make_shared<AppExecFwk::EventHandler>(
+        AppExecFwk::EventRunner::Create("InputThreadRouting01"));
+
+    ASSERT_EQ(station.mainHandler_, station.GetUiHandler(channel));
+    std::shared_ptr<MMI::IInputEventConsumer> listener = std::make_shared<InputEventListener>(InputEventListener());
+    station.SetInputListener(ROUTING_WINDOW_ID, listener);
+    ASSERT_TRUE(channel->HasInputListener());
+    ASSERT_EQ(nullptr, station.GetUiHandler(channel));
+    station.SetInputListener(ROUTING_WINDOW_ID, nullptr);
+    ASSERT_FALSE(channel->HasInputListener());
+    ASSERT_EQ(station.mainHandler_, station.GetUiHandler(channel));
+
+    // without the input thread every event is handled where it is received
+    station.isInputThreadEnabled_ = false;
+    ASSERT_EQ(nullptr, station.GetUiHandler(channel));
+
+    station.isInputThreadEnabled_ = isInputThreadEnabled;
+    station.mainHandler_ = mainHandler;
+    EXPECT_CALL(m->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    window->Destroy();
+}
 }
 } // namespace Rosen
 } // namespace OHOS
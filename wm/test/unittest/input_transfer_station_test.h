@@ -19,6 +19,8 @@
 #include <gtest/gtest.h>
 #include "input_manager.h"
 #include "input_transfer_station.h"
+#include "mock_window_adapter.h"
+#include "singleton_mocker.h"
 #include "window_impl.h"
 
 namespace OHOS {
@@ -29,6 +31,8 @@ public:
     static void TearDownTestCase();
     virtual void SetUp() override;
     virtual void TearDown() override;
+    static sptr<WindowImpl> CreateInputWindow(SingletonMocker<WindowAdapter, MockWindowAdapter>& mocker,
+        const std::string& name, uint32_t windowId);
     static inline sptr<WindowImpl> window_;
 };
 } // namespace ROSEN
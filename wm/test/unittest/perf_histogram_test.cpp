@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "perf_histogram_test.h"
+
+#include <thread>
+#include <vector>
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+void PerfHistogramTest::SetUpTestCase()
+{
+}
+
+void PerfHistogramTest::TearDownTestCase()
+{
+}
+
+void PerfHistogramTest::SetUp()
+{
+}
+
+void PerfHistogramTest::TearDown()
+{
+}
+
+namespace {
+/**
+ * @tc.name: Record01
+ * @tc.desc: Record samples and check count/avg/max
+ * @tc.type: FUNC
+ */
+HWTEST_F(PerfHistogramTest, Record01, Function | SmallTest | Level2)
+{
+    PerfHistogram histogram;
+    histogram.Record(10);
+    histogram.Record(20);
+    histogram.Record(30);
+    PerfHistogramSnapshot snapshot = histogram.GetSnapshot();
+    ASSERT_EQ(3u, snapshot.count_);
+    ASSERT_EQ(60u, snapshot.sumUs_);
+    ASSERT_EQ(20u, snapshot.GetAverageUs());
+    ASSERT_EQ(30u, snapshot.maxUs_);
+}
+
+/**
+ * @tc.name: Percentile01
+ * @tc.desc: Percentiles are reported as bucket upper bounds and never exceed max
+ * @tc.type: FUNC
+ */
+HWTEST_F(PerfHistogramTest, Percentile01, Function | SmallTest | Level2)
+{
+    PerfHistogram histogram;
+    for (uint64_t i = 0; i < 99; i++) {
+        histogram.Record(100); // bucket [64, 128)
+    }
+    histogram.Record(5000); // bucket [4096, 8192)
+    PerfHistogramSnapshot snapshot = histogram.GetSnapshot();
+    ASSERT_EQ(127u, snapshot.p50Us_);
+    ASSERT_EQ(127u, snapshot.p99Us_);
+    ASSERT_EQ(5000u, snapshot.maxUs_);
+}
+
+/**
+ * @tc.name: Reset01
+ * @tc.desc: Reset clears all samples
+ * @tc.type: FUNC
+ */
+HWTEST_F(PerfHistogramTest, Reset01, Function | SmallTest | Level2)
+{
+    PerfHistogram histogram;
+    histogram.Record(0);
+    histogram.Record(UINT64_MAX >> 1);
+    ASSERT_EQ(2u, histogram.GetSnapshot().count_);
+    histogram.Reset();
+    PerfHistogramSnapshot snapshot = histogram.GetSnapshot();
+    ASSERT_EQ(0u, snapshot.count_);
+    ASSERT_EQ(0u, snapshot.maxUs_);
+    ASSERT_EQ(0u, snapshot.p99Us_);
+}
+
+/**
+ * @tc.name: TakeSnapshot01
+ * @tc.desc: Take a snapshot and clear the histogram in one step
+ * @tc.type: FUNC
+ */
+HWTEST_F(PerfHistogramTest, TakeSnapshot01, Function | SmallTest | Level2)
+{
+    PerfHistogram histogram;
+    histogram.Record(10);
+    histogram.Record(30);
+    PerfHistogramSnapshot snapshot = histogram.TakeSnapshot();
+    ASSERT_EQ(2u, snapshot.count_);
+    ASSERT_EQ(40u, snapshot.sumUs_);
+    ASSERT_EQ(30u, snapshot.maxUs_);
+    ASSERT_EQ(15u, snapshot.p50Us_);
+    snapshot = histogram.GetSnapshot();
+    ASSERT_EQ(0u, snapshot.count_);
+    ASSERT_EQ(0u, snapshot.sumUs_);
+    ASSERT_EQ(0u, snapshot.maxUs_);
+}
+
+/**
+ * @tc.name: TakeSnapshot02
+ * @tc.desc: Samples recorded while snapshots are taken are all reported once
+ * @tc.type: FUNC
+ */
+HWTEST_F(PerfHistogramTest, TakeSnapshot02, Function | SmallTest | Level2)
+{
+    constexpr uint64_t threadNum = 4;
+    constexpr uint64_t sampleNum = 100000;
+    constexpr uint64_t costUs = 3;
+    PerfHistogram histogram;
+    std::atomic<uint64_t> runningNum { threadNum };
+    std::vector<std::thread> writers;
+    for (uint64_t i = 0; i < threadNum; i++) {
+        writers.emplace_back([&histogram, &runningNum]() {
+            for (uint64_t j = 0; j < sampleNum; j++) {
+                histogram.Record(costUs);
+            }
+            runningNum--;
+        });
+    }
+    uint64_t count = 0;
+    uint64_t sumUs = 0;
+    while (runningNum > 0) {
+        PerfHistogramSnapshot snapshot = histogram.TakeSnapshot();
+        count += snapshot.count_;
+        sumUs += snapshot.sumUs_;
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    PerfHistogramSnapshot snapshot = histogram.TakeSnapshot();
+    count += snapshot.count_;
+    sumUs += snapshot.sumUs_;
+    ASSERT_EQ(threadNum * sampleNum, count);
+    ASSERT_EQ(threadNum * sampleNum * costUs, sumUs);
+}
+}
+} // namespace Rosen
+} // namespace OHOS
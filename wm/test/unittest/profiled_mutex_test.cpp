@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "profiled_mutex_test.h"
+
+#include <chrono>
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr uint32_t REQUEST_CODE = 7;
+    constexpr auto HOLD_TIME = std::chrono::milliseconds(20);
+    constexpr uint64_t MIN_MEASURED_US = 10000; // half of HOLD_TIME, leaves room for scheduling jitter
+
+    bool TryLockFromOtherThread(ProfiledRecursiveMutex& mutex)
+    {
+        bool locked = false;
+        std::thread([&mutex, &locked]() {
+            locked = mutex.try_lock();
+            if (locked) {
+                mutex.unlock();
+            }
+        }).join();
+        return locked;
+    }
+}
+
+void ProfiledMutexTest::SetUpTestCase()
+{
+}
+
+void ProfiledMutexTest::TearDownTestCase()
+{
+}
+
+void ProfiledMutexTest::SetUp()
+{
+}
+
+void ProfiledMutexTest::TearDown()
+{
+}
+
+namespace {
+/**
+ * @tc.name: Reentry01
+ * @tc.desc: The owner can lock again, only the outermost acquisition is recorded
+ * @tc.type: FUNC
+ */
+HWTEST_F(ProfiledMutexTest, Reentry01, Function | SmallTest | Level2)
+{
+    ProfiledRecursiveMutex mutex("test");
+    mutex.SetProfileEnabled(true);
+    mutex.Lock("Outer");
+    mutex.Lock("Inner");
+    mutex.unlock();
+    ASSERT_FALSE(TryLockFromOtherThread(mutex)); // still held by the outer lock
+    mutex.unlock();
+    ASSERT_TRUE(TryLockFromOtherThread(mutex));
+
+    auto& siteStats = mutex.stats_[INNER_REQUEST_CODE];
+    ASSERT_EQ(1u, siteStats.count("Outer"));
+    ASSERT_EQ(0u, siteStats.count("Inner"));
+    ASSERT_EQ(1u, siteStats["Outer"].count_);
+    ASSERT_EQ(1u, siteStats["unknown"].count_); // try_lock carries no call-site
+}
+
+/**
+ * @tc.name: Reentry02
+ * @tc.desc: Reentry works with profiling disabled and nothing is recorded
+ * @tc.type: FUNC
+ */
+HWTEST_F(ProfiledMutexTest, Reentry02, Function | SmallTest | Level2)
+{
+    ProfiledRecursiveMutex mutex("test");
+    {
+        WM_PROFILED_LOCK(mutex);
+        std::lock_guard<ProfiledRecursiveMutex> lock(mutex);
+        ASSERT_FALSE(TryLockFromOtherThread(mutex));
+    }
+    ASSERT_TRUE(TryLockFromOtherThread(mutex));
+    ASSERT_TRUE(mutex.stats_.empty());
+}
+
+/**
+ * @tc.name: Accounting01
+ * @tc.desc: Hold time is charged to the owner and wait time to the contender, per request code
+ * @tc.type: FUNC
+ */
+HWTEST_F(ProfiledMutexTest, Accounting01, Function | SmallTest | Level2)
+{
+    ProfiledRecursiveMutex mutex("test");
+    mutex.SetProfileEnabled(true);
+    std::atomic<bool> waiting { false };
+    mutex.Lock("Holder");
+    std::thread waiter([&mutex, &waiting]() {
+        ProfiledRequestScope scope(REQUEST_CODE);
+        waiting = true;
+        mutex.Lock("Waiter");
+        mutex.unlock();
+    });
+    while (!waiting) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(HOLD_TIME);
+    mutex.unlock();
+    waiter.join();
+
+    const LockProfileStats& holder = mutex.stats_[INNER_REQUEST_CODE]["Holder"];
+    ASSERT_EQ(1u, holder.count_);
+    ASSERT_EQ(0u, holder.maxWaitUs_);
+    ASSERT_GE(holder.maxHoldUs_, static_cast<uint64_t>(std::chrono::microseconds(HOLD_TIME).count()));
+    ASSERT_EQ(holder.maxHoldUs_, holder.totalHoldUs_);
+
+    const LockProfileStats& waiterStats = mutex.stats_[REQUEST_CODE]["Waiter"];
+    ASSERT_EQ(1u, waiterStats.count_);
+    ASSERT_GE(waiterStats.maxWaitUs_, MIN_MEASURED_US);
+    ASSERT_EQ(waiterStats.maxWaitUs_, waiterStats.totalWaitUs_);
+}
+
+/**
+ * @tc.name: Accounting02
+ * @tc.desc: Totals add up over several acquisitions while max keeps the largest one
+ * @tc.type: FUNC
+ */
+HWTEST_F(ProfiledMutexTest, Accounting02, Function | SmallTest | Level2)
+{
+    ProfiledRecursiveMutex mutex("test");
+    mutex.SetProfileEnabled(true);
+    {
+        WM_PROFILED_LOCK(mutex);
+        std::this_thread::sleep_for(HOLD_TIME);
+    }
+    {
+        WM_PROFILED_LOCK(mutex);
+    }
+    const LockProfileStats& stats = mutex.stats_[INNER_REQUEST_CODE]["TestBody"];
+    ASSERT_EQ(2u, stats.count_);
+    ASSERT_GE(stats.totalHoldUs_, stats.maxHoldUs_);
+    ASSERT_GE(stats.maxHoldUs_, MIN_MEASURED_US);
+}
+
+/**
+ * @tc.name: Dump01
+ * @tc.desc: Dump lists every request code and call-site, reset clears them
+ * @tc.type: FUNC
+ */
+HWTEST_F(ProfiledMutexTest, Dump01, Function | SmallTest | Level2)
+{
+    ProfiledRecursiveMutex mutex("TestMutex");
+    std::string dumpInfo;
+    mutex.DumpProfile(dumpInfo);
+    ASSERT_NE(std::string::npos, dumpInfo.find("Lock Profile: TestMutex (disabled)"));
+    ASSERT_NE(std::string::npos, dumpInfo.find("MaxWait(us)"));
+
+    mutex.SetProfileEnabled(true);
+    mutex.Lock("InnerSite");
+    mutex.unlock();
+    {
+        ProfiledRequestScope scope(REQUEST_CODE);
+        mutex.Lock("RequestSite");
+        mutex.unlock();
+    }
+    dumpInfo.clear();
+    mutex.DumpProfile(dumpInfo);
+    ASSERT_NE(std::string::npos, dumpInfo.find("(enabled)"));
+    size_t innerPos = dumpInfo.find("inner");
+    ASSERT_NE(std::string::npos, innerPos);
+    ASSERT_NE(std::string::npos, dumpInfo.find("InnerSite", innerPos));
+    size_t requestPos = dumpInfo.find(std::to_string(REQUEST_CODE) + " ");
+    ASSERT_NE(std::string::npos, requestPos);
+    ASSERT_NE(std::string::npos, dumpInfo.find("RequestSite", requestPos));
+
+    mutex.ResetProfile();
+    dumpInfo.clear();
+    mutex.DumpProfile(dumpInfo);
+    ASSERT_EQ(std::string::npos, dumpInfo.find("InnerSite"));
+    ASSERT_EQ(std::string::npos, dumpInfo.find("RequestSite"));
+    ASSERT_TRUE(mutex.IsProfileEnabled()); // reset keeps profiling on
+}
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "surface_reader_test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr uint32_t BPP = 4;
+    constexpr uint32_t TILE_SIZE = 64; // tile size of the change detection in SurfaceReader
+    constexpr uint32_t FRAME_WIDTH = 2 * TILE_SIZE;
+    constexpr uint32_t FRAME_HEIGHT = TILE_SIZE;
+    constexpr uint32_t FRAME_STRIDE = FRAME_WIDTH * BPP;
+    const Rect FULL_DAMAGE = { 0, 0, FRAME_WIDTH, FRAME_HEIGHT };
+    const Rect SECOND_TILE = { TILE_SIZE, 0, TILE_SIZE, TILE_SIZE };
+
+    class RecordingHandler : public SurfaceReaderHandler {
+    public:
+        bool OnImageAvalible(sptr<Media::PixelMap> pixleMap) override
+        {
+            return true;
+        }
+        bool OnFrameAvailable(const SurfaceReaderFrame& frame) override
+        {
+            damages_.push_back(frame.damage_);
+            return result_;
+        }
+        std::vector<Rect> damages_;
+        bool result_ = true;
+    };
+}
+
+void SurfaceReaderTest::SetUpTestCase()
+{
+}
+
+void SurfaceReaderTest::TearDownTestCase()
+{
+}
+
+void SurfaceReaderTest::SetUp()
+{
+}
+
+void SurfaceReaderTest::TearDown()
+{
+}
+
+namespace {
+SurfaceReaderFrame MakeFrame(const std::vector<uint8_t>& content, const Rect& damage)
+{
+    SurfaceReaderFrame frame = {
+        .addr_ = content.data(),
+        .width_ = FRAME_WIDTH,
+        .height_ = FRAME_HEIGHT,
+        .stride_ = FRAME_STRIDE,
+        .damage_ = damage,
+    };
+    return frame;
+}
+
+/**
+ * @tc.name: DamagePropagation01
+ * @tc.desc: With change detection the handler gets the changed tiles only, unchanged frames are not delivered
+ * @tc.type: FUNC
+ */
+HWTEST_F(SurfaceReaderTest, DamagePropagation01, Function | SmallTest | Level2)
+{
+    SurfaceReader reader;
+    sptr<RecordingHandler> handler = new RecordingHandler();
+    reader.SetHandler(handler);
+    reader.SetChangeDetectionEnabled(true);
+    std::vector<uint8_t> content(FRAME_STRIDE * FRAME_HEIGHT, 0);
+
+    auto frame = MakeFrame(content, FULL_DAMAGE);
+    ASSERT_TRUE(reader.ProcessFrame(frame));
+    content[FRAME_STRIDE + TILE_SIZE * BPP] = 1; // first pixel of the second tile in the second row
+    frame = MakeFrame(content, FULL_DAMAGE);
+    ASSERT_TRUE(reader.ProcessFrame(frame));
+    frame = MakeFrame(content, FULL_DAMAGE);
+    ASSERT_TRUE(reader.ProcessFrame(frame));
+
+    ASSERT_EQ(2u, handler->damages_.size());
+    ASSERT_EQ(FULL_DAMAGE, handler->damages_[0]);
+    ASSERT_EQ(SECOND_TILE, handler->damages_[1]);
+}
+
+/**
+ * @tc.name: DamagePropagation02
+ * @tc.desc: The changes of a frame the handler failed on are delivered with the next frame
+ * @tc.type: FUNC
+ */
+HWTEST_F(SurfaceReaderTest, DamagePropagation02, Function | SmallTest | Level2)
+{
+    SurfaceReader reader;
+    sptr<RecordingHandler> handler = new RecordingHandler();
+    reader.SetHandler(handler);
+    reader.SetChangeDetectionEnabled(true);
+    std::vector<uint8_t> content(FRAME_STRIDE * FRAME_HEIGHT, 0);
+    auto frame = MakeFrame(content, FULL_DAMAGE);
+    ASSERT_TRUE(reader.ProcessFrame(frame));
+
+    content[TILE_SIZE * BPP] = 1; // first pixel of the second tile
+    handler->result_ = false;
+    frame = MakeFrame(content, FULL_DAMAGE);
+    ASSERT_FALSE(reader.ProcessFrame(frame));
+    handler->result_ = true;
+    frame = MakeFrame(content, FULL_DAMAGE);
+    ASSERT_TRUE(reader.ProcessFrame(frame));
+
+    ASSERT_EQ(3u, handler->damages_.size());
+    ASSERT_EQ(SECOND_TILE, handler->damages_[1]);
+    ASSERT_EQ(SECOND_TILE, handler->damages_[2]);
+
+    // disabling the detection delivers the damage reported by the producer again
+    reader.SetChangeDetectionEnabled(false);
+    frame = MakeFrame(content, FULL_DAMAGE);
+    ASSERT_TRUE(reader.ProcessFrame(frame));
+    ASSERT_EQ(FULL_DAMAGE, handler->damages_.back());
+}
+
+/**
+ * @tc.name: DamagePropagation03
+ * @tc.desc: SurfaceReaderHandlerImpl copies only the damage into the content it builds its pixel maps from
+ * @tc.type: FUNC
+ */
+HWTEST_F(SurfaceReaderTest, DamagePropagation03, Function | SmallTest | Level2)
+{
+    sptr<SurfaceReaderHandlerImpl> handler = new SurfaceReaderHandlerImpl();
+    std::vector<uint8_t> content(FRAME_STRIDE * FRAME_HEIGHT, 0);
+    ASSERT_TRUE(handler->OnFrameAvailable(MakeFrame(content, FULL_DAMAGE)));
+    ASSERT_TRUE(handler->IsImageOk());
+    handler->ResetFlag();
+
+    // every pixel differs, but only the second tile is reported as damaged
+    std::fill(content.begin(), content.end(), 1);
+    ASSERT_TRUE(handler->OnFrameAvailable(MakeFrame(content, SECOND_TILE)));
+    ASSERT_TRUE(handler->IsImageOk());
+    auto pixelMap = handler->GetPixelMap();
+    ASSERT_NE(nullptr, pixelMap);
+    const uint8_t* pixels = pixelMap->GetPixels();
+    ASSERT_NE(nullptr, pixels);
+    ASSERT_EQ(0, pixels[0]);
+    ASSERT_EQ(1, pixels[TILE_SIZE * BPP]);
+    ASSERT_EQ(1, pixels[(FRAME_HEIGHT - 1) * FRAME_STRIDE + (FRAME_WIDTH - 1) * BPP]);
+}
+
+/**
+ * @tc.name: TrailingFrame01
+ * @tc.desc: Destroying the reader waits for a trailing frame task already running
+ * @tc.type: FUNC
+ */
+HWTEST_F(SurfaceReaderTest, TrailingFrame01, Function | SmallTest | Level2)
+{
+    SurfaceReader* reader = new SurfaceReader();
+    std::mutex& frameMutex = reader->mutex_;
+    std::atomic<bool> unlocked { false };
+    std::atomic<bool> destroyedBeforeUnlock { false };
+    frameMutex.lock();
+    reader->ScheduleTrailingFrameLocked(0);
+    // the task is now running and waits for the frame state held here
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::thread destroyer([reader, &unlocked, &destroyedBeforeUnlock]() {
+        delete reader;
+        destroyedBeforeUnlock = !unlocked;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    unlocked = true;
+    frameMutex.unlock();
+    destroyer.join();
+    ASSERT_FALSE(destroyedBeforeUnlock);
+}
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tile_change_detector_test.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr uint32_t TILE_SIZE = 16;
+    constexpr uint32_t BPP = 4;
+    constexpr uint32_t FRAME_WIDTH = 100;
+    constexpr uint32_t FRAME_HEIGHT = 50;
+    constexpr uint32_t FRAME_STRIDE = FRAME_WIDTH * BPP;
+    const Rect FULL_DAMAGE = { 0, 0, FRAME_WIDTH, FRAME_HEIGHT };
+}
+
+void TileChangeDetectorTest::SetUpTestCase()
+{
+}
+
+void TileChangeDetectorTest::TearDownTestCase()
+{
+}
+
+void TileChangeDetectorTest::SetUp()
+{
+}
+
+void TileChangeDetectorTest::TearDown()
+{
+}
+
+namespace {
+void SetPixel(std::vector<uint8_t>& frame, uint32_t x, uint32_t y, uint8_t value)
+{
+    frame[y * FRAME_STRIDE + x * BPP] = value;
+}
+
+/**
+ * @tc.name: Detect01
+ * @tc.desc: The first frame is changed as a whole, an identical frame is not changed
+ * @tc.type: FUNC
+ */
+HWTEST_F(TileChangeDetectorTest, Detect01, Function | SmallTest | Level2)
+{
+    TileChangeDetector detector(TILE_SIZE, BPP);
+    std::vector<uint8_t> frame(FRAME_STRIDE * FRAME_HEIGHT, 0);
+    ASSERT_EQ(FULL_DAMAGE, detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, FULL_DAMAGE));
+    detector.Commit();
+
+    Rect changed = detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, FULL_DAMAGE);
+    ASSERT_EQ(0u, changed.width_);
+    ASSERT_EQ(0u, changed.height_);
+}
+
+/**
+ * @tc.name: Detect02
+ * @tc.desc: Changed pixels are reported as the bounding rect of their tiles, clipped to the frame
+ * @tc.type: FUNC
+ */
+HWTEST_F(TileChangeDetectorTest, Detect02, Function | SmallTest | Level2)
+{
+    TileChangeDetector detector(TILE_SIZE, BPP);
+    std::vector<uint8_t> frame(FRAME_STRIDE * FRAME_HEIGHT, 0);
+    detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, FULL_DAMAGE);
+    detector.Commit();
+
+    SetPixel(frame, 20, 5, 1); // 20, 5: pixel in tile (1, 0)
+    Rect expected = { 16, 0, 16, 16 };
+    ASSERT_EQ(expected, detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, FULL_DAMAGE));
+    detector.Commit();
+
+    SetPixel(frame, 99, 49, 1); // 99, 49: last pixel, in the partial tile (6, 3)
+    SetPixel(frame, 40, 20, 1); // 40, 20: pixel in tile (2, 1)
+    expected = { 32, 16, 68, 34 };
+    ASSERT_EQ(expected, detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, FULL_DAMAGE));
+}
+
+/**
+ * @tc.name: Detect03
+ * @tc.desc: Only tiles inside the damage are compared, a size change or reset reports the whole frame
+ * @tc.type: FUNC
+ */
+HWTEST_F(TileChangeDetectorTest, Detect03, Function | SmallTest | Level2)
+{
+    TileChangeDetector detector(TILE_SIZE, BPP);
+    std::vector<uint8_t> frame(FRAME_STRIDE * FRAME_HEIGHT, 0);
+    detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, FULL_DAMAGE);
+    detector.Commit();
+
+    SetPixel(frame, 70, 40, 1); // 70, 40: pixel in tile (4, 2)
+    Rect damage = { 0, 0, 32, 32 };
+    Rect changed = detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, damage);
+    ASSERT_EQ(0u, changed.width_);
+
+    Rect halfFrame = { 0, 0, FRAME_WIDTH / 2, FRAME_HEIGHT };
+    ASSERT_EQ(halfFrame, detector.Detect(frame.data(), FRAME_WIDTH / 2, FRAME_HEIGHT, FRAME_STRIDE, damage));
+
+    detector.Reset();
+    ASSERT_EQ(FULL_DAMAGE, detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, damage));
+}
+
+/**
+ * @tc.name: Commit01
+ * @tc.desc: Changes of a frame which was not committed are reported again with the next frame
+ * @tc.type: FUNC
+ */
+HWTEST_F(TileChangeDetectorTest, Commit01, Function | SmallTest | Level2)
+{
+    TileChangeDetector detector(TILE_SIZE, BPP);
+    std::vector<uint8_t> frame(FRAME_STRIDE * FRAME_HEIGHT, 0);
+    detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, FULL_DAMAGE);
+    detector.Commit();
+
+    SetPixel(frame, 20, 5, 1); // 20, 5: pixel in tile (1, 0)
+    Rect expected = { 16, 0, 16, 16 };
+    ASSERT_EQ(expected, detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, FULL_DAMAGE));
+    ASSERT_EQ(expected, detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, FULL_DAMAGE));
+    detector.Commit();
+
+    Rect changed = detector.Detect(frame.data(), FRAME_WIDTH, FRAME_HEIGHT, FRAME_STRIDE, FULL_DAMAGE);
+    ASSERT_EQ(0u, changed.width_);
+    ASSERT_EQ(0u, changed.height_);
+}
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vsync_station_test.h"
+
+#include <chrono>
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+using CallbackType = VsyncStation::CallbackType;
+namespace {
+    constexpr int64_t FRAME_PERIOD_60HZ = 16666667;
+    constexpr int64_t FRAME_PERIOD_120HZ = 8333333;
+    constexpr int64_t SKIPPED_VSYNC_INTERVAL = 50000000;
+    constexpr int64_t LATE_VSYNC_NANOSECONDS = 100000000; // several frame periods before the callbacks run
+    constexpr int64_t EARLY_VSYNC_NANOSECONDS = 1000000000; // the deadline is far away
+    constexpr uint32_t FRAME_PERIOD_SAMPLES = 9; // 9: one more timestamp than the intervals of a window
+
+    int64_t GetCurrentTimeNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void AddPendingCallback(CallbackType type, const std::shared_ptr<VsyncStation::VsyncCallback>& callback)
+    {
+        VsyncStation::GetInstance().pendingCallbacks_[static_cast<size_t>(type)].push_back(callback);
+    }
+
+    std::shared_ptr<VsyncStation::VsyncCallback> MakeCallback(std::vector<CallbackType>& calls, CallbackType type)
+    {
+        auto callback = std::make_shared<VsyncStation::VsyncCallback>();
+        callback->onCallback = [&calls, type](int64_t) { calls.push_back(type); };
+        return callback;
+    }
+
+    void FeedVsyncs(int64_t begin, int64_t interval)
+    {
+        auto& station = VsyncStation::GetInstance();
+        for (uint32_t i = 0; i < FRAME_PERIOD_SAMPLES; i++) {
+            station.UpdateFramePeriodLocked(begin + interval * i);
+        }
+    }
+}
+
+void VsyncStationTest::SetUpTestCase()
+{
+    // no vsync receiver is created, the callbacks are driven by calling the vsync handling directly
+    VsyncStation::GetInstance().vsyncHandler_ = std::make_shared<AppExecFwk::EventHandler>(
+        AppExecFwk::EventRunner::Create("vsync_station_test"));
+}
+
+void VsyncStationTest::TearDownTestCase()
+{
+    VsyncStation::GetInstance().vsyncHandler_->RemoveAllEvents();
+    VsyncStation::GetInstance().vsyncHandler_ = nullptr;
+}
+
+void VsyncStationTest::SetUp()
+{
+    ResetStation();
+}
+
+void VsyncStationTest::TearDown()
+{
+    ResetStation();
+}
+
+void VsyncStationTest::ResetStation()
+{
+    auto& station = VsyncStation::GetInstance();
+    for (size_t i = 0; i < VsyncStation::CALLBACK_TYPE_NUM; i++) {
+        station.pendingCallbacks_[i].clear();
+        station.dispatchingCallbacks_[i].clear();
+    }
+    station.hasRequestedVsync_ = false;
+    station.isIdleDeferred_ = false;
+    station.lastVsyncTimestamp_ = 0;
+    station.vsyncIntervalCount_ = 0;
+    station.framePeriodNs_ = FRAME_PERIOD_60HZ;
+}
+
+namespace {
+/**
+ * @tc.name: CallbackOrder01
+ * @tc.desc: Callbacks of one vsync run by type, whatever the order they were requested in
+ * @tc.type: FUNC
+ */
+HWTEST_F(VsyncStationTest, CallbackOrder01, Function | SmallTest | Level2)
+{
+    std::vector<CallbackType> calls;
+    AddPendingCallback(CallbackType::CALLBACK_IDLE, MakeCallback(calls, CallbackType::CALLBACK_IDLE));
+    AddPendingCallback(CallbackType::CALLBACK_FRAME, MakeCallback(calls, CallbackType::CALLBACK_FRAME));
+    AddPendingCallback(CallbackType::CALLBACK_ANIMATION, MakeCallback(calls, CallbackType::CALLBACK_ANIMATION));
+    AddPendingCallback(CallbackType::CALLBACK_INPUT, MakeCallback(calls, CallbackType::CALLBACK_INPUT));
+    VsyncStation::GetInstance().VsyncCallbackInner(GetCurrentTimeNs() + EARLY_VSYNC_NANOSECONDS);
+    std::vector<CallbackType> expected = { CallbackType::CALLBACK_INPUT, CallbackType::CALLBACK_ANIMATION,
+        CallbackType::CALLBACK_FRAME, CallbackType::CALLBACK_IDLE };
+    ASSERT_EQ(expected, calls);
+
+    // a dispatched callback is not run again without a new request
+    VsyncStation::GetInstance().VsyncCallbackInner(GetCurrentTimeNs() + EARLY_VSYNC_NANOSECONDS);
+    ASSERT_EQ(expected.size(), calls.size());
+}
+
+/**
+ * @tc.name: IdleDeferral01
+ * @tc.desc: Idle callbacks of a late vsync move to the next vsync once, then run even if it is late as well
+ * @tc.type: FUNC
+ */
+HWTEST_F(VsyncStationTest, IdleDeferral01, Function | SmallTest | Level2)
+{
+    auto& station = VsyncStation::GetInstance();
+    std::vector<CallbackType> calls;
+    auto idleCallback = MakeCallback(calls, CallbackType::CALLBACK_IDLE);
+    AddPendingCallback(CallbackType::CALLBACK_FRAME, MakeCallback(calls, CallbackType::CALLBACK_FRAME));
+    AddPendingCallback(CallbackType::CALLBACK_IDLE, idleCallback);
+    station.VsyncCallbackInner(GetCurrentTimeNs() - LATE_VSYNC_NANOSECONDS);
+    ASSERT_EQ(std::vector<CallbackType>({ CallbackType::CALLBACK_FRAME }), calls);
+    ASSERT_EQ(1u, station.pendingCallbacks_[static_cast<size_t>(CallbackType::CALLBACK_IDLE)].size());
+    ASSERT_TRUE(station.hasRequestedVsync_);
+
+    station.VsyncCallbackInner(GetCurrentTimeNs() - LATE_VSYNC_NANOSECONDS);
+    ASSERT_EQ(std::vector<CallbackType>({ CallbackType::CALLBACK_FRAME, CallbackType::CALLBACK_IDLE }), calls);
+
+    // having run, the idle callbacks may be deferred again
+    AddPendingCallback(CallbackType::CALLBACK_IDLE, idleCallback);
+    station.VsyncCallbackInner(GetCurrentTimeNs() - LATE_VSYNC_NANOSECONDS);
+    ASSERT_EQ(2u, calls.size());
+    station.VsyncCallbackInner(GetCurrentTimeNs() + EARLY_VSYNC_NANOSECONDS);
+    ASSERT_EQ(3u, calls.size());
+}
+
+/**
+ * @tc.name: IdleDeferral02
+ * @tc.desc: An idle callback requested again by a frame callback of the late vsync is deferred only once
+ * @tc.type: FUNC
+ */
+HWTEST_F(VsyncStationTest, IdleDeferral02, Function | SmallTest | Level2)
+{
+    auto& station = VsyncStation::GetInstance();
+    std::vector<CallbackType> calls;
+    auto idleCallback = MakeCallback(calls, CallbackType::CALLBACK_IDLE);
+    auto frameCallback = std::make_shared<VsyncStation::VsyncCallback>();
+    frameCallback->onCallback = [&idleCallback](int64_t) {
+        AddPendingCallback(CallbackType::CALLBACK_IDLE, idleCallback);
+    };
+    AddPendingCallback(CallbackType::CALLBACK_FRAME, frameCallback);
+    AddPendingCallback(CallbackType::CALLBACK_IDLE, idleCallback);
+    station.VsyncCallbackInner(GetCurrentTimeNs() - LATE_VSYNC_NANOSECONDS);
+    ASSERT_EQ(1u, station.pendingCallbacks_[static_cast<size_t>(CallbackType::CALLBACK_IDLE)].size());
+    station.VsyncCallbackInner(GetCurrentTimeNs() + EARLY_VSYNC_NANOSECONDS);
+    ASSERT_EQ(1u, calls.size());
+}
+
+/**
+ * @tc.name: FramePeriod01
+ * @tc.desc: The idle deadline follows the measured vsync period and ignores skipped vsyncs
+ * @tc.type: FUNC
+ */
+HWTEST_F(VsyncStationTest, FramePeriod01, Function | SmallTest | Level2)
+{
+    auto& station = VsyncStation::GetInstance();
+    FeedVsyncs(SKIPPED_VSYNC_INTERVAL, FRAME_PERIOD_120HZ);
+    ASSERT_EQ(FRAME_PERIOD_120HZ, station.framePeriodNs_);
+
+    int64_t begin = station.lastVsyncTimestamp_ + SKIPPED_VSYNC_INTERVAL;
+    FeedVsyncs(begin, SKIPPED_VSYNC_INTERVAL);
+    ASSERT_EQ(FRAME_PERIOD_120HZ, station.framePeriodNs_);
+
+    FeedVsyncs(station.lastVsyncTimestamp_ + FRAME_PERIOD_60HZ, FRAME_PERIOD_60HZ);
+    ASSERT_EQ(FRAME_PERIOD_60HZ, station.framePeriodNs_);
+}
+
+/**
+ * @tc.name: CallbackCost01
+ * @tc.desc: Every dispatched callback is timed into the cost of its type
+ * @tc.type: FUNC
+ */
+HWTEST_F(VsyncStationTest, CallbackCost01, Function | SmallTest | Level2)
+{
+    auto& station = VsyncStation::GetInstance();
+    station.ResetCallbackCosts();
+    std::vector<CallbackType> calls;
+    AddPendingCallback(CallbackType::CALLBACK_FRAME, MakeCallback(calls, CallbackType::CALLBACK_FRAME));
+    station.VsyncCallbackInner(GetCurrentTimeNs() + EARLY_VSYNC_NANOSECONDS);
+    ASSERT_EQ(1u, station.callbackCosts_[static_cast<size_t>(CallbackType::CALLBACK_FRAME)].GetSnapshot().count_);
+    ASSERT_NE(std::string::npos, station.GetCallbackCostInfo().find("frame"));
+    station.ResetCallbackCosts();
+    ASSERT_EQ(0u, station.callbackCosts_[static_cast<size_t>(CallbackType::CALLBACK_FRAME)].GetSnapshot().count_);
+}
+}
+} // namespace Rosen
+} // namespace OHOS
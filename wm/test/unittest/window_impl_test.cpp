@@ -15,6 +15,9 @@
 
 #include "window_impl_test.h"
 
+#include <chrono>
+#include <thread>
+
 using namespace testing;
 using namespace testing::ext;
 
@@ -400,6 +403,89 @@ HWTEST_F(WindowImplTest, ShowHideWindow06, Function | SmallTest | Level3)
     ASSERT_EQ(WMError::WM_OK, window_->Hide());
 }
 
+/**
+ * @tc.name: ShowHideWindow07
+ * @tc.desc: Speculative show returns before add window and hide waits for it
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowImplTest, ShowHideWindow07, Function | SmallTest | Level3)
+{
+    std::unique_ptr<Mocker> m = std::make_unique<Mocker>();
+    sptr<WindowOption> option = new WindowOption();
+    option->SetWindowName("ShowHideWindow07");
+    option->SetSpeculativeShowEnabled(true);
+    sptr<WindowImpl> window = new WindowImpl(option);
+    EXPECT_CALL(m->Mock(), CreateWindow(_, _, _, _, _)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Create(""));
+
+    EXPECT_CALL(m->Mock(), AddWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Show());
+    EXPECT_CALL(m->Mock(), RemoveWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Hide());
+
+    EXPECT_CALL(m->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Destroy());
+}
+
+/**
+ * @tc.name: ShowHideWindow08
+ * @tc.desc: Failed speculative add window rolls the window back to hidden
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowImplTest, ShowHideWindow08, Function | SmallTest | Level3)
+{
+    std::unique_ptr<Mocker> m = std::make_unique<Mocker>();
+    sptr<WindowOption> option = new WindowOption();
+    option->SetWindowName("ShowHideWindow08");
+    option->SetSpeculativeShowEnabled(true);
+    sptr<WindowImpl> window = new WindowImpl(option);
+    EXPECT_CALL(m->Mock(), CreateWindow(_, _, _, _, _)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Create(""));
+
+    EXPECT_CALL(m->Mock(), AddWindow(_)).Times(1).WillOnce(Return(WMError::WM_ERROR_SAMGR));
+    ASSERT_EQ(WMError::WM_OK, window->Show());
+    EXPECT_CALL(m->Mock(), RemoveWindow(_)).Times(0);
+    ASSERT_EQ(WMError::WM_OK, window->Hide());
+    ASSERT_EQ(WindowState::STATE_HIDDEN, window->state_);
+
+    EXPECT_CALL(m->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Destroy());
+}
+
+/**
+ * @tc.name: ShowHideWindow09
+ * @tc.desc: Property updates after a speculative show reach server after the add window
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowImplTest, ShowHideWindow09, Function | SmallTest | Level3)
+{
+    std::unique_ptr<Mocker> m = std::make_unique<Mocker>();
+    sptr<WindowOption> option = new WindowOption();
+    option->SetWindowName("ShowHideWindow09");
+    option->SetSpeculativeShowEnabled(true);
+    sptr<WindowImpl> window = new WindowImpl(option);
+    EXPECT_CALL(m->Mock(), CreateWindow(_, _, _, _, _)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Create(""));
+
+    {
+        InSequence sequence;
+        EXPECT_CALL(m->Mock(), AddWindow(_)).Times(1).WillOnce(Invoke([](sptr<WindowProperty>& property) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 50: slow server
+            return WMError::WM_OK;
+        }));
+        EXPECT_CALL(m->Mock(), UpdateProperty(_, PropertyChangeAction::ACTION_UPDATE_FOCUSABLE)).Times(1)
+            .WillOnce(Return(WMError::WM_OK));
+        EXPECT_CALL(m->Mock(), UpdateProperty(_, PropertyChangeAction::ACTION_UPDATE_TOUCHABLE)).Times(1)
+            .WillOnce(Return(WMError::WM_OK));
+    }
+    ASSERT_EQ(WMError::WM_OK, window->Show());
+    ASSERT_EQ(WMError::WM_OK, window->SetFocusable(false));
+    ASSERT_EQ(WMError::WM_OK, window->SetTouchable(false));
+
+    EXPECT_CALL(m->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Destroy());
+}
+
 /**
  * @tc.name: SetSystemBarProperty01
  * @tc.desc: SetSystemBarProperty with default param
@@ -1092,6 +1178,69 @@ HWTEST_F(WindowImplTest, SetTouchable02, Function | SmallTest | Level3)
     ASSERT_EQ(WMError::WM_OK, window->SetTouchable(true));
     ASSERT_TRUE(window->GetTouchable());
 }
+
+/**
+ * @tc.name: PredictedRect01
+ * @tc.desc: The rect of the create reply is the window rect, and the first matching layout is a hit
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowImplTest, PredictedRect01, Function | SmallTest | Level2)
+{
+    sptr<WindowOption> option = new WindowOption();
+    option->SetWindowName("WindowImplTest_PredictedRect01");
+    sptr<WindowImpl> window = new WindowImpl(option);
+    const Rect predictedRect = { 0, 48, 720, 1232 };
+    EXPECT_CALL(m_->Mock(), CreateWindow(_, _, _, _, _)).Times(1).WillOnce(Invoke(
+        [&predictedRect](sptr<IWindow>&, sptr<WindowProperty>& property, std::shared_ptr<RSSurfaceNode>,
+        uint32_t&, const sptr<IRemoteObject>&) {
+            property->SetWindowRect(predictedRect);
+            return WMError::WM_OK;
+        }));
+    ASSERT_EQ(WMError::WM_OK, window->Create(""));
+    ASSERT_TRUE(window->GetRect() == predictedRect);
+    ASSERT_TRUE(window->isRectPredicted_);
+
+    ASSERT_TRUE(window->ConsumeRectPrediction(predictedRect));
+    // later layouts always reach ace
+    ASSERT_FALSE(window->isRectPredicted_);
+    ASSERT_FALSE(window->ConsumeRectPrediction(predictedRect));
+
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Destroy());
+}
+
+/**
+ * @tc.name: PredictedRect02
+ * @tc.desc: A first layout that differs from the prediction is a miss, an empty reply predicts nothing
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowImplTest, PredictedRect02, Function | SmallTest | Level2)
+{
+    sptr<WindowOption> option = new WindowOption();
+    option->SetWindowName("WindowImplTest_PredictedRect02");
+    sptr<WindowImpl> window = new WindowImpl(option);
+    const Rect predictedRect = { 0, 48, 720, 1232 };
+    const Rect layoutRect = { 0, 0, 720, 1280 };
+    EXPECT_CALL(m_->Mock(), CreateWindow(_, _, _, _, _)).Times(1).WillOnce(Invoke(
+        [&predictedRect](sptr<IWindow>&, sptr<WindowProperty>& property, std::shared_ptr<RSSurfaceNode>,
+        uint32_t&, const sptr<IRemoteObject>&) {
+            property->SetWindowRect(predictedRect);
+            return WMError::WM_OK;
+        }));
+    ASSERT_EQ(WMError::WM_OK, window->Create(""));
+    ASSERT_FALSE(window->ConsumeRectPrediction(layoutRect));
+    ASSERT_FALSE(window->isRectPredicted_);
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Destroy());
+
+    option->SetWindowName("WindowImplTest_PredictedRect02_Empty");
+    window = new WindowImpl(option);
+    EXPECT_CALL(m_->Mock(), CreateWindow(_, _, _, _, _)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Create(""));
+    ASSERT_FALSE(window->isRectPredicted_);
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Destroy());
+}
 }
 } // namespace Rosen
 } // namespace OHOS
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_layout_cache_test.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    const Rect PORTRAIT_RECT = { 0, 0, 720, 1280 };
+    const Rect LANDSCAPE_RECT = { 0, 0, 1280, 720 };
+    const Rect PORTRAIT_LIMIT_RECT = { 0, 48, 720, 1184 };
+    const Rect LANDSCAPE_LIMIT_RECT = { 0, 48, 1280, 624 };
+    constexpr float VIRTUAL_PIXEL_RATIO = 1.5f;
+}
+
+void WindowLayoutCacheTest::SetUpTestCase()
+{
+}
+
+void WindowLayoutCacheTest::TearDownTestCase()
+{
+}
+
+void WindowLayoutCacheTest::SetUp()
+{
+}
+
+void WindowLayoutCacheTest::TearDown()
+{
+}
+
+namespace {
+/**
+ * @tc.name: FindAndInsert01
+ * @tc.desc: A value is found only with the display rect, limit rect and ratio it was inserted with
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutCacheTest, FindAndInsert01, Function | SmallTest | Level2)
+{
+    WindowLayoutCache<Rect> cache;
+    WindowLayoutCacheKey portrait = { PORTRAIT_RECT, PORTRAIT_LIMIT_RECT, VIRTUAL_PIXEL_RATIO };
+    Rect value = { 0, 0, 0, 0 };
+    ASSERT_FALSE(cache.Find(portrait, value));
+
+    cache.Insert(portrait, PORTRAIT_LIMIT_RECT);
+    ASSERT_TRUE(cache.Find(portrait, value));
+    ASSERT_EQ(PORTRAIT_LIMIT_RECT, value);
+
+    WindowLayoutCacheKey otherLimit = { PORTRAIT_RECT, PORTRAIT_RECT, VIRTUAL_PIXEL_RATIO };
+    ASSERT_FALSE(cache.Find(otherLimit, value));
+    WindowLayoutCacheKey otherRatio = { PORTRAIT_RECT, PORTRAIT_LIMIT_RECT, 2.0f };
+    ASSERT_FALSE(cache.Find(otherRatio, value));
+
+    cache.Insert(portrait, PORTRAIT_RECT);
+    ASSERT_EQ(1u, cache.Size());
+    ASSERT_TRUE(cache.Find(portrait, value));
+    ASSERT_EQ(PORTRAIT_RECT, value);
+}
+
+/**
+ * @tc.name: Evict01
+ * @tc.desc: The least recently used entry is evicted when the cache is full
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutCacheTest, Evict01, Function | SmallTest | Level2)
+{
+    WindowLayoutCache<Rect> cache(2); // 2: capacity
+    WindowLayoutCacheKey portrait = { PORTRAIT_RECT, PORTRAIT_LIMIT_RECT, VIRTUAL_PIXEL_RATIO };
+    WindowLayoutCacheKey landscape = { LANDSCAPE_RECT, LANDSCAPE_LIMIT_RECT, VIRTUAL_PIXEL_RATIO };
+    WindowLayoutCacheKey fullLandscape = { LANDSCAPE_RECT, LANDSCAPE_RECT, VIRTUAL_PIXEL_RATIO };
+    cache.Insert(portrait, PORTRAIT_LIMIT_RECT);
+    cache.Insert(landscape, LANDSCAPE_LIMIT_RECT);
+
+    Rect value;
+    ASSERT_TRUE(cache.Find(portrait, value));
+    cache.Insert(fullLandscape, LANDSCAPE_RECT);
+    ASSERT_EQ(2u, cache.Size());
+    ASSERT_TRUE(cache.Find(portrait, value));
+    ASSERT_FALSE(cache.Find(landscape, value));
+    ASSERT_TRUE(cache.Find(fullLandscape, value));
+
+    cache.Clear();
+    ASSERT_EQ(0u, cache.Size());
+}
+}
+} // namespace Rosen
+} // namespace OHOS
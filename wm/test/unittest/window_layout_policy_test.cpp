@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_layout_policy_test.h"
+
+#include "window_helper.h"
+#include "window_node_container.h"
+#include "window_stub.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr DisplayId DISPLAY_ID = 0;
+    const Rect PORTRAIT_RECT = { 0, 0, 720, 1280 };
+    const Rect LANDSCAPE_RECT = { 0, 0, 1280, 720 };
+    const Rect STATUS_BAR_RECT = { 0, 0, 1280, 48 };
+    const Rect FLOATING_RECT = { 100, 100, 300, 400 };
+    constexpr int32_t DIVIDER_POS_Y = 640; // within the move bounds of the divider on the portrait display
+    constexpr int32_t DIVIDER_MOVE_STEP = 20;
+    constexpr uint32_t LONG_NOTIFY_INTERVAL = 60000; // ms, no second notification during a test
+
+    // counts how often each window is placed, a display change must place every window once
+    template<typename Policy>
+    class CountingLayoutPolicy : public Policy {
+    public:
+        CountingLayoutPolicy(const std::map<DisplayId, Rect>& displayRectMap, WindowNodeMaps& windowNodeMaps)
+            : Policy(displayRectMap, windowNodeMaps) {}
+        void LayoutWindowNode(const sptr<WindowNode>& node) override
+        {
+            if (node != nullptr && node->parent_ != nullptr) {
+                layoutCount_[node->GetWindowId()]++;
+            }
+            Policy::LayoutWindowNode(node);
+        }
+        std::map<uint32_t, uint32_t> layoutCount_;
+    };
+
+    class RecordingWindow : public WindowStub {
+    public:
+        void UpdateWindowRect(const struct Rect& rect, bool decoStatus, WindowSizeChangeReason reason) override
+        {
+            rects_.emplace_back(rect, reason);
+        }
+        void UpdateWindowMode(WindowMode mode) override {}
+        void UpdateFocusStatus(bool focused) override {}
+        void UpdateAvoidArea(const std::vector<Rect>& avoidAreas) override {}
+        void UpdateWindowState(WindowState state) override {}
+        void UpdateWindowDragInfo(const PointInfo& point, DragEvent event) override {}
+        void UpdateDisplayId(DisplayId from, DisplayId to) override {}
+        void UpdateOccupiedAreaChangeInfo(const sptr<OccupiedAreaChangeInfo>& info) override {}
+        void UpdateActiveStatus(bool isActive) override {}
+        std::vector<std::pair<Rect, WindowSizeChangeReason>> rects_;
+    };
+
+    std::vector<std::pair<Rect, WindowSizeChangeReason>>& GetNotifiedRects(const sptr<WindowNode>& node)
+    {
+        return static_cast<RecordingWindow*>(node->GetWindowToken().GetRefPtr())->rects_;
+    }
+
+    // the divider is moved the way the server handles a divider drag event
+    void MoveDivider(const sptr<WindowLayoutPolicy>& policy, const sptr<WindowNode>& divider, int32_t posY)
+    {
+        Rect rect = divider->GetRequestRect();
+        rect.posY_ = posY;
+        divider->SetRequestRect(rect);
+        divider->SetWindowSizeChangeReason(WindowSizeChangeReason::DRAG);
+        policy->UpdateWindowNode(divider, false);
+    }
+}
+
+void WindowLayoutPolicyTest::SetUpTestCase()
+{
+}
+
+void WindowLayoutPolicyTest::TearDownTestCase()
+{
+}
+
+void WindowLayoutPolicyTest::SetUp()
+{
+    displayRectMap_ = { { DISPLAY_ID, PORTRAIT_RECT } };
+    for (auto rootType : { WindowRootNodeType::ABOVE_WINDOW_NODE, WindowRootNodeType::APP_WINDOW_NODE,
+        WindowRootNodeType::BELOW_WINDOW_NODE }) {
+        windowNodeMaps_[DISPLAY_ID][rootType] = std::make_unique<std::vector<sptr<WindowNode>>>();
+        rootNodes_[rootType] = new WindowNode();
+    }
+}
+
+void WindowLayoutPolicyTest::TearDown()
+{
+    windowNodeMaps_.clear();
+    rootNodes_.clear();
+}
+
+sptr<WindowNode> WindowLayoutPolicyTest::CreateWindowNode(uint32_t windowId, WindowType type, WindowMode mode,
+    const Rect& requestRect)
+{
+    sptr<WindowProperty> property = new WindowProperty();
+    property->SetWindowId(windowId);
+    property->SetWindowType(type);
+    property->SetWindowMode(mode);
+    property->SetRequestRect(requestRect);
+    property->SetDisplayId(DISPLAY_ID);
+    property->SetWindowFlags(static_cast<uint32_t>(WindowFlag::WINDOW_FLAG_NEED_AVOID));
+    sptr<WindowNode> node = new WindowNode(property);
+    node->currentVisibility_ = true;
+    return node;
+}
+
+void WindowLayoutPolicyTest::AddWindowNode(const sptr<WindowNode>& node, WindowRootNodeType rootType)
+{
+    node->parent_ = rootNodes_[rootType];
+    rootNodes_[rootType]->children_.push_back(node);
+    windowNodeMaps_[DISPLAY_ID][rootType]->push_back(node);
+}
+
+void WindowLayoutPolicyTest::CreateSplitWindowNodes(sptr<WindowNode>& divider, sptr<WindowNode>& primary,
+    sptr<WindowNode>& secondary)
+{
+    divider = CreateWindowNode(10, WindowType::WINDOW_TYPE_DOCK_SLICE, WindowMode::WINDOW_MODE_FLOATING,
+        { 0, DIVIDER_POS_Y, PORTRAIT_RECT.width_, DIVIDER_WIDTH });
+    primary = CreateWindowNode(11, WindowType::WINDOW_TYPE_APP_MAIN_WINDOW, WindowMode::WINDOW_MODE_SPLIT_PRIMARY,
+        PORTRAIT_RECT);
+    secondary = CreateWindowNode(12, WindowType::WINDOW_TYPE_APP_MAIN_WINDOW,
+        WindowMode::WINDOW_MODE_SPLIT_SECONDARY, PORTRAIT_RECT);
+    for (auto& node : { divider, primary, secondary }) {
+        node->SetWindowToken(new RecordingWindow());
+    }
+}
+
+namespace {
+/**
+ * @tc.name: UpdateDisplayRect01
+ * @tc.desc: A display change lays out every window of the cascade policy once, the app avoids the status bar
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutPolicyTest, UpdateDisplayRect01, Function | SmallTest | Level2)
+{
+    auto statusBar = CreateWindowNode(1, WindowType::WINDOW_TYPE_STATUS_BAR, WindowMode::WINDOW_MODE_FLOATING,
+        STATUS_BAR_RECT);
+    auto app = CreateWindowNode(2, WindowType::WINDOW_TYPE_APP_MAIN_WINDOW, WindowMode::WINDOW_MODE_FULLSCREEN,
+        PORTRAIT_RECT);
+    auto desktop = CreateWindowNode(3, WindowType::WINDOW_TYPE_DESKTOP, WindowMode::WINDOW_MODE_FULLSCREEN,
+        PORTRAIT_RECT);
+    AddWindowNode(statusBar, WindowRootNodeType::ABOVE_WINDOW_NODE);
+    AddWindowNode(app, WindowRootNodeType::APP_WINDOW_NODE);
+    AddWindowNode(desktop, WindowRootNodeType::BELOW_WINDOW_NODE);
+    sptr<CountingLayoutPolicy<WindowLayoutPolicyCascade>> policy =
+        new CountingLayoutPolicy<WindowLayoutPolicyCascade>(displayRectMap_, windowNodeMaps_);
+    policy->Launch();
+    policy->layoutCount_.clear();
+
+    policy->UpdateDisplayRect(DISPLAY_ID, LANDSCAPE_RECT);
+
+    ASSERT_EQ(1u, policy->layoutCount_[statusBar->GetWindowId()]);
+    ASSERT_EQ(1u, policy->layoutCount_[app->GetWindowId()]);
+    ASSERT_EQ(1u, policy->layoutCount_[desktop->GetWindowId()]);
+    Rect appRect = app->GetWindowRect();
+    ASSERT_EQ(LANDSCAPE_RECT.width_, appRect.width_);
+    ASSERT_EQ(static_cast<int32_t>(STATUS_BAR_RECT.height_), appRect.posY_);
+    ASSERT_EQ(LANDSCAPE_RECT.height_ - STATUS_BAR_RECT.height_, appRect.height_);
+}
+
+/**
+ * @tc.name: UpdateDisplayRect02
+ * @tc.desc: A display change lays out the avoid area windows of the tile policy once
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutPolicyTest, UpdateDisplayRect02, Function | SmallTest | Level2)
+{
+    auto statusBar = CreateWindowNode(1, WindowType::WINDOW_TYPE_STATUS_BAR, WindowMode::WINDOW_MODE_FLOATING,
+        STATUS_BAR_RECT);
+    auto desktop = CreateWindowNode(2, WindowType::WINDOW_TYPE_DESKTOP, WindowMode::WINDOW_MODE_FULLSCREEN,
+        PORTRAIT_RECT);
+    AddWindowNode(statusBar, WindowRootNodeType::ABOVE_WINDOW_NODE);
+    AddWindowNode(desktop, WindowRootNodeType::BELOW_WINDOW_NODE);
+    sptr<CountingLayoutPolicy<WindowLayoutPolicyTile>> policy =
+        new CountingLayoutPolicy<WindowLayoutPolicyTile>(displayRectMap_, windowNodeMaps_);
+    policy->Launch();
+    policy->layoutCount_.clear();
+
+    policy->UpdateDisplayRect(DISPLAY_ID, LANDSCAPE_RECT);
+
+    ASSERT_EQ(1u, policy->layoutCount_[statusBar->GetWindowId()]);
+    ASSERT_EQ(1u, policy->layoutCount_[desktop->GetWindowId()]);
+    ASSERT_EQ(LANDSCAPE_RECT.width_, desktop->GetWindowRect().width_);
+}
+
+/**
+ * @tc.name: PredictLayoutRect01
+ * @tc.desc: The tile policy predicts the rect a new main window gets when it is added, without placing it
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutPolicyTest, PredictLayoutRect01, Function | SmallTest | Level2)
+{
+    auto statusBar = CreateWindowNode(1, WindowType::WINDOW_TYPE_STATUS_BAR, WindowMode::WINDOW_MODE_FLOATING,
+        STATUS_BAR_RECT);
+    AddWindowNode(statusBar, WindowRootNodeType::ABOVE_WINDOW_NODE);
+    sptr<WindowLayoutPolicyTile> policy = new WindowLayoutPolicyTile(displayRectMap_, windowNodeMaps_);
+    policy->Launch();
+
+    auto app = CreateWindowNode(2, WindowType::WINDOW_TYPE_APP_MAIN_WINDOW, WindowMode::WINDOW_MODE_FULLSCREEN,
+        { 0, 0, 0, 0 });
+    Rect predictedRect = policy->GetPredictedLayoutRect(app);
+    ASSERT_FALSE(WindowHelper::IsEmptyRect(predictedRect));
+    ASSERT_TRUE(WindowHelper::IsEmptyRect(app->GetWindowRect()));
+    ASSERT_EQ(0u, policy->foregroundNodesMap_[DISPLAY_ID].size());
+
+    AddWindowNode(app, WindowRootNodeType::APP_WINDOW_NODE);
+    policy->AddWindowNode(app);
+    ASSERT_TRUE(app->GetWindowRect() == predictedRect);
+}
+
+/**
+ * @tc.name: PredictLayoutRect02
+ * @tc.desc: The tile policy predicts the back of the foreground queue for a window added next to another one
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutPolicyTest, PredictLayoutRect02, Function | SmallTest | Level2)
+{
+    displayRectMap_[DISPLAY_ID] = LANDSCAPE_RECT;
+    sptr<WindowLayoutPolicyTile> policy = new WindowLayoutPolicyTile(displayRectMap_, windowNodeMaps_);
+    policy->Launch();
+    auto first = CreateWindowNode(1, WindowType::WINDOW_TYPE_APP_MAIN_WINDOW, WindowMode::WINDOW_MODE_FULLSCREEN,
+        { 0, 0, 0, 0 });
+    AddWindowNode(first, WindowRootNodeType::APP_WINDOW_NODE);
+    policy->AddWindowNode(first);
+    Rect firstRect = first->GetWindowRect();
+
+    auto second = CreateWindowNode(2, WindowType::WINDOW_TYPE_APP_MAIN_WINDOW, WindowMode::WINDOW_MODE_FULLSCREEN,
+        { 0, 0, 0, 0 });
+    Rect predictedRect = policy->GetPredictedLayoutRect(second);
+    ASSERT_TRUE(first->GetWindowRect() == firstRect);
+    if (policy->maxTileWinNumMap_[DISPLAY_ID] < 2) { // 2: the display is too narrow to tile two windows
+        return;
+    }
+    AddWindowNode(second, WindowRootNodeType::APP_WINDOW_NODE);
+    policy->AddWindowNode(second);
+    ASSERT_TRUE(second->GetWindowRect() == predictedRect);
+    ASSERT_FALSE(first->GetWindowRect() == firstRect);
+}
+
+/**
+ * @tc.name: DividerDrag01
+ * @tc.desc: A divider move during a drag lays out the split windows only, without a drag all windows
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutPolicyTest, DividerDrag01, Function | SmallTest | Level2)
+{
+    sptr<WindowNode> divider;
+    sptr<WindowNode> primary;
+    sptr<WindowNode> secondary;
+    CreateSplitWindowNodes(divider, primary, secondary);
+    auto statusBar = CreateWindowNode(1, WindowType::WINDOW_TYPE_STATUS_BAR, WindowMode::WINDOW_MODE_FLOATING,
+        STATUS_BAR_RECT);
+    auto floating = CreateWindowNode(2, WindowType::WINDOW_TYPE_APP_MAIN_WINDOW, WindowMode::WINDOW_MODE_FLOATING,
+        FLOATING_RECT);
+    AddWindowNode(statusBar, WindowRootNodeType::ABOVE_WINDOW_NODE);
+    for (auto& node : { floating, divider, primary, secondary }) {
+        AddWindowNode(node, WindowRootNodeType::APP_WINDOW_NODE);
+    }
+    sptr<CountingLayoutPolicy<WindowLayoutPolicyCascade>> policy =
+        new CountingLayoutPolicy<WindowLayoutPolicyCascade>(displayRectMap_, windowNodeMaps_);
+    policy->Launch();
+    MoveDivider(policy, divider, DIVIDER_POS_Y);
+    policy->layoutCount_.clear();
+
+    policy->StartDividerDrag(DISPLAY_ID);
+    MoveDivider(policy, divider, DIVIDER_POS_Y - DIVIDER_MOVE_STEP);
+    ASSERT_EQ(1u, policy->layoutCount_[primary->GetWindowId()]);
+    ASSERT_EQ(1u, policy->layoutCount_[secondary->GetWindowId()]);
+    ASSERT_EQ(0u, policy->layoutCount_[floating->GetWindowId()]);
+    ASSERT_EQ(0u, policy->layoutCount_[statusBar->GetWindowId()]);
+    ASSERT_EQ(divider->GetWindowRect().posY_, static_cast<int32_t>(primary->GetWindowRect().height_));
+
+    policy->EndDividerDrag(DISPLAY_ID);
+    policy->layoutCount_.clear();
+    MoveDivider(policy, divider, DIVIDER_POS_Y);
+    ASSERT_EQ(1u, policy->layoutCount_[primary->GetWindowId()]);
+    ASSERT_EQ(1u, policy->layoutCount_[floating->GetWindowId()]);
+    ASSERT_EQ(1u, policy->layoutCount_[statusBar->GetWindowId()]);
+}
+
+/**
+ * @tc.name: DividerDrag02
+ * @tc.desc: Within the notify interval the split windows are laid out but not notified
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutPolicyTest, DividerDrag02, Function | SmallTest | Level2)
+{
+    sptr<WindowNode> divider;
+    sptr<WindowNode> primary;
+    sptr<WindowNode> secondary;
+    CreateSplitWindowNodes(divider, primary, secondary);
+    for (auto& node : { divider, primary, secondary }) {
+        AddWindowNode(node, WindowRootNodeType::APP_WINDOW_NODE);
+    }
+    sptr<WindowLayoutPolicyCascade> policy = new WindowLayoutPolicyCascade(displayRectMap_, windowNodeMaps_);
+    policy->Launch();
+    policy->SetDividerDragNotifyInterval(LONG_NOTIFY_INTERVAL);
+    MoveDivider(policy, divider, DIVIDER_POS_Y);
+    GetNotifiedRects(primary).clear();
+
+    policy->StartDividerDrag(DISPLAY_ID);
+    MoveDivider(policy, divider, DIVIDER_POS_Y - DIVIDER_MOVE_STEP);
+    ASSERT_EQ(1u, GetNotifiedRects(primary).size());
+    MoveDivider(policy, divider, DIVIDER_POS_Y - 2 * DIVIDER_MOVE_STEP); // 2: second step
+    ASSERT_EQ(1u, GetNotifiedRects(primary).size());
+    ASSERT_EQ(divider->GetWindowRect().posY_, static_cast<int32_t>(primary->GetWindowRect().height_));
+    ASSERT_FALSE(GetNotifiedRects(primary).back().first == primary->GetWindowRect());
+}
+
+/**
+ * @tc.name: DividerDrag03
+ * @tc.desc: A notify interval of 0 notifies the split windows on every divider move
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutPolicyTest, DividerDrag03, Function | SmallTest | Level2)
+{
+    sptr<WindowNode> divider;
+    sptr<WindowNode> primary;
+    sptr<WindowNode> secondary;
+    CreateSplitWindowNodes(divider, primary, secondary);
+    for (auto& node : { divider, primary, secondary }) {
+        AddWindowNode(node, WindowRootNodeType::APP_WINDOW_NODE);
+    }
+    sptr<WindowLayoutPolicyCascade> policy = new WindowLayoutPolicyCascade(displayRectMap_, windowNodeMaps_);
+    policy->Launch();
+    policy->SetDividerDragNotifyInterval(0);
+    MoveDivider(policy, divider, DIVIDER_POS_Y);
+    GetNotifiedRects(secondary).clear();
+
+    policy->StartDividerDrag(DISPLAY_ID);
+    constexpr int32_t moveCount = 3;
+    for (int32_t i = 1; i <= moveCount; i++) {
+        MoveDivider(policy, divider, DIVIDER_POS_Y - i * DIVIDER_MOVE_STEP);
+    }
+    ASSERT_EQ(static_cast<size_t>(moveCount), GetNotifiedRects(secondary).size());
+    ASSERT_TRUE(GetNotifiedRects(secondary).back().first == secondary->GetWindowRect());
+}
+
+/**
+ * @tc.name: DividerDrag04
+ * @tc.desc: The drag end notifies every split window of its exact final rect, also after suppressed moves
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutPolicyTest, DividerDrag04, Function | SmallTest | Level2)
+{
+    sptr<WindowNodeContainer> container = new WindowNodeContainer(DISPLAY_ID, PORTRAIT_RECT.width_,
+        PORTRAIT_RECT.height_);
+    sptr<WindowNode> divider;
+    sptr<WindowNode> primary;
+    sptr<WindowNode> secondary;
+    CreateSplitWindowNodes(divider, primary, secondary);
+    for (auto& node : { divider, primary, secondary }) {
+        node->parent_ = container->appWindowNode_;
+        container->appWindowNode_->children_.push_back(node);
+        container->windowNodeMaps_[DISPLAY_ID][WindowRootNodeType::APP_WINDOW_NODE]->push_back(node);
+    }
+    auto policy = container->layoutPolicy_;
+    policy->SetDividerDragNotifyInterval(LONG_NOTIFY_INTERVAL);
+    MoveDivider(policy, divider, DIVIDER_POS_Y);
+
+    container->UpdateSizeChangeReason(divider, WindowSizeChangeReason::DRAG_START);
+    ASSERT_TRUE(policy->IsDividerDragging(DISPLAY_ID));
+    MoveDivider(policy, divider, DIVIDER_POS_Y - DIVIDER_MOVE_STEP);
+    MoveDivider(policy, divider, DIVIDER_POS_Y - 2 * DIVIDER_MOVE_STEP); // 2: second step, not notified
+    container->UpdateSizeChangeReason(divider, WindowSizeChangeReason::DRAG_END);
+
+    ASSERT_FALSE(policy->IsDividerDragging(DISPLAY_ID));
+    for (auto& node : { primary, secondary }) {
+        auto& notified = GetNotifiedRects(node).back();
+        ASSERT_EQ(WindowSizeChangeReason::DRAG_END, notified.second);
+        ASSERT_TRUE(notified.first == node->GetWindowRect());
+    }
+    ASSERT_EQ(divider->GetWindowRect().posY_, static_cast<int32_t>(primary->GetWindowRect().height_));
+    // the nodes were never added to RS or input, they are not removed through the container
+    container->appWindowNode_->children_.clear();
+    container->windowNodeMaps_[DISPLAY_ID][WindowRootNodeType::APP_WINDOW_NODE]->clear();
+}
+
+/**
+ * @tc.name: DividerDrag05
+ * @tc.desc: Removing the divider or cleaning the policy ends the drag mode
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowLayoutPolicyTest, DividerDrag05, Function | SmallTest | Level2)
+{
+    sptr<WindowNode> divider;
+    sptr<WindowNode> primary;
+    sptr<WindowNode> secondary;
+    CreateSplitWindowNodes(divider, primary, secondary);
+    for (auto& node : { divider, primary, secondary }) {
+        AddWindowNode(node, WindowRootNodeType::APP_WINDOW_NODE);
+    }
+    sptr<WindowLayoutPolicyCascade> policy = new WindowLayoutPolicyCascade(displayRectMap_, windowNodeMaps_);
+    policy->Launch();
+
+    policy->StartDividerDrag(DISPLAY_ID);
+    ASSERT_TRUE(policy->IsDividerDragging(DISPLAY_ID));
+    policy->RemoveWindowNode(divider);
+    ASSERT_FALSE(policy->IsDividerDragging(DISPLAY_ID));
+
+    policy->StartDividerDrag(DISPLAY_ID);
+    policy->Clean();
+    ASSERT_FALSE(policy->IsDividerDragging(DISPLAY_ID));
+}
+}
+} // namespace Rosen
+} // namespace OHOS
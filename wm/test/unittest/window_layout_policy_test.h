@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FRAMEWORKS_WM_TEST_UT_WINDOW_LAYOUT_POLICY_TEST_H
+#define FRAMEWORKS_WM_TEST_UT_WINDOW_LAYOUT_POLICY_TEST_H
+
+#include <gtest/gtest.h>
+#include "window_layout_policy_cascade.h"
+#include "window_layout_policy_tile.h"
+
+namespace OHOS {
+namespace Rosen {
+class WindowLayoutPolicyTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    virtual void SetUp() override;
+    virtual void TearDown() override;
+    sptr<WindowNode> CreateWindowNode(uint32_t windowId, WindowType type, WindowMode mode, const Rect& requestRect);
+    void AddWindowNode(const sptr<WindowNode>& node, WindowRootNodeType rootType);
+    // a divider with a window on each side, every window records the rects notified to it
+    void CreateSplitWindowNodes(sptr<WindowNode>& divider, sptr<WindowNode>& primary, sptr<WindowNode>& secondary);
+
+    std::map<DisplayId, Rect> displayRectMap_;
+    WindowNodeMaps windowNodeMaps_;
+    std::map<WindowRootNodeType, sptr<WindowNode>> rootNodes_;
+};
+} // namespace ROSEN
+} // namespace OHOS
+#endif // FRAMEWORKS_WM_TEST_UT_WINDOW_LAYOUT_POLICY_TEST_H
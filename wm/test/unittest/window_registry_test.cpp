@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_registry_test.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+void WindowRegistryTest::SetUpTestCase()
+{
+    m_ = std::make_unique<Mocker>();
+}
+
+void WindowRegistryTest::TearDownTestCase()
+{
+    m_ = nullptr;
+}
+
+void WindowRegistryTest::SetUp()
+{
+}
+
+void WindowRegistryTest::TearDown()
+{
+}
+
+sptr<WindowImpl> WindowRegistryTest::CreateWindow(const std::string& name, uint32_t windowId,
+    const std::string& parentName, const std::shared_ptr<AbilityRuntime::Context>& context)
+{
+    sptr<WindowOption> option = new WindowOption();
+    option->SetWindowName(name);
+    if (parentName != "") {
+        option->SetWindowType(WindowType::WINDOW_TYPE_APP_SUB_WINDOW);
+    }
+    sptr<WindowImpl> window = new WindowImpl(option);
+    EXPECT_CALL(m_->Mock(), CreateWindow(_, _, _, _, _)).Times(1)
+        .WillOnce(DoAll(SetArgReferee<3>(windowId), Return(WMError::WM_OK)));
+    if (window->Create(parentName, context) != WMError::WM_OK) {
+        return nullptr;
+    }
+    return window;
+}
+
+namespace {
+/**
+ * @tc.name: FindWindow01
+ * @tc.desc: Created windows can be found by name and by id until destroyed
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowRegistryTest, FindWindow01, Function | SmallTest | Level2)
+{
+    auto& registry = WindowRegistry::GetInstance();
+    sptr<WindowImpl> window = CreateWindow("WindowRegistryTest_FindWindow01", 101, "");
+    ASSERT_NE(nullptr, window);
+    ASSERT_EQ(window, registry.FindByName("WindowRegistryTest_FindWindow01"));
+    ASSERT_EQ(window, registry.FindById(101));
+    ASSERT_TRUE(WindowImpl::Find("WindowRegistryTest_FindWindow01") != nullptr);
+
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Destroy());
+    ASSERT_EQ(nullptr, registry.FindByName("WindowRegistryTest_FindWindow01"));
+    ASSERT_EQ(nullptr, registry.FindById(101));
+}
+
+/**
+ * @tc.name: SubWindow01
+ * @tc.desc: Sub windows are indexed by parent and destroyed with it
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowRegistryTest, SubWindow01, Function | SmallTest | Level2)
+{
+    auto& registry = WindowRegistry::GetInstance();
+    sptr<WindowImpl> parent = CreateWindow("WindowRegistryTest_Parent", 102, "");
+    ASSERT_NE(nullptr, parent);
+    sptr<WindowImpl> sub1 = CreateWindow("WindowRegistryTest_Sub1", 103, "WindowRegistryTest_Parent");
+    ASSERT_NE(nullptr, sub1);
+    sptr<WindowImpl> sub2 = CreateWindow("WindowRegistryTest_Sub2", 104, "WindowRegistryTest_Parent");
+    ASSERT_NE(nullptr, sub2);
+    ASSERT_EQ(2, WindowImpl::GetSubWindow(102).size());
+
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, sub1->Destroy());
+    ASSERT_EQ(1, registry.GetSubWindows(102).size());
+    ASSERT_EQ(sub2, registry.GetSubWindows(102)[0]);
+
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, parent->Destroy());
+    ASSERT_EQ(nullptr, registry.FindByName("WindowRegistryTest_Sub2"));
+    ASSERT_TRUE(registry.GetSubWindows(102).empty());
+    ASSERT_FALSE(sub2->IsWindowValid());
+}
+
+/**
+ * @tc.name: DuplicateName01
+ * @tc.desc: A second window with a registered name is rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowRegistryTest, DuplicateName01, Function | SmallTest | Level2)
+{
+    sptr<WindowImpl> window = CreateWindow("WindowRegistryTest_Duplicate", 105, "");
+    ASSERT_NE(nullptr, window);
+
+    sptr<WindowOption> option = new WindowOption();
+    option->SetWindowName("WindowRegistryTest_Duplicate");
+    sptr<WindowImpl> duplicate = new WindowImpl(option);
+    ASSERT_EQ(WMError::WM_ERROR_INVALID_PARAM, duplicate->Create(""));
+    ASSERT_EQ(window, WindowRegistry::GetInstance().FindByName("WindowRegistryTest_Duplicate"));
+
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Destroy());
+}
+
+/**
+ * @tc.name: DuplicateName02
+ * @tc.desc: A window whose name is taken while it is being created fails and is destroyed on the server
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowRegistryTest, DuplicateName02, Function | SmallTest | Level2)
+{
+    auto& registry = WindowRegistry::GetInstance();
+    sptr<WindowOption> option = new WindowOption();
+    option->SetWindowName("WindowRegistryTest_Race");
+    sptr<WindowImpl> winner = new WindowImpl(option);
+    sptr<WindowImpl> loser = new WindowImpl(option);
+    EXPECT_CALL(m_->Mock(), CreateWindow(_, _, _, _, _)).Times(1)
+        .WillOnce(DoAll(SetArgReferee<3>(108), InvokeWithoutArgs([&registry, winner] {
+            registry.Add(winner, INVALID_WINDOW_ID);
+        }), Return(WMError::WM_OK)));
+    EXPECT_CALL(m_->Mock(), DestroyWindow(108)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_ERROR_INVALID_PARAM, loser->Create(""));
+    ASSERT_EQ(winner, registry.FindByName("WindowRegistryTest_Race"));
+    ASSERT_EQ(nullptr, registry.FindById(108));
+
+    registry.Remove(winner->GetWindowId());
+    ASSERT_EQ(nullptr, registry.FindByName("WindowRegistryTest_Race"));
+}
+
+/**
+ * @tc.name: FindMainWindowByContext01
+ * @tc.desc: Windows without context are not indexed by context
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowRegistryTest, FindMainWindowByContext01, Function | SmallTest | Level2)
+{
+    sptr<WindowImpl> window = CreateWindow("WindowRegistryTest_Context", 106, "");
+    ASSERT_NE(nullptr, window);
+    ASSERT_EQ(nullptr, WindowRegistry::GetInstance().FindMainWindowByContext(nullptr));
+
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Destroy());
+}
+
+/**
+ * @tc.name: FindMainWindowByContext02
+ * @tc.desc: Main windows are indexed by their context, sub windows are not
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowRegistryTest, FindMainWindowByContext02, Function | SmallTest | Level2)
+{
+    auto& registry = WindowRegistry::GetInstance();
+    auto context = std::make_shared<AbilityRuntime::AbilityContextImpl>();
+    sptr<WindowImpl> window = CreateWindow("WindowRegistryTest_MainContext", 109, "", context);
+    ASSERT_NE(nullptr, window);
+    sptr<WindowImpl> sub = CreateWindow("WindowRegistryTest_SubContext", 110, "WindowRegistryTest_MainContext",
+        context);
+    ASSERT_NE(nullptr, sub);
+    ASSERT_EQ(window, registry.FindMainWindowByContext(context.get()));
+
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, sub->Destroy());
+    ASSERT_EQ(window, registry.FindMainWindowByContext(context.get()));
+
+    EXPECT_CALL(m_->Mock(), DestroyWindow(_)).Times(1).WillOnce(Return(WMError::WM_OK));
+    ASSERT_EQ(WMError::WM_OK, window->Destroy());
+    ASSERT_EQ(nullptr, registry.FindMainWindowByContext(context.get()));
+}
+}
+} // namespace Rosen
+} // namespace OHOS
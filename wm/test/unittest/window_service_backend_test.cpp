@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_service_backend_test.h"
+
+#include <functional>
+#include <ui/rs_surface_node.h>
+
+#include "display_manager_service_inner.h"
+#include "window_stub.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr uint32_t DISPLAY_WIDTH = 720;
+    constexpr uint32_t DISPLAY_HEIGHT = 1280;
+
+    class HeadlessTestWindow : public WindowStub {
+    public:
+        void UpdateWindowRect(const struct Rect& rect, bool decoStatus, WindowSizeChangeReason reason) override {}
+        void UpdateWindowMode(WindowMode mode) override {}
+        void UpdateFocusStatus(bool focused) override {}
+        void UpdateAvoidArea(const std::vector<Rect>& avoidAreas) override {}
+        void UpdateWindowState(WindowState state) override {}
+        void UpdateWindowDragInfo(const PointInfo& point, DragEvent event) override {}
+        void UpdateDisplayId(DisplayId from, DisplayId to) override {}
+        void UpdateOccupiedAreaChangeInfo(const sptr<OccupiedAreaChangeInfo>& info) override {}
+        void UpdateActiveStatus(bool isActive) override {}
+    };
+
+    uint32_t AddHeadlessWindow(const std::string& name, const std::function<void(sptr<WindowProperty>&)>& setter)
+    {
+        sptr<IWindow> window = new HeadlessTestWindow();
+        sptr<WindowProperty> property = new WindowProperty();
+        property->SetWindowName(name);
+        property->SetWindowType(WindowType::WINDOW_TYPE_APP_MAIN_WINDOW);
+        property->SetWindowMode(WindowMode::WINDOW_MODE_FULLSCREEN);
+        property->SetDisplayId(WindowServiceBackendTest::displayId_);
+        property->SetWindowRect({ 0, 0, DISPLAY_WIDTH, DISPLAY_HEIGHT });
+        property->SetTokenState(false);
+        setter(property);
+        struct RSSurfaceNodeConfig config;
+        config.SurfaceNodeName = name;
+        std::shared_ptr<RSSurfaceNode> surfaceNode = RSSurfaceNode::Create(config);
+        uint32_t windowId = INVALID_WINDOW_ID;
+        auto& wms = WindowManagerService::GetInstance();
+        if (wms.CreateWindow(window, property, surfaceNode, windowId, nullptr) != WMError::WM_OK) {
+            return INVALID_WINDOW_ID;
+        }
+        property->SetWindowId(windowId);
+        if (wms.AddWindow(property) != WMError::WM_OK) {
+            wms.DestroyWindow(windowId);
+            return INVALID_WINDOW_ID;
+        }
+        return windowId;
+    }
+
+    bool HasInputWindow(const std::vector<MMI::LogicalDisplayInfo>& displays, uint32_t windowId)
+    {
+        for (auto& display : displays) {
+            for (auto& windowInfo : display.windowsInfo) {
+                if (windowInfo.id == static_cast<int32_t>(windowId)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+}
+
+void WindowServiceBackendTest::SetUpTestCase()
+{
+    // the in-process service runs on a headless display, no render service screen is needed
+    ASSERT_TRUE(WindowManagerService::GetInstance().StartInProcess(DISPLAY_WIDTH, DISPLAY_HEIGHT));
+    displayId_ = DisplayManagerServiceInner::GetInstance().GetDefaultDisplayId();
+}
+
+void WindowServiceBackendTest::TearDownTestCase()
+{
+}
+
+void WindowServiceBackendTest::SetUp()
+{
+}
+
+void WindowServiceBackendTest::TearDown()
+{
+}
+
+namespace {
+/**
+ * @tc.name: AddWindow01
+ * @tc.desc: add and remove a window, WMS flushes RS and publishes the input windows through the backend
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowServiceBackendTest, AddWindow01, Function | SmallTest | Level2)
+{
+    Mocker m;
+    uint32_t windowId = AddHeadlessWindow("AddWindow01", [](sptr<WindowProperty>&) {});
+    ASSERT_NE(INVALID_WINDOW_ID, windowId);
+    ASSERT_LT(0u, m.Mock().GetCallCount(BackendCallType::FLUSH_TRANSACTION));
+    ASSERT_LT(0u, m.Mock().GetCallCount(BackendCallType::UPDATE_INPUT_DISPLAY_INFO));
+    ASSERT_TRUE(HasInputWindow(m.Mock().GetLogicalDisplays(), windowId));
+
+    uint64_t flushCount = m.Mock().GetCallCount(BackendCallType::FLUSH_TRANSACTION);
+    ASSERT_EQ(WMError::WM_OK, WindowManagerService::GetInstance().RemoveWindow(windowId));
+    ASSERT_LT(flushCount, m.Mock().GetCallCount(BackendCallType::FLUSH_TRANSACTION));
+    ASSERT_FALSE(HasInputWindow(m.Mock().GetLogicalDisplays(), windowId));
+    ASSERT_EQ(WMError::WM_OK, WindowManagerService::GetInstance().DestroyWindow(windowId));
+}
+
+/**
+ * @tc.name: TurnScreenOn01
+ * @tc.desc: a window which turns the screen on wakes up the headless device
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowServiceBackendTest, TurnScreenOn01, Function | SmallTest | Level2)
+{
+    Mocker m;
+    m.Mock().SetScreenOn(false);
+    uint32_t windowId = AddHeadlessWindow("TurnScreenOn01", [](sptr<WindowProperty>& property) {
+        property->SetTurnScreenOn(true);
+    });
+    ASSERT_NE(INVALID_WINDOW_ID, windowId);
+    ASSERT_EQ(1u, m.Mock().GetCallCount(BackendCallType::WAKEUP_DEVICE));
+    ASSERT_TRUE(m.Mock().IsScreenOn());
+    ASSERT_EQ(WMError::WM_OK, WindowManagerService::GetInstance().DestroyWindow(windowId));
+}
+
+/**
+ * @tc.name: Brightness01
+ * @tc.desc: the brightness of the active window is overridden through the backend and restored on removal
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowServiceBackendTest, Brightness01, Function | SmallTest | Level2)
+{
+    Mocker m;
+    uint32_t windowId = AddHeadlessWindow("Brightness01", [](sptr<WindowProperty>& property) {
+        property->SetBrightness(0.5f); // half of the maximum brightness
+    });
+    ASSERT_NE(INVALID_WINDOW_ID, windowId);
+    ASSERT_EQ(1u, m.Mock().GetCallCount(BackendCallType::OVERRIDE_BRIGHTNESS));
+    ASSERT_EQ(WMError::WM_OK, WindowManagerService::GetInstance().DestroyWindow(windowId));
+}
+}
+} // namespace Rosen
+} // namespace OHOS
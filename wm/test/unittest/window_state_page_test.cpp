@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_state_page_test.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+void WindowStatePageTest::SetUpTestCase()
+{
+}
+
+void WindowStatePageTest::TearDownTestCase()
+{
+}
+
+void WindowStatePageTest::SetUp()
+{
+}
+
+void WindowStatePageTest::TearDown()
+{
+}
+
+namespace {
+WindowStateSnapshot MakeSnapshot(uint32_t focusWinId)
+{
+    WindowStateSnapshot snapshot {};
+    snapshot.displayCount_ = 1;
+    snapshot.displays_[0] = { 0, 0, 0, 1080, 2340, focusWinId, 0 }; // 1080, 2340: display size
+    snapshot.topWindowCount_ = 2; // 2: two visible main windows
+    snapshot.topWindows_[0] = { 1, 3 }; // 3: sub window on top of main window 1
+    snapshot.topWindows_[1] = { 2, 2 };
+    snapshot.isSystemDecorEnable_ = 1;
+    return snapshot;
+}
+
+/**
+ * @tc.name: WriteRead01
+ * @tc.desc: A published snapshot is read back and answers the top window and focus queries
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowStatePageTest, WriteRead01, Function | SmallTest | Level2)
+{
+    WindowStatePage page;
+    InitWindowStatePage(page);
+    WriteWindowStatePage(page, MakeSnapshot(1));
+
+    WindowStateSnapshot snapshot;
+    ASSERT_TRUE(ReadWindowStatePage(page, snapshot));
+    ASSERT_EQ(1u, snapshot.isSystemDecorEnable_);
+    uint32_t topWinId = 0;
+    ASSERT_TRUE(FindTopWindowId(snapshot, 1, topWinId));
+    ASSERT_EQ(3u, topWinId);
+    ASSERT_TRUE(FindTopWindowId(snapshot, 2, topWinId)); // 2: main window without sub window
+    ASSERT_EQ(2u, topWinId);
+    ASSERT_FALSE(FindTopWindowId(snapshot, 4, topWinId)); // 4: hidden main window
+    uint32_t focusWinId = 0;
+    ASSERT_TRUE(FindFocusWindowId(snapshot, 0, focusWinId));
+    ASSERT_EQ(1u, focusWinId);
+    ASSERT_FALSE(FindFocusWindowId(snapshot, 1, focusWinId));
+}
+
+/**
+ * @tc.name: Invalid01
+ * @tc.desc: A page of another layout or in the middle of a write is not read
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowStatePageTest, Invalid01, Function | SmallTest | Level2)
+{
+    WindowStatePage page;
+    InitWindowStatePage(page);
+    WriteWindowStatePage(page, MakeSnapshot(1));
+    WindowStateSnapshot snapshot;
+
+    uint32_t sequence = page.sequence_.load();
+    page.sequence_.store(sequence + 1); // writer stopped in the middle of a write
+    ASSERT_FALSE(ReadWindowStatePage(page, snapshot));
+    page.sequence_.store(sequence);
+    ASSERT_TRUE(ReadWindowStatePage(page, snapshot));
+
+    page.version_ = WINDOW_STATE_PAGE_VERSION + 1;
+    ASSERT_FALSE(ReadWindowStatePage(page, snapshot));
+}
+
+/**
+ * @tc.name: Concurrent01
+ * @tc.desc: A reader racing with the writer only sees complete snapshots
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowStatePageTest, Concurrent01, Function | SmallTest | Level2)
+{
+    WindowStatePage page;
+    InitWindowStatePage(page);
+    auto write = [&page](uint32_t value) {
+        WindowStateSnapshot snapshot = MakeSnapshot(value);
+        snapshot.topWindows_[1].topWindowId_ = value;
+        WriteWindowStatePage(page, snapshot);
+    };
+    write(0);
+    std::atomic<bool> stop { false };
+    std::thread writer([&write, &stop]() {
+        for (uint32_t i = 1; !stop.load(); i++) {
+            write(i);
+        }
+    });
+    for (uint32_t i = 0; i < 10000; i++) { // 10000: read times
+        WindowStateSnapshot snapshot;
+        if (ReadWindowStatePage(page, snapshot)) {
+            ASSERT_EQ(snapshot.displays_[0].focusedWindowId_, snapshot.topWindows_[1].topWindowId_);
+        }
+    }
+    stop.store(true);
+    writer.join();
+}
+}
+} // namespace Rosen
+} // namespace OHOS
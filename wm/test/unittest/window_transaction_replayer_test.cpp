@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_transaction_replayer_test.h"
+
+#include <cstdio>
+
+#include <ipc_object_stub.h>
+#include <message_parcel.h>
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    using WindowManagerMessage = IWindowManager::WindowManagerMessage;
+    const std::string RECORD_PATH = "/data/window_transaction_replayer_test.bin";
+    constexpr uint32_t FIRST_REPLAYED_WINDOW_ID = 100;
+
+    // keeps the window tree the replayed transactions build, ids differ from the recorded ones on purpose
+    class TreeWindowManager : public IWindowManager {
+    public:
+        struct Node {
+            uint32_t parentId_;
+            bool isAdded_;
+            DisplayId displayId_ { 0 };
+        };
+
+        sptr<IRemoteObject> AsObject() override
+        {
+            return nullptr;
+        }
+        WMError CreateWindow(sptr<IWindow>& window, sptr<WindowProperty>& property,
+            const std::shared_ptr<RSSurfaceNode>& surfaceNode, uint32_t& windowId, sptr<IRemoteObject> token) override
+        {
+            if (window == nullptr || property == nullptr || surfaceNode == nullptr) {
+                return WMError::WM_ERROR_NULLPTR;
+            }
+            windowId = nextWindowId_++;
+            nodes_[windowId] = { property->GetParentId(), false, property->GetDisplayId() };
+            return WMError::WM_OK;
+        }
+        WMError AddWindow(sptr<WindowProperty>& property) override
+        {
+            auto iter = nodes_.find(property->GetWindowId());
+            if (iter == nodes_.end()) {
+                return WMError::WM_ERROR_INVALID_WINDOW;
+            }
+            iter->second.isAdded_ = true;
+            iter->second.displayId_ = property->GetDisplayId();
+            return WMError::WM_OK;
+        }
+        WMError RemoveWindow(uint32_t windowId) override
+        {
+            auto iter = nodes_.find(windowId);
+            if (iter == nodes_.end()) {
+                return WMError::WM_ERROR_INVALID_WINDOW;
+            }
+            iter->second.isAdded_ = false;
+            return WMError::WM_OK;
+        }
+        WMError DestroyWindow(uint32_t windowId, bool onlySelf) override
+        {
+            return nodes_.erase(windowId) != 0 ? WMError::WM_OK : WMError::WM_ERROR_INVALID_WINDOW;
+        }
+        WMError RequestFocus(uint32_t windowId) override
+        {
+            return WMError::WM_OK;
+        }
+        WMError SetWindowBackgroundBlur(uint32_t windowId, WindowBlurLevel level) override
+        {
+            return WMError::WM_OK;
+        }
+        WMError SetAlpha(uint32_t windowId, float alpha) override
+        {
+            return WMError::WM_OK;
+        }
+        std::vector<Rect> GetAvoidAreaByType(uint32_t windowId, AvoidAreaType type) override
+        {
+            return {};
+        }
+        WMError GetTopWindowId(uint32_t mainWinId, uint32_t& topWinId) override
+        {
+            return WMError::WM_OK;
+        }
+        void ProcessPointDown(uint32_t windowId, bool isStartDrag) override {}
+        void ProcessPointUp(uint32_t windowId) override {}
+        void MinimizeAllAppWindows(DisplayId displayId) override
+        {
+            minimizedDisplayIds_.push_back(displayId);
+        }
+        WMError MaxmizeWindow(uint32_t windowId) override
+        {
+            return WMError::WM_OK;
+        }
+        WMError SetWindowLayoutMode(DisplayId displayId, WindowLayoutMode mode) override
+        {
+            return WMError::WM_OK;
+        }
+        WMError UpdateProperty(sptr<WindowProperty>& windowProperty, PropertyChangeAction action) override
+        {
+            return nodes_.count(windowProperty->GetWindowId()) != 0 ? WMError::WM_OK : WMError::WM_ERROR_INVALID_WINDOW;
+        }
+        void RegisterWindowManagerAgent(WindowManagerAgentType type,
+            const sptr<IWindowManagerAgent>& windowManagerAgent) override {}
+        void UnregisterWindowManagerAgent(WindowManagerAgentType type,
+            const sptr<IWindowManagerAgent>& windowManagerAgent) override {}
+        WMError GetAccessibilityWindowInfo(sptr<AccessibilityWindowInfo>& windowInfo) override
+        {
+            return WMError::WM_OK;
+        }
+        WMError SetWindowAnimationController(const sptr<RSIWindowAnimationController>& controller) override
+        {
+            return WMError::WM_OK;
+        }
+        WMError GetSystemDecorEnable(bool& isSystemDecorEnable) override
+        {
+            return WMError::WM_OK;
+        }
+        void NotifyWindowTransition(WindowTransitionInfo from, WindowTransitionInfo to) override {}
+        WMError GetModeChangeHotZones(DisplayId displayId, ModeChangeHotZones& hotZones) override
+        {
+            return WMError::WM_OK;
+        }
+        sptr<Ashmem> GetWindowStatePage() override
+        {
+            return nullptr;
+        }
+
+        std::map<uint32_t, Node> nodes_;
+        std::vector<DisplayId> minimizedDisplayIds_;
+        uint32_t nextWindowId_ { FIRST_REPLAYED_WINDOW_ID };
+    };
+
+    // writes the transactions the way WindowManagerProxy does and hands them to the recorder like the stub
+    void RecordCreate(uint32_t windowId, uint32_t parentId, DisplayId displayId = 0)
+    {
+        sptr<WindowProperty> property = new WindowProperty();
+        property->SetWindowName("replay_test_" + std::to_string(windowId));
+        property->SetParentId(parentId);
+        property->SetDisplayId(displayId);
+        MessageParcel data;
+        MessageParcel reply;
+        data.WriteInterfaceToken(IWindowManager::GetDescriptor());
+        data.WriteRemoteObject(new IPCObjectStub(u"replay_test"));
+        data.WriteParcelable(property.GetRefPtr());
+        reply.WriteUint32(windowId);
+        reply.WriteInt32(static_cast<int32_t>(WMError::WM_OK));
+        WindowTransactionRecorder::GetInstance().Record(
+            static_cast<uint32_t>(WindowManagerMessage::TRANS_ID_CREATE_WINDOW), data, reply, 0);
+    }
+
+    void RecordAdd(uint32_t windowId, uint32_t parentId, DisplayId displayId = 0)
+    {
+        sptr<WindowProperty> property = new WindowProperty();
+        property->SetWindowId(windowId);
+        property->SetParentId(parentId);
+        property->SetDisplayId(displayId);
+        MessageParcel data;
+        MessageParcel reply;
+        data.WriteInterfaceToken(IWindowManager::GetDescriptor());
+        data.WriteParcelable(property.GetRefPtr());
+        WindowTransactionRecorder::GetInstance().Record(
+            static_cast<uint32_t>(WindowManagerMessage::TRANS_ID_ADD_WINDOW), data, reply, 0);
+    }
+
+    void RecordWindowId(WindowManagerMessage code, uint32_t windowId)
+    {
+        MessageParcel data;
+        MessageParcel reply;
+        data.WriteInterfaceToken(IWindowManager::GetDescriptor());
+        data.WriteUint32(windowId);
+        WindowTransactionRecorder::GetInstance().Record(static_cast<uint32_t>(code), data, reply, 0);
+    }
+
+    void RecordMinimizeAll(DisplayId displayId)
+    {
+        MessageParcel data;
+        MessageParcel reply;
+        data.WriteInterfaceToken(IWindowManager::GetDescriptor());
+        data.WriteUint64(displayId);
+        WindowTransactionRecorder::GetInstance().Record(
+            static_cast<uint32_t>(WindowManagerMessage::TRANS_ID_MINIMIZE_ALL_APP_WINDOWS), data, reply, 0);
+    }
+}
+
+void WindowTransactionReplayerTest::SetUpTestCase()
+{
+}
+
+void WindowTransactionReplayerTest::TearDownTestCase()
+{
+    remove(RECORD_PATH.c_str());
+}
+
+void WindowTransactionReplayerTest::SetUp()
+{
+    ASSERT_TRUE(WindowTransactionRecorder::GetInstance().Start(RECORD_PATH));
+}
+
+void WindowTransactionReplayerTest::TearDown()
+{
+    WindowTransactionRecorder::GetInstance().Stop();
+}
+
+namespace {
+/**
+ * @tc.name: RoundTrip01
+ * @tc.desc: A recorded workload replays to the same window tree with the ids of the target
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowTransactionReplayerTest, RoundTrip01, Function | SmallTest | Level2)
+{
+    RecordCreate(10, INVALID_WINDOW_ID);
+    RecordAdd(10, INVALID_WINDOW_ID);
+    RecordCreate(11, 10);
+    RecordAdd(11, 10);
+    RecordCreate(12, 10);
+    RecordAdd(12, 10);
+    RecordWindowId(WindowManagerMessage::TRANS_ID_REQUEST_FOCUS, 11);
+    RecordWindowId(WindowManagerMessage::TRANS_ID_REMOVE_WINDOW, 12);
+    RecordWindowId(WindowManagerMessage::TRANS_ID_DESTROY_WINDOW, 12);
+    WindowTransactionRecorder::GetInstance().Stop();
+
+    TreeWindowManager target;
+    WindowTransactionReplayer replayer(target);
+    ASSERT_TRUE(replayer.Load(RECORD_PATH));
+    replayer.Replay(false);
+    ASSERT_EQ(0u, replayer.GetFailedCount());
+    ASSERT_EQ(2u, target.nodes_.size());
+    auto& mainNode = target.nodes_[FIRST_REPLAYED_WINDOW_ID];
+    ASSERT_EQ(INVALID_WINDOW_ID, mainNode.parentId_);
+    ASSERT_TRUE(mainNode.isAdded_);
+    auto& subNode = target.nodes_[FIRST_REPLAYED_WINDOW_ID + 1];
+    ASSERT_EQ(FIRST_REPLAYED_WINDOW_ID, subNode.parentId_);
+    ASSERT_TRUE(subNode.isAdded_);
+}
+
+/**
+ * @tc.name: UnknownWindow01
+ * @tc.desc: Transactions on windows the replay did not create fail instead of reaching the target
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowTransactionReplayerTest, UnknownWindow01, Function | SmallTest | Level2)
+{
+    RecordCreate(20, INVALID_WINDOW_ID);
+    RecordAdd(20, INVALID_WINDOW_ID);
+    RecordWindowId(WindowManagerMessage::TRANS_ID_REMOVE_WINDOW, 21);
+    RecordCreate(22, 21);
+    RecordAdd(23, INVALID_WINDOW_ID);
+    WindowTransactionRecorder::GetInstance().Stop();
+
+    TreeWindowManager target;
+    target.nodes_[21] = { INVALID_WINDOW_ID, true }; // same id as a recorded window, must stay untouched
+    WindowTransactionReplayer replayer(target);
+    ASSERT_TRUE(replayer.Load(RECORD_PATH));
+    replayer.Replay(false);
+    ASSERT_EQ(3u, replayer.GetFailedCount());
+    ASSERT_EQ(2u, target.nodes_.size());
+    ASSERT_TRUE(target.nodes_[21].isAdded_);
+    ASSERT_TRUE(target.nodes_[FIRST_REPLAYED_WINDOW_ID].isAdded_);
+}
+
+/**
+ * @tc.name: DisplayId01
+ * @tc.desc: Display ids of window properties and display transactions are mapped to the displays of the target
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowTransactionReplayerTest, DisplayId01, Function | SmallTest | Level2)
+{
+    constexpr DisplayId mappedDisplayId = 5;
+    constexpr DisplayId otherDisplayId = 6;
+    RecordCreate(30, INVALID_WINDOW_ID, mappedDisplayId);
+    RecordAdd(30, INVALID_WINDOW_ID, mappedDisplayId);
+    RecordCreate(31, INVALID_WINDOW_ID, otherDisplayId);
+    RecordAdd(31, INVALID_WINDOW_ID, otherDisplayId);
+    RecordMinimizeAll(mappedDisplayId);
+    RecordMinimizeAll(otherDisplayId);
+    WindowTransactionRecorder::GetInstance().Stop();
+
+    TreeWindowManager target;
+    WindowTransactionReplayer replayer(target);
+    replayer.MapDisplay(mappedDisplayId, 1);
+    replayer.SetDefaultDisplay(0);
+    ASSERT_TRUE(replayer.Load(RECORD_PATH));
+    replayer.Replay(false);
+    ASSERT_EQ(0u, replayer.GetFailedCount());
+    ASSERT_EQ(1u, target.nodes_[FIRST_REPLAYED_WINDOW_ID].displayId_);
+    ASSERT_EQ(0u, target.nodes_[FIRST_REPLAYED_WINDOW_ID + 1].displayId_);
+    ASSERT_EQ((std::vector<DisplayId> { 1, 0 }), target.minimizedDisplayIds_);
+}
+
+/**
+ * @tc.name: DisplayId02
+ * @tc.desc: Without a default display the recorded display ids are replayed unchanged
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowTransactionReplayerTest, DisplayId02, Function | SmallTest | Level2)
+{
+    constexpr DisplayId recordedDisplayId = 5;
+    RecordCreate(40, INVALID_WINDOW_ID, recordedDisplayId);
+    RecordAdd(40, INVALID_WINDOW_ID, recordedDisplayId);
+    WindowTransactionRecorder::GetInstance().Stop();
+
+    TreeWindowManager target;
+    WindowTransactionReplayer replayer(target);
+    ASSERT_TRUE(replayer.Load(RECORD_PATH));
+    replayer.Replay(false);
+    ASSERT_EQ(0u, replayer.GetFailedCount());
+    ASSERT_EQ(recordedDisplayId, target.nodes_[FIRST_REPLAYED_WINDOW_ID].displayId_);
+}
+}
+} // namespace Rosen
+} // namespace OHOS
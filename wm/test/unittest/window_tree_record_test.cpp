@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_tree_record_test.h"
+
+using namespace testing;
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Rosen {
+void WindowTreeRecordTest::SetUpTestCase()
+{
+}
+
+void WindowTreeRecordTest::TearDownTestCase()
+{
+}
+
+void WindowTreeRecordTest::SetUp()
+{
+}
+
+void WindowTreeRecordTest::TearDown()
+{
+}
+
+namespace {
+std::vector<WindowTreeNodeRecord> CreateNodes(uint32_t count)
+{
+    std::vector<WindowTreeNodeRecord> nodes;
+    for (uint32_t i = 0; i < count; i++) {
+        WindowTreeNodeRecord node = {};
+        node.windowId_ = i + 1;
+        node.zOrder_ = count - i;
+        node.width_ = 100; // 100: test width
+        node.height_ = 200; // 200: test height
+        nodes.push_back(node);
+    }
+    return nodes;
+}
+
+/**
+ * @tc.name: Serialize01
+ * @tc.desc: Recorded trees can be serialized and deserialized without loss
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowTreeRecordTest, Serialize01, Function | SmallTest | Level2)
+{
+    WindowTreeRecordBuffer buffer(4);
+    buffer.Record(WindowTreeChangeReason::ADD_WINDOW, CreateNodes(3));
+    buffer.Record(WindowTreeChangeReason::REMOVE_WINDOW, CreateNodes(0));
+    std::vector<uint8_t> data = buffer.Serialize();
+    std::vector<WindowTreeSnapshot> snapshots;
+    ASSERT_TRUE(WindowTreeRecordBuffer::Deserialize(data.data(), data.size(), snapshots));
+    ASSERT_EQ(2u, snapshots.size());
+    ASSERT_EQ(static_cast<uint16_t>(WindowTreeChangeReason::ADD_WINDOW), snapshots[0].header_.reason_);
+    ASSERT_EQ(3u, snapshots[0].nodes_.size());
+    ASSERT_EQ(3u, snapshots[0].nodes_[2].windowId_);
+    ASSERT_EQ(200u, snapshots[0].nodes_[2].height_);
+    ASSERT_EQ(0u, snapshots[1].nodes_.size());
+}
+
+/**
+ * @tc.name: Wrap01
+ * @tc.desc: Only the latest records are kept and returned from oldest to newest
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowTreeRecordTest, Wrap01, Function | SmallTest | Level2)
+{
+    WindowTreeRecordBuffer buffer(2);
+    for (uint32_t i = 1; i <= 5; i++) {
+        buffer.Record(WindowTreeChangeReason::UPDATE_WINDOW, CreateNodes(i));
+    }
+    std::vector<WindowTreeSnapshot> snapshots = buffer.GetSnapshots();
+    ASSERT_EQ(2u, snapshots.size());
+    ASSERT_EQ(3u, snapshots[0].header_.seq_);
+    ASSERT_EQ(4u, snapshots[0].nodes_.size());
+    ASSERT_EQ(4u, snapshots[1].header_.seq_);
+    ASSERT_EQ(5u, snapshots[1].nodes_.size());
+}
+
+/**
+ * @tc.name: Deserialize01
+ * @tc.desc: Truncated or corrupted data is rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(WindowTreeRecordTest, Deserialize01, Function | SmallTest | Level2)
+{
+    WindowTreeRecordBuffer buffer(2);
+    buffer.Record(WindowTreeChangeReason::ADD_WINDOW, CreateNodes(2));
+    std::vector<uint8_t> data = buffer.Serialize();
+    std::vector<WindowTreeSnapshot> snapshots;
+    ASSERT_FALSE(WindowTreeRecordBuffer::Deserialize(data.data(), data.size() - 1, snapshots));
+    data[0] = 0;
+    snapshots.clear();
+    ASSERT_FALSE(WindowTreeRecordBuffer::Deserialize(data.data(), data.size(), snapshots));
+}
+}
+} // namespace Rosen
+} // namespace OHOS
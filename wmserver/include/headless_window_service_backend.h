@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_HEADLESS_WINDOW_SERVICE_BACKEND_H
+#define OHOS_ROSEN_HEADLESS_WINDOW_SERVICE_BACKEND_H
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#include <input_manager.h>
+
+#include "window_service_backend.h"
+
+namespace OHOS {
+namespace Rosen {
+enum class BackendCallType : uint32_t {
+    FLUSH_TRANSACTION,
+    EXTRACT_RS_SURFACE,
+    UPDATE_INPUT_DISPLAY_INFO,
+    IS_SCREEN_ON,
+    WAKEUP_DEVICE,
+    OVERRIDE_BRIGHTNESS,
+    RESTORE_BRIGHTNESS,
+    CREATE_RUNNING_LOCK,
+    CALL_TYPE_END,
+};
+
+// in-memory backend which only records the requests and keeps the state they would have changed
+class HeadlessWindowServiceBackend : public WindowServiceBackend {
+public:
+    HeadlessWindowServiceBackend() = default;
+    ~HeadlessWindowServiceBackend() = default;
+
+    void FlushImplicitTransaction() override;
+    std::shared_ptr<RSSurface> ExtractRSSurface(const std::shared_ptr<RSSurfaceNode>& surfaceNode) override;
+    void UpdateInputDisplayInfo(const std::vector<MMI::PhysicalDisplayInfo>& physicalDisplays,
+        const std::vector<MMI::LogicalDisplayInfo>& logicalDisplays) override;
+    bool IsScreenOn() override;
+    void WakeupDevice() override;
+    void OverrideBrightness(uint32_t brightness) override;
+    void RestoreBrightness() override;
+    std::shared_ptr<PowerMgr::RunningLock> CreateScreenRunningLock(const std::string& name) override;
+
+    uint64_t GetCallCount(BackendCallType type) const;
+    std::vector<MMI::LogicalDisplayInfo> GetLogicalDisplays() const;
+    void SetScreenOn(bool isScreenOn);
+    void Dump(std::string& dumpInfo) const;
+    void Reset();
+
+private:
+    void Count(BackendCallType type);
+
+    static constexpr size_t CALL_TYPE_NUM = static_cast<size_t>(BackendCallType::CALL_TYPE_END);
+    std::array<std::atomic<uint64_t>, CALL_TYPE_NUM> callCounts_ {};
+    std::atomic<bool> isScreenOn_ { true };
+    std::atomic<uint32_t> overrideBrightness_ { 0 };
+    std::atomic<bool> isBrightnessOverridden_ { false };
+    mutable std::mutex mutex_;
+    std::vector<MMI::LogicalDisplayInfo> logicalDisplays_;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_HEADLESS_WINDOW_SERVICE_BACKEND_H
@@ -23,14 +23,16 @@
 #include "surface_draw.h"
 #include "zidl/window_manager_agent_interface.h"
 #include "window_root.h"
+#include "window_state_publisher.h"
 #include "wm_common.h"
 
 namespace OHOS {
 namespace Rosen {
 class WindowController : public RefBase {
 public:
-    WindowController(sptr<WindowRoot>& root, sptr<InputWindowMonitor> inputWindowMonitor) : windowRoot_(root),
-        inputWindowMonitor_(inputWindowMonitor) {}
+    WindowController(sptr<WindowRoot>& root, sptr<InputWindowMonitor> inputWindowMonitor,
+        sptr<WindowStatePublisher> windowStatePublisher) : windowRoot_(root), inputWindowMonitor_(inputWindowMonitor),
+        windowStatePublisher_(windowStatePublisher) {}
     ~WindowController() = default;
 
     WMError CreateWindow(sptr<IWindow>& window, sptr<WindowProperty>& property,
@@ -65,6 +67,8 @@ private:
     void FlushWindowInfoWithDisplayId(DisplayId displayId);
     void UpdateWindowAnimation(const sptr<WindowNode>& node);
     void ProcessDisplayChange(DisplayId displayId, DisplayStateChangeType type);
+    void SaveSystemBarRect(WindowType type, const sptr<DisplayInfo>& lastDisplayInfo);
+    void PrepareSystemBarRect(WindowType type, const sptr<DisplayInfo>& displayInfo, const Rect& defaultRect);
     void StopBootAnimationIfNeed(WindowType type) const;
     WMError SetWindowType(uint32_t windowId, WindowType type);
     WMError SetWindowFlags(uint32_t windowId, uint32_t flags);
@@ -76,6 +80,7 @@ private:
 
     sptr<WindowRoot> windowRoot_;
     sptr<InputWindowMonitor> inputWindowMonitor_;
+    sptr<WindowStatePublisher> windowStatePublisher_;
     sptr<RSIWindowAnimationController> windowAnimationController_ = nullptr;
     std::atomic<uint32_t> windowId_ { INVALID_WINDOW_ID };
     // Remove 'sysBarWinId_' after SystemUI resize 'systembar'
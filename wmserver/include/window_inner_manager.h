@@ -25,7 +25,6 @@
 #ifdef ACE_ENABLE_GL
 #include "render_context/render_context.h"
 #endif
-#include "transaction/rs_transaction.h"
 #include "ui/rs_surface_extractor.h"
 #include "wm_single_instance.h"
 #include "singleton_delegator.h"
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_LAYOUT_CACHE_H
+#define OHOS_ROSEN_WINDOW_LAYOUT_CACHE_H
+
+#include <list>
+#include <utility>
+
+#include "wm_common.h"
+
+namespace OHOS {
+namespace Rosen {
+struct WindowLayoutCacheKey {
+    Rect displayRect_;
+    Rect limitRect_; // display rect left by the avoid area windows
+    float virtualPixelRatio_;
+
+    bool operator==(const WindowLayoutCacheKey& key) const
+    {
+        return displayRect_ == key.displayRect_ && limitRect_ == key.limitRect_ &&
+            virtualPixelRatio_ == key.virtualPixelRatio_;
+    }
+};
+
+/*
+ * Keeps the display level layout artifacts of the last few display geometries, so that switching back to an
+ * orientation or mode seen before does not recompute them. Entries are evicted in least recently used order.
+ */
+template<typename T>
+class WindowLayoutCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4;
+
+    explicit WindowLayoutCache(size_t capacity = DEFAULT_CAPACITY) : capacity_(capacity == 0 ? 1 : capacity) {}
+    ~WindowLayoutCache() = default;
+
+    bool Find(const WindowLayoutCacheKey& key, T& value)
+    {
+        for (auto iter = entries_.begin(); iter != entries_.end(); iter++) {
+            if (iter->first == key) {
+                entries_.splice(entries_.begin(), entries_, iter);
+                value = entries_.front().second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Insert(const WindowLayoutCacheKey& key, const T& value)
+    {
+        for (auto iter = entries_.begin(); iter != entries_.end(); iter++) {
+            if (iter->first == key) {
+                entries_.erase(iter);
+                break;
+            }
+        }
+        entries_.emplace_front(key, value);
+        if (entries_.size() > capacity_) {
+            entries_.pop_back();
+        }
+    }
+
+    void Clear()
+    {
+        entries_.clear();
+    }
+
+    size_t Size() const
+    {
+        return entries_.size();
+    }
+
+private:
+    size_t capacity_;
+    std::list<std::pair<WindowLayoutCacheKey, T>> entries_; // most recently used first
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_WINDOW_LAYOUT_CACHE_H
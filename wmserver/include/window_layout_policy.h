@@ -22,6 +22,7 @@
 
 #include "window_node.h"
 #include "wm_common.h"
+#include "wm_common_inner.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -38,15 +39,22 @@ public:
     virtual void Reset();
     virtual void Reorder();
     virtual void UpdateDisplayInfo(const std::map<DisplayId, Rect>& displayRectMap);
+    virtual void UpdateDisplayRect(DisplayId displayId, const Rect& displayRect);
     virtual void AddWindowNode(const sptr<WindowNode>& node) = 0;
     virtual void LayoutWindowTree(DisplayId displayId);
     virtual void RemoveWindowNode(const sptr<WindowNode>& node);
     virtual void UpdateWindowNode(const sptr<WindowNode>& node, bool isAddWindow = false);
     virtual void UpdateLayoutRect(const sptr<WindowNode>& node) = 0;
     float GetVirtualPixelRatio(DisplayId displayId) const;
+    Rect GetPredictedLayoutRect(const sptr<WindowNode>& node);
     void UpdateClientRectAndResetReason(const sptr<WindowNode>& node, const Rect& lastLayoutRect, const Rect& winRect);
+    void SetDividerDragNotifyInterval(uint32_t interval);
+    void StartDividerDrag(DisplayId displayId);
+    void EndDividerDrag(DisplayId displayId);
+    bool IsDividerDragging(DisplayId displayId) const;
 
 protected:
+    virtual Rect PredictLayoutRect(const sptr<WindowNode>& node);
     void UpdateFloatingLayoutRect(Rect& limitRect, Rect& winRect);
     void UpdateLimitRect(const sptr<WindowNode>& node, Rect& limitRect);
     virtual void LayoutWindowNode(const sptr<WindowNode>& node);
@@ -57,6 +65,8 @@ protected:
     bool IsVerticalDisplay(DisplayId displayId) const;
     bool IsFullScreenRecentWindowExist(const std::vector<sptr<WindowNode>>& nodeVec) const;
     void LayoutWindowNodesByRootType(const std::vector<sptr<WindowNode>>& nodeVec);
+    void LayoutAppAndBelowWindowNodes(DisplayId displayId);
+    bool IsDividerDragNotifyDue(DisplayId displayId);
 
     const std::set<WindowType> avoidTypes_ {
         WindowType::WINDOW_TYPE_STATUS_BAR,
@@ -65,6 +75,9 @@ protected:
     mutable std::map<DisplayId, Rect> displayRectMap_;
     mutable std::map<DisplayId, Rect> limitRectMap_;
     WindowNodeMaps& windowNodeMaps_;
+    std::map<DisplayId, uint64_t> dividerDragNotifyTimeMap_; // displays whose divider is dragged, to last notify time
+    uint32_t dividerDragNotifyInterval_ = DEFAULT_DIVIDER_DRAG_NOTIFY_INTERVAL; // ms
+    bool isSplitRectNotifySuppressed_ = false;
 };
 }
 }
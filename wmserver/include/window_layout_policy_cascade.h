@@ -20,6 +20,7 @@
 #include <refbase.h>
 #include <set>
 
+#include "window_layout_cache.h"
 #include "window_layout_policy.h"
 #include "window_node.h"
 #include "wm_common.h"
@@ -36,19 +37,25 @@ public:
     void Clean() override;
     void Reset() override;
     void Reorder() override;
+    void UpdateDisplayRect(DisplayId displayId, const Rect& displayRect) override;
     void AddWindowNode(const sptr<WindowNode>& node) override;
     void UpdateWindowNode(const sptr<WindowNode>& node, bool isAddWindow = false) override;
     void UpdateLayoutRect(const sptr<WindowNode>& node) override;
     void RemoveWindowNode(const sptr<WindowNode>& node) override;
 
+protected:
+    Rect PredictLayoutRect(const sptr<WindowNode>& node) override;
+
 private:
     void InitAllRects();
+    void InitDisplayRects(DisplayId displayId);
     void InitSplitRects(DisplayId displayId);
     void SetSplitRectByRatio(float ratio, DisplayId displayId);
     void SetSplitRect(const Rect& rect, DisplayId displayId);
     void UpdateSplitLimitRect(const Rect& limitRect, Rect& limitSplitRect);
     void LayoutWindowNode(const sptr<WindowNode>& node) override;
     void LayoutWindowTree(DisplayId displayId) override;
+    void LayoutSplitWindows(DisplayId displayId);
     void InitLimitRects(DisplayId displayId);
     void LimitMoveBounds(Rect& rect, DisplayId displayId) const;
     void InitCascadeRect(DisplayId displayId);
@@ -70,6 +77,7 @@ private:
         Rect firstCascadeRect_;
     };
     mutable std::map<DisplayId, CascadeRects> cascadeRectsMap_;
+    WindowLayoutCache<CascadeRects> layoutCache_;
 };
 }
 }
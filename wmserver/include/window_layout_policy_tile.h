@@ -21,6 +21,7 @@
 #include <refbase.h>
 #include <set>
 
+#include "window_layout_cache.h"
 #include "window_layout_policy.h"
 #include "window_node.h"
 #include "wm_common.h"
@@ -34,16 +35,26 @@ public:
                            WindowNodeMaps& windowNodeMaps);
     ~WindowLayoutPolicyTile() = default;
     void Launch() override;
+    void UpdateDisplayRect(DisplayId displayId, const Rect& displayRect) override;
     void AddWindowNode(const sptr<WindowNode>& node) override;
     void UpdateWindowNode(const sptr<WindowNode>& node, bool isAddWindow = false) override;
     void RemoveWindowNode(const sptr<WindowNode>& node) override;
     void UpdateLayoutRect(const sptr<WindowNode>& node) override;
 
+protected:
+    Rect PredictLayoutRect(const sptr<WindowNode>& node) override;
+
 private:
+    struct TilePresetRects {
+        uint32_t maxTileWinNum_;
+        std::vector<std::vector<Rect>> presetRects_;
+    };
     std::map<DisplayId, uint32_t> maxTileWinNumMap_;
     std::map<DisplayId, std::vector<std::vector<Rect>>> presetRectsMap_;
     std::map<DisplayId, std::deque<sptr<WindowNode>>> foregroundNodesMap_;
+    WindowLayoutCache<TilePresetRects> layoutCache_;
     void InitAllRects();
+    void InitDisplayRects(DisplayId displayId);
     uint32_t GetMaxTileWinNum(DisplayId displayId) const;
     void InitTileWindowRects(DisplayId displayId);
     void AssignNodePropertyForTileWindows(DisplayId displayId);
@@ -16,6 +16,7 @@
 #ifndef OHOS_WINDOW_MANAGER_INTERFACE_H
 #define OHOS_WINDOW_MANAGER_INTERFACE_H
 
+#include <ashmem.h>
 #include <iremote_broker.h>
 #include <ui/rs_surface_node.h>
 
@@ -56,6 +57,7 @@ public:
         TRANS_ID_GET_SYSTEM_DECOR_ENABLE,
         TRANS_ID_NOTIFY_WINDOW_TRANSITION,
         TRANS_ID_GET_FULLSCREEN_AND_SPLIT_HOT_ZONE,
+        TRANS_ID_GET_WINDOW_STATE_PAGE,
     };
     virtual WMError CreateWindow(sptr<IWindow>& window, sptr<WindowProperty>& property,
         const std::shared_ptr<RSSurfaceNode>& surfaceNode,
@@ -83,6 +85,7 @@ public:
     virtual WMError GetSystemDecorEnable(bool& isSystemDecorEnable) = 0;
     virtual void NotifyWindowTransition(WindowTransitionInfo from, WindowTransitionInfo to) = 0;
     virtual WMError GetModeChangeHotZones(DisplayId displayId, ModeChangeHotZones& hotZones) = 0;
+    virtual sptr<Ashmem> GetWindowStatePage() = 0;
 };
 }
 }
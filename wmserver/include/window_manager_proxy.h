@@ -55,6 +55,7 @@ public:
     WMError GetAccessibilityWindowInfo(sptr<AccessibilityWindowInfo>& windowInfo) override;
     WMError GetSystemDecorEnable(bool& isSystemDecorEnable) override;
     WMError GetModeChangeHotZones(DisplayId displayId, ModeChangeHotZones& hotZones) override;
+    sptr<Ashmem> GetWindowStatePage() override;
 
 private:
     static inline BrokerDelegator<WindowManagerProxy> delegator_;
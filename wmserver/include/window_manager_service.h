@@ -46,6 +46,9 @@ WM_DECLARE_SINGLE_INSTANCE_BASE(WindowManagerService);
 public:
     void OnStart() override;
     void OnStop() override;
+    int Dump(int fd, const std::vector<std::u16string>& args) override;
+    // runs the service in-process on a headless display without publishing it, used by window_replay
+    bool StartInProcess(uint32_t displayWidth, uint32_t displayHeight);
 
     WMError CreateWindow(sptr<IWindow>& window, sptr<WindowProperty>& property,
         const std::shared_ptr<RSSurfaceNode>& surfaceNode,
@@ -75,6 +78,7 @@ public:
     WMError SetWindowAnimationController(const sptr<RSIWindowAnimationController>& controller) override;
     WMError GetSystemDecorEnable(bool& isSystemDecorEnable) override;
     WMError GetModeChangeHotZones(DisplayId displayId, ModeChangeHotZones& hotZones) override;
+    sptr<Ashmem> GetWindowStatePage() override;
 
 protected:
     WindowManagerService();
@@ -87,12 +91,15 @@ private:
     void OnWindowEvent(Event event, uint32_t windowId);
     void NotifyDisplayStateChange(DisplayId id, DisplayStateChangeType type);
     void ConfigureWindowManagerService();
+    void DumpLockProfile(const std::vector<std::string>& params, std::string& dumpInfo);
+    void DumpTransactionRecord(const std::vector<std::string>& params, std::string& dumpInfo);
 
     static inline SingletonDelegator<WindowManagerService> delegator;
-    std::recursive_mutex mutex_;
+    ProfiledRecursiveMutex mutex_ { "WindowManagerService" };
     sptr<WindowRoot> windowRoot_;
     sptr<WindowController> windowController_;
     sptr<InputWindowMonitor> inputWindowMonitor_;
+    sptr<WindowStatePublisher> windowStatePublisher_;
     sptr<SnapshotController> snapshotController_;
     sptr<DragController> dragController_;
     sptr<FreezeController> freezeDisplayController_;
@@ -25,6 +25,7 @@
 #include "wm_common.h"
 #include "wm_common_inner.h"
 #include "window_pair.h"
+#include "window_tree_record.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -79,6 +80,7 @@ public:
     void RaiseSplitRelatedWindowToTop(sptr<WindowNode>& node);
     void MoveWindowNodes(DisplayId displayId, std::vector<uint32_t>& windowIds);
     float GetVirtualPixelRatio(DisplayId displayId) const;
+    Rect GetPredictedLayoutRect(const sptr<WindowNode>& node);
     void TraverseWindowTree(const WindowNodeOperationFunc& func, bool isFromTopToBottom = true) const;
     void UpdateSizeChangeReason(sptr<WindowNode>& node, WindowSizeChangeReason reason);
     void GetWindowList(std::vector<sptr<WindowInfo>>& windowList) const;
@@ -87,8 +89,10 @@ public:
     void ProcessDisplayDestroy(DisplayId displayId, std::vector<uint32_t>& windowIds);
     void ProcessDisplayChange(DisplayId displayId, const Rect& displayRect);
     void SetMinimizedByOther(bool isMinimizedByOther);
+    void SetDividerDragNotifyInterval(uint32_t interval);
     void GetModeChangeHotZones(DisplayId displayId,
         ModeChangeHotZones& hotZones, const ModeChangeHotZonesConfig& config);
+    void DumpScreenWindowTree(WindowTreeChangeReason reason);
 
 private:
     void TraverseWindowNode(sptr<WindowNode>& root, std::vector<sptr<WindowNode>>& windowNodes) const;
@@ -103,7 +107,9 @@ private:
     void NotifyIfSystemBarTintChanged(DisplayId displayId);
     void NotifyIfSystemBarRegionChanged(DisplayId displayId);
     void TraverseAndUpdateWindowState(WindowState state, int32_t topPriority);
-    void UpdateWindowState(sptr<WindowNode> node, int32_t topPriority, WindowState state);
+    void UnfreezeKeyguardFrozenNodes();
+    void UpdateWindowState(sptr<WindowNode> node, int32_t topPriority, WindowState state,
+        std::vector<wptr<WindowNode>>& updatedNodes);
     void HandleKeepScreenOn(const sptr<WindowNode>& node, WindowState state);
     bool IsTopWindow(uint32_t windowId, sptr<WindowNode>& rootNode) const;
     sptr<WindowNode> FindDividerNode() const;
@@ -121,7 +127,6 @@ private:
     void RaiseOrderedWindowToTop(std::vector<sptr<WindowNode>>& orderedNodes,
         std::vector<sptr<WindowNode>>& windowNodes);
     static bool ReadIsWindowAnimationEnabledProperty();
-    void DumpScreenWindowTree();
     void RaiseInputMethodWindowPriorityIfNeeded(const sptr<WindowNode>& node) const;
     void RaiseShowWhenLockedWindowIfNeeded(const sptr<WindowNode>& node);
     void ReZOrderShowWhenLockedWindows(const sptr<WindowNode>& node, bool up);
@@ -157,7 +162,11 @@ private:
     sptr<WindowNode> aboveAppWindowNode_ = new WindowNode();
     std::map<DisplayId, Rect> displayRectMap_;
     WindowNodeMaps windowNodeMaps_;
+    std::vector<WindowTreeNodeRecord> treeRecordNodes_;
     bool isMinimizedByOther_ = true;
+    // windows frozen for the keyguard at suspend, the wake up unfreezes them without traversing the window tree
+    std::vector<wptr<WindowNode>> keyguardFrozenNodes_;
+    bool isKeyguardFrozen_ = false;
 };
 } // namespace Rosen
 } // namespace OHOS
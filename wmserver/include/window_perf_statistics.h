@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_PERF_STATISTICS_H
+#define OHOS_ROSEN_WINDOW_PERF_STATISTICS_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "noncopyable.h"
+#include "perf_histogram.h"
+#include "wm_single_instance.h"
+
+#define WM_PERF_SCOPED_STAT(type) WindowPerfScopedStat windowPerfScopedStat(type)
+
+namespace OHOS {
+namespace Rosen {
+enum class WindowPerfStatType : uint32_t {
+    CREATE_WINDOW,
+    ADD_WINDOW,
+    REMOVE_WINDOW,
+    DESTROY_WINDOW,
+    UPDATE_PROPERTY,
+    LAYOUT,
+    ASSIGN_ZORDER,
+    INPUT_SYNC,
+    RS_COMMIT,
+    LOCK_WAIT,
+    STAT_TYPE_END,
+};
+
+class WindowPerfStatistics {
+WM_DECLARE_SINGLE_INSTANCE_BASE(WindowPerfStatistics);
+public:
+    void Record(WindowPerfStatType type, uint64_t costUs);
+    void RecordSince(WindowPerfStatType type, uint64_t startTimeUs);
+    void Dump(std::string& dumpInfo) const;
+    void Reset();
+    void StartPeriodicReport();
+    void StopPeriodicReport();
+
+protected:
+    WindowPerfStatistics() = default;
+    virtual ~WindowPerfStatistics();
+
+private:
+    void ReportLoop();
+    void ReportStatistics();
+
+    static constexpr size_t STAT_TYPE_NUM = static_cast<size_t>(WindowPerfStatType::STAT_TYPE_END);
+    std::array<PerfHistogram, STAT_TYPE_NUM> histograms_; // since boot or the last reset, for dump
+    std::array<PerfHistogram, STAT_TYPE_NUM> intervalHistograms_; // since the last report
+    std::mutex reportMutex_;
+    std::condition_variable reportCond_;
+    std::thread reportThread_;
+    bool isReportStopped_ = false;
+};
+
+class WindowPerfScopedStat final {
+public:
+    explicit WindowPerfScopedStat(WindowPerfStatType type)
+        : type_(type), startTimeUs_(PerfHistogram::GetCurrentTimeUs()) {}
+    ~WindowPerfScopedStat()
+    {
+        WindowPerfStatistics::GetInstance().RecordSince(type_, startTimeUs_);
+    }
+
+    WM_DISALLOW_COPY_AND_MOVE(WindowPerfScopedStat);
+
+private:
+    WindowPerfStatType type_;
+    uint64_t startTimeUs_;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_WINDOW_PERF_STATISTICS_H
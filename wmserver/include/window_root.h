@@ -20,7 +20,9 @@
 
 #include "agent_death_recipient.h"
 #include "display_manager_service_inner.h"
+#include "profiled_mutex.h"
 #include "window_node_container.h"
+#include "window_state_page.h"
 #include "zidl/window_manager_agent_interface.h"
 
 namespace OHOS {
@@ -33,7 +35,7 @@ class WindowRoot : public RefBase {
 using Callback = std::function<void (Event event, uint32_t windowId)>;
 
 public:
-    WindowRoot(std::recursive_mutex& mutex, Callback callback) : mutex_(mutex), callback_(callback) {}
+    WindowRoot(ProfiledRecursiveMutex& mutex, Callback callback) : mutex_(mutex), callback_(callback) {}
     ~WindowRoot() = default;
 
     sptr<WindowNodeContainer> GetWindowNodeContainer(DisplayId displayId);
@@ -70,6 +72,7 @@ public:
     WMError RaiseZOrderForAppWindow(sptr<WindowNode>& node);
     void FocusFaultDetection() const;
     float GetVirtualPixelRatio(DisplayId displayId) const;
+    Rect GetPredictedLayoutRect(const sptr<WindowNode>& node);
     WMError UpdateSizeChangeReason(uint32_t windowId, WindowSizeChangeReason reason);
     void SetBrightness(uint32_t windowId, float brightness);
     void HandleKeepScreenOn(uint32_t windowId, bool requireLock);
@@ -77,8 +80,10 @@ public:
     WMError GetAccessibilityWindowInfo(sptr<AccessibilityWindowInfo>& windowInfo);
     void SetMaxAppWindowNumber(int windowNum);
     void SetMinimizedByOtherWindow(bool isMinimizedByOtherWindow);
+    void SetDividerDragNotifyInterval(uint32_t interval);
     WMError GetModeChangeHotZones(DisplayId displayId,
         ModeChangeHotZones& hotZones, const ModeChangeHotZonesConfig& config);
+    void GetWindowStateSnapshot(WindowStateSnapshot& snapshot) const;
 
 private:
     void OnRemoteDied(const sptr<IRemoteObject>& remoteObject);
@@ -94,7 +99,7 @@ private:
         const sptr<WindowNodeContainer>& container, Rect rect);
     ScreenId GetScreenGroupId(DisplayId displayId);
 
-    std::recursive_mutex& mutex_;
+    ProfiledRecursiveMutex& mutex_;
     std::map<uint32_t, sptr<WindowNode>> windowNodeMap_;
     std::map<sptr<IRemoteObject>, uint32_t> windowIdMap_;
     std::map<ScreenId, sptr<WindowNodeContainer>> windowNodeContainerMap_;
@@ -108,6 +113,7 @@ private:
         this, std::placeholders::_1));
     Callback callback_;
     int maxAppWindowNumber_ = 100;
+    uint32_t dividerDragNotifyInterval_ = DEFAULT_DIVIDER_DRAG_NOTIFY_INTERVAL; // ms
 };
 }
 }
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_SERVICE_BACKEND_H
+#define OHOS_ROSEN_WINDOW_SERVICE_BACKEND_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "singleton_delegator.h"
+
+namespace OHOS {
+namespace MMI {
+struct PhysicalDisplayInfo;
+struct LogicalDisplayInfo;
+}
+namespace PowerMgr {
+class RunningLock;
+}
+namespace Rosen {
+class RSSurface;
+class RSSurfaceNode;
+
+/*
+ * Platform services used by window manager service: render service, multimodal input and power.
+ * The platform implementation is used by default, building with window_manager_headless_backend = true selects
+ * HeadlessWindowServiceBackend, so that WMS logic can run and be profiled without the platform.
+ * Callers get the backend from SingletonContainer, tests replace it with a SingletonMocker.
+ */
+class WindowServiceBackend {
+public:
+    static WindowServiceBackend& GetInstance();
+    virtual ~WindowServiceBackend() = default;
+
+    virtual void FlushImplicitTransaction() = 0;
+    virtual std::shared_ptr<RSSurface> ExtractRSSurface(const std::shared_ptr<RSSurfaceNode>& surfaceNode) = 0;
+    virtual void UpdateInputDisplayInfo(const std::vector<MMI::PhysicalDisplayInfo>& physicalDisplays,
+        const std::vector<MMI::LogicalDisplayInfo>& logicalDisplays) = 0;
+    virtual bool IsScreenOn() = 0;
+    virtual void WakeupDevice() = 0;
+    virtual void OverrideBrightness(uint32_t brightness) = 0;
+    virtual void RestoreBrightness() = 0;
+    virtual std::shared_ptr<PowerMgr::RunningLock> CreateScreenRunningLock(const std::string& name) = 0;
+
+private:
+    static inline SingletonDelegator<WindowServiceBackend> delegator;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_WINDOW_SERVICE_BACKEND_H
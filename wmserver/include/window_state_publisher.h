@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_STATE_PUBLISHER_H
+#define OHOS_ROSEN_WINDOW_STATE_PUBLISHER_H
+
+#include <ashmem.h>
+#include <mutex>
+#include <refbase.h>
+
+#include "window_root.h"
+#include "window_state_page.h"
+
+namespace OHOS {
+namespace Rosen {
+/*
+ * Owns the shared window state page. The page is created when the first client asks for it; after that every
+ * flush of the window tree republishes the snapshot, so clients read focus, top windows and decor config
+ * without an IPC.
+ */
+class WindowStatePublisher : public RefBase {
+public:
+    explicit WindowStatePublisher(sptr<WindowRoot>& root) : windowRoot_(root) {}
+    ~WindowStatePublisher();
+
+    void Publish();
+    void SetSystemDecorEnable(bool isSystemDecorEnable);
+    sptr<Ashmem> GetPage();
+
+private:
+    bool InitPageLocked();
+    void PublishLocked();
+
+    std::mutex mutex_;
+    sptr<WindowRoot> windowRoot_;
+    sptr<Ashmem> ashmem_;
+    WindowStatePage* page_ = nullptr;
+    bool isSystemDecorEnable_ = true;
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_WINDOW_STATE_PUBLISHER_H
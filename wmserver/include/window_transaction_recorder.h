@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_TRANSACTION_RECORDER_H
+#define OHOS_ROSEN_WINDOW_TRANSACTION_RECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include <message_parcel.h>
+
+#include "wm_single_instance.h"
+
+namespace OHOS {
+namespace Rosen {
+constexpr uint32_t WINDOW_TRANSACTION_FILE_MAGIC = 0x52585457; // "WTXR"
+constexpr uint32_t WINDOW_TRANSACTION_FILE_VERSION = 1;
+
+struct WindowTransactionFileHeader {
+    uint32_t magic_;
+    uint32_t version_;
+};
+
+// followed by dataSize_ bytes of arguments, marshalled in the order WindowManagerStub reads them
+struct WindowTransactionRecordHeader {
+    uint64_t timeUs_; // since recording started
+    uint32_t code_;
+    uint32_t dataSize_;
+};
+
+/*
+ * Records the transactions handled by WindowManagerStub so that a workload can be replayed off device with
+ * window_replay. Remote objects can not be replayed, so arguments are stored without them: CreateWindow keeps the
+ * window property and the window id assigned by the service, agent and animation controller registrations are not
+ * recorded.
+ */
+class WindowTransactionRecorder {
+WM_DECLARE_SINGLE_INSTANCE(WindowTransactionRecorder);
+public:
+    bool Start(const std::string& path);
+    void Stop();
+    bool IsRecording() const
+    {
+        return isRecording_.load(std::memory_order_relaxed);
+    }
+    void Record(uint32_t code, MessageParcel& data, MessageParcel& reply, uint64_t startTimeUs);
+
+private:
+    bool MarshallArguments(uint32_t code, MessageParcel& data, MessageParcel& reply, Parcel& args) const;
+
+    std::atomic<bool> isRecording_ { false };
+    std::mutex mutex_;
+    std::ofstream file_;
+    uint64_t beginTimeUs_ { 0 };
+    uint32_t recordCount_ { 0 };
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_WINDOW_TRANSACTION_RECORDER_H
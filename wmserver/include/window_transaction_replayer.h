@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_TRANSACTION_REPLAYER_H
+#define OHOS_ROSEN_WINDOW_TRANSACTION_REPLAYER_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "perf_histogram.h"
+#include "window_manager_interface.h"
+#include "window_transaction_recorder.h"
+
+namespace OHOS {
+namespace Rosen {
+/*
+ * Replays a file of WindowTransactionRecorder against a window manager, either the remote service or an in-process
+ * one. Window ids assigned by the target differ from the recorded ones, so they are mapped on the fly, and a
+ * transaction on a window which was not created by the replay fails instead of hitting an unrelated window.
+ * Display ids of the record are mapped to the displays of the target before they are sent.
+ */
+class WindowTransactionReplayer {
+public:
+    explicit WindowTransactionReplayer(IWindowManager& target) : target_(target) {}
+    ~WindowTransactionReplayer() = default;
+
+    bool Load(const std::string& path);
+    void Replay(bool keepTiming);
+    void Dump(std::string& result) const;
+    void MapDisplay(DisplayId recordedId, DisplayId displayId);
+    // recorded displays which are not mapped are replayed on this display, or keep their id if it is invalid
+    void SetDefaultDisplay(DisplayId displayId);
+    uint32_t GetFailedCount() const
+    {
+        return failedCount_;
+    }
+
+private:
+    struct Transaction {
+        uint64_t timeUs_;
+        uint32_t code_;
+        std::vector<uint8_t> data_;
+    };
+
+    WMError ReplayTransaction(const Transaction& transaction);
+    WMError ReplayCreateWindow(Parcel& data);
+    WMError ReplayWindowProperty(uint32_t code, Parcel& data);
+    bool MapWindowId(uint32_t recordedId, uint32_t& windowId) const;
+    bool MapWindowProperty(const sptr<WindowProperty>& property) const;
+    DisplayId MapDisplayId(DisplayId recordedId) const;
+
+    IWindowManager& target_;
+    std::vector<Transaction> transactions_;
+    std::map<uint32_t, uint32_t> windowIdMap_;
+    std::map<DisplayId, DisplayId> displayIdMap_;
+    DisplayId defaultDisplayId_ { DISPLAY_ID_INVALID };
+    std::vector<sptr<IWindow>> windows_;
+    std::map<uint32_t, std::unique_ptr<PerfHistogram>> histograms_;
+    uint32_t failedCount_ { 0 };
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_WINDOW_TRANSACTION_REPLAYER_H
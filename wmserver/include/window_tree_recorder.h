@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_ROSEN_WINDOW_TREE_RECORDER_H
+#define OHOS_ROSEN_WINDOW_TREE_RECORDER_H
+
+#include <string>
+#include <vector>
+
+#include "window_tree_record.h"
+#include "wm_single_instance.h"
+
+namespace OHOS {
+namespace Rosen {
+class WindowTreeRecorder {
+WM_DECLARE_SINGLE_INSTANCE(WindowTreeRecorder);
+public:
+    void Record(WindowTreeChangeReason reason, const std::vector<WindowTreeNodeRecord>& nodes);
+    void Dump(std::string& dumpInfo) const;
+    bool DumpRaw(int fd) const;
+
+private:
+    static constexpr uint32_t RECORD_CAPACITY = 128;
+    WindowTreeRecordBuffer buffer_ { RECORD_CAPACITY };
+};
+} // namespace Rosen
+} // namespace OHOS
+#endif // OHOS_ROSEN_WINDOW_TREE_RECORDER_H
@@ -24,6 +24,7 @@
 #include "display_manager_service_inner.h"
 #include "window_manager_hilog.h"
 #include "window_option.h"
+#include "window_service_backend.h"
 #include "wm_common.h"
 
 namespace OHOS {
@@ -61,7 +62,8 @@ bool FreezeController::FreezeDisplay(DisplayId displayId)
     WLOGFI("freeze window rect, x : %{public}d, y : %{public}d, width: %{public}u, height: %{public}u",
         winRect.posX_, winRect.posY_, winRect.width_, winRect.height_);
 
-    std::shared_ptr<RSSurface> rsSurface = RSSurfaceExtractor::ExtractRSSurface(surfaceNode);
+    auto& backend = SingletonContainer::Get<WindowServiceBackend>();
+    std::shared_ptr<RSSurface> rsSurface = backend.ExtractRSSurface(surfaceNode);
     if (rsSurface == nullptr) {
         WLOGFE("RSSurface is null");
         return false;
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "headless_window_service_backend.h"
+
+#include <sstream>
+
+#include <transaction/rs_transaction.h>
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    const char* const CALL_TYPE_NAMES[] = {
+        "FlushImplicitTransaction",
+        "ExtractRSSurface",
+        "UpdateInputDisplayInfo",
+        "IsScreenOn",
+        "WakeupDevice",
+        "OverrideBrightness",
+        "RestoreBrightness",
+        "CreateScreenRunningLock",
+    };
+}
+
+void HeadlessWindowServiceBackend::Count(BackendCallType type)
+{
+    callCounts_[static_cast<size_t>(type)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void HeadlessWindowServiceBackend::FlushImplicitTransaction()
+{
+    Count(BackendCallType::FLUSH_TRANSACTION);
+    // still drain the queued RS commands, the client drops them while no render service is connected
+    RSTransaction::FlushImplicitTransaction();
+}
+
+std::shared_ptr<RSSurface> HeadlessWindowServiceBackend::ExtractRSSurface(
+    const std::shared_ptr<RSSurfaceNode>& surfaceNode)
+{
+    Count(BackendCallType::EXTRACT_RS_SURFACE);
+    return nullptr;
+}
+
+void HeadlessWindowServiceBackend::UpdateInputDisplayInfo(const std::vector<MMI::PhysicalDisplayInfo>& physicalDisplays,
+    const std::vector<MMI::LogicalDisplayInfo>& logicalDisplays)
+{
+    Count(BackendCallType::UPDATE_INPUT_DISPLAY_INFO);
+    std::lock_guard<std::mutex> lock(mutex_);
+    logicalDisplays_ = logicalDisplays;
+}
+
+bool HeadlessWindowServiceBackend::IsScreenOn()
+{
+    Count(BackendCallType::IS_SCREEN_ON);
+    return isScreenOn_.load();
+}
+
+void HeadlessWindowServiceBackend::WakeupDevice()
+{
+    Count(BackendCallType::WAKEUP_DEVICE);
+    isScreenOn_.store(true);
+}
+
+void HeadlessWindowServiceBackend::OverrideBrightness(uint32_t brightness)
+{
+    Count(BackendCallType::OVERRIDE_BRIGHTNESS);
+    overrideBrightness_.store(brightness);
+    isBrightnessOverridden_.store(true);
+}
+
+void HeadlessWindowServiceBackend::RestoreBrightness()
+{
+    Count(BackendCallType::RESTORE_BRIGHTNESS);
+    isBrightnessOverridden_.store(false);
+}
+
+std::shared_ptr<PowerMgr::RunningLock> HeadlessWindowServiceBackend::CreateScreenRunningLock(const std::string& name)
+{
+    // no running lock without power manager, callers skip keeping screen on
+    Count(BackendCallType::CREATE_RUNNING_LOCK);
+    return nullptr;
+}
+
+uint64_t HeadlessWindowServiceBackend::GetCallCount(BackendCallType type) const
+{
+    size_t index = static_cast<size_t>(type);
+    return index < CALL_TYPE_NUM ? callCounts_[index].load(std::memory_order_relaxed) : 0;
+}
+
+std::vector<MMI::LogicalDisplayInfo> HeadlessWindowServiceBackend::GetLogicalDisplays() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return logicalDisplays_;
+}
+
+void HeadlessWindowServiceBackend::SetScreenOn(bool isScreenOn)
+{
+    isScreenOn_.store(isScreenOn);
+}
+
+void HeadlessWindowServiceBackend::Dump(std::string& dumpInfo) const
+{
+    std::ostringstream os;
+    os << "-------------------- Headless Backend --------------------" << std::endl;
+    for (size_t i = 0; i < CALL_TYPE_NUM; i++) {
+        os << CALL_TYPE_NAMES[i] << ": " << callCounts_[i].load(std::memory_order_relaxed) << std::endl;
+    }
+    os << "screen on: " << isScreenOn_.load() << ", brightness: ";
+    if (isBrightnessOverridden_.load()) {
+        os << overrideBrightness_.load() << std::endl;
+    } else {
+        os << "default" << std::endl;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& display : logicalDisplays_) {
+        os << "input display " << display.id << ": windows " << display.windowsInfo.size() << ", focus " <<
+            display.focusWindowId << std::endl;
+    }
+    dumpInfo.append(os.str());
+}
+
+void HeadlessWindowServiceBackend::Reset()
+{
+    for (auto& count : callCounts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    logicalDisplays_.clear();
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -22,6 +22,8 @@
 #include "display_manager_service_inner.h"
 #include "dm_common.h"
 #include "window_manager_hilog.h"
+#include "window_perf_statistics.h"
+#include "window_service_backend.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -52,6 +54,7 @@ void InputWindowMonitor::UpdateInputWindowByDisplayId(DisplayId displayId)
     if (displayId == DISPLAY_ID_INVALID) {
         return;
     }
+    WM_PERF_SCOPED_STAT(WindowPerfStatType::INPUT_SYNC);
     auto container = windowRoot_->GetWindowNodeContainer(displayId);
     if (container == nullptr) {
         WLOGFE("can not get window node container.");
@@ -74,7 +77,7 @@ void InputWindowMonitor::UpdateInputWindowByDisplayId(DisplayId displayId)
         return;
     }
     WLOGFI("update display info to IMS.");
-    MMI::InputManager::GetInstance()->UpdateDisplayInfo(physicalDisplays_, logicalDisplays_);
+    SingletonContainer::Get<WindowServiceBackend>().UpdateInputDisplayInfo(physicalDisplays_, logicalDisplays_);
 }
 
 void InputWindowMonitor::UpdateDisplaysInfo(const sptr<WindowNodeContainer>& container, DisplayId displayId)
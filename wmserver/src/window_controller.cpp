@@ -15,10 +15,10 @@
 
 #include "window_controller.h"
 #include <parameters.h>
-#include <power_mgr_client.h>
-#include <transaction/rs_transaction.h>
 #include "window_manager_hilog.h"
 #include "window_helper.h"
+#include "window_perf_statistics.h"
+#include "window_service_backend.h"
 #include "wm_common.h"
 #include "wm_trace.h"
 
@@ -58,7 +58,12 @@ WMError WindowController::CreateWindow(sptr<IWindow>& window, sptr<WindowPropert
     sptr<WindowNode> node = new WindowNode(windowProperty, window, surfaceNode);
     node->abilityToken_ = token;
     UpdateWindowAnimation(node);
-    return windowRoot_->SaveWindow(node);
+    WMError res = windowRoot_->SaveWindow(node);
+    if (res == WMError::WM_OK && WindowHelper::IsAppWindow(node->GetWindowType())) {
+        // returned in the create reply, so the app can lay out its first frame at the final size
+        property->SetWindowRect(windowRoot_->GetPredictedLayoutRect(node));
+    }
+    return res;
 }
 
 WMError WindowController::AddWindowNode(sptr<WindowProperty>& property)
@@ -139,9 +144,9 @@ void WindowController::HandleTurnScreenOn(const sptr<WindowNode>& node)
     }
     // reset ipc identity
     std::string identity = IPCSkeleton::ResetCallingIdentity();
-    if (node->IsTurnScreenOn() && !PowerMgr::PowerMgrClient::GetInstance().IsScreenOn()) {
+    if (node->IsTurnScreenOn() && !SingletonContainer::Get<WindowServiceBackend>().IsScreenOn()) {
         WLOGFI("handle turn screen on");
-        PowerMgr::PowerMgrClient::GetInstance().WakeupDevice();
+        SingletonContainer::Get<WindowServiceBackend>().WakeupDevice();
     }
     // set ipc identity to raw
     IPCSkeleton::SetCallingIdentity(identity);
@@ -217,7 +222,11 @@ WMError WindowController::RequestFocus(uint32_t windowId)
     if (windowRoot_ == nullptr) {
         return WMError::WM_ERROR_NULLPTR;
     }
-    return windowRoot_->RequestFocus(windowId);
+    WMError res = windowRoot_->RequestFocus(windowId);
+    if (res == WMError::WM_OK) {
+        windowStatePublisher_->Publish();
+    }
+    return res;
 }
 
 WMError WindowController::SetWindowMode(uint32_t windowId, WindowMode dstMode)
@@ -295,6 +304,7 @@ void WindowController::NotifyDisplayStateChange(DisplayId displayId, DisplayStat
             return;
         }
     }
+    windowStatePublisher_->Publish();
 }
 
 void WindowController::ProcessDisplayChange(DisplayId displayId, DisplayStateChangeType type)
@@ -308,40 +318,25 @@ void WindowController::ProcessDisplayChange(DisplayId displayId, DisplayStateCha
     switch (type) {
         case DisplayStateChangeType::SIZE_CHANGE:
         case DisplayStateChangeType::UPDATE_ROTATION: {
-            auto iter = curDisplayInfo_.find(displayId);
-            if (iter != curDisplayInfo_.end()) {
-                auto lastDisplayInfo = iter->second;
-                uint32_t lastDisplayWidth = static_cast<uint32_t>(lastDisplayInfo->GetWidth());
-                uint32_t lastDisplayHeight = static_cast<uint32_t>(lastDisplayInfo->GetHeight());
-                auto statusBarNode = windowRoot_->GetWindowNode(sysBarWinId_[WindowType::WINDOW_TYPE_STATUS_BAR]);
-                auto navigationBarNode =
-                    windowRoot_->GetWindowNode(sysBarWinId_[WindowType::WINDOW_TYPE_NAVIGATION_BAR]);
-                systemBarRect_[WindowType::WINDOW_TYPE_STATUS_BAR][lastDisplayWidth][lastDisplayHeight]
-                    = statusBarNode->GetWindowProperty()->GetWindowRect();
-                systemBarRect_[WindowType::WINDOW_TYPE_NAVIGATION_BAR][lastDisplayWidth][lastDisplayHeight]
-                    = navigationBarNode->GetWindowProperty()->GetWindowRect();
+            {
+                // precompute the system bar rects of the new display size before the single layout pass
+                WM_SCOPED_TRACE("wms:DisplayChange:Precompute");
+                auto iter = curDisplayInfo_.find(displayId);
+                if (iter != curDisplayInfo_.end()) {
+                    SaveSystemBarRect(WindowType::WINDOW_TYPE_STATUS_BAR, iter->second);
+                    SaveSystemBarRect(WindowType::WINDOW_TYPE_NAVIGATION_BAR, iter->second);
+                }
+                curDisplayInfo_[displayId] = displayInfo;
+                // Remove 'sysBarWinId_' after SystemUI resize 'systembar'
+                uint32_t width = static_cast<uint32_t>(displayInfo->GetWidth());
+                uint32_t height = static_cast<uint32_t>(displayInfo->GetHeight() * SYSTEM_BAR_HEIGHT_RATIO);
+                Rect newRect = { 0, 0, width, height };
+                PrepareSystemBarRect(WindowType::WINDOW_TYPE_STATUS_BAR, displayInfo, newRect);
+                newRect = { 0, displayInfo->GetHeight() - static_cast<int32_t>(height), width, height };
+                PrepareSystemBarRect(WindowType::WINDOW_TYPE_NAVIGATION_BAR, displayInfo, newRect);
             }
-            curDisplayInfo_[displayId] = displayInfo;
+            WM_SCOPED_TRACE("wms:DisplayChange:Layout");
             windowRoot_->ProcessDisplayChange(displayInfo);
-            // Remove 'sysBarWinId_' after SystemUI resize 'systembar'
-            uint32_t width = static_cast<uint32_t>(displayInfo->GetWidth());
-            uint32_t height = static_cast<uint32_t>(displayInfo->GetHeight() * SYSTEM_BAR_HEIGHT_RATIO);
-            Rect newRect = { 0, 0, width, height };
-            uint32_t displayWidth = static_cast<uint32_t>(displayInfo->GetWidth());
-            uint32_t displayHeight = static_cast<uint32_t>(displayInfo->GetHeight());
-            auto statusBarRectIter =
-                systemBarRect_[WindowType::WINDOW_TYPE_STATUS_BAR][displayWidth].find(displayHeight);
-            if (statusBarRectIter != systemBarRect_[WindowType::WINDOW_TYPE_STATUS_BAR][displayWidth].end()) {
-                newRect = statusBarRectIter->second;
-            }
-            ResizeRect(sysBarWinId_[WindowType::WINDOW_TYPE_STATUS_BAR], newRect, WindowSizeChangeReason::DRAG);
-            newRect = { 0, displayInfo->GetHeight() - static_cast<int32_t>(height), width, height };
-            auto navigationBarRectIter =
-                systemBarRect_[WindowType::WINDOW_TYPE_NAVIGATION_BAR][displayWidth].find(displayHeight);
-            if (navigationBarRectIter != systemBarRect_[WindowType::WINDOW_TYPE_NAVIGATION_BAR][displayWidth].end()) {
-                newRect = navigationBarRectIter->second;
-            }
-            ResizeRect(sysBarWinId_[WindowType::WINDOW_TYPE_NAVIGATION_BAR], newRect, WindowSizeChangeReason::DRAG);
             break;
         }
         default: {
@@ -353,6 +348,35 @@ void WindowController::ProcessDisplayChange(DisplayId displayId, DisplayStateCha
     WLOGFI("Finish ProcessDisplayChange");
 }
 
+void WindowController::SaveSystemBarRect(WindowType type, const sptr<DisplayInfo>& lastDisplayInfo)
+{
+    auto node = windowRoot_->GetWindowNode(sysBarWinId_[type]);
+    if (node == nullptr) {
+        return;
+    }
+    uint32_t lastDisplayWidth = static_cast<uint32_t>(lastDisplayInfo->GetWidth());
+    uint32_t lastDisplayHeight = static_cast<uint32_t>(lastDisplayInfo->GetHeight());
+    systemBarRect_[type][lastDisplayWidth][lastDisplayHeight] = node->GetWindowProperty()->GetWindowRect();
+}
+
+void WindowController::PrepareSystemBarRect(WindowType type, const sptr<DisplayInfo>& displayInfo,
+    const Rect& defaultRect)
+{
+    auto node = windowRoot_->GetWindowNode(sysBarWinId_[type]);
+    if (node == nullptr || node->GetWindowMode() != WindowMode::WINDOW_MODE_FLOATING) {
+        return;
+    }
+    Rect newRect = defaultRect;
+    auto& rectMap = systemBarRect_[type][static_cast<uint32_t>(displayInfo->GetWidth())];
+    auto iter = rectMap.find(static_cast<uint32_t>(displayInfo->GetHeight()));
+    if (iter != rectMap.end()) {
+        newRect = iter->second;
+    }
+    // only the request rect is set here, the display change layout applies it with the rest of the tree
+    node->SetWindowSizeChangeReason(WindowSizeChangeReason::DRAG);
+    node->GetWindowProperty()->SetRequestRect(newRect);
+}
+
 void WindowController::StopBootAnimationIfNeed(WindowType type) const
 {
     if (WindowType::WINDOW_TYPE_DESKTOP == type) {
@@ -510,15 +534,23 @@ WMError WindowController::GetTopWindowId(uint32_t mainWinId, uint32_t& topWinId)
 void WindowController::FlushWindowInfo(uint32_t windowId)
 {
     WLOGFI("FlushWindowInfo");
-    RSTransaction::FlushImplicitTransaction();
+    {
+        WM_PERF_SCOPED_STAT(WindowPerfStatType::RS_COMMIT);
+        SingletonContainer::Get<WindowServiceBackend>().FlushImplicitTransaction();
+    }
     inputWindowMonitor_->UpdateInputWindow(windowId);
+    windowStatePublisher_->Publish();
 }
 
 void WindowController::FlushWindowInfoWithDisplayId(DisplayId displayId)
 {
     WLOGFI("FlushWindowInfoWithDisplayId");
-    RSTransaction::FlushImplicitTransaction();
+    {
+        WM_PERF_SCOPED_STAT(WindowPerfStatType::RS_COMMIT);
+        SingletonContainer::Get<WindowServiceBackend>().FlushImplicitTransaction();
+    }
     inputWindowMonitor_->UpdateInputWindowByDisplayId(displayId);
+    windowStatePublisher_->Publish();
 }
 
 void WindowController::UpdateWindowAnimation(const sptr<WindowNode>& node)
@@ -22,9 +22,11 @@
 #include "include/core/SkData.h"
 #include "include/core/SkImage.h"
 
+#include "input_transfer_station.h"
 #include "vsync_station.h"
 #include "window_manager_hilog.h"
 #include "window_option.h"
+#include "window_service_backend.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -59,7 +61,8 @@ void WindowInnerManager::DrawSurface(const sptr<Window>& window)
     auto width = winRect.width_;
     auto height = winRect.height_;
 
-    std::shared_ptr<RSSurface> rsSurface = RSSurfaceExtractor::ExtractRSSurface(surfaceNode);
+    auto& backend = SingletonContainer::Get<WindowServiceBackend>();
+    std::shared_ptr<RSSurface> rsSurface = backend.ExtractRSSurface(surfaceNode);
     if (rsSurface == nullptr) {
         WLOGFE("RSSurface is nullptr");
         return;
@@ -297,6 +300,7 @@ void WindowInnerManager::Init()
     innerWMThread.detach();
     hasInitThread_ = true;
     VsyncStation::GetInstance().SetIsMainHandlerAvailable(false);
+    InputTransferStation::GetInstance().SetInputThreadEnabled(true, false);
     WLOGFI("Inner window manager thread create success");
 }
 }
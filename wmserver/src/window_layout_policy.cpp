@@ -15,6 +15,7 @@
 
 #include "window_layout_policy.h"
 #include "display_manager_service_inner.h"
+#include "perf_histogram.h"
 #include "window_helper.h"
 #include "window_manager_hilog.h"
 #include "wm_common_inner.h"
@@ -55,6 +56,12 @@ void WindowLayoutPolicy::UpdateDisplayInfo(const std::map<DisplayId, Rect>& disp
     Launch();
 }
 
+void WindowLayoutPolicy::UpdateDisplayRect(DisplayId displayId, const Rect& displayRect)
+{
+    displayRectMap_[displayId] = displayRect;
+    LayoutWindowTree(displayId);
+}
+
 void WindowLayoutPolicy::LayoutWindowNodesByRootType(const std::vector<sptr<WindowNode>>& nodeVec)
 {
     if (nodeVec.empty()) {
@@ -72,6 +79,12 @@ void WindowLayoutPolicy::LayoutWindowTree(DisplayId displayId)
     limitRectMap_[displayId] = displayRectMap_[displayId];
     // ensure that the avoid area windows are traversed first
     LayoutWindowNodesByRootType(*(windowNodeMap[WindowRootNodeType::ABOVE_WINDOW_NODE]));
+    LayoutAppAndBelowWindowNodes(displayId);
+}
+
+void WindowLayoutPolicy::LayoutAppAndBelowWindowNodes(DisplayId displayId)
+{
+    auto& windowNodeMap = windowNodeMaps_[displayId];
     if (IsFullScreenRecentWindowExist(*(windowNodeMap[WindowRootNodeType::ABOVE_WINDOW_NODE]))) {
         WLOGFI("recent window on top, early exit layout tree");
         return;
@@ -109,6 +122,10 @@ bool WindowLayoutPolicy::IsVerticalDisplay(DisplayId displayId) const
 void WindowLayoutPolicy::UpdateClientRectAndResetReason(const sptr<WindowNode>& node,
     const Rect& lastLayoutRect, const Rect& winRect)
 {
+    if (isSplitRectNotifySuppressed_ && node->IsSplitMode()) {
+        // RS scales the last buffer of the app to the new bounds until the next notification or the drag end
+        return;
+    }
     if ((!(lastLayoutRect == winRect)) || node->GetWindowType() == WindowType::WINDOW_TYPE_DOCK_SLICE) {
         auto reason = node->GetWindowSizeChangeReason();
         if (node->GetWindowToken()) {
@@ -120,6 +137,40 @@ void WindowLayoutPolicy::UpdateClientRectAndResetReason(const sptr<WindowNode>&
     }
 }
 
+void WindowLayoutPolicy::SetDividerDragNotifyInterval(uint32_t interval)
+{
+    dividerDragNotifyInterval_ = interval;
+}
+
+void WindowLayoutPolicy::StartDividerDrag(DisplayId displayId)
+{
+    dividerDragNotifyTimeMap_[displayId] = 0;
+}
+
+void WindowLayoutPolicy::EndDividerDrag(DisplayId displayId)
+{
+    dividerDragNotifyTimeMap_.erase(displayId);
+}
+
+bool WindowLayoutPolicy::IsDividerDragging(DisplayId displayId) const
+{
+    return dividerDragNotifyTimeMap_.find(displayId) != dividerDragNotifyTimeMap_.end();
+}
+
+bool WindowLayoutPolicy::IsDividerDragNotifyDue(DisplayId displayId)
+{
+    auto iter = dividerDragNotifyTimeMap_.find(displayId);
+    if (iter == dividerDragNotifyTimeMap_.end()) {
+        return true;
+    }
+    uint64_t now = PerfHistogram::GetCurrentTimeUs();
+    if (iter->second != 0 && now - iter->second < static_cast<uint64_t>(dividerDragNotifyInterval_) * 1000) {
+        return false;
+    }
+    iter->second = now;
+    return true;
+}
+
 void WindowLayoutPolicy::RemoveWindowNode(const sptr<WindowNode>& node)
 {
     WM_FUNCTION_TRACE();
@@ -150,6 +201,30 @@ void WindowLayoutPolicy::UpdateWindowNode(const sptr<WindowNode>& node, bool isA
     }
 }
 
+Rect WindowLayoutPolicy::GetPredictedLayoutRect(const sptr<WindowNode>& node)
+{
+    auto property = node->GetWindowProperty();
+    if (property == nullptr) {
+        return { 0, 0, 0, 0 };
+    }
+    bool parentLimit = (node->GetWindowFlags() & static_cast<uint32_t>(WindowFlag::WINDOW_FLAG_PARENT_LIMIT));
+    if (WindowHelper::IsSubWindow(node->GetWindowType()) && parentLimit) {
+        return { 0, 0, 0, 0 }; // depends on the parent rect, which is not known before the window is added
+    }
+    // lay out a detached copy, which has no window token or surface node, so neither client nor RS is touched
+    sptr<WindowNode> predictedNode = new WindowNode(new WindowProperty(property));
+    Rect rect = PredictLayoutRect(predictedNode);
+    WLOGFI("Predicted rect of window %{public}u: [%{public}d, %{public}d, %{public}u, %{public}u]",
+        node->GetWindowId(), rect.posX_, rect.posY_, rect.width_, rect.height_);
+    return rect;
+}
+
+Rect WindowLayoutPolicy::PredictLayoutRect(const sptr<WindowNode>& node)
+{
+    UpdateLayoutRect(node);
+    return node->GetWindowRect();
+}
+
 void WindowLayoutPolicy::UpdateFloatingLayoutRect(Rect& limitRect, Rect& winRect)
 {
     winRect.width_ = std::min(limitRect.width_, winRect.width_);
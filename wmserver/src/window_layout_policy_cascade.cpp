@@ -50,6 +50,7 @@ void WindowLayoutPolicyCascade::Launch()
 
 void WindowLayoutPolicyCascade::Clean()
 {
+    dividerDragNotifyTimeMap_.clear();
     WLOGFI("WindowLayoutPolicyCascade::Clean");
 }
 
@@ -65,16 +66,42 @@ void WindowLayoutPolicyCascade::Reset()
 void WindowLayoutPolicyCascade::InitAllRects()
 {
     for (auto& iter : displayRectMap_) {
-        // init split and limit rects
-        InitSplitRects(iter.first);
-        InitLimitRects(iter.first);
-        // init cascade rect
-        auto& windowNodeMap = windowNodeMaps_[iter.first];
-        LayoutWindowNodesByRootType(*(windowNodeMap[WindowRootNodeType::ABOVE_WINDOW_NODE]));
-        InitCascadeRect(iter.first);
+        InitDisplayRects(iter.first);
     }
 }
 
+void WindowLayoutPolicyCascade::InitDisplayRects(DisplayId displayId)
+{
+    // the avoid area windows are laid out first, the limit rect they leave is part of the cache key
+    const Rect& displayRect = displayRectMap_[displayId];
+    limitRectMap_[displayId] = displayRect;
+    auto& windowNodeMap = windowNodeMaps_[displayId];
+    LayoutWindowNodesByRootType(*(windowNodeMap[WindowRootNodeType::ABOVE_WINDOW_NODE]));
+    WindowLayoutCacheKey key = { displayRect, limitRectMap_[displayId], GetVirtualPixelRatio(displayId) };
+    if (layoutCache_.Find(key, cascadeRectsMap_[displayId])) {
+        WLOGFI("reuse cached cascade rects");
+        return;
+    }
+    // init split and limit rects
+    InitSplitRects(displayId);
+    auto& cascadeRects = cascadeRectsMap_[displayId];
+    cascadeRects.primaryLimitRect_ = cascadeRects.primaryRect_;
+    cascadeRects.secondaryLimitRect_ = cascadeRects.secondaryRect_;
+    UpdateSplitLimitRect(limitRectMap_[displayId], cascadeRects.primaryLimitRect_);
+    UpdateSplitLimitRect(limitRectMap_[displayId], cascadeRects.secondaryLimitRect_);
+    // init cascade rect
+    InitCascadeRect(displayId);
+    layoutCache_.Insert(key, cascadeRects);
+}
+
+void WindowLayoutPolicyCascade::UpdateDisplayRect(DisplayId displayId, const Rect& displayRect)
+{
+    displayRectMap_[displayId] = displayRect;
+    // the avoid area windows were placed while the rects of the display were rebuilt, only the rest follows
+    InitDisplayRects(displayId);
+    LayoutAppAndBelowWindowNodes(displayId);
+}
+
 void WindowLayoutPolicyCascade::LayoutWindowNode(const sptr<WindowNode>& node)
 {
     if (node == nullptr) {
@@ -110,6 +137,25 @@ void WindowLayoutPolicyCascade::LayoutWindowTree(DisplayId displayId)
     WindowLayoutPolicy::LayoutWindowTree(displayId);
 }
 
+void WindowLayoutPolicyCascade::LayoutSplitWindows(DisplayId displayId)
+{
+    // only the split rects moved, the limit rect left by the avoid area windows is the one of the last full layout
+    auto& cascadeRects = cascadeRectsMap_[displayId];
+    cascadeRects.primaryLimitRect_ = cascadeRects.primaryRect_;
+    cascadeRects.secondaryLimitRect_ = cascadeRects.secondaryRect_;
+    UpdateSplitLimitRect(limitRectMap_[displayId], cascadeRects.primaryLimitRect_);
+    UpdateSplitLimitRect(limitRectMap_[displayId], cascadeRects.secondaryLimitRect_);
+
+    isSplitRectNotifySuppressed_ = !IsDividerDragNotifyDue(displayId);
+    const auto& appWindowNodeVec = *(windowNodeMaps_[displayId][WindowRootNodeType::APP_WINDOW_NODE]);
+    for (auto& childNode : appWindowNodeVec) {
+        if (childNode->IsSplitMode()) {
+            LayoutWindowNode(childNode);
+        }
+    }
+    isSplitRectNotifySuppressed_ = false;
+}
+
 void WindowLayoutPolicyCascade::RemoveWindowNode(const sptr<WindowNode>& node)
 {
     WM_FUNCTION_TRACE();
@@ -118,6 +164,7 @@ void WindowLayoutPolicyCascade::RemoveWindowNode(const sptr<WindowNode>& node)
     if (avoidTypes_.find(type) != avoidTypes_.end()) {
         LayoutWindowTree(node->GetDisplayId());
     } else if (type == WindowType::WINDOW_TYPE_DOCK_SLICE) { // split screen mode
+        EndDividerDrag(node->GetDisplayId());
         InitSplitRects(node->GetDisplayId());
         LayoutWindowTree(node->GetDisplayId());
     }
@@ -148,7 +195,11 @@ void WindowLayoutPolicyCascade::UpdateWindowNode(const sptr<WindowNode>& node, b
                 }
             }
         }
-        LayoutWindowTree(displayId);
+        if (IsDividerDragging(displayId)) {
+            LayoutSplitWindows(displayId);
+        } else {
+            LayoutWindowTree(displayId);
+        }
     } else if (node->IsSplitMode()) {
         LayoutWindowTree(displayId);
     } else { // layout single window
@@ -173,6 +224,20 @@ void WindowLayoutPolicyCascade::AddWindowNode(const sptr<WindowNode>& node)
     UpdateWindowNode(node, true); // currently, update and add do the same process
 }
 
+Rect WindowLayoutPolicyCascade::PredictLayoutRect(const sptr<WindowNode>& node)
+{
+    // same request rect as SetCascadeRect would give, but keeps the first app window state for the real add
+    if (WindowHelper::IsEmptyRect(node->GetRequestRect())) {
+        if (WindowHelper::IsAppWindow(node->GetWindowType())) {
+            node->SetRequestRect(GetCurCascadeRect(node));
+        } else {
+            node->SetRequestRect(cascadeRectsMap_[node->GetDisplayId()].firstCascadeRect_);
+        }
+        node->SetDecoStatus(true);
+    }
+    return WindowLayoutPolicy::PredictLayoutRect(node);
+}
+
 void WindowLayoutPolicyCascade::LimitMoveBounds(Rect& rect, DisplayId displayId) const
 {
     float virtualPixelRatio = GetVirtualPixelRatio(displayId);
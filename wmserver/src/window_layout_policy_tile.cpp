@@ -52,17 +52,31 @@ void WindowLayoutPolicyTile::Launch()
     WLOGFI("WindowLayoutPolicyTile::Launch");
 }
 
+void WindowLayoutPolicyTile::UpdateDisplayRect(DisplayId displayId, const Rect& displayRect)
+{
+    displayRectMap_[displayId] = displayRect;
+    // same pass as Launch, restricted to the display which changed
+    InitDisplayRects(displayId);
+    AssignNodePropertyForTileWindows(displayId);
+    LayoutForegroundNodeQueue(displayId);
+    LayoutWindowNodesByRootType(*(windowNodeMaps_[displayId][WindowRootNodeType::BELOW_WINDOW_NODE]));
+}
+
 void WindowLayoutPolicyTile::InitAllRects()
 {
     for (auto& iter : displayRectMap_) {
-        DisplayId displayId = iter.first;
-        limitRectMap_[displayId] = iter.second;
-        auto& windowNodeMap = windowNodeMaps_[displayId];
-        LayoutWindowNodesByRootType(*(windowNodeMap[WindowRootNodeType::ABOVE_WINDOW_NODE]));
-        InitTileWindowRects(displayId);
+        InitDisplayRects(iter.first);
     }
 }
 
+void WindowLayoutPolicyTile::InitDisplayRects(DisplayId displayId)
+{
+    limitRectMap_[displayId] = displayRectMap_[displayId];
+    auto& windowNodeMap = windowNodeMaps_[displayId];
+    LayoutWindowNodesByRootType(*(windowNodeMap[WindowRootNodeType::ABOVE_WINDOW_NODE]));
+    InitTileWindowRects(displayId);
+}
+
 uint32_t WindowLayoutPolicyTile::GetMaxTileWinNum(DisplayId displayId) const
 {
     float virtualPixelRatio = GetVirtualPixelRatio(displayId);
@@ -78,6 +92,14 @@ uint32_t WindowLayoutPolicyTile::GetMaxTileWinNum(DisplayId displayId) const
 void WindowLayoutPolicyTile::InitTileWindowRects(DisplayId displayId)
 {
     float virtualPixelRatio = GetVirtualPixelRatio(displayId);
+    WindowLayoutCacheKey key = { displayRectMap_[displayId], limitRectMap_[displayId], virtualPixelRatio };
+    TilePresetRects cachedRects;
+    if (layoutCache_.Find(key, cachedRects)) {
+        WLOGFI("reuse cached preset rects");
+        maxTileWinNumMap_[displayId] = cachedRects.maxTileWinNum_;
+        presetRectsMap_[displayId] = cachedRects.presetRects_;
+        return;
+    }
     uint32_t edgeIntervalVp = static_cast<uint32_t>(EDGE_INTERVAL * virtualPixelRatio);
     uint32_t midIntervalVp = static_cast<uint32_t>(MID_INTERVAL * virtualPixelRatio);
 
@@ -110,6 +132,7 @@ void WindowLayoutPolicyTile::InitTileWindowRects(DisplayId displayId)
         }
         presetRects.emplace_back(curLevel);
     }
+    layoutCache_.Insert(key, { maxTileWinNumMap_[displayId], presetRects });
 }
 
 void WindowLayoutPolicyTile::AddWindowNode(const sptr<WindowNode>& node)
@@ -125,6 +148,26 @@ void WindowLayoutPolicyTile::AddWindowNode(const sptr<WindowNode>& node)
     }
 }
 
+Rect WindowLayoutPolicyTile::PredictLayoutRect(const sptr<WindowNode>& node)
+{
+    if (!WindowHelper::IsMainWindow(node->GetWindowType())) {
+        return WindowLayoutPolicy::PredictLayoutRect(node);
+    }
+    // a new main window is pushed to the back of the foreground queue and takes the last preset rect, laid out as
+    // AssignNodePropertyForTileWindows would request it
+    DisplayId displayId = node->GetDisplayId();
+    uint32_t num = std::min(static_cast<uint32_t>(foregroundNodesMap_[displayId].size()) + 1,
+        maxTileWinNumMap_[displayId]);
+    auto& presetRects = presetRectsMap_[displayId];
+    if (num == 0 || num > presetRects.size() || presetRects[num - 1].size() != num) {
+        return { 0, 0, 0, 0 };
+    }
+    node->SetWindowMode(WindowMode::WINDOW_MODE_FLOATING);
+    node->SetRequestRect(presetRects[num - 1][num - 1]);
+    node->SetDecoStatus(true);
+    return WindowLayoutPolicy::PredictLayoutRect(node);
+}
+
 void WindowLayoutPolicyTile::UpdateWindowNode(const sptr<WindowNode>& node, bool isAddWindow)
 {
     WM_FUNCTION_TRACE();
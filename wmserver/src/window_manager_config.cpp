@@ -56,7 +56,8 @@ bool WindowManagerConfig::LoadConfigXml(const std::string& configFilePath)
             continue;
         }
         if (!xmlStrcmp(nodeName, reinterpret_cast<const xmlChar*>("maxAppWindowNumber")) ||
-            !xmlStrcmp(nodeName, reinterpret_cast<const xmlChar*>("modeChangeHotZones"))) {
+            !xmlStrcmp(nodeName, reinterpret_cast<const xmlChar*>("modeChangeHotZones")) ||
+            !xmlStrcmp(nodeName, reinterpret_cast<const xmlChar*>("dividerDragNotifyInterval"))) {
             ReadNumbersConfigInfo(curNodePtr);
             continue;
         }
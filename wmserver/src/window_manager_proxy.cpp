@@ -63,6 +63,15 @@ WMError WindowManagerProxy::CreateWindow(sptr<IWindow>& window, sptr<WindowPrope
     }
     windowId = reply.ReadUint32();
     int32_t ret = reply.ReadInt32();
+    if (static_cast<WMError>(ret) == WMError::WM_OK) {
+        property->SetDecorEnable(reply.ReadBool());
+        Rect rect;
+        rect.posX_ = reply.ReadInt32();
+        rect.posY_ = reply.ReadInt32();
+        rect.width_ = reply.ReadUint32();
+        rect.height_ = reply.ReadUint32();
+        property->SetWindowRect(rect);
+    }
     return static_cast<WMError>(ret);
 }
 
@@ -622,5 +631,24 @@ WMError WindowManagerProxy::GetModeChangeHotZones(DisplayId displayId, ModeChang
     }
     return ret;
 }
+
+sptr<Ashmem> WindowManagerProxy::GetWindowStatePage()
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        WLOGFE("WriteInterfaceToken failed");
+        return nullptr;
+    }
+    if (Remote()->SendRequest(static_cast<uint32_t>(WindowManagerMessage::TRANS_ID_GET_WINDOW_STATE_PAGE),
+        data, reply, option) != ERR_NONE) {
+        return nullptr;
+    }
+    if (!reply.ReadBool()) {
+        return nullptr;
+    }
+    return reply.ReadAshmem();
+}
 } // namespace Rosen
 } // namespace OHOS
\ No newline at end of file
@@ -15,7 +15,10 @@
 
 #include "window_manager_service.h"
 
+#include <cerrno>
 #include <cinttypes>
+#include <string_ex.h>
+#include <sys/stat.h>
 
 #include <ability_manager_client.h>
 #include <ipc_skeleton.h>
@@ -31,6 +34,9 @@
 #include "window_manager_agent_controller.h"
 #include "window_manager_config.h"
 #include "window_manager_hilog.h"
+#include "window_perf_statistics.h"
+#include "window_transaction_recorder.h"
+#include "window_tree_recorder.h"
 #include "wm_common.h"
 #include "wm_trace.h"
 
@@ -38,6 +44,8 @@ namespace OHOS {
 namespace Rosen {
 namespace {
     constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WindowManagerService"};
+    const std::string TRANSACTION_RECORD_DIR = "/data/window_transactions/";
+    const std::string DEFAULT_TRANSACTION_RECORD_NAME = "window_transactions.bin";
 }
 WM_IMPLEMENT_SINGLE_INSTANCE(WindowManagerService)
 
@@ -48,7 +56,8 @@ WindowManagerService::WindowManagerService() : SystemAbility(WINDOW_MANAGER_SERV
     windowRoot_ = new WindowRoot(mutex_,
         std::bind(&WindowManagerService::OnWindowEvent, this, std::placeholders::_1, std::placeholders::_2));
     inputWindowMonitor_ = new InputWindowMonitor(windowRoot_);
-    windowController_ = new WindowController(windowRoot_, inputWindowMonitor_);
+    windowStatePublisher_ = new WindowStatePublisher(windowRoot_);
+    windowController_ = new WindowController(windowRoot_, inputWindowMonitor_, windowStatePublisher_);
     snapshotController_ = new SnapshotController(windowRoot_);
     dragController_ = new DragController(windowRoot_);
     freezeDisplayController_ = new FreezeController();
@@ -65,6 +74,7 @@ void WindowManagerService::OnStart()
     DisplayManagerServiceInner::GetInstance().RegisterDisplayChangeListener(listener);
     RegisterSnapshotHandler();
     RegisterWindowManagerServiceHandler();
+    WindowPerfStatistics::GetInstance().StartPeriodicReport();
 }
 
 void WindowManagerService::RegisterSnapshotHandler()
@@ -122,6 +132,7 @@ void WindowManagerService::ConfigureWindowManagerService()
 
     if (enableConfig.count("decor") != 0) {
         isSystemDecorEnable_ = enableConfig["decor"];
+        windowStatePublisher_->SetSystemDecorEnable(isSystemDecorEnable_);
     }
 
     if (enableConfig.count("minimizeByOther") != 0) {
@@ -135,6 +146,13 @@ void WindowManagerService::ConfigureWindowManagerService()
         }
     }
 
+    if (numbersConfig.count("dividerDragNotifyInterval") != 0) {
+        auto numbers = numbersConfig["dividerDragNotifyInterval"];
+        if (numbers.size() == 1 && numbers[0] >= 0) {
+            windowRoot_->SetDividerDragNotifyInterval(static_cast<uint32_t>(numbers[0]));
+        }
+    }
+
     if (numbersConfig.count("modeChangeHotZones") != 0) {
         auto numbers = numbersConfig["modeChangeHotZones"];
         if (numbers.size() == 3) { // 3 hot zones
@@ -149,9 +167,113 @@ void WindowManagerService::ConfigureWindowManagerService()
 void WindowManagerService::OnStop()
 {
     SingletonContainer::Get<WindowInnerManager>().SendMessage(InnerWMCmd::INNER_WM_DESTROY_THREAD);
+    WindowPerfStatistics::GetInstance().StopPeriodicReport();
     WLOGFI("ready to stop service.");
 }
 
+int WindowManagerService::Dump(int fd, const std::vector<std::u16string>& args)
+{
+    std::vector<std::string> params;
+    for (auto& arg : args) {
+        params.emplace_back(Str16ToStr8(arg));
+    }
+    std::string dumpInfo;
+    if (params.empty() || params[0] == "-h") {
+        dumpInfo.append("Usage:\n")
+            .append(" -h                  help information\n")
+            .append(" -perf               dump latency statistics of window manager service\n")
+            .append(" -perf -reset        reset latency statistics of window manager service\n")
+            .append(" -lock               dump lock profile of window manager service\n")
+            .append(" -lock -enable       start lock profiling\n")
+            .append(" -lock -disable      stop lock profiling\n")
+            .append(" -lock -reset        reset lock profile\n")
+            .append(" -tree               dump the latest recorded window tree\n")
+            .append(" -tree -raw          dump all recorded window trees in binary for window_tree_analyzer\n")
+            .append(" -record -start [name] start recording transactions to /data/window_transactions/\n")
+            .append(" -record -stop       stop recording transactions\n");
+    } else if (params[0] == "-tree" && params.size() > 1 && params[1] == "-raw") {
+        return WindowTreeRecorder::GetInstance().DumpRaw(fd) ? 0 : -1;
+    } else if (params[0] == "-tree") {
+        WindowTreeRecorder::GetInstance().Dump(dumpInfo);
+    } else if (params[0] == "-record") {
+        DumpTransactionRecord(params, dumpInfo);
+    } else if (params[0] == "-perf") {
+        WindowPerfStatistics::GetInstance().Dump(dumpInfo);
+        if (params.size() > 1 && params[1] == "-reset") {
+            WindowPerfStatistics::GetInstance().Reset();
+            dumpInfo.append("statistics have been reset\n");
+        }
+    } else if (params[0] == "-lock") {
+        DumpLockProfile(params, dumpInfo);
+    } else {
+        dumpInfo.append("unknown parameter: ").append(params[0]).append(", use -h for help\n");
+    }
+    int ret = dprintf(fd, "%s", dumpInfo.c_str());
+    if (ret < 0) {
+        WLOGFE("dump failed, ret: %{public}d", ret);
+        return -1;
+    }
+    return 0;
+}
+
+void WindowManagerService::DumpTransactionRecord(const std::vector<std::string>& params, std::string& dumpInfo)
+{
+    if (params.size() > 1 && params[1] == "-start") {
+        // only a file name is accepted, records are always written to the fixed directory
+        std::string name = params.size() > 2 ? params[2] : DEFAULT_TRANSACTION_RECORD_NAME;
+        if (name.empty() || name == "." || name == ".." || name.find('/') != std::string::npos) {
+            dumpInfo.append("invalid record file name: ").append(name).append("\n");
+            return;
+        }
+        if (mkdir(TRANSACTION_RECORD_DIR.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+            dumpInfo.append("create ").append(TRANSACTION_RECORD_DIR).append(" failed\n");
+            return;
+        }
+        std::string path = TRANSACTION_RECORD_DIR + name;
+        if (WindowTransactionRecorder::GetInstance().Start(path)) {
+            dumpInfo.append("transaction recording started: ").append(path).append("\n");
+        } else {
+            dumpInfo.append("start transaction recording failed\n");
+        }
+    } else if (params.size() > 1 && params[1] == "-stop") {
+        WindowTransactionRecorder::GetInstance().Stop();
+        dumpInfo.append("transaction recording stopped\n");
+    } else {
+        dumpInfo.append("transaction recording is ")
+            .append(WindowTransactionRecorder::GetInstance().IsRecording() ? "on\n" : "off\n");
+    }
+}
+
+void WindowManagerService::DumpLockProfile(const std::vector<std::string>& params, std::string& dumpInfo)
+{
+    if (params.size() > 1 && params[1] == "-enable") {
+        mutex_.SetProfileEnabled(true);
+    } else if (params.size() > 1 && params[1] == "-disable") {
+        mutex_.SetProfileEnabled(false);
+    } else if (params.size() > 1 && params[1] == "-reset") {
+        mutex_.ResetProfile();
+    }
+    mutex_.DumpProfile(dumpInfo);
+}
+
+bool WindowManagerService::StartInProcess(uint32_t displayWidth, uint32_t displayHeight)
+{
+    sptr<IDisplayChangeListener> listener = new DisplayChangeListener();
+    DisplayManagerServiceInner::GetInstance().RegisterDisplayChangeListener(listener);
+    DisplayId displayId = DisplayManagerServiceInner::GetInstance().CreateHeadlessDisplay(displayWidth, displayHeight);
+    if (displayId == DISPLAY_ID_INVALID) {
+        WLOGFE("create headless display failed");
+        return false;
+    }
+    WM_PROFILED_LOCK(mutex_);
+    if (windowRoot_->GetWindowNodeContainer(displayId) == nullptr) {
+        WLOGFE("no window node container for headless display %{public}" PRIu64"", displayId);
+        return false;
+    }
+    WLOGFI("in-process service started on display %{public}" PRIu64"", displayId);
+    return true;
+}
+
 void WindowManagerService::NotifyWindowTransition(WindowTransitionInfo fromInfo, WindowTransitionInfo toInfo)
 {
     windowController_->NotifyWindowTransition(fromInfo, toInfo);
@@ -161,6 +283,7 @@ WMError WindowManagerService::CreateWindow(sptr<IWindow>& window, sptr<WindowPro
     const std::shared_ptr<RSSurfaceNode>& surfaceNode, uint32_t& windowId, sptr<IRemoteObject> token)
 {
     WM_SCOPED_TRACE("wms:CreateWindow(%u)", windowId);
+    WM_PERF_SCOPED_STAT(WindowPerfStatType::CREATE_WINDOW);
     if (window == nullptr || property == nullptr || surfaceNode == nullptr) {
         WLOGFE("window is invalid");
         return WMError::WM_ERROR_NULLPTR;
@@ -169,7 +292,12 @@ WMError WindowManagerService::CreateWindow(sptr<IWindow>& window, sptr<WindowPro
         WLOGFE("failed to get window agent");
         return WMError::WM_ERROR_NULLPTR;
     }
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (!isSystemDecorEnable_) {
+        property->SetDecorEnable(false);
+    }
+    uint64_t lockStartTime = PerfHistogram::GetCurrentTimeUs();
+    WM_PROFILED_LOCK(mutex_);
+    WindowPerfStatistics::GetInstance().RecordSince(WindowPerfStatType::LOCK_WAIT, lockStartTime);
     return windowController_->CreateWindow(window, property, surfaceNode, windowId, token);
 }
 
@@ -181,10 +309,16 @@ WMError WindowManagerService::AddWindow(sptr<WindowProperty>& property)
         "%{public}4d %{public}4d]", windowId, property->GetWindowType(), property->GetWindowMode(),
         property->GetWindowFlags(), rect.posX_, rect.posY_, rect.width_, rect.height_);
     WM_SCOPED_TRACE("wms:AddWindow(%u)", windowId);
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    WMError res = windowController_->AddWindowNode(property);
-    if (property->GetWindowType() == WindowType::WINDOW_TYPE_DRAGGING_EFFECT) {
-        dragController_->StartDrag(windowId);
+    WMError res;
+    {
+        WM_PERF_SCOPED_STAT(WindowPerfStatType::ADD_WINDOW);
+        uint64_t lockStartTime = PerfHistogram::GetCurrentTimeUs();
+        WM_PROFILED_LOCK(mutex_);
+        WindowPerfStatistics::GetInstance().RecordSince(WindowPerfStatType::LOCK_WAIT, lockStartTime);
+        res = windowController_->AddWindowNode(property);
+        if (property->GetWindowType() == WindowType::WINDOW_TYPE_DRAGGING_EFFECT) {
+            dragController_->StartDrag(windowId);
+        }
     }
     return res;
 }
@@ -193,7 +327,10 @@ WMError WindowManagerService::RemoveWindow(uint32_t windowId)
 {
     WLOGFI("[WMS] Remove: %{public}u", windowId);
     WM_SCOPED_TRACE("wms:RemoveWindow(%u)", windowId);
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PERF_SCOPED_STAT(WindowPerfStatType::REMOVE_WINDOW);
+    uint64_t lockStartTime = PerfHistogram::GetCurrentTimeUs();
+    WM_PROFILED_LOCK(mutex_);
+    WindowPerfStatistics::GetInstance().RecordSince(WindowPerfStatType::LOCK_WAIT, lockStartTime);
     return windowController_->RemoveWindowNode(windowId);
 }
 
@@ -201,7 +338,10 @@ WMError WindowManagerService::DestroyWindow(uint32_t windowId, bool onlySelf)
 {
     WLOGFI("[WMS] Destroy: %{public}u", windowId);
     WM_SCOPED_TRACE("wms:DestroyWindow(%u)", windowId);
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PERF_SCOPED_STAT(WindowPerfStatType::DESTROY_WINDOW);
+    uint64_t lockStartTime = PerfHistogram::GetCurrentTimeUs();
+    WM_PROFILED_LOCK(mutex_);
+    WindowPerfStatistics::GetInstance().RecordSince(WindowPerfStatType::LOCK_WAIT, lockStartTime);
     auto node = windowRoot_->GetWindowNode(windowId);
     if (node != nullptr && node->GetWindowType() == WindowType::WINDOW_TYPE_DRAGGING_EFFECT) {
         dragController_->FinishDrag(windowId);
@@ -213,28 +353,28 @@ WMError WindowManagerService::RequestFocus(uint32_t windowId)
 {
     WLOGFI("[WMS] RequestFocus: %{public}u", windowId);
     WM_SCOPED_TRACE("wms:RequestFocus");
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     return windowController_->RequestFocus(windowId);
 }
 
 WMError WindowManagerService::SetWindowBackgroundBlur(uint32_t windowId, WindowBlurLevel level)
 {
     WM_SCOPED_TRACE("wms:SetWindowBackgroundBlur");
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     return windowController_->SetWindowBackgroundBlur(windowId, level);
 }
 
 WMError WindowManagerService::SetAlpha(uint32_t windowId, float alpha)
 {
     WM_SCOPED_TRACE("wms:SetAlpha");
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     return windowController_->SetAlpha(windowId, alpha);
 }
 
 std::vector<Rect> WindowManagerService::GetAvoidAreaByType(uint32_t windowId, AvoidAreaType avoidAreaType)
 {
     WLOGFI("[WMS] GetAvoidAreaByType: %{public}u, Type: %{public}u", windowId, static_cast<uint32_t>(avoidAreaType));
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     return windowController_->GetAvoidAreaByType(windowId, avoidAreaType);
 }
 
@@ -245,7 +385,7 @@ void WindowManagerService::RegisterWindowManagerAgent(WindowManagerAgentType typ
         WLOGFE("windowManagerAgent is null");
         return;
     }
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     WindowManagerAgentController::GetInstance().RegisterWindowManagerAgent(windowManagerAgent, type);
     if (type == WindowManagerAgentType::WINDOW_MANAGER_AGENT_TYPE_SYSTEM_BAR) { // if system bar, notify once
         windowController_->NotifySystemBarTints();
@@ -259,7 +399,7 @@ void WindowManagerService::UnregisterWindowManagerAgent(WindowManagerAgentType t
         WLOGFE("windowManagerAgent is null");
         return;
     }
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     WindowManagerAgentController::GetInstance().UnregisterWindowManagerAgent(windowManagerAgent, type);
 }
 
@@ -270,7 +410,7 @@ WMError WindowManagerService::SetWindowAnimationController(const sptr<RSIWindowA
         return WMError::WM_ERROR_NULLPTR;
     }
 
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     return windowController_->SetWindowAnimationController(controller);
 }
 
@@ -289,7 +429,7 @@ void WindowManagerService::NotifyDisplayStateChange(DisplayId id, DisplayStateCh
     } else if (type == DisplayStateChangeType::UNFREEZE) {
         freezeDisplayController_->UnfreezeDisplay(id);
     } else {
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        WM_PROFILED_LOCK(mutex_);
         return windowController_->NotifyDisplayStateChange(id, type);
     }
 }
@@ -301,34 +441,34 @@ void DisplayChangeListener::OnDisplayStateChange(DisplayId id, DisplayStateChang
 
 void WindowManagerService::ProcessPointDown(uint32_t windowId, bool isStartDrag)
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     windowController_->ProcessPointDown(windowId, isStartDrag);
 }
 
 void WindowManagerService::ProcessPointUp(uint32_t windowId)
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     windowController_->ProcessPointUp(windowId);
 }
 
 void WindowManagerService::MinimizeAllAppWindows(DisplayId displayId)
 {
     WLOGFI("displayId %{public}" PRIu64"", displayId);
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     windowController_->MinimizeAllAppWindows(displayId);
 }
 
 WMError WindowManagerService::MaxmizeWindow(uint32_t windowId)
 {
     WM_SCOPED_TRACE("wms:MaxmizeWindow");
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     return windowController_->MaxmizeWindow(windowId);
 }
 
 WMError WindowManagerService::GetTopWindowId(uint32_t mainWinId, uint32_t& topWinId)
 {
     WM_SCOPED_TRACE("wms:GetTopWindowId(%u)", mainWinId);
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     return windowController_->GetTopWindowId(mainWinId, topWinId);
 }
 
@@ -336,7 +476,7 @@ WMError WindowManagerService::SetWindowLayoutMode(DisplayId displayId, WindowLay
 {
     WLOGFI("SetWindowLayoutMode, displayId: %{public}" PRIu64", layoutMode: %{public}u", displayId, mode);
     WM_SCOPED_TRACE("wms:SetWindowLayoutMode");
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     return windowController_->SetWindowLayoutMode(displayId, mode);
 }
 
@@ -347,7 +487,10 @@ WMError WindowManagerService::UpdateProperty(sptr<WindowProperty>& windowPropert
         return WMError::WM_ERROR_NULLPTR;
     }
     WM_SCOPED_TRACE("wms:UpdateProperty");
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PERF_SCOPED_STAT(WindowPerfStatType::UPDATE_PROPERTY);
+    uint64_t lockStartTime = PerfHistogram::GetCurrentTimeUs();
+    WM_PROFILED_LOCK(mutex_);
+    WindowPerfStatistics::GetInstance().RecordSince(WindowPerfStatType::LOCK_WAIT, lockStartTime);
     WMError res = windowController_->UpdateProperty(windowProperty, action);
     if (action == PropertyChangeAction::ACTION_UPDATE_RECT && res == WMError::WM_OK &&
         windowProperty->GetWindowSizeChangeReason() == WindowSizeChangeReason::MOVE) {
@@ -363,7 +506,7 @@ WMError WindowManagerService::GetAccessibilityWindowInfo(sptr<AccessibilityWindo
         return WMError::WM_ERROR_NULLPTR;
     }
     WM_SCOPED_TRACE("wms:GetAccessibilityWindowInfo");
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     WMError res = windowRoot_->GetAccessibilityWindowInfo(windowInfo);
     return res;
 }
@@ -382,5 +525,11 @@ WMError WindowManagerService::GetModeChangeHotZones(DisplayId displayId, ModeCha
 
     return windowController_->GetModeChangeHotZones(displayId, hotZones, hotZonesConfig_);
 }
+
+sptr<Ashmem> WindowManagerService::GetWindowStatePage()
+{
+    WM_PROFILED_LOCK(mutex_);
+    return windowStatePublisher_->GetPage();
+}
 } // namespace Rosen
 } // namespace OHOS
\ No newline at end of file
@@ -16,6 +16,9 @@
 #include "window_manager_stub.h"
 #include <ipc_skeleton.h>
 #include <rs_iwindow_animation_controller.h>
+#include "perf_histogram.h"
+#include "profiled_mutex.h"
+#include "window_transaction_recorder.h"
 #include "window_manager_hilog.h"
 
 
@@ -32,6 +35,9 @@ int32_t WindowManagerStub::OnRemoteRequest(uint32_t code, MessageParcel &data, M
         WLOGFE("InterfaceToken check failed");
         return -1;
     }
+    ProfiledRequestScope requestScope(code);
+    uint64_t recordStartTime = WindowTransactionRecorder::GetInstance().IsRecording() ?
+        PerfHistogram::GetCurrentTimeUs() : 0;
     WindowManagerMessage msgId = static_cast<WindowManagerMessage>(code);
     switch (msgId) {
         case WindowManagerMessage::TRANS_ID_CREATE_WINDOW: {
@@ -49,6 +55,14 @@ int32_t WindowManagerStub::OnRemoteRequest(uint32_t code, MessageParcel &data, M
             WMError errCode = CreateWindow(windowProxy, windowProperty, surfaceNode, windowId, token);
             reply.WriteUint32(windowId);
             reply.WriteInt32(static_cast<int32_t>(errCode));
+            if (errCode == WMError::WM_OK) {
+                reply.WriteBool(windowProperty->GetDecorEnable());
+                Rect rect = windowProperty->GetWindowRect();
+                reply.WriteInt32(rect.posX_);
+                reply.WriteInt32(rect.posY_);
+                reply.WriteUint32(rect.width_);
+                reply.WriteUint32(rect.height_);
+            }
             break;
         }
         case WindowManagerMessage::TRANS_ID_ADD_WINDOW: {
@@ -210,10 +224,21 @@ int32_t WindowManagerStub::OnRemoteRequest(uint32_t code, MessageParcel &data, M
             reply.WriteUint32(hotZones.secondary_.height_);
             break;
         }
+        case WindowManagerMessage::TRANS_ID_GET_WINDOW_STATE_PAGE: {
+            sptr<Ashmem> page = GetWindowStatePage();
+            reply.WriteBool(page != nullptr);
+            if (page != nullptr) {
+                reply.WriteAshmem(page);
+            }
+            break;
+        }
         default:
             WLOGFW("unknown transaction code %{public}d", code);
             return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
     }
+    if (recordStartTime != 0) {
+        WindowTransactionRecorder::GetInstance().Record(code, data, reply, recordStartTime);
+    }
     return 0;
 }
 } // namespace Rosen
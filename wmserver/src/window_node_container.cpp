@@ -19,8 +19,6 @@
 #include <algorithm>
 #include <cinttypes>
 #include <ctime>
-#include <display_power_mgr_client.h>
-#include <power_mgr_client.h>
 
 #include "common_event_manager.h"
 #include "display_manager_service_inner.h"
@@ -31,6 +29,9 @@
 #include "window_layout_policy_tile.h"
 #include "window_manager_agent_controller.h"
 #include "window_manager_hilog.h"
+#include "window_perf_statistics.h"
+#include "window_service_backend.h"
+#include "window_tree_recorder.h"
 #include "wm_common.h"
 #include "wm_common_inner.h"
 #include "wm_trace.h"
@@ -39,7 +40,6 @@ namespace OHOS {
 namespace Rosen {
 namespace {
     constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WindowNodeContainer"};
-    constexpr int WINDOW_NAME_MAX_LENGTH = 10;
     const std::string SPLIT_SCREEN_EVENT_NAME = "common.event.SPLIT_SCREEN";
     const char DISABLE_WINDOW_ANIMATION_PATH[] = "/etc/disable_window_animation";
     constexpr uint32_t MAX_BRIGHTNESS = 255;
@@ -242,7 +242,10 @@ WMError WindowNodeContainer::AddWindowNode(sptr<WindowNode>& node, sptr<WindowNo
     }
     UpdateRSTree(node, true, node->isPlayAnimationShow_);
     AssignZOrder();
-    layoutPolicy_->AddWindowNode(node);
+    {
+        WM_PERF_SCOPED_STAT(WindowPerfStatType::LAYOUT);
+        layoutPolicy_->AddWindowNode(node);
+    }
     if (WindowHelper::IsAvoidAreaWindow(node->GetWindowType())) {
         avoidController_->AvoidControl(node, AvoidControlType::AVOID_NODE_ADD);
         NotifyIfSystemBarRegionChanged(node->GetDisplayId());
@@ -251,7 +254,7 @@ WMError WindowNodeContainer::AddWindowNode(sptr<WindowNode>& node, sptr<WindowNo
     }
     std::vector<sptr<WindowVisibilityInfo>> infos;
     UpdateWindowVisibilityInfos(infos);
-    DumpScreenWindowTree();
+    DumpScreenWindowTree(WindowTreeChangeReason::ADD_WINDOW);
     NotifyAccessibilityWindowInfo(node, WindowUpdateType::WINDOW_UPDATE_ADDED);
     WLOGFI("AddWindowNode windowId: %{public}u end", node->GetWindowId());
     return WMError::WM_OK;
@@ -262,14 +265,17 @@ WMError WindowNodeContainer::UpdateWindowNode(sptr<WindowNode>& node, WindowUpda
     if (WindowHelper::IsMainWindow(node->GetWindowType()) && WindowHelper::IsSwitchCascadeReason(reason)) {
         SwitchLayoutPolicy(WindowLayoutMode::CASCADE, node->GetDisplayId());
     }
-    layoutPolicy_->UpdateWindowNode(node);
+    {
+        WM_PERF_SCOPED_STAT(WindowPerfStatType::LAYOUT);
+        layoutPolicy_->UpdateWindowNode(node);
+    }
     if (WindowHelper::IsAvoidAreaWindow(node->GetWindowType())) {
         avoidController_->AvoidControl(node, AvoidControlType::AVOID_NODE_UPDATE);
         NotifyIfSystemBarRegionChanged(node->GetDisplayId());
     } else {
         NotifyIfSystemBarTintChanged(node->GetDisplayId());
     }
-    DumpScreenWindowTree();
+    DumpScreenWindowTree(WindowTreeChangeReason::UPDATE_WINDOW);
     WLOGFI("UpdateWindowNode windowId: %{public}u end", node->GetWindowId());
     return WMError::WM_OK;
 }
@@ -281,6 +287,12 @@ void WindowNodeContainer::UpdateSizeChangeReason(sptr<WindowNode>& node, WindowS
         return;
     }
     if (node->GetWindowType() == WindowType::WINDOW_TYPE_DOCK_SLICE) {
+        // while the divider is dragged only the split rects are laid out, the drag end sends their exact rects
+        if (reason == WindowSizeChangeReason::DRAG_START) {
+            layoutPolicy_->StartDividerDrag(node->GetDisplayId());
+        } else if (reason == WindowSizeChangeReason::DRAG_END) {
+            layoutPolicy_->EndDividerDrag(node->GetDisplayId());
+        }
         for (auto& childNode : appWindowNode_->children_) {
             if (childNode->IsSplitMode()) {
                 childNode->GetWindowToken()->UpdateWindowRect(childNode->GetWindowRect(),
@@ -423,7 +435,10 @@ WMError WindowNodeContainer::RemoveWindowNode(sptr<WindowNode>& node)
     }
     UpdateRSTree(node, false, node->isPlayAnimationHide_);
     UpdateWindowNodeMaps();
-    layoutPolicy_->RemoveWindowNode(node);
+    {
+        WM_PERF_SCOPED_STAT(WindowPerfStatType::LAYOUT);
+        layoutPolicy_->RemoveWindowNode(node);
+    }
     windowPair_->HandleRemoveWindow(node);
     if (WindowHelper::IsAvoidAreaWindow(node->GetWindowType())) {
         avoidController_->AvoidControl(node, AvoidControlType::AVOID_NODE_REMOVE);
@@ -432,7 +447,7 @@ WMError WindowNodeContainer::RemoveWindowNode(sptr<WindowNode>& node)
         NotifyIfSystemBarTintChanged(node->GetDisplayId());
     }
     UpdateWindowVisibilityInfos(infos);
-    DumpScreenWindowTree();
+    DumpScreenWindowTree(WindowTreeChangeReason::REMOVE_WINDOW);
     NotifyAccessibilityWindowInfo(node, WindowUpdateType::WINDOW_UPDATE_REMOVED);
     RcoveryScreenDefaultOrientationIfNeed(node->GetDisplayId());
     WLOGFI("RemoveWindowNode windowId: %{public}u end", node->GetWindowId());
@@ -548,14 +563,14 @@ void WindowNodeContainer::UpdateBrightness(uint32_t id, bool byRemoved)
     if (node->GetBrightness() == UNDEFINED_BRIGHTNESS) {
         if (GetDisplayBrightness() != node->GetBrightness()) {
             WLOGFI("adjust brightness with default value");
-            DisplayPowerMgr::DisplayPowerMgrClient::GetInstance().RestoreBrightness();
+            SingletonContainer::Get<WindowServiceBackend>().RestoreBrightness();
             SetDisplayBrightness(UNDEFINED_BRIGHTNESS); // UNDEFINED_BRIGHTNESS means system default brightness
         }
         SetBrightnessWindow(INVALID_WINDOW_ID);
     } else {
         if (GetDisplayBrightness() != node->GetBrightness()) {
             WLOGFI("adjust brightness with value: %{public}u", ToOverrideBrightness(node->GetBrightness()));
-            DisplayPowerMgr::DisplayPowerMgrClient::GetInstance().OverrideBrightness(
+            SingletonContainer::Get<WindowServiceBackend>().OverrideBrightness(
                 ToOverrideBrightness(node->GetBrightness()));
             SetDisplayBrightness(node->GetBrightness());
         }
@@ -565,6 +580,7 @@ void WindowNodeContainer::UpdateBrightness(uint32_t id, bool byRemoved)
 
 void WindowNodeContainer::AssignZOrder()
 {
+    WM_PERF_SCOPED_STAT(WindowPerfStatType::ASSIGN_ZORDER);
     zOrder_ = 0;
     WindowNodeOperationFunc func = [this](sptr<WindowNode> node) {
         if (node->surfaceNode_ == nullptr) {
@@ -646,8 +662,8 @@ void WindowNodeContainer::HandleKeepScreenOn(const sptr<WindowNode>& node, bool
     if (requireLock && node->keepScreenLock_ == nullptr) {
         // reset ipc identity
         std::string identity = IPCSkeleton::ResetCallingIdentity();
-        node->keepScreenLock_ = PowerMgr::PowerMgrClient::GetInstance().CreateRunningLock(node->GetWindowName(),
-            PowerMgr::RunningLockType::RUNNINGLOCK_SCREEN);
+        node->keepScreenLock_ =
+            SingletonContainer::Get<WindowServiceBackend>().CreateScreenRunningLock(node->GetWindowName());
         // set ipc identity to raw
         IPCSkeleton::SetCallingIdentity(identity);
     }
@@ -976,31 +992,41 @@ std::vector<Rect> WindowNodeContainer::GetAvoidAreaByType(AvoidAreaType avoidAre
 void WindowNodeContainer::OnAvoidAreaChange(const std::vector<Rect>& avoidArea, DisplayId displayId)
 {
     for (auto& node : appWindowNode_->children_) {
-        if (node->GetWindowMode() == WindowMode::WINDOW_MODE_FULLSCREEN && node->GetWindowToken() != nullptr) {
-            // notify client
+        // every app window is notified so that its process can answer avoid area queries locally, the client only
+        // passes the change on to listeners of fullscreen windows
+        if (node->GetDisplayId() == displayId && node->GetWindowToken() != nullptr) {
             node->GetWindowToken()->UpdateAvoidArea(avoidArea);
         }
     }
 }
 
-void WindowNodeContainer::DumpScreenWindowTree()
+void WindowNodeContainer::DumpScreenWindowTree(WindowTreeChangeReason reason)
 {
-    WLOGFI("-------- dump window info begin---------");
-    WLOGFI("WindowName DisplayId WinId Type Mode Flag ZOrd Orientation [   x    y    w    h]");
+    // the tree is recorded in binary and decoded on demand, see "hidumper -a '-tree'" and window_tree_analyzer
+    treeRecordNodes_.clear();
     uint32_t zOrder = zOrder_;
-    WindowNodeOperationFunc func = [&zOrder](sptr<WindowNode> node) {
+    WindowNodeOperationFunc func = [this, &zOrder](sptr<WindowNode> node) {
         Rect rect = node->GetWindowRect();
-        const std::string& windowName = node->GetWindowName().size() < WINDOW_NAME_MAX_LENGTH ?
-            node->GetWindowName() : node->GetWindowName().substr(0, WINDOW_NAME_MAX_LENGTH);
-        WLOGI("DumpScreenWindowTree: %{public}10s %{public}9" PRIu64" %{public}5u %{public}4u %{public}4u %{public}4u "
-            "%{public}4u %{public}11u [%{public}4d %{public}4d %{public}4u %{public}4u]",
-            windowName.c_str(), node->GetDisplayId(), node->GetWindowId(), node->GetWindowType(), node->GetWindowMode(),
-            node->GetWindowFlags(), --zOrder, static_cast<uint32_t>(node->GetRequestedOrientation()),
-            rect.posX_, rect.posY_, rect.width_, rect.height_);
+        WindowTreeNodeRecord record;
+        record.displayId_ = node->GetDisplayId();
+        record.windowId_ = node->GetWindowId();
+        record.parentId_ = node->parent_ != nullptr ? node->parent_->GetWindowId() : INVALID_WINDOW_ID;
+        record.type_ = static_cast<uint32_t>(node->GetWindowType());
+        record.flags_ = node->GetWindowFlags();
+        record.zOrder_ = --zOrder;
+        record.posX_ = rect.posX_;
+        record.posY_ = rect.posY_;
+        record.width_ = rect.width_;
+        record.height_ = rect.height_;
+        record.mode_ = static_cast<uint8_t>(node->GetWindowMode());
+        record.visibility_ = node->currentVisibility_ ? 1 : 0;
+        record.orientation_ = static_cast<uint8_t>(node->GetRequestedOrientation());
+        record.reserved_ = 0;
+        treeRecordNodes_.push_back(record);
         return false;
     };
     TraverseWindowTree(func, true);
-    WLOGFI("-------- dump window info end  ---------");
+    WindowTreeRecorder::GetInstance().Record(reason, treeRecordNodes_);
 }
 
 uint64_t WindowNodeContainer::GetScreenId(DisplayId displayId) const
@@ -1023,6 +1049,10 @@ void WindowNodeContainer::ProcessWindowStateChange(WindowState state, WindowStat
 {
     switch (reason) {
         case WindowStateChangeReason::KEYGUARD: {
+            if (state == WindowState::STATE_UNFROZEN && isKeyguardFrozen_) {
+                UnfreezeKeyguardFrozenNodes();
+                break;
+            }
             int32_t topPriority = zorderPolicy_->GetWindowPriority(WindowType::WINDOW_TYPE_KEYGUARD);
             TraverseAndUpdateWindowState(state, topPriority);
             break;
@@ -1035,12 +1065,37 @@ void WindowNodeContainer::ProcessWindowStateChange(WindowState state, WindowStat
 void WindowNodeContainer::TraverseAndUpdateWindowState(WindowState state, int32_t topPriority)
 {
     std::vector<sptr<WindowNode>> rootNodes = { belowAppWindowNode_, appWindowNode_, aboveAppWindowNode_ };
+    std::vector<wptr<WindowNode>> updatedNodes;
     for (auto& node : rootNodes) {
-        UpdateWindowState(node, topPriority, state);
+        UpdateWindowState(node, topPriority, state, updatedNodes);
+    }
+    isKeyguardFrozen_ = (state == WindowState::STATE_FROZEN);
+    keyguardFrozenNodes_.clear();
+    if (isKeyguardFrozen_) {
+        keyguardFrozenNodes_.swap(updatedNodes);
+    }
+}
+
+void WindowNodeContainer::UnfreezeKeyguardFrozenNodes()
+{
+    WM_SCOPED_TRACE("wms:UnfreezeKeyguardFrozenNodes(%zu)", keyguardFrozenNodes_.size());
+    for (auto& weakNode : keyguardFrozenNodes_) {
+        auto node = weakNode.promote();
+        // windows removed while the screen was off are skipped, windows added since then were never frozen
+        if (node == nullptr || node->parent_ == nullptr) {
+            continue;
+        }
+        if (node->GetWindowToken()) {
+            node->GetWindowToken()->UpdateWindowState(WindowState::STATE_UNFROZEN);
+        }
+        HandleKeepScreenOn(node, WindowState::STATE_UNFROZEN);
     }
+    keyguardFrozenNodes_.clear();
+    isKeyguardFrozen_ = false;
 }
 
-void WindowNodeContainer::UpdateWindowState(sptr<WindowNode> node, int32_t topPriority, WindowState state)
+void WindowNodeContainer::UpdateWindowState(sptr<WindowNode> node, int32_t topPriority, WindowState state,
+    std::vector<wptr<WindowNode>>& updatedNodes)
 {
     if (node == nullptr) {
         return;
@@ -1052,10 +1107,11 @@ void WindowNodeContainer::UpdateWindowState(sptr<WindowNode> node, int32_t topPr
                 node->GetWindowToken()->UpdateWindowState(state);
             }
             HandleKeepScreenOn(node, state);
+            updatedNodes.emplace_back(node);
         }
     }
     for (auto& childNode : node->children_) {
-        UpdateWindowState(childNode, topPriority, state);
+        UpdateWindowState(childNode, topPriority, state, updatedNodes);
     }
 }
 
@@ -1128,7 +1184,7 @@ WMError WindowNodeContainer::RaiseZOrderForAppWindow(sptr<WindowNode>& node, spt
     }
     AssignZOrder();
     WLOGFI("RaiseZOrderForAppWindow finished");
-    DumpScreenWindowTree();
+    DumpScreenWindowTree(WindowTreeChangeReason::RAISE_ZORDER);
     return WMError::WM_OK;
 }
 
@@ -1280,14 +1336,14 @@ WMError WindowNodeContainer::SwitchLayoutPolicy(WindowLayoutMode dstMode, Displa
         layoutPolicy_->Clean();
         layoutPolicy_ = layoutPolicys_[dstMode];
         layoutPolicy_->Launch();
-        DumpScreenWindowTree();
+        DumpScreenWindowTree(WindowTreeChangeReason::SWITCH_LAYOUT);
     } else {
         WLOGFI("Current layout mode is already: %{public}d", static_cast<uint32_t>(dstMode));
     }
     if (reorder) {
         windowPair_->Clear();
         layoutPolicy_->Reorder();
-        DumpScreenWindowTree();
+        DumpScreenWindowTree(WindowTreeChangeReason::REORDER);
     }
     NotifyIfSystemBarTintChanged(displayId);
     return WMError::WM_OK;
@@ -1400,7 +1456,19 @@ void WindowNodeContainer::ProcessDisplayDestroy(DisplayId displayId, std::vector
 void WindowNodeContainer::ProcessDisplayChange(DisplayId displayId, const Rect& displayRect)
 {
     displayRectMap_[displayId] = displayRect;
-    layoutPolicy_->UpdateDisplayInfo(displayRectMap_);
+    {
+        WM_PERF_SCOPED_STAT(WindowPerfStatType::LAYOUT);
+        // system bars carry the rects of the new display size, one pass places them and every window they limit
+        layoutPolicy_->UpdateDisplayRect(displayId, displayRect);
+    }
+    for (auto& node : aboveAppWindowNode_->children_) {
+        if (node->GetDisplayId() == displayId && WindowHelper::IsAvoidAreaWindow(node->GetWindowType())) {
+            avoidController_->AvoidControl(node, AvoidControlType::AVOID_NODE_UPDATE);
+        }
+    }
+    NotifyIfSystemBarRegionChanged(displayId);
+    NotifyIfSystemBarTintChanged(displayId);
+    DumpScreenWindowTree(WindowTreeChangeReason::UPDATE_WINDOW);
 }
 
 void WindowNodeContainer::TraverseWindowTree(const WindowNodeOperationFunc& func, bool isFromTopToBottom) const
@@ -1525,6 +1593,11 @@ float WindowNodeContainer::GetVirtualPixelRatio(DisplayId displayId) const
     return layoutPolicy_->GetVirtualPixelRatio(displayId);
 }
 
+Rect WindowNodeContainer::GetPredictedLayoutRect(const sptr<WindowNode>& node)
+{
+    return layoutPolicy_->GetPredictedLayoutRect(node);
+}
+
 bool WindowNodeContainer::ReadIsWindowAnimationEnabledProperty()
 {
     if (access(DISABLE_WINDOW_ANIMATION_PATH, F_OK) == 0) {
@@ -1577,6 +1650,13 @@ void WindowNodeContainer::SetMinimizedByOther(bool isMinimizedByOther)
     isMinimizedByOther_ = isMinimizedByOther;
 }
 
+void WindowNodeContainer::SetDividerDragNotifyInterval(uint32_t interval)
+{
+    for (auto& elem : layoutPolicys_) {
+        elem.second->SetDividerDragNotifyInterval(interval);
+    }
+}
+
 void WindowNodeContainer::GetModeChangeHotZones(DisplayId displayId, ModeChangeHotZones& hotZones,
     const ModeChangeHotZonesConfig& config)
 {
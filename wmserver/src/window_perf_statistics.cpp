@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_perf_statistics.h"
+
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+
+#include <hisysevent.h>
+
+#include "window_manager_hilog.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WindowPerfStatistics"};
+    constexpr uint64_t REPORT_INTERVAL_US = 3600ULL * 1000 * 1000; // report the last hour once an hour
+    const char* const STAT_TYPE_NAMES[] = {
+        "CreateWindow",
+        "AddWindow",
+        "RemoveWindow",
+        "DestroyWindow",
+        "UpdateProperty",
+        "Layout",
+        "AssignZOrder",
+        "InputSync",
+        "RSCommit",
+        "LockWait",
+    };
+}
+WM_IMPLEMENT_SINGLE_INSTANCE(WindowPerfStatistics)
+
+WindowPerfStatistics::~WindowPerfStatistics()
+{
+    StopPeriodicReport();
+}
+
+void WindowPerfStatistics::Record(WindowPerfStatType type, uint64_t costUs)
+{
+    size_t index = static_cast<size_t>(type);
+    if (index >= STAT_TYPE_NUM) {
+        return;
+    }
+    histograms_[index].Record(costUs);
+    intervalHistograms_[index].Record(costUs);
+}
+
+void WindowPerfStatistics::RecordSince(WindowPerfStatType type, uint64_t startTimeUs)
+{
+    uint64_t now = PerfHistogram::GetCurrentTimeUs();
+    Record(type, now > startTimeUs ? now - startTimeUs : 0);
+}
+
+void WindowPerfStatistics::Dump(std::string& dumpInfo) const
+{
+    std::ostringstream os;
+    os << "-------------------- WMS Perf Statistics --------------------" << std::endl;
+    for (size_t i = 0; i < STAT_TYPE_NUM; i++) {
+        os << STAT_TYPE_NAMES[i] << ": " << histograms_[i].ToString() << std::endl;
+    }
+    dumpInfo.append(os.str());
+}
+
+void WindowPerfStatistics::Reset()
+{
+    for (auto& histogram : histograms_) {
+        histogram.Reset();
+    }
+}
+
+void WindowPerfStatistics::StartPeriodicReport()
+{
+    std::lock_guard<std::mutex> lock(reportMutex_);
+    if (reportThread_.joinable()) {
+        return;
+    }
+    isReportStopped_ = false;
+    reportThread_ = std::thread(&WindowPerfStatistics::ReportLoop, this);
+}
+
+void WindowPerfStatistics::StopPeriodicReport()
+{
+    {
+        std::lock_guard<std::mutex> lock(reportMutex_);
+        isReportStopped_ = true;
+    }
+    reportCond_.notify_all();
+    if (reportThread_.joinable()) {
+        reportThread_.join();
+    }
+}
+
+void WindowPerfStatistics::ReportLoop()
+{
+    std::unique_lock<std::mutex> lock(reportMutex_);
+    while (!reportCond_.wait_for(lock, std::chrono::microseconds(REPORT_INTERVAL_US),
+        [this]() { return isReportStopped_; })) {
+        lock.unlock();
+        ReportStatistics();
+        lock.lock();
+    }
+}
+
+void WindowPerfStatistics::ReportStatistics()
+{
+    std::vector<std::string> names;
+    std::vector<uint64_t> counts;
+    std::vector<uint64_t> avgs;
+    std::vector<uint64_t> p50s;
+    std::vector<uint64_t> p99s;
+    std::vector<uint64_t> maxs;
+    for (size_t i = 0; i < STAT_TYPE_NUM; i++) {
+        // each report covers its own interval
+        PerfHistogramSnapshot snapshot = intervalHistograms_[i].TakeSnapshot();
+        names.emplace_back(STAT_TYPE_NAMES[i]);
+        counts.push_back(snapshot.count_);
+        avgs.push_back(snapshot.GetAverageUs());
+        p50s.push_back(snapshot.p50Us_);
+        p99s.push_back(snapshot.p99Us_);
+        maxs.push_back(snapshot.maxUs_);
+    }
+    int32_t ret = OHOS::HiviewDFX::HiSysEvent::Write(
+        OHOS::HiviewDFX::HiSysEvent::Domain::WINDOW_MANAGER,
+        "WINDOW_PERF_STATISTICS",
+        OHOS::HiviewDFX::HiSysEvent::EventType::STATISTIC,
+        "PID", getpid(),
+        "UID", getuid(),
+        "OPERATION", names,
+        "COUNT", counts,
+        "AVG_US", avgs,
+        "P50_US", p50s,
+        "P99_US", p99s,
+        "MAX_US", maxs);
+    if (ret != 0) {
+        WLOGFE("Write HiSysEvent error, ret:%{public}d", ret);
+    }
+}
+} // namespace Rosen
+} // namespace OHOS
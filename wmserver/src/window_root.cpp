@@ -16,12 +16,11 @@
 #include "window_root.h"
 
 #include <cinttypes>
-#include <display_power_mgr_client.h>
 #include <hisysevent.h>
-#include <transaction/rs_transaction.h>
 #include "display_manager_service_inner.h"
 #include "window_helper.h"
 #include "window_manager_hilog.h"
+#include "window_service_backend.h"
 
 namespace OHOS {
 namespace Rosen {
@@ -71,6 +70,7 @@ sptr<WindowNodeContainer> WindowRoot::CreateWindowNodeContainer(DisplayId displa
     sptr<WindowNodeContainer> container = new WindowNodeContainer(displayId,
         static_cast<uint32_t>(displayInfo->GetWidth()), static_cast<uint32_t>(displayInfo->GetHeight()));
     container->SetMinimizedByOther(isMinimizedByOtherWindow_);
+    container->SetDividerDragNotifyInterval(dividerDragNotifyInterval_);
     windowNodeContainerMap_.insert(std::make_pair(screenGroupId, container));
     std::vector<DisplayId> displayVec = { displayId };
     displayIdMap_.insert(std::make_pair(screenGroupId, displayVec));
@@ -371,7 +371,7 @@ void WindowRoot::SetBrightness(uint32_t windowId, float brightness)
     if (windowId == container->GetActiveWindow()) {
         if (container->GetDisplayBrightness() != brightness) {
             WLOGFI("set brightness with value: %{public}u", container->ToOverrideBrightness(brightness));
-            DisplayPowerMgr::DisplayPowerMgrClient::GetInstance().OverrideBrightness(
+            SingletonContainer::Get<WindowServiceBackend>().OverrideBrightness(
                 container->ToOverrideBrightness(brightness));
             container->SetDisplayBrightness(brightness);
         }
@@ -706,7 +706,7 @@ WMError WindowRoot::RaiseZOrderForAppWindow(sptr<WindowNode>& node)
 
 void WindowRoot::OnRemoteDied(const sptr<IRemoteObject>& remoteObject)
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    WM_PROFILED_LOCK(mutex_);
     auto iter = windowIdMap_.find(remoteObject);
     if (iter == windowIdMap_.end()) {
         WLOGFE("window id could not be found");
@@ -799,6 +799,11 @@ void WindowRoot::FocusFaultDetection() const
         }
     }
     if (needReport) {
+        for (auto& elem : windowNodeContainerMap_) {
+            if (elem.second != nullptr) {
+                elem.second->DumpScreenWindowTree(WindowTreeChangeReason::FOCUS_FAULT);
+            }
+        }
         std::string windowLog(GenAllWindowsLogInfo());
         WLOGFE("The focus window is faulty, focusWinId:%{public}u, %{public}s", focusWinId, windowLog.c_str());
         int32_t ret = OHOS::HiviewDFX::HiSysEvent::Write(
@@ -885,6 +890,16 @@ float WindowRoot::GetVirtualPixelRatio(DisplayId displayId) const
     return container->GetVirtualPixelRatio(displayId);
 }
 
+Rect WindowRoot::GetPredictedLayoutRect(const sptr<WindowNode>& node)
+{
+    auto container = GetWindowNodeContainer(node->GetDisplayId());
+    if (container == nullptr) {
+        WLOGFE("window container could not be found");
+        return { 0, 0, 0, 0 };
+    }
+    return container->GetPredictedLayoutRect(node);
+}
+
 WMError WindowRoot::GetAccessibilityWindowInfo(sptr<AccessibilityWindowInfo>& windowInfo)
 {
     for (auto iter = windowNodeContainerMap_.begin(); iter != windowNodeContainerMap_.end(); ++iter) {
@@ -903,6 +918,15 @@ void WindowRoot::SetMaxAppWindowNumber(int windowNum)
     maxAppWindowNumber_ = windowNum;
 }
 
+void WindowRoot::SetDividerDragNotifyInterval(uint32_t interval)
+{
+    WLOGFI("dividerDragNotifyInterval:%{public}u", interval);
+    dividerDragNotifyInterval_ = interval;
+    for (auto& elem : windowNodeContainerMap_) {
+        elem.second->SetDividerDragNotifyInterval(interval);
+    }
+}
+
 void WindowRoot::SetMinimizedByOtherWindow(bool isMinimizedByOtherWindow)
 {
     WLOGFI("isMinimizedByOtherWindow:%{public}d", isMinimizedByOtherWindow);
@@ -920,5 +944,48 @@ WMError WindowRoot::GetModeChangeHotZones(DisplayId displayId,
     container->GetModeChangeHotZones(displayId, hotZones, config);
     return WMError::WM_OK;
 }
+
+void WindowRoot::GetWindowStateSnapshot(WindowStateSnapshot& snapshot) const
+{
+    snapshot.displayCount_ = 0;
+    for (auto& elem : displayIdMap_) {
+        auto containerIter = windowNodeContainerMap_.find(elem.first);
+        if (containerIter == windowNodeContainerMap_.end() || containerIter->second == nullptr) {
+            continue;
+        }
+        for (auto displayId : elem.second) {
+            if (snapshot.displayCount_ >= WINDOW_STATE_MAX_DISPLAY_NUM) {
+                break;
+            }
+            Rect displayRect = containerIter->second->GetDisplayRect(displayId);
+            WindowStateDisplayEntry& entry = snapshot.displays_[snapshot.displayCount_++];
+            entry.displayId_ = displayId;
+            entry.posX_ = displayRect.posX_;
+            entry.posY_ = displayRect.posY_;
+            entry.width_ = displayRect.width_;
+            entry.height_ = displayRect.height_;
+            entry.focusedWindowId_ = containerIter->second->GetFocusWindow();
+            entry.reserved_ = 0;
+        }
+    }
+
+    // same answer as GetTopWindowId for every visible main window
+    snapshot.topWindowCount_ = 0;
+    for (auto& elem : windowNodeMap_) {
+        if (snapshot.topWindowCount_ >= WINDOW_STATE_MAX_TOP_WINDOW_NUM) {
+            WLOGFD("too many main windows, the rest are left to GetTopWindowId");
+            break;
+        }
+        auto& node = elem.second;
+        if (node == nullptr || !node->currentVisibility_ || !WindowHelper::IsMainWindow(node->GetWindowType())) {
+            continue;
+        }
+        uint32_t topWinId = elem.first;
+        if (!node->children_.empty() && WindowHelper::IsSubWindow(node->children_.back()->GetWindowType())) {
+            topWinId = node->children_.back()->GetWindowId();
+        }
+        snapshot.topWindows_[snapshot.topWindowCount_++] = { elem.first, topWinId };
+    }
+}
 } // namespace OHOS::Rosen
 } // namespace OHOS
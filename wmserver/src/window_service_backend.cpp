@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_service_backend.h"
+
+#ifdef WM_HEADLESS_BACKEND
+#include "headless_window_service_backend.h"
+#else
+#include <display_power_mgr_client.h>
+#include <input_manager.h>
+#include <power_mgr_client.h>
+#include <running_lock.h>
+#include <transaction/rs_transaction.h>
+#include <ui/rs_surface_extractor.h>
+#endif
+
+namespace OHOS {
+namespace Rosen {
+#ifndef WM_HEADLESS_BACKEND
+namespace {
+class PlatformWindowServiceBackend : public WindowServiceBackend {
+public:
+    void FlushImplicitTransaction() override
+    {
+        RSTransaction::FlushImplicitTransaction();
+    }
+
+    std::shared_ptr<RSSurface> ExtractRSSurface(const std::shared_ptr<RSSurfaceNode>& surfaceNode) override
+    {
+        return RSSurfaceExtractor::ExtractRSSurface(surfaceNode);
+    }
+
+    void UpdateInputDisplayInfo(const std::vector<MMI::PhysicalDisplayInfo>& physicalDisplays,
+        const std::vector<MMI::LogicalDisplayInfo>& logicalDisplays) override
+    {
+        MMI::InputManager::GetInstance()->UpdateDisplayInfo(physicalDisplays, logicalDisplays);
+    }
+
+    bool IsScreenOn() override
+    {
+        return PowerMgr::PowerMgrClient::GetInstance().IsScreenOn();
+    }
+
+    void WakeupDevice() override
+    {
+        PowerMgr::PowerMgrClient::GetInstance().WakeupDevice();
+    }
+
+    void OverrideBrightness(uint32_t brightness) override
+    {
+        DisplayPowerMgr::DisplayPowerMgrClient::GetInstance().OverrideBrightness(brightness);
+    }
+
+    void RestoreBrightness() override
+    {
+        DisplayPowerMgr::DisplayPowerMgrClient::GetInstance().RestoreBrightness();
+    }
+
+    std::shared_ptr<PowerMgr::RunningLock> CreateScreenRunningLock(const std::string& name) override
+    {
+        return PowerMgr::PowerMgrClient::GetInstance().CreateRunningLock(name,
+            PowerMgr::RunningLockType::RUNNINGLOCK_SCREEN);
+    }
+};
+}
+#endif
+
+WindowServiceBackend& WindowServiceBackend::GetInstance()
+{
+#ifdef WM_HEADLESS_BACKEND
+    static HeadlessWindowServiceBackend instance;
+#else
+    static PlatformWindowServiceBackend instance;
+#endif
+    return instance;
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_state_publisher.h"
+
+#include <new>
+#include <sys/mman.h>
+
+#include "window_manager_hilog.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WindowStatePublisher"};
+    constexpr const char* WINDOW_STATE_PAGE_NAME = "WindowStatePage";
+}
+
+WindowStatePublisher::~WindowStatePublisher()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (page_ != nullptr) {
+        ::munmap(page_, sizeof(WindowStatePage));
+        page_ = nullptr;
+    }
+    if (ashmem_ != nullptr) {
+        ashmem_->CloseAshmem();
+        ashmem_ = nullptr;
+    }
+}
+
+bool WindowStatePublisher::InitPageLocked()
+{
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem(WINDOW_STATE_PAGE_NAME, sizeof(WindowStatePage));
+    if (ashmem == nullptr) {
+        WLOGFE("create window state page failed");
+        return false;
+    }
+    void* addr = ::mmap(nullptr, sizeof(WindowStatePage), PROT_READ | PROT_WRITE, MAP_SHARED,
+        ashmem->GetAshmemFd(), 0);
+    if (addr == MAP_FAILED) {
+        WLOGFE("map window state page failed");
+        ashmem->CloseAshmem();
+        return false;
+    }
+    // later mappings, i.e. the ones of the clients, can only be read only; the mapping above stays writable
+    if (!ashmem->SetProtection(PROT_READ)) {
+        WLOGFE("set protection of window state page failed");
+        ::munmap(addr, sizeof(WindowStatePage));
+        ashmem->CloseAshmem();
+        return false;
+    }
+    page_ = new (addr) WindowStatePage();
+    InitWindowStatePage(*page_);
+    ashmem_ = ashmem;
+    WLOGFI("window state page created, size: %{public}zu", sizeof(WindowStatePage));
+    return true;
+}
+
+void WindowStatePublisher::PublishLocked()
+{
+    if (page_ == nullptr || windowRoot_ == nullptr) {
+        return;
+    }
+    WindowStateSnapshot snapshot {};
+    windowRoot_->GetWindowStateSnapshot(snapshot);
+    snapshot.isSystemDecorEnable_ = isSystemDecorEnable_ ? 1 : 0;
+    WriteWindowStatePage(*page_, snapshot);
+}
+
+void WindowStatePublisher::Publish()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    PublishLocked();
+}
+
+void WindowStatePublisher::SetSystemDecorEnable(bool isSystemDecorEnable)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    isSystemDecorEnable_ = isSystemDecorEnable;
+    PublishLocked();
+}
+
+sptr<Ashmem> WindowStatePublisher::GetPage()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ashmem_ == nullptr) {
+        if (!InitPageLocked()) {
+            return nullptr;
+        }
+        PublishLocked();
+    }
+    return ashmem_;
+}
+} // namespace Rosen
+} // namespace OHOS
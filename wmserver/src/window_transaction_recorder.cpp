@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_transaction_recorder.h"
+
+#include "perf_histogram.h"
+#include "window_manager_hilog.h"
+#include "window_manager_interface.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WindowTransactionRecorder"};
+}
+WM_IMPLEMENT_SINGLE_INSTANCE(WindowTransactionRecorder)
+
+bool WindowTransactionRecorder::Start(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isRecording_.load()) {
+        WLOGFE("transaction recording is already started");
+        return false;
+    }
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        WLOGFE("open %{public}s failed", path.c_str());
+        return false;
+    }
+    WindowTransactionFileHeader header = { WINDOW_TRANSACTION_FILE_MAGIC, WINDOW_TRANSACTION_FILE_VERSION };
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    beginTimeUs_ = PerfHistogram::GetCurrentTimeUs();
+    recordCount_ = 0;
+    isRecording_.store(true);
+    WLOGFI("transaction recording started, path: %{public}s", path.c_str());
+    return true;
+}
+
+void WindowTransactionRecorder::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!isRecording_.load()) {
+        return;
+    }
+    isRecording_.store(false);
+    file_.close();
+    WLOGFI("transaction recording stopped, records: %{public}u", recordCount_);
+}
+
+void WindowTransactionRecorder::Record(uint32_t code, MessageParcel& data, MessageParcel& reply,
+    uint64_t startTimeUs)
+{
+    Parcel args;
+    if (!MarshallArguments(code, data, reply, args)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!isRecording_.load()) {
+        return;
+    }
+    WindowTransactionRecordHeader header;
+    header.timeUs_ = startTimeUs > beginTimeUs_ ? startTimeUs - beginTimeUs_ : 0;
+    header.code_ = code;
+    header.dataSize_ = static_cast<uint32_t>(args.GetDataSize());
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file_.write(reinterpret_cast<const char*>(args.GetData()), header.dataSize_);
+    if (!file_.good()) {
+        WLOGFE("write transaction record failed, stop recording");
+        isRecording_.store(false);
+        file_.close();
+        return;
+    }
+    recordCount_++;
+}
+
+bool WindowTransactionRecorder::MarshallArguments(uint32_t code, MessageParcel& data, MessageParcel& reply,
+    Parcel& args) const
+{
+    using WindowManagerMessage = IWindowManager::WindowManagerMessage;
+    data.RewindRead(0);
+    data.ReadInterfaceToken();
+    switch (static_cast<WindowManagerMessage>(code)) {
+        case WindowManagerMessage::TRANS_ID_CREATE_WINDOW: {
+            data.ReadRemoteObject();
+            sptr<WindowProperty> property = data.ReadStrongParcelable<WindowProperty>();
+            reply.RewindRead(0);
+            uint32_t windowId = reply.ReadUint32();
+            return property != nullptr && args.WriteParcelable(property.GetRefPtr()) && args.WriteUint32(windowId);
+        }
+        // arguments of these transactions have no remote object, so they can be copied as they are
+        case WindowManagerMessage::TRANS_ID_ADD_WINDOW:
+        case WindowManagerMessage::TRANS_ID_REMOVE_WINDOW:
+        case WindowManagerMessage::TRANS_ID_DESTROY_WINDOW:
+        case WindowManagerMessage::TRANS_ID_REQUEST_FOCUS:
+        case WindowManagerMessage::TRANS_ID_GET_AVOID_AREA:
+        case WindowManagerMessage::TRANS_ID_GET_TOP_WINDOW_ID:
+        case WindowManagerMessage::TRANS_ID_PROCESS_POINT_DOWN:
+        case WindowManagerMessage::TRANS_ID_PROCESS_POINT_UP:
+        case WindowManagerMessage::TRANS_ID_MINIMIZE_ALL_APP_WINDOWS:
+        case WindowManagerMessage::TRANS_ID_SET_BACKGROUND_BLUR:
+        case WindowManagerMessage::TRANS_ID_SET_APLPHA:
+        case WindowManagerMessage::TRANS_ID_UPDATE_LAYOUT_MODE:
+        case WindowManagerMessage::TRANS_ID_MAXMIZE_WINDOW:
+        case WindowManagerMessage::TRANS_ID_UPDATE_PROPERTY:
+        case WindowManagerMessage::TRANS_ID_GET_FULLSCREEN_AND_SPLIT_HOT_ZONE: {
+            size_t offset = data.GetReadPosition();
+            if (offset >= data.GetDataSize()) {
+                return false;
+            }
+            return args.WriteBuffer(reinterpret_cast<const void*>(data.GetData() + offset),
+                data.GetDataSize() - offset);
+        }
+        default:
+            return false;
+    }
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_transaction_replayer.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <ui/rs_surface_node.h>
+
+#include "window_manager_hilog.h"
+#include "window_stub.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WindowTransactionReplayer"};
+    using WindowManagerMessage = IWindowManager::WindowManagerMessage;
+
+    // client side of a replayed window, the callbacks of the service are dropped
+    class ReplayWindow : public WindowStub {
+    public:
+        void UpdateWindowRect(const struct Rect& rect, bool decoStatus, WindowSizeChangeReason reason) override {}
+        void UpdateWindowMode(WindowMode mode) override {}
+        void UpdateFocusStatus(bool focused) override {}
+        void UpdateAvoidArea(const std::vector<Rect>& avoidAreas) override {}
+        void UpdateWindowState(WindowState state) override {}
+        void UpdateWindowDragInfo(const PointInfo& point, DragEvent event) override {}
+        void UpdateDisplayId(DisplayId from, DisplayId to) override {}
+        void UpdateOccupiedAreaChangeInfo(const sptr<OccupiedAreaChangeInfo>& info) override {}
+        void UpdateActiveStatus(bool isActive) override {}
+    };
+}
+
+bool WindowTransactionReplayer::Load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        WLOGFE("open %{public}s failed", path.c_str());
+        return false;
+    }
+    WindowTransactionFileHeader fileHeader;
+    if (!file.read(reinterpret_cast<char*>(&fileHeader), sizeof(fileHeader)) ||
+        fileHeader.magic_ != WINDOW_TRANSACTION_FILE_MAGIC || fileHeader.version_ != WINDOW_TRANSACTION_FILE_VERSION) {
+        WLOGFE("%{public}s is not a transaction record file", path.c_str());
+        return false;
+    }
+    transactions_.clear();
+    WindowTransactionRecordHeader header;
+    while (file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        Transaction transaction = { header.timeUs_, header.code_, std::vector<uint8_t>(header.dataSize_) };
+        if (!file.read(reinterpret_cast<char*>(transaction.data_.data()), header.dataSize_)) {
+            WLOGFW("record file is truncated, %{public}zu transactions loaded", transactions_.size());
+            break;
+        }
+        transactions_.push_back(std::move(transaction));
+    }
+    return true;
+}
+
+void WindowTransactionReplayer::Replay(bool keepTiming)
+{
+    uint64_t beginTimeUs = PerfHistogram::GetCurrentTimeUs();
+    for (auto& transaction : transactions_) {
+        if (keepTiming) {
+            uint64_t elapsedUs = PerfHistogram::GetCurrentTimeUs() - beginTimeUs;
+            if (transaction.timeUs_ > elapsedUs) {
+                std::this_thread::sleep_for(std::chrono::microseconds(transaction.timeUs_ - elapsedUs));
+            }
+        }
+        uint64_t startTimeUs = PerfHistogram::GetCurrentTimeUs();
+        WMError ret = ReplayTransaction(transaction);
+        uint64_t costUs = PerfHistogram::GetCurrentTimeUs() - startTimeUs;
+        auto& histogram = histograms_[transaction.code_];
+        if (histogram == nullptr) {
+            histogram = std::make_unique<PerfHistogram>();
+        }
+        histogram->Record(costUs);
+        if (ret != WMError::WM_OK && ret != WMError::WM_DO_NOTHING) {
+            WLOGFW("replay transaction %{public}u failed, ret: %{public}d", transaction.code_, ret);
+            failedCount_++;
+        }
+    }
+}
+
+void WindowTransactionReplayer::Dump(std::string& result) const
+{
+    std::ostringstream os;
+    os << "transactions: " << transactions_.size() << ", failed: " << failedCount_ << std::endl;
+    for (auto& elem : histograms_) {
+        os << "code " << elem.first << ": " << elem.second->ToString() << std::endl;
+    }
+    result.append(os.str());
+}
+
+void WindowTransactionReplayer::MapDisplay(DisplayId recordedId, DisplayId displayId)
+{
+    displayIdMap_[recordedId] = displayId;
+}
+
+void WindowTransactionReplayer::SetDefaultDisplay(DisplayId displayId)
+{
+    defaultDisplayId_ = displayId;
+}
+
+WMError WindowTransactionReplayer::ReplayTransaction(const Transaction& transaction)
+{
+    Parcel data;
+    data.WriteBuffer(transaction.data_.data(), transaction.data_.size());
+    auto code = static_cast<WindowManagerMessage>(transaction.code_);
+    switch (code) {
+        case WindowManagerMessage::TRANS_ID_CREATE_WINDOW:
+            return ReplayCreateWindow(data);
+        case WindowManagerMessage::TRANS_ID_ADD_WINDOW:
+        case WindowManagerMessage::TRANS_ID_UPDATE_PROPERTY:
+            return ReplayWindowProperty(transaction.code_, data);
+        case WindowManagerMessage::TRANS_ID_MINIMIZE_ALL_APP_WINDOWS:
+            target_.MinimizeAllAppWindows(MapDisplayId(data.ReadUint64()));
+            return WMError::WM_OK;
+        case WindowManagerMessage::TRANS_ID_UPDATE_LAYOUT_MODE: {
+            DisplayId displayId = MapDisplayId(data.ReadUint64());
+            return target_.SetWindowLayoutMode(displayId, static_cast<WindowLayoutMode>(data.ReadUint32()));
+        }
+        case WindowManagerMessage::TRANS_ID_GET_FULLSCREEN_AND_SPLIT_HOT_ZONE: {
+            ModeChangeHotZones hotZones = { { 0, 0, 0, 0 }, { 0, 0, 0, 0 }, { 0, 0, 0, 0 } };
+            return target_.GetModeChangeHotZones(MapDisplayId(data.ReadUint64()), hotZones);
+        }
+        default:
+            break;
+    }
+    // the remaining transactions start with the id of the window they apply to
+    uint32_t windowId = INVALID_WINDOW_ID;
+    if (!MapWindowId(data.ReadUint32(), windowId)) {
+        return WMError::WM_ERROR_INVALID_WINDOW;
+    }
+    switch (code) {
+        case WindowManagerMessage::TRANS_ID_REMOVE_WINDOW:
+            return target_.RemoveWindow(windowId);
+        case WindowManagerMessage::TRANS_ID_DESTROY_WINDOW:
+            return target_.DestroyWindow(windowId);
+        case WindowManagerMessage::TRANS_ID_REQUEST_FOCUS:
+            return target_.RequestFocus(windowId);
+        case WindowManagerMessage::TRANS_ID_GET_AVOID_AREA:
+            target_.GetAvoidAreaByType(windowId, static_cast<AvoidAreaType>(data.ReadUint32()));
+            return WMError::WM_OK;
+        case WindowManagerMessage::TRANS_ID_GET_TOP_WINDOW_ID: {
+            uint32_t topWinId = INVALID_WINDOW_ID;
+            return target_.GetTopWindowId(windowId, topWinId);
+        }
+        case WindowManagerMessage::TRANS_ID_PROCESS_POINT_DOWN:
+            target_.ProcessPointDown(windowId, data.ReadBool());
+            return WMError::WM_OK;
+        case WindowManagerMessage::TRANS_ID_PROCESS_POINT_UP:
+            target_.ProcessPointUp(windowId);
+            return WMError::WM_OK;
+        case WindowManagerMessage::TRANS_ID_SET_BACKGROUND_BLUR:
+            return target_.SetWindowBackgroundBlur(windowId, static_cast<WindowBlurLevel>(data.ReadUint32()));
+        case WindowManagerMessage::TRANS_ID_SET_APLPHA:
+            return target_.SetAlpha(windowId, data.ReadFloat());
+        case WindowManagerMessage::TRANS_ID_MAXMIZE_WINDOW:
+            return target_.MaxmizeWindow(windowId);
+        default:
+            WLOGFW("transaction %{public}u is not supported", transaction.code_);
+            return WMError::WM_ERROR_INVALID_OPERATION;
+    }
+}
+
+WMError WindowTransactionReplayer::ReplayCreateWindow(Parcel& data)
+{
+    sptr<WindowProperty> property = data.ReadStrongParcelable<WindowProperty>();
+    if (property == nullptr) {
+        return WMError::WM_ERROR_NULLPTR;
+    }
+    uint32_t recordedWindowId = data.ReadUint32();
+    // the window is not created yet, only its parent has to be known
+    property->SetWindowId(INVALID_WINDOW_ID);
+    if (!MapWindowProperty(property)) {
+        return WMError::WM_ERROR_INVALID_WINDOW;
+    }
+    property->SetTokenState(false);
+    sptr<IWindow> window = new ReplayWindow();
+    struct RSSurfaceNodeConfig surfaceNodeConfig;
+    surfaceNodeConfig.SurfaceNodeName = property->GetWindowName();
+    std::shared_ptr<RSSurfaceNode> surfaceNode = RSSurfaceNode::Create(surfaceNodeConfig);
+    if (surfaceNode == nullptr) {
+        WLOGFE("create surface node failed, window: %{public}u", recordedWindowId);
+        return WMError::WM_ERROR_NULLPTR;
+    }
+    uint32_t windowId = INVALID_WINDOW_ID;
+    WMError ret = target_.CreateWindow(window, property, surfaceNode, windowId, nullptr);
+    if (ret == WMError::WM_OK) {
+        windowIdMap_[recordedWindowId] = windowId;
+        windows_.push_back(window);
+    }
+    return ret;
+}
+
+WMError WindowTransactionReplayer::ReplayWindowProperty(uint32_t code, Parcel& data)
+{
+    sptr<WindowProperty> property = data.ReadStrongParcelable<WindowProperty>();
+    if (property == nullptr) {
+        return WMError::WM_ERROR_NULLPTR;
+    }
+    if (!MapWindowProperty(property)) {
+        return WMError::WM_ERROR_INVALID_WINDOW;
+    }
+    if (static_cast<WindowManagerMessage>(code) == WindowManagerMessage::TRANS_ID_ADD_WINDOW) {
+        return target_.AddWindow(property);
+    }
+    return target_.UpdateProperty(property, static_cast<PropertyChangeAction>(data.ReadUint32()));
+}
+
+bool WindowTransactionReplayer::MapWindowId(uint32_t recordedId, uint32_t& windowId) const
+{
+    if (recordedId == INVALID_WINDOW_ID) {
+        windowId = INVALID_WINDOW_ID;
+        return true;
+    }
+    auto iter = windowIdMap_.find(recordedId);
+    if (iter == windowIdMap_.end()) {
+        WLOGFE("window %{public}u is not created by the replay, the record may be incomplete", recordedId);
+        return false;
+    }
+    windowId = iter->second;
+    return true;
+}
+
+bool WindowTransactionReplayer::MapWindowProperty(const sptr<WindowProperty>& property) const
+{
+    uint32_t windowId = INVALID_WINDOW_ID;
+    uint32_t parentId = INVALID_WINDOW_ID;
+    if (!MapWindowId(property->GetWindowId(), windowId) || !MapWindowId(property->GetParentId(), parentId)) {
+        return false;
+    }
+    property->SetWindowId(windowId);
+    property->SetParentId(parentId);
+    property->SetDisplayId(MapDisplayId(property->GetDisplayId()));
+    return true;
+}
+
+DisplayId WindowTransactionReplayer::MapDisplayId(DisplayId recordedId) const
+{
+    auto iter = displayIdMap_.find(recordedId);
+    if (iter != displayIdMap_.end()) {
+        return iter->second;
+    }
+    if (recordedId == DISPLAY_ID_INVALID || defaultDisplayId_ == DISPLAY_ID_INVALID) {
+        return recordedId;
+    }
+    return defaultDisplayId_;
+}
+} // namespace Rosen
+} // namespace OHOS
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "window_tree_recorder.h"
+
+#include <cerrno>
+#include <sstream>
+#include <unistd.h>
+
+#include "window_manager_hilog.h"
+
+namespace OHOS {
+namespace Rosen {
+namespace {
+    constexpr HiviewDFX::HiLogLabel LABEL = {LOG_CORE, HILOG_DOMAIN_WINDOW, "WindowTreeRecorder"};
+}
+WM_IMPLEMENT_SINGLE_INSTANCE(WindowTreeRecorder)
+
+void WindowTreeRecorder::Record(WindowTreeChangeReason reason, const std::vector<WindowTreeNodeRecord>& nodes)
+{
+    uint32_t seq = buffer_.Record(reason, nodes);
+    WLOGFD("window tree recorded, seq: %{public}u, reason: %{public}s, nodes: %{public}zu", seq,
+        WindowTreeChangeReasonToString(static_cast<uint16_t>(reason)), nodes.size());
+}
+
+void WindowTreeRecorder::Dump(std::string& dumpInfo) const
+{
+    std::vector<WindowTreeSnapshot> snapshots = buffer_.GetSnapshots();
+    std::ostringstream os;
+    os << "-------------------- Window Tree Records: " << snapshots.size() << " --------------------" << std::endl;
+    if (snapshots.empty()) {
+        dumpInfo.append(os.str());
+        return;
+    }
+    const WindowTreeSnapshot& latest = snapshots.back();
+    os << "seq: " << latest.header_.seq_ << ", reason: " << WindowTreeChangeReasonToString(latest.header_.reason_) <<
+        ", time(ms): " << latest.header_.timestampMs_ << std::endl;
+    os << "DisplayId WinId Parent Type Mode Flag ZOrd Visible Orientation [   x    y    w    h]" << std::endl;
+    for (auto& node : latest.nodes_) {
+        os << node.displayId_ << " " << node.windowId_ << " " << node.parentId_ << " " << node.type_ << " " <<
+            static_cast<uint32_t>(node.mode_) << " " << node.flags_ << " " << node.zOrder_ << " " <<
+            static_cast<uint32_t>(node.visibility_) << " " << static_cast<uint32_t>(node.orientation_) << " [" <<
+            node.posX_ << " " << node.posY_ << " " << node.width_ << " " << node.height_ << "]" << std::endl;
+    }
+    dumpInfo.append(os.str());
+}
+
+bool WindowTreeRecorder::DumpRaw(int fd) const
+{
+    std::vector<uint8_t> data = buffer_.Serialize();
+    size_t offset = 0;
+    while (offset < data.size()) {
+        ssize_t ret = write(fd, data.data() + offset, data.size() - offset);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            WLOGFE("write window tree records failed, errno: %{public}d", errno);
+            return false;
+        }
+        offset += static_cast<size_t>(ret);
+    }
+    return true;
+}
+} // namespace Rosen
+} // namespace OHOS